@@ -0,0 +1,220 @@
+/**
+ *  @file       algorithm.h
+ *  @brief      Header file for container utility functions
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ALGORITHM_H
+#define ALGORITHM_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+/**
+ *  @file       vector.h
+ *  @brief      Required for vector, the output of the set operations
+ */
+#include "vector.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ *      Set operations on two sorted ranges, [first1, last1) and
+ *      [first2, last2), ordered by the compare function of first1's
+ *      typetable -- e.g. rbtree or set ranges, or sorted vectors.
+ *
+ *      Each is a single merge pass that appends its result, in order,
+ *      to dest (deep copies, iff dest's typetable has a copy function),
+ *      and returns the number of elements appended. A sorted result can
+ *      be turned into a tree in O(n) with rbt_build_sorted.
+ *
+ *      Where one range only has to be skipped over (set_intersection,
+ *      and the second range of set_difference), it is searched ahead
+ *      rather than stepped through: galloping (exponential, then binary)
+ *      search over a vector, and a walk of SET_GALLOP_WALK steps followed
+ *      by an O(log n) descent over an rbtree. Operating on m elements
+ *      and n >> m elements thus costs O(m log(n / m)), not O(m + n).
+ *
+ *      As with std::set_union and the like, equal elements are matched
+ *      one for one, so ranges with duplicates behave as multisets.
+ */
+#define SET_GALLOP_WALK 4
+
+/**< algorithm: set operations on sorted ranges */
+size_t set_union(iterator *first1, iterator *last1,
+                 iterator *first2, iterator *last2, vector *dest);
+size_t set_intersection(iterator *first1, iterator *last1,
+                        iterator *first2, iterator *last2, vector *dest);
+size_t set_difference(iterator *first1, iterator *last1,
+                      iterator *first2, iterator *last2, vector *dest);
+size_t set_symmetric_difference(iterator *first1, iterator *last1,
+                                iterator *first2, iterator *last2,
+                                vector *dest);
+
+/**< algorithm: sorted range containment */
+bool includes(iterator *first1, iterator *last1,
+              iterator *first2, iterator *last2);
+
+/**
+ *      Sequence algorithms over [first, last) of any container.
+ *
+ *      Functions that locate an element return an iterator to it
+ *      (or a copy of last, if there is none); neither first nor last
+ *      is modified. Elements compare equal when the typetable's compare
+ *      function returns 0 (or, without one, when their bytes are equal);
+ *      the _custom variants take their ordering from compare,
+ *      and the _predicate and _if variants take their notion of a match
+ *      from binary_predicate/unary_predicate.
+ *
+ *      The container behind first picks the loop that is run:
+ *      a contiguous range (vector, and the typed vectors) is walked
+ *      with a raw pointer, a list with its nodes, and anything else
+ *      with it_incr. Over contiguous integer ranges, equality searches
+ *      (find, count, equal_equal, search_equal, search_n_equal) compare
+ *      bytes directly -- memchr and memcmp, or word-sized loads --
+ *      rather than calling compare, and lower_bound and the like
+ *      binary search in place -- as they also do over any other
+ *      random access range, such as a deque. partition on a list
+ *      exchanges data pointers, never elements.
+ */
+
+/**< algorithm: non-modifying sequence operations */
+bool all_of(iterator *first, iterator *last,
+            bool (*unary_predicate)(const void *));
+bool any_of(iterator *first, iterator *last,
+            bool (*unary_predicate)(const void *));
+bool none_of(iterator *first, iterator *last,
+             bool (*unary_predicate)(const void *));
+
+void for_each(iterator *first, iterator *last, void (*consumer)(const void *));
+
+iterator find(iterator *first, iterator *last, const void *valaddr);
+iterator find_if(iterator *first, iterator *last,
+                 bool (*unary_predicate)(const void *));
+iterator find_if_not(iterator *first, iterator *last,
+                     bool (*unary_predicate)(const void *));
+
+iterator find_end_equal(iterator *first1, iterator *last1,
+                        iterator *first2, iterator *last2);
+iterator find_end_predicate(iterator *first1, iterator *last1,
+                            iterator *first2, iterator *last2,
+                            bool (*binary_predicate)(const void *,
+                                                     const void *));
+
+iterator find_first_of_equal(iterator *first1, iterator *last1,
+                             iterator *first2, iterator *last2);
+iterator find_first_of_predicate(iterator *first1, iterator *last1,
+                                 iterator *first2, iterator *last2,
+                                 bool (*binary_predicate)(const void *,
+                                                          const void *));
+
+iterator adjacent_find_equal(iterator *first, iterator *last);
+iterator adjacent_find_if(iterator *first, iterator *last,
+                          bool (*binary_predicate)(const void *,
+                                                   const void *));
+
+size_t count(iterator *first, iterator *last, const void *valaddr);
+size_t count_if(iterator *first, iterator *last,
+                bool (*unary_predicate)(const void *));
+
+bool equal_equal(iterator *first1, iterator *last1, iterator *first2);
+bool equal_predicate(iterator *first1, iterator *last1, iterator *first2,
+                     bool (*binary_predicate)(const void *, const void *));
+
+iterator search_equal(iterator *first1, iterator *last1,
+                      iterator *first2, iterator *last2);
+iterator search_predicate(iterator *first1, iterator *last1,
+                          iterator *first2, iterator *last2,
+                          bool (*binary_predicate)(const void *,
+                                                   const void *));
+
+iterator search_n_equal(iterator *first, iterator *last, size_t count,
+                        const void *valaddr);
+iterator search_n_predicate(iterator *first, iterator *last, size_t count,
+                            const void *valaddr,
+                            bool (*binary_predicate)(const void *,
+                                                     const void *));
+
+/**< algorithm: partitioning operations */
+bool is_partitioned(iterator *first, iterator *last,
+                    bool (*unary_predicate)(const void *));
+iterator partition(iterator *first, iterator *last,
+                   bool (*unary_predicate)(const void *));
+iterator partition_point(iterator *first, iterator *last,
+                         bool (*unary_predicate)(const void *));
+
+/**< algorithm: sorting checks */
+bool is_sorted(iterator *first, iterator *last);
+bool is_sorted_custom(iterator *first, iterator *last,
+                      int (*compare)(const void *, const void *));
+
+iterator is_sorted_until(iterator *first, iterator *last);
+iterator is_sorted_until_custom(iterator *first, iterator *last,
+                                int (*compare)(const void *, const void *));
+
+/**< algorithm: binary search on sorted ranges */
+iterator lower_bound(iterator *first, iterator *last, const void *valaddr);
+iterator lower_bound_custom(iterator *first, iterator *last,
+                            const void *valaddr,
+                            int (*compare)(const void *, const void *));
+
+iterator upper_bound(iterator *first, iterator *last, const void *valaddr);
+iterator upper_bound_custom(iterator *first, iterator *last,
+                            const void *valaddr,
+                            int (*compare)(const void *, const void *));
+
+bool binary_search(iterator *first, iterator *last, const void *valaddr);
+bool binary_search_custom(iterator *first, iterator *last, const void *valaddr,
+                          int (*compare)(const void *, const void *));
+
+/**< algorithm: minimum/maximum */
+iterator min_element(iterator *first, iterator *last);
+iterator min_element_custom(iterator *first, iterator *last,
+                            int (*compare)(const void *, const void *));
+
+iterator max_element(iterator *first, iterator *last);
+iterator max_element_custom(iterator *first, iterator *last,
+                            int (*compare)(const void *, const void *));
+
+bool lexicographical_compare(iterator *first1, iterator *last1,
+                             iterator *first2, iterator *last2);
+bool lexicographical_compare_custom(iterator *first1, iterator *last1,
+                                    iterator *first2, iterator *last2,
+                                    int (*compare)(const void *, const void *));
+
+#endif /* ALGORITHM_H */
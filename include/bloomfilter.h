@@ -0,0 +1,105 @@
+/**
+ *  @file       bloomfilter.h
+ *  @brief      Header file for a blocked Bloom filter
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct bloomfilter     bloomfilter;
+typedef struct bloomfilter *   bloomfilter_ptr;
+typedef struct bloomfilter **  bloomfilter_dptr;
+
+/**
+ *      A bloomfilter answers "might this element have been added?"
+ *      with no false negatives, and a small rate of false positives --
+ *      so that, placed in front of a container that holds the same
+ *      elements, it answers most lookups of absent elements without
+ *      touching the container at all.
+ *
+ *      It stores no elements, only bits: elements are hashed with
+ *      ttbl->hash (or, without it, by their ttbl->width bytes), and
+ *      every element sets BLOOMFILTER_K bits within one block of
+ *      BLOOMFILTER_BLOCK_BYTES (a cache line), one bit in every
+ *      64-bit word of the block. A test is thus a single cache miss,
+ *      and its word-wise loop is readily vectorized.
+ *
+ *      Elements cannot be removed (see cuckoofilter for that).
+ *
+ *      bf_serialize writes a filter to a portable byte format
+ *      (independent of the host's byte order), which bf_deserialize
+ *      reads back -- the hash functions must be the same on both ends.
+ */
+#define BLOOMFILTER_BLOCK_BYTES 64
+#define BLOOMFILTER_K           8
+
+/**
+ *  Number of tests bf_maybe_contains_many keeps in flight at once
+ */
+#define BLOOMFILTER_FIND_GROUP 16
+
+/**< bloomfilter: constructor (sized for n elements at rate fpr) */
+bloomfilter *bf_new(struct typetable *ttbl, size_t n, double fpr);
+
+/**< bloomfilter: destructor */
+void bf_delete(bloomfilter **bf);
+
+/**< bloomfilter: length functions */
+size_t bf_count(bloomfilter *bf);
+size_t bf_bytes(bloomfilter *bf);
+
+/**< bloomfilter: insertion */
+void bf_add(bloomfilter *bf, const void *valaddr);
+
+/**< bloomfilter: membership tests */
+bool bf_maybe_contains(bloomfilter *bf, const void *valaddr);
+size_t bf_maybe_contains_many(bloomfilter *bf, const void *base, size_t n,
+                              bool *out);
+
+/**< bloomfilter: remove all elements */
+void bf_clear(bloomfilter *bf);
+
+/**< bloomfilter: serialization */
+size_t bf_serialize(bloomfilter *bf, void *dest, size_t len);
+bloomfilter *bf_deserialize(struct typetable *ttbl, const void *src,
+                            size_t len);
+
+/**< bloomfilter: retrieve typetable */
+struct typetable *bf_get_ttbl(bloomfilter *bf);
+
+#endif /* BLOOMFILTER_H */
@@ -0,0 +1,122 @@
+/**
+ *  @file       btree.h
+ *  @brief      Header file for a B-tree ordered container
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BTREE_H
+#define BTREE_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct btree     btree;
+typedef struct btree *   btree_ptr;
+typedef struct btree **  btree_dptr;
+
+/**
+ *      A btree is an ordered container with the same contract as rbtree
+ *      (same typetable, duplicates allowed by bt_insert, rejected by
+ *      bt_insert_unique), but it stores many elements per node:
+ *      nodes are BTREE_NODE_BYTES (or larger, for very wide elements),
+ *      and their elements are stored inline, in sorted order.
+ *
+ *      A lookup therefore visits about log_B(n) nodes instead of log_2(n),
+ *      each searched within a few cache lines, and the memory overhead
+ *      per element is a fraction of a pointer rather than three of them.
+ *
+ *      Inserting or erasing an element may move its neighbors within
+ *      (and between) nodes -- element addresses, and iterators, are
+ *      invalidated by bt_insert/bt_insert_unique/bt_erase.
+ *
+ *      By default, elements are deep copied into the container,
+ *      iff the typetable provided upon instantiation has a copy function;
+ *      otherwise, they are shallow copied.
+ */
+#define BTREE_NODE_BYTES 512
+
+/**< btree: constructor */
+btree *bt_new(struct typetable *ttbl);
+
+/**< btree: destructor */
+void bt_delete(btree **t);
+
+/**< btree: iterator functions (in order) */
+iterator bt_begin(btree *t);
+iterator bt_end(btree *t);
+
+/**< btree: length functions */
+size_t bt_size(btree *t);
+int bt_height(btree *t);
+bool bt_empty(btree *t);
+
+/**< btree: element access functions */
+void *bt_min(btree *t);
+void *bt_max(btree *t);
+void *bt_predecessor(btree *t, const void *valaddr);
+void *bt_successor(btree *t, const void *valaddr);
+
+/**< btree: lookup */
+void *bt_find(btree *t, const void *valaddr);
+
+/**< btree: insert, erase, erase min/max */
+void bt_insert(btree *t, const void *valaddr);
+void bt_insert_unique(btree *t, const void *valaddr);
+void bt_erase(btree *t, const void *valaddr);
+void bt_erase_min(btree *t);
+void bt_erase_max(btree *t);
+
+/**< btree: remove all elements */
+void bt_clear(btree *t);
+
+/**< btree: map consumer(ctx, elem) to elements in [lo, hi), in order */
+size_t bt_foreach_range(btree *t, const void *lo, const void *hi,
+                        bool (*consumer)(void *, void *), void *ctx);
+
+/**< btree: map visitor to runs of adjacent elements, in order */
+size_t bt_for_each_chunk(btree *t, bool (*visitor)(void *, void *, size_t),
+                         void *ctx);
+
+/**< btree: retrieve typetable */
+struct typetable *bt_get_ttbl(btree *t);
+
+/**< ptrs to vtables */
+extern struct iterator_table *_btree_iterator_;
+
+#endif /* BTREE_H */
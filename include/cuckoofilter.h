@@ -0,0 +1,111 @@
+/**
+ *  @file       cuckoofilter.h
+ *  @brief      Header file for a cuckoo filter
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef CUCKOOFILTER_H
+#define CUCKOOFILTER_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct cuckoofilter     cuckoofilter;
+typedef struct cuckoofilter *   cuckoofilter_ptr;
+typedef struct cuckoofilter **  cuckoofilter_dptr;
+
+/**
+ *      A cuckoofilter answers "might this element have been added?"
+ *      like a bloomfilter does, but also supports removing elements.
+ *
+ *      It stores a 16-bit fingerprint of every element (hashed with
+ *      ttbl->hash, or, without it, by its ttbl->width bytes) in one of
+ *      two buckets of CUCKOOFILTER_SLOTS fingerprints -- 8 bytes each,
+ *      compared all at once. A test reads at most those two buckets;
+ *      the false positive rate is about 2 * CUCKOOFILTER_SLOTS / 65536.
+ *
+ *      Adding an element may relocate other fingerprints to their
+ *      alternate buckets. When no relocation makes room, the last
+ *      fingerprint displaced is kept aside (and still tested): the
+ *      filter is then full -- typically above 95% of its slots -- and
+ *      cf_add returns false until elements are removed. A full filter
+ *      must be rebuilt larger to take more elements.
+ *
+ *      Only remove elements that were added: removing an element that
+ *      was not could remove the fingerprint of another one. An element
+ *      added twice is held twice, and must be removed twice.
+ *
+ *      cf_serialize writes a filter to a portable byte format
+ *      (independent of the host's byte order), which cf_deserialize
+ *      reads back -- the hash functions must be the same on both ends.
+ */
+#define CUCKOOFILTER_SLOTS 4
+
+/**
+ *  Number of tests cf_maybe_contains_many keeps in flight at once
+ */
+#define CUCKOOFILTER_FIND_GROUP 16
+
+/**< cuckoofilter: constructor (sized for n elements) */
+cuckoofilter *cf_new(struct typetable *ttbl, size_t n);
+
+/**< cuckoofilter: destructor */
+void cf_delete(cuckoofilter **cf);
+
+/**< cuckoofilter: length functions */
+size_t cf_count(cuckoofilter *cf);
+size_t cf_capacity(cuckoofilter *cf);
+size_t cf_bytes(cuckoofilter *cf);
+
+/**< cuckoofilter: insertion/removal */
+bool cf_add(cuckoofilter *cf, const void *valaddr);
+bool cf_remove(cuckoofilter *cf, const void *valaddr);
+
+/**< cuckoofilter: membership tests */
+bool cf_maybe_contains(cuckoofilter *cf, const void *valaddr);
+size_t cf_maybe_contains_many(cuckoofilter *cf, const void *base, size_t n,
+                              bool *out);
+
+/**< cuckoofilter: remove all elements */
+void cf_clear(cuckoofilter *cf);
+
+/**< cuckoofilter: serialization */
+size_t cf_serialize(cuckoofilter *cf, void *dest, size_t len);
+cuckoofilter *cf_deserialize(struct typetable *ttbl, const void *src,
+                             size_t len);
+
+/**< cuckoofilter: retrieve typetable */
+struct typetable *cf_get_ttbl(cuckoofilter *cf);
+
+#endif /* CUCKOOFILTER_H */
@@ -0,0 +1,151 @@
+/**
+ *  @file       deque.h
+ *  @brief      Header file for a double-ended queue ADT
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct deque     deque;
+typedef struct deque *   deque_ptr;
+typedef struct deque **  deque_dptr;
+
+/**
+ *      Elements are stored in fixed-size blocks of DEQUE_BLOCK_BYTES
+ *      (or one element per block, for elements wider than that),
+ *      and the blocks are indexed by a growable map of block pointers.
+ *
+ *      Pushing or popping at either end is O(1) and never moves
+ *      existing elements -- addresses obtained via dq_at, dq_front,
+ *      dq_back, or it_curr remain valid until that element is erased.
+ *      Iterators, however, are invalidated by dq_pushf/dq_popf.
+ *
+ *      By default, elements are deep copied into the containers,
+ *      iff the typetable provided upon instantiation has a copy function
+ *      that performs a deep copy of its argument.
+ *
+ *      If there is no deep copy function provided in the typetable,
+ *      elements are shallow copied.
+ */
+#define DEQUE_BLOCK_BYTES 512
+
+/**< deque: constructors */
+deque *dq_new(struct typetable *ttbl);
+deque *dq_newfill(struct typetable *ttbl, size_t n, void *valaddr);
+deque *dq_newrnge(iterator first, iterator last);
+deque *dq_newcopy(deque *dq);
+deque *dq_newmove(deque **dq);
+
+/**< deque: destructor */
+void dq_delete(deque **dq);
+
+/**< deque: iterator functions */
+iterator dq_begin(deque *dq);
+iterator dq_end(deque *dq);
+
+/**< deque: length functions */
+size_t dq_size(deque *dq);
+size_t dq_maxsize(deque *dq);
+
+/**< deque: capacity-based functions */
+bool dq_empty(deque *dq);
+void dq_shrink_to_fit(deque *dq);
+
+/**< deque: element access functions */
+void *dq_at(deque *dq, size_t n);
+void *dq_front(deque *dq);
+void *dq_back(deque *dq);
+
+/**< deque: element access functions with const qualifier */
+const void *dq_at_const(deque *dq, size_t n);
+const void *dq_front_const(deque *dq);
+const void *dq_back_const(deque *dq);
+
+/**< deque: modifiers - push/pop */
+void dq_pushf(deque *dq, const void *valaddr);
+void dq_popf(deque *dq);
+void dq_pushb(deque *dq, const void *valaddr);
+void dq_popb(deque *dq);
+
+/**< deque: container swappage */
+void dq_swap(deque **dq, deque **other);
+
+/**< deque: modifiers - clear container */
+void dq_clear(deque *dq);
+
+/**< deque: map visitor to runs of adjacent elements */
+size_t dq_for_each_chunk(deque *dq, bool (*visitor)(void *, void *, size_t),
+                         void *ctx);
+
+/**< deque: custom print functions - output to FILE stream */
+void dq_puts(deque *dq);
+
+void dq_putsf(deque *dq, const char *before, const char *after,
+              const char *postelem, const char *empty, size_t breaklim);
+
+void dq_fputs(deque *dq, FILE *dest);
+
+void dq_fputsf(deque *dq, FILE *dest, const char *before, const char *after,
+               const char *postelem, const char *empty, size_t breaklim);
+
+/**< deque: required function prototypes for (struct typetable) */
+void *deque_copy(void *arg, const void *other);
+void deque_dtor(void *arg);
+void deque_swap(void *s1, void *s2);
+int deque_compare(const void *c1, const void *c2);
+void deque_print(const void *arg, FILE *dest);
+
+/**< deque: retrieve width/copy/dtor/swap/compare/print/typetable */
+size_t dq_get_width(deque *dq);
+copy_fn dq_get_copy(deque *dq);
+dtor_fn dq_get_dtor(deque *dq);
+swap_fn dq_get_swap(deque *dq);
+compare_fn dq_get_compare(deque *dq);
+print_fn dq_get_print(deque *dq);
+struct typetable *dq_get_ttbl(deque *dq);
+
+/**< ptrs to vtables */
+extern struct typetable *_deque_;
+extern struct iterator_table *_deque_iterator_;
+
+#endif /* DEQUE_H */
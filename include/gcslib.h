@@ -53,15 +53,19 @@
 /**
  *  Dependencies:
  *      utils
- *      algorithm
+ *      iterator
+ *      vector
+ *      list
+ *      rbtree
  */
-/* #include "algorithm.h" */
+#include "algorithm.h"
 
 /**
  *  Dependencies:
  *      utils
  *      iterator
  *      mergesort
+ *      hashset
  */
 #include "vector.h"
 
@@ -83,9 +87,16 @@
  *      utils
  *      iterator
  *      mergesort
+ *      hashset
  */
 #include "list.h"
 
+/**
+ *  Dependencies:
+ *      utils
+ */
+#include "ilist.h"
+
 /**
  *  Dependencies:
  *      utils
@@ -120,9 +131,8 @@
  *  Dependencies:
  *      utils
  *      iterator
- *      mergesort
  */
-/* #include "deque.h" */
+#include "deque.h"
 
 /**
  *  Dependencies:
@@ -141,7 +151,7 @@
  *      iterator
  *      deque
  */
-/* #include "stack.h" */
+#include "stack.h"
 
 /**
  *  Dependencies:
@@ -153,13 +163,19 @@
 /* #include "stack_int.h" */
 /* #include "stack_str.h" */
 
+/**
+ *  Dependencies:
+ *      utils
+ */
+#include "queue.h"
+
 /**
  *  Dependencies:
  *      utils
  *      iterator
  *      deque
  */
-/* #include "queue.h" */
+#include "uqueue.h"
 
 /**
  *  Dependencies:
@@ -178,6 +194,49 @@
  */
  #include "rbtree.h"
 
+/**
+ *  Dependencies:
+ *      utils
+ *      iterator
+ */
+#include "btree.h"
+
+/**
+ *  Dependencies:
+ *      utils
+ *      iterator
+ */
+#include "hashmap.h"
+
+/**
+ *  Dependencies:
+ *      utils
+ *      iterator
+ *      hashmap
+ */
+#include "hashset.h"
+
+/**
+ *  Dependencies:
+ *      utils
+ *      hashset
+ */
+#include "intern.h"
+
+/**
+ *  Dependencies:
+ *      utils
+ *      hashmap
+ */
+#include "lru_cache.h"
+
+/**
+ *  Dependencies:
+ *      utils
+ */
+#include "bloomfilter.h"
+#include "cuckoofilter.h"
+
 /**
  *  Dependencies:
  *      utils
@@ -201,7 +260,7 @@
  *      iterator
  *      rbtree
  */
-/* #include "set.h" */
+#include "set.h"
 
 /**
  *  Dependencies:
@@ -217,10 +276,9 @@
  *  Dependencies:
  *      utils
  *      iterator
- *      pair
  *      rbtree
  */
-/* #include "map.h" */
+#include "map.h"
 
 /**
  *  Dependencies:
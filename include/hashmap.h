@@ -0,0 +1,134 @@
+/**
+ *  @file       hashmap.h
+ *  @brief      Header file for an open-addressing hash map
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct hashmap     hashmap;
+typedef struct hashmap *   hashmap_ptr;
+typedef struct hashmap **  hashmap_dptr;
+
+/**
+ *      A hashmap associates unique keys (described by ttbl_key) with
+ *      values (described by ttbl_val), in no particular order.
+ *
+ *      It is an open-addressing ("Swiss") table: every slot has one
+ *      control byte -- empty, deleted, or 7 bits of the key's hash --
+ *      and slots are probed in groups of HASHMAP_GROUP, whose control
+ *      bytes are matched against the hash all at once (with SSE2,
+ *      where available). A lookup is typically one miss for the
+ *      control bytes and one for the slot; keys are compared only
+ *      when their 7 hash bits match.
+ *
+ *      Entries are a key immediately followed by its value (padded for
+ *      the value's alignment), stored inline in the slot array.
+ *      Keys are hashed with ttbl_key->hash and tested for equality with
+ *      ttbl_key->equals (or, without them, hashed by their
+ *      ttbl_key->width bytes and compared with ttbl_key->compare --
+ *      which only suits plain values, such as flat structs).
+ *
+ *      Inserting may rehash the table, which moves every entry:
+ *      element addresses, and iterators, are invalidated by
+ *      hm_insert/hm_assign/hm_reserve. hm_erase only invalidates
+ *      the erased entry.
+ *
+ *      Keys and values are deep copied into the hashmap, iff their
+ *      typetables have a copy function; otherwise, they are shallow copied.
+ *      Their dtor functions (if any) are called when an entry is erased.
+ */
+#define HASHMAP_GROUP 16
+
+/**
+ *  Number of lookups hm_find_many keeps in flight at once
+ */
+#define HASHMAP_FIND_GROUP 16
+
+/**< hashmap: constructors */
+hashmap *hm_new(struct typetable *ttbl_key, struct typetable *ttbl_val);
+hashmap *hm_newcopy(hashmap *h);
+
+/**< hashmap: destructor */
+void hm_delete(hashmap **h);
+
+/**< hashmap: iterator functions (in slot order) */
+iterator hm_begin(hashmap *h);
+iterator hm_end(hashmap *h);
+
+/**< hashmap: length functions */
+size_t hm_size(hashmap *h);
+size_t hm_capacity(hashmap *h);
+bool hm_empty(hashmap *h);
+
+/**< hashmap: capacity-based functions */
+void hm_reserve(hashmap *h, size_t n);
+
+/**< hashmap: element access functions */
+void *hm_key(hashmap *h, iterator it);
+void *hm_val(hashmap *h, iterator it);
+
+/**< hashmap: lookup */
+void *hm_find(hashmap *h, const void *key);
+void *hm_find_key(hashmap *h, const void *key);
+size_t hm_find_many(hashmap *h, const void *keys, size_t n, void **out);
+
+/**< hashmap: modifiers - insertion */
+bool hm_insert(hashmap *h, const void *key, const void *val);
+bool hm_assign(hashmap *h, const void *key, const void *val);
+
+/**< hashmap: modifiers - erasure */
+void hm_erase(hashmap *h, const void *key);
+
+/**< hashmap: clear container */
+void hm_clear(hashmap *h);
+
+/**< hashmap: retrieve typetables */
+struct typetable *hm_get_key_ttbl(hashmap *h);
+struct typetable *hm_get_val_ttbl(hashmap *h);
+
+/**< ptrs to vtables */
+extern struct iterator_table *_hashmap_iterator_;
+
+#endif /* HASHMAP_H */
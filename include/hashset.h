@@ -0,0 +1,107 @@
+/**
+ *  @file       hashset.h
+ *  @brief      Header file for an unordered container of unique elements
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef HASHSET_H
+#define HASHSET_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct hashset     hashset;
+typedef struct hashset *   hashset_ptr;
+typedef struct hashset **  hashset_dptr;
+
+/**
+ *      A hashset holds unique elements, in no particular order.
+ *
+ *      It is a hashmap whose values have no width, so every slot holds
+ *      just an element: elements are hashed with ttbl->hash and tested
+ *      for equality with ttbl->equals (or, without them, by their bytes
+ *      and with ttbl->compare), and inserting, erasing, and finding
+ *      an element take O(1) expected time.
+ *
+ *      Iterators are hashmap iterators (in slot order); like the
+ *      hashmap, inserting may rehash the table, which invalidates
+ *      element addresses and iterators.
+ *
+ *      By default, elements are deep copied into the container,
+ *      iff the typetable provided upon instantiation has a copy function;
+ *      otherwise, they are shallow copied.
+ */
+
+/**< hashset: constructors */
+hashset *hs_new(struct typetable *ttbl);
+hashset *hs_newcopy(hashset *s);
+
+/**< hashset: destructor */
+void hs_delete(hashset **s);
+
+/**< hashset: iterator functions (in slot order) */
+iterator hs_begin(hashset *s);
+iterator hs_end(hashset *s);
+
+/**< hashset: length functions */
+size_t hs_size(hashset *s);
+size_t hs_capacity(hashset *s);
+bool hs_empty(hashset *s);
+
+/**< hashset: capacity-based functions */
+void hs_reserve(hashset *s, size_t n);
+
+/**< hashset: modifiers - insertion */
+bool hs_insert(hashset *s, const void *valaddr);
+
+/**< hashset: modifiers - erasure */
+void hs_erase(hashset *s, const void *valaddr);
+
+/**< hashset: clear container */
+void hs_clear(hashset *s);
+
+/**< hashset: lookup */
+void *hs_find(hashset *s, const void *valaddr);
+size_t hs_count(hashset *s, const void *valaddr);
+
+/**< hashset: retrieve typetable */
+struct typetable *hs_get_ttbl(hashset *s);
+
+#endif /* HASHSET_H */
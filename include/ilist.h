@@ -0,0 +1,163 @@
+/**
+ *  @file       ilist.h
+ *  @brief      Header file for an intrusive doubly-linked list
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ILIST_H
+#define ILIST_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct list_node_base) and related functions
+ */
+#include "utils.h"
+
+#include <stddef.h>
+
+/**
+ *      An intrusive list does not own, allocate, or copy its elements.
+ *      Instead, the client embeds a (struct list_node_base) member
+ *      in its own struct, and links that member into one or more lists:
+ *
+ *          struct connection {
+ *              int fd;
+ *              list_node_base by_state;    (one member per list)
+ *              list_node_base by_timeout;
+ *          };
+ *
+ *          ilist idle;
+ *          il_init(&idle);
+ *
+ *          il_pushb(&idle, &conn->by_state);
+ *          ...
+ *          il_erase(&idle, &conn->by_state);
+ *
+ *      Linking and unlinking are O(1) and never allocate.
+ *      The element is recovered from its member with il_entry:
+ *
+ *          struct connection *c =
+ *              il_entry(pos, struct connection, by_state);
+ *
+ *      A node may be on at most one list per list_node_base member.
+ *      Once unlinked (il_erase, il_popf, il_popb, il_clear),
+ *      a node is self-linked, so il_linked can tell whether
+ *      it is currently on a list.
+ *
+ *      struct ilist is not opaque, so that it can live on the stack
+ *      or be embedded in another struct -- no allocation is needed
+ *      for the list either.
+ */
+
+/**
+ *  @def        il_entry
+ *  @brief      Retrieves the address of the struct of type TYPE
+ *              that embeds the list_node_base at PTR as member MEMBER
+ */
+#define il_entry(PTR, TYPE, MEMBER)                                            \
+    ((TYPE *)((char *)(PTR) - offsetof(TYPE, MEMBER)))
+
+/**
+ *  @def        il_foreach
+ *  @brief      Visits every node of ilist L, front to back;
+ *              POS is a (list_node_base *)
+ *
+ *  POS must not be unlinked within the loop body --
+ *  use il_foreach_safe for that.
+ */
+#define il_foreach(POS, L)                                                     \
+    for ((POS) = (L)->head.next; (POS) != &(L)->head; (POS) = (POS)->next)
+
+/**
+ *  @def        il_foreach_reverse
+ *  @brief      Visits every node of ilist L, back to front
+ */
+#define il_foreach_reverse(POS, L)                                             \
+    for ((POS) = (L)->head.prev; (POS) != &(L)->head; (POS) = (POS)->prev)
+
+/**
+ *  @def        il_foreach_safe
+ *  @brief      Visits every node of ilist L, front to back;
+ *              POS may be unlinked within the loop body.
+ *              TMP is a (list_node_base *) used as scratch
+ */
+#define il_foreach_safe(POS, TMP, L)                                           \
+    for ((POS) = (L)->head.next, (TMP) = (POS)->next; (POS) != &(L)->head;    \
+         (POS) = (TMP), (TMP) = (POS)->next)
+
+typedef struct ilist     ilist;
+typedef struct ilist *   ilist_ptr;
+typedef struct ilist **  ilist_dptr;
+
+/**
+ *  @struct     ilist
+ *  @brief      Represents an intrusive doubly-linked list
+ */
+struct ilist {
+    list_node_base head;    /**< sentinel; head.next is the front node */
+    size_t size;            /**< number of linked nodes */
+};
+
+/**< ilist: initialization */
+void il_init(ilist *l);
+void il_node_init(list_node_base *n);
+
+/**< ilist: length functions */
+size_t il_size(ilist *l);
+bool il_empty(ilist *l);
+
+/**< ilist: node state */
+bool il_linked(list_node_base *n);
+
+/**< ilist: element access functions */
+list_node_base *il_front(ilist *l);
+list_node_base *il_back(ilist *l);
+
+/**< ilist: iteration without macros */
+list_node_base *il_begin(ilist *l);
+list_node_base *il_end(ilist *l);
+
+/**< ilist: modifiers - push/pop */
+void il_pushf(ilist *l, list_node_base *n);
+void il_pushb(ilist *l, list_node_base *n);
+list_node_base *il_popf(ilist *l);
+list_node_base *il_popb(ilist *l);
+
+/**< ilist: modifiers - insertion/erasure */
+void il_insert(ilist *l, list_node_base *pos, list_node_base *n);
+void il_erase(ilist *l, list_node_base *n);
+
+/**< ilist: modifiers - move/splice/swap */
+void il_move_front(ilist *l, list_node_base *n);
+void il_move_back(ilist *l, list_node_base *n);
+void il_splice(ilist *l, list_node_base *pos, ilist *other);
+void il_swap(ilist *l, ilist *other);
+
+/**< ilist: modifiers - clear container */
+void il_clear(ilist *l, void (*release)(list_node_base *));
+
+#endif /* ILIST_H */
@@ -0,0 +1,97 @@
+/**
+ *  @file       intern.h
+ *  @brief      Header file for a pool of interned (canonical) strings
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef INTERN_H
+#define INTERN_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ *      The intern pool holds one canonical, immutable copy of every
+ *      distinct string passed to str_intern: interning equal strings
+ *      always yields the same address. The pool is shared by the whole
+ *      program, and str_intern/str_intern_find/str_intern_count may be
+ *      called from any number of threads at once.
+ *
+ *      _str_interned_ is the typetable for (char *) elements that are
+ *      interned strings. Its copy function interns its argument
+ *      (so a container holds canonical pointers, not copies), and its
+ *      dtor does nothing (the pool owns the strings). Its hash, equals
+ *      and compare functions accept any (char *), so keys passed to
+ *      a container of _str_interned_ need not be interned -- the pool
+ *      carves its strings out of blocks of its own, and can tell an
+ *      interned string apart from any other without a lookup.
+ *      Two interned strings are equal if and only if their addresses
+ *      are, and hash with the hash stored alongside the string;
+ *      any other string is hashed and compared by content.
+ *
+ *      Its compare function orders strings as str_compare does:
+ *      equal pointers compare equal without reading the strings, and
+ *      after str_intern_rank, every string in the pool carries its rank
+ *      in sorted order, so two ranked strings compare by rank alone.
+ *      Strings interned after the last str_intern_rank are unranked,
+ *      and compare with strcmp until str_intern_rank is called again.
+ *
+ *      str_intern_rank and str_intern_clear must not run while other
+ *      threads compare or use interned strings.
+ */
+
+/**< intern pool: interning and lookup */
+const char *str_intern(const char *str);
+const char *str_intern_find(const char *str);
+
+/**< intern pool: length */
+size_t str_intern_count(void);
+
+/**< intern pool: assign sorted ranks */
+void str_intern_rank(void);
+
+/**< intern pool: release every interned string */
+void str_intern_clear(void);
+
+/**< _str_interned_: functions for (struct typetable) */
+void *str_interned_copy(void *arg, const void *other);
+void str_interned_dtor(void *arg);
+int str_interned_compare(const void *c1, const void *c2);
+size_t str_interned_hash(const void *arg);
+bool str_interned_equals(const void *c1, const void *c2);
+
+/**< ptrs to vtables */
+extern struct typetable *_str_interned_;
+
+#endif /* INTERN_H */
@@ -49,6 +49,12 @@ typedef struct iterator iterator;
  */
 typedef struct iterator_table iterator_table;
 
+/**
+ *  @typedef    span
+ *  @brief      Alias for (struct span)
+ */
+typedef struct span span;
+
 /**
  *  @struct     iterator
  *  @brief      Abstraction for a container
@@ -59,6 +65,20 @@ struct iterator {
     void *curr;    /**< current position (address of a block, or node, etc.) */
 };
 
+/**
+ *  @enum       iterator_category
+ *  @brief      What an iterator can do cheaply; each category
+ *              includes every category listed before it
+ *
+ *  A table that leaves category out of its initializer is ITERATOR_FORWARD.
+ */
+enum iterator_category {
+    ITERATOR_FORWARD,           /**< incr only */
+    ITERATOR_BIDIRECTIONAL,     /**< incr and decr */
+    ITERATOR_RANDOM_ACCESS,     /**< advance/distance in O(1) */
+    ITERATOR_CONTIGUOUS         /**< random access, elements back to back */
+};
+
 /**
  *  @struct     iterator_table
  *  @brief      Determines the functionality of an iterator,
@@ -88,6 +108,23 @@ struct iterator_table {
     bool        (*has_prev)    (iterator);
 
     struct typetable * (*get_ttbl)(void *);
+
+    enum iterator_category category;
+};
+
+/**
+ *  @struct     span
+ *  @brief      A run of count elements, each width bytes wide,
+ *              stored back to back starting at base
+ *
+ *  A span lets a caller that knows the element type walk a contiguous
+ *  container with a plain pointer loop, rather than dispatching
+ *  through an iterator_table once per element.
+ */
+struct span {
+    void *base;     /**< address of the first element */
+    size_t count;   /**< number of elements */
+    size_t width;   /**< size of one element, in bytes */
 };
 
 /**< iterator: begin/end (returns new iterator) */
@@ -122,6 +159,12 @@ bool it_has_prev(iterator it);
 /**< iterator: retrieve typetable */
 struct typetable *it_get_ttbl(iterator it);
 
+/**< iterator: category and contiguous ranges */
+enum iterator_category it_category(iterator it);
+bool it_random_access(iterator it);
+bool it_contiguous(iterator it);
+span it_span(iterator first, iterator last);
+
 /* C99 only */
 #define foreach(TYPE, ID, IT)                                                  \
 for (TYPE *ID = NULL,                                                          \
@@ -129,6 +172,13 @@ for (TYPE *ID = NULL,                                                          \
     ((ID = it_curr(IT)) != finish);                                            \
     it_incr(&IT))                                                              \
 
+/* C99 only -- TYPE must be (width) bytes wide */
+#define foreach_span(TYPE, ID, SPAN)                                           \
+for (TYPE *ID = (SPAN).base,                                                   \
+    (*ID##_finish) = ID + (SPAN).count;                                        \
+    ID != ID##_finish;                                                         \
+    ++ID)                                                                      \
+
 #define massert_iterator(ITER)\
 massert(ITER, "['"#ITER"' was found to be NULL - '"#ITER"' must point to an initialized iterator, such that it refers to a non-null pointer-to-container.]");
 
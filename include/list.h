@@ -148,8 +148,13 @@ iterator l_splicernge(list *l, iterator pos, list *other, iterator first,
 void l_remove(list *l, const void *valaddr);
 void l_remove_if(list *l, bool (*unary_predicate)(const void *));
 
-/**< list: remove duplicates */
+/**< list: remove duplicates - adjacent (sorted l) / all (unsorted l) */
 void l_unique(list *l);
+void l_unique_unordered(list *l);
+
+/**< list: map visitor to all elements, with caller state */
+size_t l_for_each(list *l, bool (*visitor)(void *, void *, size_t),
+                  void *ctx);
 
 /**< list: merge/reverse */
 list *l_merge(list *l, list *other);
@@ -197,4 +202,7 @@ compare_fn l_get_compare(list *l);
 print_fn l_get_print(list *l);
 struct typetable *l_get_ttbl(list *l);
 
+/**< ptrs to vtables */
+extern struct iterator_table *_list_iterator_;
+
 #endif /* LIST_H */
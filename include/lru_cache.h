@@ -0,0 +1,153 @@
+/**
+ *  @file       lru_cache.h
+ *  @brief      Header file for a bounded cache with LRU or CLOCK eviction
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct lru_cache     lru_cache;
+typedef struct lru_cache *   lru_cache_ptr;
+typedef struct lru_cache **  lru_cache_dptr;
+
+typedef struct lru_sharded     lru_sharded;
+typedef struct lru_sharded *   lru_sharded_ptr;
+typedef struct lru_sharded **  lru_sharded_dptr;
+
+/**
+ *  @enum       lru_policy
+ *  @brief      Selects which entry a full cache evicts
+ *
+ *  LRU_STRICT  the least recently used entry; every hit moves
+ *              its entry to the front of the recency list
+ *  LRU_CLOCK   an approximation (second chance): a hit only marks
+ *              its entry as referenced, and eviction sweeps from the
+ *              back of the list, sparing (and moving to the front)
+ *              marked entries -- a hit never relinks anything
+ */
+enum lru_policy { LRU_STRICT, LRU_CLOCK };
+
+/**
+ *      An lru_cache maps unique keys (described by ttbl_key) to values
+ *      (described by ttbl_val), and holds entries up to a capacity,
+ *      evicting by policy to make room. Every entry has a charge:
+ *      1, by default, so that the capacity is a number of entries --
+ *      or what the charge function returns for it (e.g. its size
+ *      in bytes), so that the capacity is a total of those.
+ *
+ *      Entries live in a growable array of nodes, linked (by index)
+ *      into a recency list, and a hashmap maps every key to its node:
+ *      lru_get, lru_put, and lru_erase take O(1) expected time, and
+ *      allocate nothing but the occasional growth of the array.
+ *
+ *      The evict function, if set, is called on every entry evicted
+ *      to respect the capacity, just before it is destroyed
+ *      (it is not called by lru_erase/lru_clear/lru_delete).
+ *
+ *      Addresses of values are invalidated by lru_put and lru_erase.
+ *
+ *      Keys and values are deep copied into the cache, iff their
+ *      typetables have a copy function; otherwise, they are shallow copied.
+ *      Their dtor functions (if any) are called when an entry is removed.
+ *
+ *      An lru_sharded splits its capacity among a power-of-two number
+ *      of lru_caches, each with a lock of its own, and picks the shard
+ *      of a key by its hash; lrus_get copies the value out while
+ *      the shard is locked. Every lrus_ function except lrus_new,
+ *      lrus_delete, and lrus_set_evict is safe to call from any number
+ *      of threads at once.
+ */
+
+/**< lru_cache: constructor */
+lru_cache *lru_new(struct typetable *ttbl_key, struct typetable *ttbl_val,
+                   size_t capacity,
+                   size_t (*charge)(const void *, const void *),
+                   enum lru_policy policy);
+
+/**< lru_cache: destructor */
+void lru_delete(lru_cache **c);
+
+/**< lru_cache: eviction callback */
+void lru_set_evict(lru_cache *c, void (*evict)(const void *, void *, void *),
+                   void *ctx);
+
+/**< lru_cache: length functions */
+size_t lru_size(lru_cache *c);
+size_t lru_charge(lru_cache *c);
+size_t lru_capacity(lru_cache *c);
+bool lru_empty(lru_cache *c);
+
+/**< lru_cache: lookup (lru_get counts as a use, lru_peek does not) */
+void *lru_get(lru_cache *c, const void *key);
+void *lru_peek(lru_cache *c, const void *key);
+
+/**< lru_cache: modifiers */
+bool lru_put(lru_cache *c, const void *key, const void *val);
+void lru_erase(lru_cache *c, const void *key);
+void lru_clear(lru_cache *c);
+
+/**< lru_cache: retrieve policy */
+enum lru_policy lru_get_policy(lru_cache *c);
+
+/**< lru_sharded: constructor */
+lru_sharded *lrus_new(struct typetable *ttbl_key, struct typetable *ttbl_val,
+                      size_t capacity,
+                      size_t (*charge)(const void *, const void *),
+                      enum lru_policy policy, size_t shards);
+
+/**< lru_sharded: destructor */
+void lrus_delete(lru_sharded **c);
+
+/**< lru_sharded: eviction callback (for every shard) */
+void lrus_set_evict(lru_sharded *c,
+                    void (*evict)(const void *, void *, void *), void *ctx);
+
+/**< lru_sharded: length functions */
+size_t lrus_size(lru_sharded *c);
+size_t lrus_charge(lru_sharded *c);
+size_t lrus_shards(lru_sharded *c);
+
+/**< lru_sharded: lookup (copies the value to dest) */
+bool lrus_get(lru_sharded *c, const void *key, void *dest);
+
+/**< lru_sharded: modifiers */
+bool lrus_put(lru_sharded *c, const void *key, const void *val);
+void lrus_erase(lru_sharded *c, const void *key);
+void lrus_clear(lru_sharded *c);
+
+#endif /* LRU_CACHE_H */
@@ -0,0 +1,115 @@
+/**
+ *  @file       map.h
+ *  @brief      Header file for an ordered associative container (key to value)
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef MAP_H
+#define MAP_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct map     map;
+typedef struct map *   map_ptr;
+typedef struct map **  map_dptr;
+
+/**
+ *      A map associates unique keys (described by ttbl_key) with values
+ *      (described by ttbl_val), ordered by ttbl_key->compare.
+ *
+ *      It is an rbtree whose elements are a key immediately followed by
+ *      its value (padded for the value's alignment), stored inline in the
+ *      tree node -- there is no separate pair allocation per entry.
+ *
+ *      Iterators are rbtree iterators over those entries:
+ *      m_key and m_val return the addresses of the key and the value
+ *      of the entry an iterator refers to. Lookups and bound queries
+ *      are O(log n) and return iterators by value.
+ *
+ *      Keys and values are deep copied into the map, iff their typetables
+ *      have a copy function; otherwise, they are shallow copied.
+ *      Their dtor functions (if any) are called when an entry is erased.
+ */
+
+/**< map: constructors */
+map *m_new(struct typetable *ttbl_key, struct typetable *ttbl_val);
+map *m_newcopy(map *m);
+
+/**< map: destructor */
+void m_delete(map **m);
+
+/**< map: iterator functions (in key order) */
+iterator m_begin(map *m);
+iterator m_end(map *m);
+
+/**< map: length functions */
+size_t m_size(map *m);
+bool m_empty(map *m);
+
+/**< map: element access functions */
+void *m_at(map *m, const void *key);
+void *m_key(map *m, iterator it);
+void *m_val(map *m, iterator it);
+
+/**< map: modifiers - insertion */
+bool m_insert(map *m, const void *key, const void *val);
+bool m_inserthint(map *m, iterator *hint, const void *key, const void *val);
+bool m_assign(map *m, const void *key, const void *val);
+
+/**< map: modifiers - erasure */
+void m_erase(map *m, const void *key);
+
+/**< map: clear container */
+void m_clear(map *m);
+
+/**< map: operations */
+iterator m_find(map *m, const void *key);
+size_t m_count(map *m, const void *key);
+iterator m_lowerbound(map *m, const void *key);
+iterator m_upperbound(map *m, const void *key);
+void m_equalrange(map *m, const void *key, iterator *first, iterator *last);
+
+/**< map: observers - retrieve comparator/typetables */
+compare_fn m_key_comp(map *m);
+struct typetable *m_get_key_ttbl(map *m);
+struct typetable *m_get_val_ttbl(map *m);
+
+#endif /* MAP_H */
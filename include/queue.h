@@ -0,0 +1,115 @@
+/**
+ *  @file       queue.h
+ *  @brief      Header file for a bounded ring-buffer queue ADT
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct queue     queue;
+typedef struct queue *   queue_ptr;
+typedef struct queue **  queue_dptr;
+
+/**
+ *  @enum       queue_mode
+ *  @brief      Selects the synchronization strategy of a queue
+ *
+ *  QUEUE_SERIAL    single-threaded; no atomics, no fences
+ *  QUEUE_LOCKFREE  multi-producer/multi-consumer using per-slot
+ *                  sequence numbers; push/pop fail instead of waiting
+ *  QUEUE_BLOCKING  same as QUEUE_LOCKFREE, but q_push parks the caller
+ *                  while the queue is full and q_pop parks the caller
+ *                  while the queue is empty (futex on Linux)
+ */
+enum queue_mode { QUEUE_SERIAL, QUEUE_LOCKFREE, QUEUE_BLOCKING };
+
+/**
+ *      The capacity of a queue is fixed at instantiation, and is
+ *      rounded up to the next power of two.
+ *
+ *      Elements are deep copied into the queue iff the typetable
+ *      provided upon instantiation has a copy function;
+ *      otherwise, they are shallow copied.
+ *
+ *      Popping an element moves it out of the queue:
+ *      the bytes of the element are copied to the caller's buffer,
+ *      and ownership of any resources it refers to is transferred
+ *      to the caller -- the dtor is not called on popped elements.
+ *
+ *      q_new, q_delete, and q_clear are not thread-safe.
+ *      Every other function is safe to call from any number of threads
+ *      when the mode is QUEUE_LOCKFREE or QUEUE_BLOCKING.
+ *
+ *      A queue does not provide an iterator, since its contents
+ *      are not stable under concurrent access.
+ */
+
+/**< queue: constructor */
+queue *q_new(struct typetable *ttbl, size_t capacity, enum queue_mode mode);
+
+/**< queue: destructor */
+void q_delete(queue **q);
+
+/**< queue: length functions */
+size_t q_size(queue *q);
+size_t q_capacity(queue *q);
+
+/**< queue: capacity-based functions */
+bool q_empty(queue *q);
+bool q_full(queue *q);
+
+/**< queue: modifiers - push/pop (block in QUEUE_BLOCKING mode) */
+bool q_push(queue *q, const void *valaddr);
+bool q_pop(queue *q, void *dest);
+
+/**< queue: modifiers - push/pop (never block) */
+bool q_trypush(queue *q, const void *valaddr);
+bool q_trypop(queue *q, void *dest);
+
+/**< queue: modifiers - batched push/pop */
+size_t q_push_n(queue *q, const void *base, size_t n);
+size_t q_pop_n(queue *q, void *dest, size_t n);
+
+/**< queue: modifiers - clear container */
+void q_clear(queue *q);
+
+/**< queue: retrieve mode/width/typetable */
+enum queue_mode q_get_mode(queue *q);
+size_t q_get_width(queue *q);
+struct typetable *q_get_ttbl(queue *q);
+
+#endif /* QUEUE_H */
@@ -61,21 +61,43 @@ typedef struct rbnode *rbnode_ptr;
  */
 typedef struct rbnode **rbnode_dptr;
 
+/**
+ *  An rbnode and its element are a single allocation --
+ *  the element (ttbl->width bytes) is stored inline, right after the node,
+ *  and is addressed with rbn_valaddr.
+ *
+ *  The node's color (enum node_color) is kept in the low bit of
+ *  parent_color; the remaining bits are the address of the parent.
+ */
 struct rbnode {
-    void *valaddr;
-
     rbnode *left;
     rbnode *right;
 
-    enum node_color color;
+    size_t parent_color;    /**< parent address | color */
+    size_t count;           /**< number of nodes in the subtree rooted here */
 };
 
+/**< address of the element stored inline after rbnode N */
+#define rbn_valaddr(N) ((void *)((rbnode *)(N) + 1))
+
 typedef struct rbtree rbtree;
 
+/**
+ *  A frozen rbtree is an immutable, contiguous snapshot of an rbtree,
+ *  for read-mostly workloads: its elements are laid out in
+ *  Eytzinger (breadth-first) order, so that lookups walk one array
+ *  with prefetching, rather than chase node pointers.
+ *
+ *  rbt_freeze copies the elements (deep copies, if ttbl->copy is set);
+ *  rbt_thaw moves them back into a new rbtree and releases the snapshot.
+ */
+typedef struct rbfrozen rbfrozen;
+
 /*<< rbtree: constructors */
 rbtree *rbt_new(struct typetable *ttbl);
 rbtree *rbt_newcopy(rbtree *t);
 rbtree *rbt_newrnge(iterator *first, iterator *last);
+rbtree *rbt_build_sorted(struct typetable *ttbl, const void *base, size_t n);
 rbtree *rbt_newmove(rbtree **t);
 
 /*<< rbtree: destructor */
@@ -111,10 +133,20 @@ rbnode **rbt_data(rbtree *t);
 
 /*<< rbtree: lookup */
 void *rbt_find(rbtree *t, const void *valaddr);
+size_t rbt_find_many(rbtree *t, const void *keys, size_t n, void **out);
+iterator rbt_lower_bound(rbtree *t, const void *valaddr);
+iterator rbt_upper_bound(rbtree *t, const void *valaddr);
+
+/*<< rbtree: order statistics */
+void *rbt_select(rbtree *t, size_t k);
+size_t rbt_rank(rbtree *t, const void *valaddr);
+size_t rbt_count_range(rbtree *t, const void *lo, const void *hi);
 
 /*<< rbtree: insert, erase, erase min/max */
 void rbt_insert(rbtree *t, const void *valaddr);
 void rbt_insert_unique(rbtree *t, const void *valaddr);
+bool rbt_insert_hint(rbtree *t, iterator *hint, const void *valaddr);
+size_t rbt_insert_bulk(rbtree *t, const void *base, size_t n);
 void rbt_erase(rbtree *t, const void *valaddr);
 void rbt_erase_min(rbtree *t);
 void rbt_erase_max(rbtree *t);
@@ -125,11 +157,38 @@ void rbt_clear(rbtree *t);
 /*<< rbtree: container swappage */
 void rbt_swap(rbtree **t, rbtree **other);
 
-/*<< rbtree: map consumer function to all rbnodes */
+/*<< rbtree: map consumer function to all rbnodes, in O(n) --
+     LEVELORDER allocates a queue of n pointers, other orders nothing */
 void rbt_foreach(rbtree *t, void (*consumer)(void *), enum node_traversal ttype);
 void rbt_foreach_recursive(rbtree *t, void (*consumer)(void *),
                            enum node_traversal ttype);
 
+/*<< rbtree: map consumer(ctx, elem) to elements in [lo, hi), in order */
+size_t rbt_foreach_range(rbtree *t, const void *lo, const void *hi,
+                         bool (*consumer)(void *, void *), void *ctx);
+
+/*<< rbtree: map visitor to all elements in order, with caller state */
+size_t rbt_for_each_ctx(rbtree *t, bool (*visitor)(void *, void *, size_t),
+                        void *ctx);
+
+/*<< rbtree: frozen snapshot - freeze/thaw */
+rbfrozen *rbt_freeze(rbtree *t);
+rbtree *rbt_thaw(rbfrozen **f);
+
+/*<< rbfrozen: destructor */
+void rbf_delete(rbfrozen **f);
+
+/*<< rbfrozen: iterator functions (in order) */
+iterator rbf_begin(rbfrozen *f);
+iterator rbf_end(rbfrozen *f);
+
+/*<< rbfrozen: length functions */
+size_t rbf_size(rbfrozen *f);
+
+/*<< rbfrozen: lookup */
+void *rbf_find(rbfrozen *f, const void *valaddr);
+iterator rbf_lower_bound(rbfrozen *f, const void *valaddr);
+
 /*<< rbtree: print tree to file stream */
 void rbt_puts(rbtree *t);
 void rbt_fputs(rbtree *t, FILE *dest);
@@ -144,5 +203,6 @@ void rbtree_delete(void *arg);
 /**< ptrs to vtables */
 extern struct typetable *_rbtree_;
 extern struct iterator_table *_rbtree_iterator_;
+extern struct iterator_table *_rbfrozen_iterator_;
 
 #endif /* RBTREE_H */
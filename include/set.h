@@ -0,0 +1,104 @@
+/**
+ *  @file       set.h
+ *  @brief      Header file for an ordered container of unique elements
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef SET_H
+#define SET_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       iterator.h
+ *  @brief      Required for iterator (struct iterator) and related functions
+ */
+#include "iterator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct set     set;
+typedef struct set *   set_ptr;
+typedef struct set **  set_dptr;
+
+/**
+ *      A set holds unique elements, ordered by ttbl->compare.
+ *
+ *      It is an rbtree (elements are stored inline in the tree nodes)
+ *      that never holds two equal elements: inserting an element
+ *      that is already present leaves the set as it was, silently.
+ *
+ *      Iterators are rbtree iterators; lookups and bound queries
+ *      are O(log n) and return iterators by value.
+ *
+ *      By default, elements are deep copied into the container,
+ *      iff the typetable provided upon instantiation has a copy function;
+ *      otherwise, they are shallow copied.
+ */
+
+/**< set: constructors */
+set *s_new(struct typetable *ttbl);
+set *s_newcopy(set *s);
+
+/**< set: destructor */
+void s_delete(set **s);
+
+/**< set: iterator functions (in order) */
+iterator s_begin(set *s);
+iterator s_end(set *s);
+
+/**< set: length functions */
+size_t s_size(set *s);
+bool s_empty(set *s);
+
+/**< set: modifiers - insertion */
+bool s_insert(set *s, const void *valaddr);
+bool s_inserthint(set *s, iterator *hint, const void *valaddr);
+
+/**< set: modifiers - erasure */
+void s_erase(set *s, const void *valaddr);
+
+/**< set: clear container */
+void s_clear(set *s);
+
+/**< set: operations */
+iterator s_find(set *s, const void *valaddr);
+size_t s_count(set *s, const void *valaddr);
+iterator s_lowerbound(set *s, const void *valaddr);
+iterator s_upperbound(set *s, const void *valaddr);
+void s_equalrange(set *s, const void *valaddr, iterator *first, iterator *last);
+
+/**< set: retrieve typetable */
+struct typetable *s_get_ttbl(set *s);
+
+#endif /* SET_H */
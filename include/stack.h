@@ -0,0 +1,82 @@
+/**
+ *  @file       stack.h
+ *  @brief      Header file for a stack adapter over deque
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STACK_H
+#define STACK_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       deque.h
+ *  @brief      Required for the underlying container (struct deque)
+ */
+#include "deque.h"
+
+typedef struct stack     stack;
+typedef struct stack *   stack_ptr;
+typedef struct stack **  stack_dptr;
+
+/**
+ *      A stack is a LIFO adapter over deque --
+ *      push and pop are O(1), and the address of an element
+ *      remains valid until that element is popped.
+ *
+ *      Elements are deep copied on push iff the typetable
+ *      has a copy function, and destroyed on pop iff it has a dtor.
+ */
+
+/**< stack: constructor */
+stack *stk_new(struct typetable *ttbl);
+
+/**< stack: destructor */
+void stk_delete(stack **s);
+
+/**< stack: length functions */
+size_t stk_size(stack *s);
+bool stk_empty(stack *s);
+
+/**< stack: element access functions */
+void *stk_top(stack *s);
+
+/**< stack: modifiers - push/pop */
+void stk_push(stack *s, const void *valaddr);
+void stk_pop(stack *s);
+
+/**< stack: modifiers - clear container */
+void stk_clear(stack *s);
+
+/**< stack: retrieve typetable */
+struct typetable *stk_get_ttbl(stack *s);
+
+#endif /* STACK_H */
@@ -0,0 +1,86 @@
+/**
+ *  @file       uqueue.h
+ *  @brief      Header file for an unbounded queue adapter over deque
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef UQUEUE_H
+#define UQUEUE_H
+
+/**
+ *  @file       utils.h
+ *  @brief      Required for (struct typetable) and related functions
+ */
+#include "utils.h"
+
+/**
+ *  @file       deque.h
+ *  @brief      Required for the underlying container (struct deque)
+ */
+#include "deque.h"
+
+typedef struct uqueue     uqueue;
+typedef struct uqueue *   uqueue_ptr;
+typedef struct uqueue **  uqueue_dptr;
+
+/**
+ *      A uqueue is an unbounded, single-threaded FIFO adapter over deque.
+ *      (For a bounded queue that is safe to share between threads,
+ *       see queue.h)
+ *
+ *      push and pop are O(1), and the address of an element
+ *      remains valid until that element is popped.
+ *
+ *      Elements are deep copied on push iff the typetable
+ *      has a copy function, and destroyed on pop iff it has a dtor.
+ */
+
+/**< uqueue: constructor */
+uqueue *uq_new(struct typetable *ttbl);
+
+/**< uqueue: destructor */
+void uq_delete(uqueue **q);
+
+/**< uqueue: length functions */
+size_t uq_size(uqueue *q);
+bool uq_empty(uqueue *q);
+
+/**< uqueue: element access functions */
+void *uq_front(uqueue *q);
+void *uq_back(uqueue *q);
+
+/**< uqueue: modifiers - push/pop */
+void uq_push(uqueue *q, const void *valaddr);
+void uq_pop(uqueue *q);
+
+/**< uqueue: modifiers - clear container */
+void uq_clear(uqueue *q);
+
+/**< uqueue: retrieve typetable */
+struct typetable *uq_get_ttbl(uqueue *q);
+
+#endif /* UQUEUE_H */
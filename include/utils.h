@@ -72,6 +72,15 @@ typedef unsigned char bool;
  *          int foobar_compare(const void *c1, const void *c2);
  *          void foobar_print(const void *arg, FILE *dest);
  *
+ *  A typetable may also provide hash and equals functions
+ *  (for hash-based containers, like hashmap); these come after print,
+ *  and the TYPETABLE macros leave them NULL:
+ *
+ *          size_t foobar_hash(const void *arg);
+ *          bool foobar_equals(const void *c1, const void *c2);
+ *
+ *  Elements that are equal must hash equally.
+ *
  *  These prototypes may be in a public header if required to be,
  *  but are suggested to remain in a source file prior to their definitions
  *  only.
@@ -127,6 +136,8 @@ typedef void (*dtor_fn)(void *);
 typedef void (*swap_fn)(void *, void *);
 typedef int (*compare_fn)(const void *, const void *);
 typedef void (*print_fn)(const void *, FILE *);
+typedef size_t (*hash_fn)(const void *);
+typedef bool (*equals_fn)(const void *, const void *);
 
 /**
  *  @def        ADDR_AT
@@ -137,6 +148,20 @@ typedef void (*print_fn)(const void *, FILE *);
  */
 #define ADDR_AT(BASE, INDEX, WIDTH) (((char *)(BASE)) + ((INDEX) * (WIDTH)))
 
+/**
+ *  @def        PREFETCH
+ *  @brief      Hints that the memory at ADDR will be read soon
+ *
+ *  Issues a software prefetch where the compiler supports one
+ *  (GCC/Clang), and evaluates to nothing otherwise.
+ *  Never faults, even if ADDR is not a valid address.
+ */
+#if defined(__GNUC__)
+#define PREFETCH(ADDR) __builtin_prefetch((ADDR))
+#else
+#define PREFETCH(ADDR) ((void)(ADDR))
+#endif /* defined(__GNUC__) */
+
 /**
  *  @struct     typetable
  *  @brief      a virtual function table that determines the behavior of
@@ -152,6 +177,10 @@ struct typetable {
 
     int (*compare)(const void *, const void *); /**< sorting/searching */
     void (*print)(const void *, FILE *dest);    /**< output to stream */
+
+    size_t (*hash)(const void *); /**< hashing (equal elements, equal hashes) */
+    bool (*equals)(const void *,
+                   const void *); /**< optional; cheaper than compare == 0 */
 };
 
 /**< Use these pointer variables to instantiate an ADT container (i.e. vector)
@@ -340,18 +369,93 @@ int int8_compare(const void *c1, const void *c2);
 int int16_compare(const void *c1, const void *c2);
 int int32_compare(const void *c1, const void *c2);
 
-#if __STD_VERSION__ >= 199901L
 int int64_compare(const void *c1, const void *c2);
-#endif
 
 int uint8_compare(const void *c1, const void *c2);
 int uint16_compare(const void *c1, const void *c2);
 int uint32_compare(const void *c1, const void *c2);
 
-#if __STD_VERSION__ >= 199901L
 int uint64_compare(const void *c1, const void *c2);
+
+/**< Hash functions - casts arg to TYPE and hashes the pointee */
+size_t hash_bytes(const void *data, size_t len);
+size_t hash_bytes_ignore_case(const void *data, size_t len);
+
+size_t char_hash(const void *arg);
+size_t signed_char_hash(const void *arg);
+size_t unsigned_char_hash(const void *arg);
+
+size_t short_int_hash(const void *arg);
+size_t signed_short_int_hash(const void *arg);
+size_t unsigned_short_int_hash(const void *arg);
+
+size_t int_hash(const void *arg);
+size_t signed_int_hash(const void *arg);
+size_t unsigned_int_hash(const void *arg);
+
+size_t long_int_hash(const void *arg);
+size_t signed_long_int_hash(const void *arg);
+size_t unsigned_long_int_hash(const void *arg);
+
+#if __STDC_VERSION__ >= 199901L
+size_t long_long_int_hash(const void *arg);
+size_t signed_long_long_int_hash(const void *arg);
+size_t unsigned_long_long_int_hash(const void *arg);
+#endif
+
+size_t int64_hash(const void *arg);
+size_t uint64_hash(const void *arg);
+
+size_t float_hash(const void *arg);
+size_t double_hash(const void *arg);
+
+size_t bool_hash(const void *arg);
+
+size_t str_hash(const void *arg);
+size_t str_hash_ignore_case(const void *arg);
+size_t cstr_hash(const void *arg);
+size_t cstr_hash_ignore_case(const void *arg);
+
+size_t void_ptr_hash(const void *arg);
+
+/**< Equality functions - casts c1 and c2 to TYPE and tests for equality */
+bool char_equals(const void *c1, const void *c2);
+bool signed_char_equals(const void *c1, const void *c2);
+bool unsigned_char_equals(const void *c1, const void *c2);
+
+bool short_int_equals(const void *c1, const void *c2);
+bool signed_short_int_equals(const void *c1, const void *c2);
+bool unsigned_short_int_equals(const void *c1, const void *c2);
+
+bool int_equals(const void *c1, const void *c2);
+bool signed_int_equals(const void *c1, const void *c2);
+bool unsigned_int_equals(const void *c1, const void *c2);
+
+bool long_int_equals(const void *c1, const void *c2);
+bool signed_long_int_equals(const void *c1, const void *c2);
+bool unsigned_long_int_equals(const void *c1, const void *c2);
+
+#if __STDC_VERSION__ >= 199901L
+bool long_long_int_equals(const void *c1, const void *c2);
+bool signed_long_long_int_equals(const void *c1, const void *c2);
+bool unsigned_long_long_int_equals(const void *c1, const void *c2);
 #endif
 
+bool int64_equals(const void *c1, const void *c2);
+bool uint64_equals(const void *c1, const void *c2);
+
+bool float_equals(const void *c1, const void *c2);
+bool double_equals(const void *c1, const void *c2);
+
+bool bool_equals(const void *c1, const void *c2);
+
+bool str_equals(const void *c1, const void *c2);
+bool str_equals_ignore_case(const void *c1, const void *c2);
+bool cstr_equals(const void *c1, const void *c2);
+bool cstr_equals_ignore_case(const void *c1, const void *c2);
+
+bool void_ptr_equals(const void *c1, const void *c2);
+
 /**< Print functions - casts arg to TYPE and prints output to dest */
 void char_print(const void *arg, FILE *dest);
 void signed_char_print(const void *arg, FILE *dest);
@@ -395,17 +499,13 @@ void int8_print(const void *arg, FILE *dest);
 void int16_print(const void *arg, FILE *dest);
 void int32_print(const void *arg, FILE *dest);
 
-#if __STD_VERSION__ >= 199901L
 void int64_print(const void *arg, FILE *dest);
-#endif
 
 void uint8_print(const void *arg, FILE *dest);
 void uint16_print(const void *arg, FILE *dest);
 void uint32_print(const void *arg, FILE *dest);
 
-#if __STD_VERSION__ >= 199901L
 void uint64_print(const void *arg, FILE *dest);
-#endif
 
 /**< Parse functions - casts arg to TYPE and returns a (char *)  */
 char *char_parse(const void *arg);
@@ -450,17 +550,13 @@ char *int8_parse(const void *arg);
 char *int16_parse(const void *arg);
 char *int32_parse(const void *arg);
 
-#if __STD_VERSION__ >= 199901L
 char *int64_parse(const void *arg);
-#endif
 
 char *uint8_parse(const void *arg);
 char *uint16_parse(const void *arg);
 char *uint32_parse(const void *arg);
 
-#if __STD_VERSION__ >= 199901L
 char *uint64_parse(const void *arg);
-#endif
 
 /**< C-String functions/macros */
 char *str_trim_left(char *to_trim, const char *charset);
@@ -728,10 +824,8 @@ typedef short int **int16_dptr;
 typedef int *int32_ptr;
 typedef int **int32_dptr;
 
-#if __STD_VERSION__ >= 199901L
-typedef long long int *int64_ptr;
-typedef long long int **int64_dptr;
-#endif /* __STDC_VERSION__ >= 199901L */
+typedef int64_t *int64_ptr;
+typedef int64_t **int64_dptr;
 
 typedef unsigned char *uint8_ptr;
 typedef unsigned char **uint8_dptr;
@@ -742,10 +836,8 @@ typedef unsigned short int **uint16_dptr;
 typedef unsigned int *uint32_ptr;
 typedef unsigned int **uint32_dptr;
 
-#if __STD_VERSION__ >= 199901L
-typedef unsigned long long int *uint64_ptr;
-typedef unsigned long long int **uint64_dptr;
-#endif /* __STDC_VERSION__ >= 199901L */
+typedef uint64_t *uint64_ptr;
+typedef uint64_t **uint64_dptr;
 
 typedef float float32_t;
 typedef double float64_t;
@@ -138,6 +138,9 @@ const void *v_front_const(vector *v);
 const void *v_back_const(vector *v);
 const void *v_data_const(vector *v);
 
+/**< vector: contiguous view */
+span v_span(vector *v);
+
 /**< vector: modifiers - assignment */
 void v_assignrnge(vector *v, iterator first, iterator last);
 void v_assignfill(vector *v, size_t n, const void *valaddr);
@@ -174,6 +177,12 @@ void v_swap_elem(vector *v, size_t n1, size_t n2);
 void v_remove(vector *v, const void *valaddr);
 void v_remove_if(vector *v, bool (*unary_predicate)(const void *));
 
+/**< vector: custom modifiers - duplicate removal (unsorted v) */
+void v_unique_unordered(vector *v);
+
+/**< vector: custom utility - map visitor to runs of elements */
+size_t v_for_each_chunk(vector *v, size_t chunk,
+                        bool (*visitor)(void *, void *, size_t), void *ctx);
 
 /**< vector: custom modifiers - merge/reverse */
 vector *v_merge(vector *v, vector *other);
@@ -187,6 +196,9 @@ vector *v_ptrtov(struct typetable *ttbl, void *base, size_t length, size_t capac
 int v_search(vector *v, const void *valaddr);
 void v_sort(vector *v);
 
+/**< vector: custom utility functions - batched binary search (sorted v) */
+size_t v_find_many(vector *v, const void *keys, size_t n, void **out);
+
 /**< vector: custom print functions - output to FILE stream */
 void v_puts(vector *v);
 
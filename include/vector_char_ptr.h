@@ -128,6 +128,9 @@ const char_ptr *vfrontconst_char_ptr(vector_char_ptr *v);
 const char_ptr *vbackconst_char_ptr(vector_char_ptr *v);
 const char_ptr **vdataconst_char_ptr(vector_char_ptr *v);
 
+/**< vector_char_ptr: contiguous view */
+span vspan_char_ptr(vector_char_ptr *v);
+
 /**< vector_char_ptr: modifiers - assignement */
 void vassignrnge_char_ptr(vector_char_ptr *v, iterator first, iterator last);
 void vassignfill_char_ptr(vector_char_ptr *v, size_t n, char_ptr val);
@@ -211,7 +214,7 @@ print_fn vgetprint_char_ptr(vector_char_ptr *v);
 struct typetable *vgetttbl_char_ptr(vector_char_ptr *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_char_ptr;
-struct iterator_table *vector_iterator_table_ptr_id_char_ptr;
+extern struct typetable *vector_typetable_ptr_id_char_ptr;
+extern struct iterator_table *vector_iterator_table_ptr_id_char_ptr;
 
 #endif /* VECTOR_CHAR_PTR_H */
@@ -128,6 +128,9 @@ const cstr *vfrontconst_cstr(vector_cstr *v);
 const cstr *vbackconst_cstr(vector_cstr *v);
 const cstr **vdataconst_cstr(vector_cstr *v);
 
+/**< vector_cstr: contiguous view */
+span vspan_cstr(vector_cstr *v);
+
 /**< vector_cstr: modifiers - assignement */
 void vassignrnge_cstr(vector_cstr *v, iterator first, iterator last);
 void vassignfill_cstr(vector_cstr *v, size_t n, cstr val);
@@ -211,7 +214,7 @@ print_fn vgetprint_cstr(vector_cstr *v);
 struct typetable *vgetttbl_cstr(vector_cstr *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_cstr;
-struct iterator_table *vector_iterator_table_ptr_id_cstr;
+extern struct typetable *vector_typetable_ptr_id_cstr;
+extern struct iterator_table *vector_iterator_table_ptr_id_cstr;
 
 #endif /* VECTOR_CSTRING_H */
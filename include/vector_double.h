@@ -128,6 +128,9 @@ const double *vfrontconst_double(vector_double *v);
 const double *vbackconst_double(vector_double *v);
 const double **vdataconst_double(vector_double *v);
 
+/**< vector_double: contiguous view */
+span vspan_double(vector_double *v);
+
 /**< vector_double: modifiers - assignement */
 void vassignrnge_double(vector_double *v, iterator first, iterator last);
 void vassignfill_double(vector_double *v, size_t n, double val);
@@ -211,7 +214,7 @@ print_fn vgetprint_double(vector_double *v);
 struct typetable *vgetttbl_double(vector_double *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_double;
-struct iterator_table *vector_iterator_table_ptr_id_double;
+extern struct typetable *vector_typetable_ptr_id_double;
+extern struct iterator_table *vector_iterator_table_ptr_id_double;
 
 #endif /* VECTOR_DOUBLE_H */
@@ -128,6 +128,9 @@ const float *vfrontconst_float(vector_float *v);
 const float *vbackconst_float(vector_float *v);
 const float **vdataconst_float(vector_float *v);
 
+/**< vector_float: contiguous view */
+span vspan_float(vector_float *v);
+
 /**< vector_float: modifiers - assignement */
 void vassignrnge_float(vector_float *v, iterator first, iterator last);
 void vassignfill_float(vector_float *v, size_t n, float val);
@@ -211,7 +214,7 @@ print_fn vgetprint_float(vector_float *v);
 struct typetable *vgetttbl_float(vector_float *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_float;
-struct iterator_table *vector_iterator_table_ptr_id_float;
+extern struct typetable *vector_typetable_ptr_id_float;
+extern struct iterator_table *vector_iterator_table_ptr_id_float;
 
 #endif /* VECTOR_FLOAT_H */
@@ -128,6 +128,9 @@ const short *vfrontconst_short(vector_short *v);
 const short *vbackconst_short(vector_short *v);
 const short **vdataconst_short(vector_short *v);
 
+/**< vector_short: contiguous view */
+span vspan_short(vector_short *v);
+
 /**< vector_short: modifiers - assignement */
 void vassignrnge_short(vector_short *v, iterator first, iterator last);
 void vassignfill_short(vector_short *v, size_t n, short val);
@@ -211,7 +214,7 @@ print_fn vgetprint_short(vector_short *v);
 struct typetable *vgetttbl_short(vector_short *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_short;
-struct iterator_table *vector_iterator_table_ptr_id_short;
+extern struct typetable *vector_typetable_ptr_id_short;
+extern struct iterator_table *vector_iterator_table_ptr_id_short;
 
 #endif /* VECTOR_SHORT_H */
@@ -128,6 +128,9 @@ const int *vfrontconst_int(vector_int *v);
 const int *vbackconst_int(vector_int *v);
 const int **vdataconst_int(vector_int *v);
 
+/**< vector_int: contiguous view */
+span vspan_int(vector_int *v);
+
 /**< vector_int: modifiers - assignement */
 void vassignrnge_int(vector_int *v, iterator first, iterator last);
 void vassignfill_int(vector_int *v, size_t n, int val);
@@ -211,7 +214,7 @@ print_fn vgetprint_int(vector_int *v);
 struct typetable *vgetttbl_int(vector_int *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_int;
-struct iterator_table *vector_iterator_table_ptr_id_int;
+extern struct typetable *vector_typetable_ptr_id_int;
+extern struct iterator_table *vector_iterator_table_ptr_id_int;
 
 #endif /* VECTOR_INT_H */
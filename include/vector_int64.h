@@ -128,6 +128,9 @@ const int64_t *vfrontconst_int64_t(vector_int64_t *v);
 const int64_t *vbackconst_int64_t(vector_int64_t *v);
 const int64_t **vdataconst_int64_t(vector_int64_t *v);
 
+/**< vector_int64_t: contiguous view */
+span vspan_int64_t(vector_int64_t *v);
+
 /**< vector_int64_t: modifiers - assignement */
 void vassignrnge_int64_t(vector_int64_t *v, iterator first, iterator last);
 void vassignfill_int64_t(vector_int64_t *v, size_t n, int64_t val);
@@ -211,7 +214,7 @@ print_fn vgetprint_int64_t(vector_int64_t *v);
 struct typetable *vgetttbl_int64_t(vector_int64_t *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_int64_t;
-struct iterator_table *vector_iterator_table_ptr_id_int64_t;
+extern struct typetable *vector_typetable_ptr_id_int64_t;
+extern struct iterator_table *vector_iterator_table_ptr_id_int64_t;
 
 #endif /* VECTOR_INT64_H */
@@ -128,6 +128,9 @@ const char *vfrontconst_char(vector_char *v);
 const char *vbackconst_char(vector_char *v);
 const char **vdataconst_char(vector_char *v);
 
+/**< vector_char: contiguous view */
+span vspan_char(vector_char *v);
+
 /**< vector_char: modifiers - assignement */
 void vassignrnge_char(vector_char *v, iterator first, iterator last);
 void vassignfill_char(vector_char *v, size_t n, char val);
@@ -211,7 +214,7 @@ print_fn vgetprint_char(vector_char *v);
 struct typetable *vgetttbl_char(vector_char *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_char;
-struct iterator_table *vector_iterator_table_ptr_id_char;
+extern struct typetable *vector_typetable_ptr_id_char;
+extern struct iterator_table *vector_iterator_table_ptr_id_char;
 
 #endif /* VECTOR_CHAR_H */
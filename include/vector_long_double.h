@@ -128,6 +128,9 @@ const long_double *vfrontconst_long_double(vector_long_double *v);
 const long_double *vbackconst_long_double(vector_long_double *v);
 const long_double **vdataconst_long_double(vector_long_double *v);
 
+/**< vector_long_double: contiguous view */
+span vspan_long_double(vector_long_double *v);
+
 /**< vector_long_double: modifiers - assignement */
 void vassignrnge_long_double(vector_long_double *v, iterator first, iterator last);
 void vassignfill_long_double(vector_long_double *v, size_t n, long_double val);
@@ -211,7 +214,7 @@ print_fn vgetprint_long_double(vector_long_double *v);
 struct typetable *vgetttbl_long_double(vector_long_double *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_long_double;
-struct iterator_table *vector_iterator_table_ptr_id_long_double;
+extern struct typetable *vector_typetable_ptr_id_long_double;
+extern struct iterator_table *vector_iterator_table_ptr_id_long_double;
 
 #endif /* VECTOR_LONG_DOUBLE_H */
@@ -128,6 +128,9 @@ const str *vfrontconst_str(vector_str *v);
 const str *vbackconst_str(vector_str *v);
 const str **vdataconst_str(vector_str *v);
 
+/**< vector_str: contiguous view */
+span vspan_str(vector_str *v);
+
 /**< vector_str: modifiers - assignement */
 void vassignrnge_str(vector_str *v, iterator first, iterator last);
 void vassignfill_str(vector_str *v, size_t n, str val);
@@ -211,7 +214,7 @@ print_fn vgetprint_str(vector_str *v);
 struct typetable *vgetttbl_str(vector_str *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_str;
-struct iterator_table *vector_iterator_table_ptr_id_str;
+extern struct typetable *vector_typetable_ptr_id_str;
+extern struct iterator_table *vector_iterator_table_ptr_id_str;
 
 #endif /* VECTOR_STRING_H */
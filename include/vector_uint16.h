@@ -128,6 +128,9 @@ const uint16_t *vfrontconst_uint16_t(vector_uint16_t *v);
 const uint16_t *vbackconst_uint16_t(vector_uint16_t *v);
 const uint16_t **vdataconst_uint16_t(vector_uint16_t *v);
 
+/**< vector_uint16_t: contiguous view */
+span vspan_uint16_t(vector_uint16_t *v);
+
 /**< vector_uint16_t: modifiers - assignement */
 void vassignrnge_uint16_t(vector_uint16_t *v, iterator first, iterator last);
 void vassignfill_uint16_t(vector_uint16_t *v, size_t n, uint16_t val);
@@ -211,7 +214,7 @@ print_fn vgetprint_uint16_t(vector_uint16_t *v);
 struct typetable *vgetttbl_uint16_t(vector_uint16_t *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_uint16_t;
-struct iterator_table *vector_iterator_table_ptr_id_uint16_t;
+extern struct typetable *vector_typetable_ptr_id_uint16_t;
+extern struct iterator_table *vector_iterator_table_ptr_id_uint16_t;
 
 #endif /* VECTOR_UINT16_H */
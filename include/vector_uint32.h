@@ -128,6 +128,9 @@ const uint32_t *vfrontconst_uint32_t(vector_uint32_t *v);
 const uint32_t *vbackconst_uint32_t(vector_uint32_t *v);
 const uint32_t **vdataconst_uint32_t(vector_uint32_t *v);
 
+/**< vector_uint32_t: contiguous view */
+span vspan_uint32_t(vector_uint32_t *v);
+
 /**< vector_uint32_t: modifiers - assignement */
 void vassignrnge_uint32_t(vector_uint32_t *v, iterator first, iterator last);
 void vassignfill_uint32_t(vector_uint32_t *v, size_t n, uint32_t val);
@@ -211,7 +214,7 @@ print_fn vgetprint_uint32_t(vector_uint32_t *v);
 struct typetable *vgetttbl_uint32_t(vector_uint32_t *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_uint32_t;
-struct iterator_table *vector_iterator_table_ptr_id_uint32_t;
+extern struct typetable *vector_typetable_ptr_id_uint32_t;
+extern struct iterator_table *vector_iterator_table_ptr_id_uint32_t;
 
 #endif /* VECTOR_UINT32_H */
@@ -128,6 +128,9 @@ const uint64_t *vfrontconst_uint64_t(vector_uint64_t *v);
 const uint64_t *vbackconst_uint64_t(vector_uint64_t *v);
 const uint64_t **vdataconst_uint64_t(vector_uint64_t *v);
 
+/**< vector_uint64_t: contiguous view */
+span vspan_uint64_t(vector_uint64_t *v);
+
 /**< vector_uint64_t: modifiers - assignement */
 void vassignrnge_uint64_t(vector_uint64_t *v, iterator first, iterator last);
 void vassignfill_uint64_t(vector_uint64_t *v, size_t n, uint64_t val);
@@ -211,7 +214,7 @@ print_fn vgetprint_uint64_t(vector_uint64_t *v);
 struct typetable *vgetttbl_uint64_t(vector_uint64_t *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_uint64_t;
-struct iterator_table *vector_iterator_table_ptr_id_uint64_t;
+extern struct typetable *vector_typetable_ptr_id_uint64_t;
+extern struct iterator_table *vector_iterator_table_ptr_id_uint64_t;
 
 #endif /* VECTOR_UINT64_H */
@@ -128,6 +128,9 @@ const uint8_t *vfrontconst_uint8_t(vector_uint8_t *v);
 const uint8_t *vbackconst_uint8_t(vector_uint8_t *v);
 const uint8_t **vdataconst_uint8_t(vector_uint8_t *v);
 
+/**< vector_uint8_t: contiguous view */
+span vspan_uint8_t(vector_uint8_t *v);
+
 /**< vector_uint8_t: modifiers - assignement */
 void vassignrnge_uint8_t(vector_uint8_t *v, iterator first, iterator last);
 void vassignfill_uint8_t(vector_uint8_t *v, size_t n, uint8_t val);
@@ -211,7 +214,7 @@ print_fn vgetprint_uint8_t(vector_uint8_t *v);
 struct typetable *vgetttbl_uint8_t(vector_uint8_t *v);
 
 /**< ptrs to vtables */
-struct typetable *vector_typetable_ptr_id_uint8_t;
-struct iterator_table *vector_iterator_table_ptr_id_uint8_t;
+extern struct typetable *vector_typetable_ptr_id_uint8_t;
+extern struct iterator_table *vector_iterator_table_ptr_id_uint8_t;
 
 #endif /* VECTOR_UINT8_H */
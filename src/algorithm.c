@@ -0,0 +1,2207 @@
+/**
+ *  @file       algorithm.c
+ *  @brief      Source file for container utility functions
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "algorithm.h"
+#include "list.h"
+#include "rbtree.h"
+
+/**
+ *  @enum       range_kind
+ *  @brief      How a range moves forward and searches ahead
+ */
+enum range_kind {
+    RANGE_CONTIGUOUS,   /**< vectors: raw pointers, galloping search */
+    RANGE_LIST,         /**< list: node links */
+    RANGE_RBTREE,       /**< rbtree: it_incr, then rbt_lower_bound */
+    RANGE_STEPPED       /**< anything else: it_incr/it_advance */
+};
+
+/**
+ *  @struct     range
+ *  @brief      One input of an algorithm (or of a set operation),
+ *              [first, last)
+ *
+ *  curr and finish are element addresses for a contiguous range,
+ *  and node addresses for a list -- neither calls through
+ *  the iterator table per element. Every other range is walked
+ *  with it/last.
+ */
+struct range {
+    enum range_kind kind;
+
+    iterator it;
+    iterator last;
+
+    char *curr;
+    char *finish;
+    size_t width;
+};
+
+static void rg_init(struct range *r, iterator *first, iterator *last);
+static void *rg_peek(struct range *r);
+static void *rg_curr(struct range *r);
+static void rg_next(struct range *r);
+static void rg_advance(struct range *r, size_t n);
+static size_t rg_distance(struct range *r);
+static iterator rg_iter(struct range *r);
+static void rg_seek(struct range *r, const void *valaddr,
+                    int (*compare)(const void *, const void *));
+static size_t rg_drain(struct range *r, vector *dest);
+
+static bool alg_bytewise(struct typetable *ttbl);
+static bool alg_match(struct typetable *ttbl,
+                      bool (*binary_predicate)(const void *, const void *),
+                      const void *a, const void *b);
+static void alg_swap(void *a, void *b, size_t width);
+
+static char *alg_find_bytes(char *curr, char *finish, size_t width,
+                            const void *valaddr);
+static size_t alg_count_bytes(char *curr, char *finish, size_t width,
+                              const void *valaddr);
+
+static iterator alg_find_pred(iterator *first, iterator *last,
+                              bool (*unary_predicate)(const void *),
+                              bool want);
+static bool alg_equal(iterator *first1, iterator *last1, iterator *first2,
+                      bool (*binary_predicate)(const void *, const void *));
+static iterator alg_search(iterator *first1, iterator *last1,
+                           iterator *first2, iterator *last2,
+                           bool (*binary_predicate)(const void *,
+                                                    const void *));
+static iterator alg_search_n(iterator *first, iterator *last, size_t count,
+                             const void *valaddr,
+                             bool (*binary_predicate)(const void *,
+                                                      const void *));
+static iterator alg_find_end(iterator *first1, iterator *last1,
+                             iterator *first2, iterator *last2,
+                             bool (*binary_predicate)(const void *,
+                                                      const void *));
+static iterator alg_find_first_of(iterator *first1, iterator *last1,
+                                  iterator *first2, iterator *last2,
+                                  bool (*binary_predicate)(const void *,
+                                                           const void *));
+static iterator alg_adjacent_find(iterator *first, iterator *last,
+                                  bool (*binary_predicate)(const void *,
+                                                           const void *));
+static iterator alg_bound(iterator *first, iterator *last,
+                          const void *valaddr,
+                          int (*compare)(const void *, const void *),
+                          bool upper);
+static iterator alg_extreme(iterator *first, iterator *last,
+                            int (*compare)(const void *, const void *),
+                            bool max);
+
+/**
+ *  @brief  Appends to dest every element that is in either range
+ *
+ *  An element found in both ranges is taken from the first.
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *  @param[out] dest    pointer to vector that receives the result
+ *
+ *  @return     number of elements appended to dest
+ */
+size_t set_union(iterator *first1, iterator *last1,
+                 iterator *first2, iterator *last2, vector *dest) {
+    int (*compare)(const void *, const void *) = NULL;
+    struct range r1, r2;
+    size_t n = 0;
+    void *a = NULL;
+    void *b = NULL;
+
+    assert(dest);
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+    compare = it_get_ttbl(*first1)->compare;
+
+    while ((a = rg_curr(&r1)) && (b = rg_curr(&r2))) {
+        int cmp = compare(a, b);
+
+        if (cmp < 0) {
+            v_pushb(dest, a);
+            rg_next(&r1);
+        } else if (cmp > 0) {
+            v_pushb(dest, b);
+            rg_next(&r2);
+        } else {
+            v_pushb(dest, a);
+            rg_next(&r1);
+            rg_next(&r2);
+        }
+
+        ++n;
+    }
+
+    n += rg_drain(&r1, dest);
+    n += rg_drain(&r2, dest);
+
+    return n;
+}
+
+/**
+ *  @brief  Appends to dest every element of the first range
+ *          that is also in the second
+ *
+ *  Whichever range is behind is searched ahead to the other's element,
+ *  so when one range is much smaller, most of the other is never visited.
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *  @param[out] dest    pointer to vector that receives the result
+ *
+ *  @return     number of elements appended to dest
+ */
+size_t set_intersection(iterator *first1, iterator *last1,
+                        iterator *first2, iterator *last2, vector *dest) {
+    int (*compare)(const void *, const void *) = NULL;
+    struct range r1, r2;
+    size_t n = 0;
+    void *a = NULL;
+    void *b = NULL;
+
+    assert(dest);
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+    compare = it_get_ttbl(*first1)->compare;
+
+    while ((a = rg_curr(&r1)) && (b = rg_curr(&r2))) {
+        int cmp = compare(a, b);
+
+        if (cmp < 0) {
+            rg_seek(&r1, b, compare);
+        } else if (cmp > 0) {
+            rg_seek(&r2, a, compare);
+        } else {
+            v_pushb(dest, a);
+            rg_next(&r1);
+            rg_next(&r2);
+            ++n;
+        }
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Appends to dest every element of the first range
+ *          that is not in the second
+ *
+ *  The second range is searched ahead to each element of the first,
+ *  so a large second range costs O(log) per element of the first.
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *  @param[out] dest    pointer to vector that receives the result
+ *
+ *  @return     number of elements appended to dest
+ */
+size_t set_difference(iterator *first1, iterator *last1,
+                      iterator *first2, iterator *last2, vector *dest) {
+    int (*compare)(const void *, const void *) = NULL;
+    struct range r1, r2;
+    size_t n = 0;
+    void *a = NULL;
+    void *b = NULL;
+
+    assert(dest);
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+    compare = it_get_ttbl(*first1)->compare;
+
+    while ((a = rg_curr(&r1)) && (b = rg_curr(&r2))) {
+        int cmp = compare(a, b);
+
+        if (cmp < 0) {
+            v_pushb(dest, a);
+            rg_next(&r1);
+            ++n;
+        } else if (cmp > 0) {
+            rg_seek(&r2, a, compare);
+        } else {
+            rg_next(&r1);
+            rg_next(&r2);
+        }
+    }
+
+    n += rg_drain(&r1, dest);
+    return n;
+}
+
+/**
+ *  @brief  Appends to dest every element that is in exactly one range
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *  @param[out] dest    pointer to vector that receives the result
+ *
+ *  @return     number of elements appended to dest
+ */
+size_t set_symmetric_difference(iterator *first1, iterator *last1,
+                                iterator *first2, iterator *last2,
+                                vector *dest) {
+    int (*compare)(const void *, const void *) = NULL;
+    struct range r1, r2;
+    size_t n = 0;
+    void *a = NULL;
+    void *b = NULL;
+
+    assert(dest);
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+    compare = it_get_ttbl(*first1)->compare;
+
+    while ((a = rg_curr(&r1)) && (b = rg_curr(&r2))) {
+        int cmp = compare(a, b);
+
+        if (cmp < 0) {
+            v_pushb(dest, a);
+            rg_next(&r1);
+            ++n;
+        } else if (cmp > 0) {
+            v_pushb(dest, b);
+            rg_next(&r2);
+            ++n;
+        } else {
+            rg_next(&r1);
+            rg_next(&r2);
+        }
+    }
+
+    n += rg_drain(&r1, dest);
+    n += rg_drain(&r2, dest);
+
+    return n;
+}
+
+/**
+ *  @brief  Determines if every element of the second range
+ *          is also in the first
+ *
+ *  Both ranges must be sorted by the compare function of first1's
+ *  typetable. The first range is searched ahead (galloping, or an
+ *  rbtree descent) to each element of the second, as in
+ *  set_intersection -- so a small second range is tested against
+ *  a large first range without visiting most of it.
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *
+ *  @return     true if [first2, last2) is a subset of [first1, last1)
+ */
+bool includes(iterator *first1, iterator *last1,
+              iterator *first2, iterator *last2) {
+    int (*compare)(const void *, const void *) = NULL;
+    struct range r1, r2;
+    void *a = NULL;
+    void *b = NULL;
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+    compare = it_get_ttbl(*first1)->compare;
+
+    while ((b = rg_curr(&r2))) {
+        rg_seek(&r1, b, compare);
+
+        if ((a = rg_curr(&r1)) == NULL || compare(b, a) < 0) {
+            return false;
+        }
+
+        rg_next(&r1);
+        rg_next(&r2);
+    }
+
+    return true;
+}
+
+/**
+ *  @brief  Determines if unary_predicate holds for every element
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     true if no element fails unary_predicate (or if empty)
+ */
+bool all_of(iterator *first, iterator *last,
+            bool (*unary_predicate)(const void *)) {
+    iterator it = alg_find_pred(first, last, unary_predicate, false);
+    return it.curr == last->curr ? true : false;
+}
+
+/**
+ *  @brief  Determines if unary_predicate holds for any element
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     true if at least one element passes unary_predicate
+ */
+bool any_of(iterator *first, iterator *last,
+            bool (*unary_predicate)(const void *)) {
+    iterator it = alg_find_pred(first, last, unary_predicate, true);
+    return it.curr != last->curr ? true : false;
+}
+
+/**
+ *  @brief  Determines if unary_predicate holds for no element
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     true if no element passes unary_predicate (or if empty)
+ */
+bool none_of(iterator *first, iterator *last,
+             bool (*unary_predicate)(const void *)) {
+    iterator it = alg_find_pred(first, last, unary_predicate, true);
+    return it.curr == last->curr ? true : false;
+}
+
+/**
+ *  @brief  Applies consumer to every element, in order
+ *
+ *  @param[in]  first       iterator to the first element of the range
+ *  @param[in]  last        iterator to one past the end of the range
+ *  @param[in]  consumer    function to apply to each element
+ */
+void for_each(iterator *first, iterator *last, void (*consumer)(const void *)) {
+    struct range r;
+    void *curr = NULL;
+
+    massert_pfunc(consumer);
+    rg_init(&r, first, last);
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        for (; r.curr < r.finish; r.curr += r.width) {
+            consumer(r.curr);
+        }
+
+        return;
+    }
+
+    while ((curr = rg_curr(&r))) {
+        consumer(curr);
+        rg_next(&r);
+    }
+}
+
+/**
+ *  @brief  Finds the first element equal to valaddr
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *
+ *  @return     iterator to the first match, or last if there is none
+ */
+iterator find(iterator *first, iterator *last, const void *valaddr) {
+    struct typetable *ttbl = NULL;
+    struct range r;
+    void *curr = NULL;
+
+    massert_ptr(valaddr);
+    rg_init(&r, first, last);
+    ttbl = it_get_ttbl(*first);
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        if (alg_bytewise(ttbl)) {
+            r.curr = alg_find_bytes(r.curr, r.finish, r.width, valaddr);
+        } else {
+            while (r.curr < r.finish &&
+                   alg_match(ttbl, NULL, r.curr, valaddr) == false) {
+                r.curr += r.width;
+            }
+        }
+
+        return rg_iter(&r);
+    }
+
+    while ((curr = rg_curr(&r)) && alg_match(ttbl, NULL, curr, valaddr) == false) {
+        rg_next(&r);
+    }
+
+    return rg_iter(&r);
+}
+
+/**
+ *  @brief  Finds the first element that passes unary_predicate
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     iterator to the first match, or last if there is none
+ */
+iterator find_if(iterator *first, iterator *last,
+                 bool (*unary_predicate)(const void *)) {
+    return alg_find_pred(first, last, unary_predicate, true);
+}
+
+/**
+ *  @brief  Finds the first element that fails unary_predicate
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     iterator to the first match, or last if there is none
+ */
+iterator find_if_not(iterator *first, iterator *last,
+                     bool (*unary_predicate)(const void *)) {
+    return alg_find_pred(first, last, unary_predicate, false);
+}
+
+/**
+ *  @brief  Finds the last occurrence of [first2, last2) in [first1, last1)
+ *
+ *  @param[in]  first1  iterator to the first element of the range searched
+ *  @param[in]  last1   iterator to one past the end of the range searched
+ *  @param[in]  first2  iterator to the first element of the sequence
+ *  @param[in]  last2   iterator to one past the end of the sequence
+ *
+ *  @return     iterator to the start of the last occurrence,
+ *              or last1 if there is none (or if the sequence is empty)
+ */
+iterator find_end_equal(iterator *first1, iterator *last1,
+                        iterator *first2, iterator *last2) {
+    return alg_find_end(first1, last1, first2, last2, NULL);
+}
+
+/**
+ *  @brief  Finds the last occurrence of [first2, last2) in [first1, last1),
+ *          matching elements with binary_predicate
+ *
+ *  @param[in]  first1              iterator to the first element searched
+ *  @param[in]  last1               iterator to one past the end searched
+ *  @param[in]  first2              iterator to the first element of the sequence
+ *  @param[in]  last2               iterator to one past the end of the sequence
+ *  @param[in]  binary_predicate    function that determines a match
+ *
+ *  @return     iterator to the start of the last occurrence,
+ *              or last1 if there is none (or if the sequence is empty)
+ */
+iterator find_end_predicate(iterator *first1, iterator *last1,
+                            iterator *first2, iterator *last2,
+                            bool (*binary_predicate)(const void *,
+                                                     const void *)) {
+    massert_pfunc(binary_predicate);
+    return alg_find_end(first1, last1, first2, last2, binary_predicate);
+}
+
+/**
+ *  @brief  Finds the first element of [first1, last1)
+ *          that is equal to any element of [first2, last2)
+ *
+ *  @param[in]  first1  iterator to the first element of the range searched
+ *  @param[in]  last1   iterator to one past the end of the range searched
+ *  @param[in]  first2  iterator to the first of the elements to search for
+ *  @param[in]  last2   iterator to one past the last of them
+ *
+ *  @return     iterator to the first match, or last1 if there is none
+ */
+iterator find_first_of_equal(iterator *first1, iterator *last1,
+                             iterator *first2, iterator *last2) {
+    return alg_find_first_of(first1, last1, first2, last2, NULL);
+}
+
+/**
+ *  @brief  Finds the first element of [first1, last1) that matches
+ *          any element of [first2, last2) by binary_predicate
+ *
+ *  @param[in]  first1              iterator to the first element searched
+ *  @param[in]  last1               iterator to one past the end searched
+ *  @param[in]  first2              iterator to the first element to search for
+ *  @param[in]  last2               iterator to one past the last of them
+ *  @param[in]  binary_predicate    function that determines a match
+ *
+ *  @return     iterator to the first match, or last1 if there is none
+ */
+iterator find_first_of_predicate(iterator *first1, iterator *last1,
+                                 iterator *first2, iterator *last2,
+                                 bool (*binary_predicate)(const void *,
+                                                          const void *)) {
+    massert_pfunc(binary_predicate);
+    return alg_find_first_of(first1, last1, first2, last2, binary_predicate);
+}
+
+/**
+ *  @brief  Finds the first of two adjacent elements that are equal
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *
+ *  @return     iterator to the first of the pair, or last if there is none
+ */
+iterator adjacent_find_equal(iterator *first, iterator *last) {
+    return alg_adjacent_find(first, last, NULL);
+}
+
+/**
+ *  @brief  Finds the first of two adjacent elements
+ *          that match by binary_predicate
+ *
+ *  @param[in]  first               iterator to the first element of the range
+ *  @param[in]  last                iterator to one past the end of the range
+ *  @param[in]  binary_predicate    function that determines a match
+ *
+ *  @return     iterator to the first of the pair, or last if there is none
+ */
+iterator adjacent_find_if(iterator *first, iterator *last,
+                          bool (*binary_predicate)(const void *,
+                                                   const void *)) {
+    massert_pfunc(binary_predicate);
+    return alg_adjacent_find(first, last, binary_predicate);
+}
+
+/**
+ *  @brief  Counts the elements equal to valaddr
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to count
+ *
+ *  @return     number of elements equal to valaddr
+ */
+size_t count(iterator *first, iterator *last, const void *valaddr) {
+    struct typetable *ttbl = NULL;
+    struct range r;
+    void *curr = NULL;
+    size_t n = 0;
+
+    massert_ptr(valaddr);
+    rg_init(&r, first, last);
+    ttbl = it_get_ttbl(*first);
+
+    if (r.kind == RANGE_CONTIGUOUS && alg_bytewise(ttbl)) {
+        return alg_count_bytes(r.curr, r.finish, r.width, valaddr);
+    }
+
+    while ((curr = rg_curr(&r))) {
+        if (alg_match(ttbl, NULL, curr, valaddr)) {
+            ++n;
+        }
+
+        rg_next(&r);
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Counts the elements that pass unary_predicate
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     number of elements that pass unary_predicate
+ */
+size_t count_if(iterator *first, iterator *last,
+                bool (*unary_predicate)(const void *)) {
+    struct range r;
+    void *curr = NULL;
+    size_t n = 0;
+
+    massert_pfunc(unary_predicate);
+    rg_init(&r, first, last);
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        for (; r.curr < r.finish; r.curr += r.width) {
+            if (unary_predicate(r.curr)) {
+                ++n;
+            }
+        }
+
+        return n;
+    }
+
+    while ((curr = rg_curr(&r))) {
+        if (unary_predicate(curr)) {
+            ++n;
+        }
+
+        rg_next(&r);
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Determines if [first1, last1) is equal to the range
+ *          of as many elements, starting at first2
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *
+ *  @return     true if every pair of elements is equal
+ */
+bool equal_equal(iterator *first1, iterator *last1, iterator *first2) {
+    return alg_equal(first1, last1, first2, NULL);
+}
+
+/**
+ *  @brief  Determines if every element of [first1, last1) matches
+ *          its counterpart, starting at first2, by binary_predicate
+ *
+ *  @param[in]  first1              iterator to the first element of the first range
+ *  @param[in]  last1               iterator to one past the end of the first range
+ *  @param[in]  first2              iterator to the first element of the second range
+ *  @param[in]  binary_predicate    function that determines a match
+ *
+ *  @return     true if every pair of elements matches
+ */
+bool equal_predicate(iterator *first1, iterator *last1, iterator *first2,
+                     bool (*binary_predicate)(const void *, const void *)) {
+    massert_pfunc(binary_predicate);
+    return alg_equal(first1, last1, first2, binary_predicate);
+}
+
+/**
+ *  @brief  Finds the first occurrence of [first2, last2) in [first1, last1)
+ *
+ *  @param[in]  first1  iterator to the first element of the range searched
+ *  @param[in]  last1   iterator to one past the end of the range searched
+ *  @param[in]  first2  iterator to the first element of the sequence
+ *  @param[in]  last2   iterator to one past the end of the sequence
+ *
+ *  @return     iterator to the start of the first occurrence,
+ *              last1 if there is none, or first1 if the sequence is empty
+ */
+iterator search_equal(iterator *first1, iterator *last1,
+                      iterator *first2, iterator *last2) {
+    return alg_search(first1, last1, first2, last2, NULL);
+}
+
+/**
+ *  @brief  Finds the first occurrence of [first2, last2) in [first1, last1),
+ *          matching elements with binary_predicate
+ *
+ *  @param[in]  first1              iterator to the first element searched
+ *  @param[in]  last1               iterator to one past the end searched
+ *  @param[in]  first2              iterator to the first element of the sequence
+ *  @param[in]  last2               iterator to one past the end of the sequence
+ *  @param[in]  binary_predicate    function that determines a match
+ *
+ *  @return     iterator to the start of the first occurrence,
+ *              last1 if there is none, or first1 if the sequence is empty
+ */
+iterator search_predicate(iterator *first1, iterator *last1,
+                          iterator *first2, iterator *last2,
+                          bool (*binary_predicate)(const void *,
+                                                   const void *)) {
+    massert_pfunc(binary_predicate);
+    return alg_search(first1, last1, first2, last2, binary_predicate);
+}
+
+/**
+ *  @brief  Finds the first run of count consecutive elements
+ *          equal to valaddr
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  count   length of the run
+ *  @param[in]  valaddr address of the element that makes up the run
+ *
+ *  @return     iterator to the start of the run,
+ *              last if there is none, or first if count is 0
+ */
+iterator search_n_equal(iterator *first, iterator *last, size_t count,
+                        const void *valaddr) {
+    return alg_search_n(first, last, count, valaddr, NULL);
+}
+
+/**
+ *  @brief  Finds the first run of count consecutive elements
+ *          that match valaddr by binary_predicate
+ *
+ *  @param[in]  first               iterator to the first element of the range
+ *  @param[in]  last                iterator to one past the end of the range
+ *  @param[in]  count               length of the run
+ *  @param[in]  valaddr             address of the element to match against
+ *  @param[in]  binary_predicate    function that determines a match,
+ *                                  called as binary_predicate(elem, valaddr)
+ *
+ *  @return     iterator to the start of the run,
+ *              last if there is none, or first if count is 0
+ */
+iterator search_n_predicate(iterator *first, iterator *last, size_t count,
+                            const void *valaddr,
+                            bool (*binary_predicate)(const void *,
+                                                     const void *)) {
+    massert_pfunc(binary_predicate);
+    return alg_search_n(first, last, count, valaddr, binary_predicate);
+}
+
+/**
+ *  @brief  Determines if every element that passes unary_predicate
+ *          precedes every element that fails it
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     true if the range is partitioned by unary_predicate
+ */
+bool is_partitioned(iterator *first, iterator *last,
+                    bool (*unary_predicate)(const void *)) {
+    iterator it = alg_find_pred(first, last, unary_predicate, false);
+    it = alg_find_pred(&it, last, unary_predicate, true);
+    return it.curr == last->curr ? true : false;
+}
+
+/**
+ *  @brief  Reorders the range so that every element that passes
+ *          unary_predicate precedes every element that fails it
+ *
+ *  A contiguous range is partitioned from both ends (Hoare),
+ *  swapping as few elements as possible. A list is partitioned
+ *  by exchanging the data pointers of its nodes, so the cost
+ *  does not depend on the element width. Any other range is
+ *  partitioned in a single forward pass. The relative order of
+ *  the elements is not preserved.
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *
+ *  @return     iterator to the first element that fails unary_predicate,
+ *              or last if there is none
+ */
+iterator partition(iterator *first, iterator *last,
+                   bool (*unary_predicate)(const void *)) {
+    struct range r;
+    struct range store;
+    void *curr = NULL;
+
+    massert_pfunc(unary_predicate);
+    rg_init(&r, first, last);
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        char *lo = r.curr;
+        char *hi = r.finish;
+
+        for (;;) {
+            while (lo < hi && unary_predicate(lo)) {
+                lo += r.width;
+            }
+
+            while (lo < hi && unary_predicate(hi - r.width) == false) {
+                hi -= r.width;
+            }
+
+            if (lo == hi) {
+                break;
+            }
+
+            /**< *lo fails, *(hi - 1) passes */
+            hi -= r.width;
+            alg_swap(lo, hi, r.width);
+            lo += r.width;
+        }
+
+        r.curr = lo;
+        return rg_iter(&r);
+    }
+
+    store = r;
+
+    while ((curr = rg_curr(&r))) {
+        if (unary_predicate(curr)) {
+            void *dest = rg_peek(&store);
+
+            if (dest != curr) {
+                if (r.kind == RANGE_LIST) {
+                    list_node *a = (list_node *)(store.curr);
+                    list_node *b = (list_node *)(r.curr);
+
+                    a->data = curr;
+                    b->data = dest;
+                } else {
+                    alg_swap(dest, curr, r.width);
+                }
+            }
+
+            rg_next(&store);
+        }
+
+        rg_next(&r);
+    }
+
+    return rg_iter(&store);
+}
+
+/**
+ *  @brief  Finds the end of the leading run of elements
+ *          that pass unary_predicate, in a partitioned range
+ *
+ *  Takes O(log n) calls to unary_predicate; a contiguous range
+ *  also takes O(log n) steps, any other range O(n).
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function the range is partitioned by
+ *
+ *  @return     iterator to the first element that fails unary_predicate,
+ *              or last if there is none
+ */
+iterator partition_point(iterator *first, iterator *last,
+                         bool (*unary_predicate)(const void *)) {
+    struct range r;
+    size_t n = 0;
+
+    massert_pfunc(unary_predicate);
+    rg_init(&r, first, last);
+    n = rg_distance(&r);
+
+    while (n > 0) {
+        size_t half = n / 2;
+        struct range mid = r;
+
+        rg_advance(&mid, half);
+
+        if (unary_predicate(rg_peek(&mid))) {
+            r = mid;
+            rg_next(&r);
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+
+    return rg_iter(&r);
+}
+
+/**
+ *  @brief  Determines if the range is sorted in non-descending order,
+ *          by the compare function of first's typetable
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *
+ *  @return     true if the range is sorted
+ */
+bool is_sorted(iterator *first, iterator *last) {
+    iterator it = is_sorted_until(first, last);
+    return it.curr == last->curr ? true : false;
+}
+
+/**
+ *  @brief  Determines if the range is sorted in non-descending order,
+ *          by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  compare comparator of the range's elements
+ *
+ *  @return     true if the range is sorted
+ */
+bool is_sorted_custom(iterator *first, iterator *last,
+                      int (*compare)(const void *, const void *)) {
+    iterator it = is_sorted_until_custom(first, last, compare);
+    return it.curr == last->curr ? true : false;
+}
+
+/**
+ *  @brief  Finds the end of the leading sorted run of the range,
+ *          by the compare function of first's typetable
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *
+ *  @return     iterator to the first element that is less than
+ *              the one before it, or last if there is none
+ */
+iterator is_sorted_until(iterator *first, iterator *last) {
+    massert_iterator(first);
+    return is_sorted_until_custom(first, last, it_get_ttbl(*first)->compare);
+}
+
+/**
+ *  @brief  Finds the end of the leading sorted run of the range,
+ *          by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  compare comparator of the range's elements
+ *
+ *  @return     iterator to the first element that is less than
+ *              the one before it, or last if there is none
+ */
+iterator is_sorted_until_custom(iterator *first, iterator *last,
+                                int (*compare)(const void *, const void *)) {
+    struct range r;
+    void *prev = NULL;
+    void *curr = NULL;
+
+    massert_pfunc(compare);
+    rg_init(&r, first, last);
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        if (r.curr < r.finish) {
+            while (r.curr + r.width < r.finish &&
+                   compare(r.curr + r.width, r.curr) >= 0) {
+                r.curr += r.width;
+            }
+
+            r.curr += r.width;
+        }
+
+        return rg_iter(&r);
+    }
+
+    if ((prev = rg_curr(&r)) == NULL) {
+        return rg_iter(&r);
+    }
+
+    rg_next(&r);
+
+    while ((curr = rg_curr(&r)) && compare(curr, prev) >= 0) {
+        prev = curr;
+        rg_next(&r);
+    }
+
+    return rg_iter(&r);
+}
+
+/**
+ *  @brief  Finds the first element that does not compare less than valaddr
+ *
+ *  The range must be sorted by the compare function of first's typetable.
+ *  Takes O(log n) comparisons; a contiguous range also takes
+ *  O(log n) steps, any other range O(n).
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *
+ *  @return     iterator to the lower bound, or last if there is none
+ */
+iterator lower_bound(iterator *first, iterator *last, const void *valaddr) {
+    massert_iterator(first);
+    return alg_bound(first, last, valaddr, it_get_ttbl(*first)->compare, false);
+}
+
+/**
+ *  @brief  Finds the first element that does not compare less than valaddr,
+ *          in a range sorted by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *  @param[in]  compare comparator the range is sorted by
+ *
+ *  @return     iterator to the lower bound, or last if there is none
+ */
+iterator lower_bound_custom(iterator *first, iterator *last,
+                            const void *valaddr,
+                            int (*compare)(const void *, const void *)) {
+    return alg_bound(first, last, valaddr, compare, false);
+}
+
+/**
+ *  @brief  Finds the first element that compares greater than valaddr
+ *
+ *  The range must be sorted by the compare function of first's typetable.
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *
+ *  @return     iterator to the upper bound, or last if there is none
+ */
+iterator upper_bound(iterator *first, iterator *last, const void *valaddr) {
+    massert_iterator(first);
+    return alg_bound(first, last, valaddr, it_get_ttbl(*first)->compare, true);
+}
+
+/**
+ *  @brief  Finds the first element that compares greater than valaddr,
+ *          in a range sorted by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *  @param[in]  compare comparator the range is sorted by
+ *
+ *  @return     iterator to the upper bound, or last if there is none
+ */
+iterator upper_bound_custom(iterator *first, iterator *last,
+                            const void *valaddr,
+                            int (*compare)(const void *, const void *)) {
+    return alg_bound(first, last, valaddr, compare, true);
+}
+
+/**
+ *  @brief  Determines if an element equal to valaddr is in the range
+ *
+ *  The range must be sorted by the compare function of first's typetable.
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *
+ *  @return     true if found, false otherwise
+ */
+bool binary_search(iterator *first, iterator *last, const void *valaddr) {
+    massert_iterator(first);
+    return binary_search_custom(first, last, valaddr,
+                                it_get_ttbl(*first)->compare);
+}
+
+/**
+ *  @brief  Determines if an element equal to valaddr is in a range
+ *          sorted by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *  @param[in]  compare comparator the range is sorted by
+ *
+ *  @return     true if found, false otherwise
+ */
+bool binary_search_custom(iterator *first, iterator *last, const void *valaddr,
+                          int (*compare)(const void *, const void *)) {
+    iterator it = alg_bound(first, last, valaddr, compare, false);
+
+    if (it.curr == last->curr) {
+        return false;
+    }
+
+    return compare(valaddr, it_curr(it)) < 0 ? false : true;
+}
+
+/**
+ *  @brief  Finds the smallest element,
+ *          by the compare function of first's typetable
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *
+ *  @return     iterator to the first smallest element, or last if empty
+ */
+iterator min_element(iterator *first, iterator *last) {
+    massert_iterator(first);
+    return alg_extreme(first, last, it_get_ttbl(*first)->compare, false);
+}
+
+/**
+ *  @brief  Finds the smallest element, by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  compare comparator of the range's elements
+ *
+ *  @return     iterator to the first smallest element, or last if empty
+ */
+iterator min_element_custom(iterator *first, iterator *last,
+                            int (*compare)(const void *, const void *)) {
+    return alg_extreme(first, last, compare, false);
+}
+
+/**
+ *  @brief  Finds the largest element,
+ *          by the compare function of first's typetable
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *
+ *  @return     iterator to the first largest element, or last if empty
+ */
+iterator max_element(iterator *first, iterator *last) {
+    massert_iterator(first);
+    return alg_extreme(first, last, it_get_ttbl(*first)->compare, true);
+}
+
+/**
+ *  @brief  Finds the largest element, by compare
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  compare comparator of the range's elements
+ *
+ *  @return     iterator to the first largest element, or last if empty
+ */
+iterator max_element_custom(iterator *first, iterator *last,
+                            int (*compare)(const void *, const void *)) {
+    return alg_extreme(first, last, compare, true);
+}
+
+/**
+ *  @brief  Determines if [first1, last1) orders before [first2, last2),
+ *          by the compare function of first1's typetable
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *
+ *  @return     true if the first range is lexicographically less
+ */
+bool lexicographical_compare(iterator *first1, iterator *last1,
+                             iterator *first2, iterator *last2) {
+    massert_iterator(first1);
+    return lexicographical_compare_custom(first1, last1, first2, last2,
+                                          it_get_ttbl(*first1)->compare);
+}
+
+/**
+ *  @brief  Determines if [first1, last1) orders before [first2, last2),
+ *          by compare
+ *
+ *  @param[in]  first1  iterator to the first element of the first range
+ *  @param[in]  last1   iterator to one past the end of the first range
+ *  @param[in]  first2  iterator to the first element of the second range
+ *  @param[in]  last2   iterator to one past the end of the second range
+ *  @param[in]  compare comparator of the ranges' elements
+ *
+ *  @return     true if the first range is lexicographically less
+ */
+bool lexicographical_compare_custom(iterator *first1, iterator *last1,
+                                    iterator *first2, iterator *last2,
+                                    int (*compare)(const void *,
+                                                   const void *)) {
+    struct range r1, r2;
+    void *a = NULL;
+    void *b = NULL;
+
+    massert_pfunc(compare);
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+
+    while ((b = rg_curr(&r2))) {
+        int cmp = 0;
+
+        if ((a = rg_curr(&r1)) == NULL) {
+            return true;
+        }
+
+        if ((cmp = compare(a, b)) != 0) {
+            return cmp < 0 ? true : false;
+        }
+
+        rg_next(&r1);
+        rg_next(&r2);
+    }
+
+    return false;
+}
+
+/**
+ *  @brief  Initializes r to the range [first, last)
+ *
+ *  @param[out] r       pointer to range
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ */
+static void rg_init(struct range *r, iterator *first, iterator *last) {
+    massert_iterator(first);
+    massert_iterator(last);
+
+    r->it = *first;
+    r->last = *last;
+    r->width = it_get_ttbl(*first)->width;
+
+    r->curr = NULL;
+    r->finish = NULL;
+
+    if (it_contiguous(*first)) {
+        r->kind = RANGE_CONTIGUOUS;
+        r->curr = first->curr;
+        r->finish = last->curr;
+    } else if (first->itbl == _list_iterator_) {
+        /**< a list that has never held an element has no first node */
+        r->kind = RANGE_LIST;
+        r->curr = first->curr ? first->curr : last->curr;
+        r->finish = last->curr;
+    } else if (first->itbl == _rbtree_iterator_) {
+        r->kind = RANGE_RBTREE;
+    } else {
+        r->kind = RANGE_STEPPED;
+    }
+}
+
+/**
+ *  @brief  Returns the address of r's current element,
+ *          without checking for the end of r
+ *
+ *  @param[in]  r   pointer to range
+ *
+ *  @return     address of the current element
+ */
+static void *rg_peek(struct range *r) {
+    switch (r->kind) {
+    case RANGE_CONTIGUOUS:
+        return r->curr;
+
+    case RANGE_LIST:
+        return ((list_node *)(r->curr))->data;
+
+    default:
+        return it_curr(r->it);
+    }
+}
+
+/**
+ *  @brief  Returns the address of r's current element
+ *
+ *  @param[in]  r   pointer to range
+ *
+ *  @return     address of the current element, or NULL if r is exhausted
+ */
+static void *rg_curr(struct range *r) {
+    if (r->kind == RANGE_RBTREE || r->kind == RANGE_STEPPED) {
+        return r->it.curr == r->last.curr ? NULL : it_curr(r->it);
+    }
+
+    return r->curr != r->finish ? rg_peek(r) : NULL;
+}
+
+/**
+ *  @brief  Moves r to its next element
+ *
+ *  @param[in]  r   pointer to range
+ */
+static void rg_next(struct range *r) {
+    switch (r->kind) {
+    case RANGE_CONTIGUOUS:
+        r->curr += r->width;
+        break;
+
+    case RANGE_LIST:
+        r->curr = (char *)(((list_node_base *)(r->curr))->next);
+        break;
+
+    default:
+        it_incr(&r->it);
+        break;
+    }
+}
+
+/**
+ *  @brief  Moves r n elements ahead -- O(1) if r is random access
+ *
+ *  @param[in]  r   pointer to range
+ *  @param[in]  n   number of elements to skip
+ */
+static void rg_advance(struct range *r, size_t n) {
+    if (r->kind == RANGE_CONTIGUOUS) {
+        r->curr += n * r->width;
+        return;
+    } else if (r->kind == RANGE_STEPPED && it_random_access(r->it)) {
+        it_advance(&r->it, (int)(n));
+        return;
+    }
+
+    while (n-- > 0) {
+        rg_next(r);
+    }
+}
+
+/**
+ *  @brief  Returns the number of elements left in r
+ *          -- O(1) if r is random access
+ *
+ *  @param[in]  r   pointer to range
+ *
+ *  @return     number of elements from r's position to its end
+ */
+static size_t rg_distance(struct range *r) {
+    struct range temp = *r;
+    size_t n = 0;
+
+    if (r->kind == RANGE_CONTIGUOUS) {
+        return (size_t)(r->finish - r->curr) / r->width;
+    } else if (r->kind == RANGE_STEPPED && it_random_access(r->it)) {
+        return (size_t)(it_distance(&r->it, &r->last));
+    }
+
+    while (rg_curr(&temp)) {
+        rg_next(&temp);
+        ++n;
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Returns an iterator to r's current position
+ *
+ *  @param[in]  r   pointer to range
+ *
+ *  @return     iterator to r's current element (or to last, if exhausted)
+ */
+static iterator rg_iter(struct range *r) {
+    iterator it = r->it;
+
+    if (r->kind == RANGE_CONTIGUOUS || r->kind == RANGE_LIST) {
+        it.curr = r->curr;
+    }
+
+    return it;
+}
+
+/**
+ *  @brief  Moves r to its first element that does not compare
+ *          less than valaddr (or to its end, if there is none)
+ *
+ *  A contiguous range gallops: it probes 1, 2, 4, ... elements ahead
+ *  until it overshoots valaddr, then binary searches the last gap --
+ *  O(log d) comparisons to skip d elements.
+ *
+ *  An rbtree range steps up to SET_GALLOP_WALK times (the common case,
+ *  when the ranges interleave densely), then descends from the root
+ *  with rbt_lower_bound. That cannot land past last: if last's element
+ *  does not compare less than valaddr, the lower bound precedes
+ *  (or is) last -- otherwise, every element before last is skipped.
+ *  Any other range steps.
+ *
+ *  @param[in]  r       pointer to range
+ *  @param[in]  valaddr address of the element to search for
+ *  @param[in]  compare comparator of the range's elements
+ */
+static void rg_seek(struct range *r, const void *valaddr,
+                    int (*compare)(const void *, const void *)) {
+    void *curr = NULL;
+    int i = 0;
+
+    if (r->kind == RANGE_CONTIGUOUS) {
+        size_t width = r->width;
+        size_t step = 1;
+        size_t count = 0;
+        size_t left = 0;
+        char *lo = r->curr;
+
+        if (lo >= r->finish || compare(lo, valaddr) >= 0) {
+            return;
+        }
+
+        /**< *lo < valaddr; left elements follow lo */
+        left = (size_t)(r->finish - lo) / width - 1;
+
+        while (step <= left && compare(lo + step * width, valaddr) < 0) {
+            lo += step * width;
+            left -= step;
+            step *= 2;
+        }
+
+        /**< the answer is among the count elements after lo */
+        count = step <= left ? step : left + 1;
+        lo += width;
+        --count;
+
+        while (count > 0) {
+            size_t half = count / 2;
+
+            if (compare(lo + half * width, valaddr) < 0) {
+                lo += (half + 1) * width;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+
+        r->curr = lo;
+        return;
+    }
+
+    for (i = 0; r->kind != RANGE_RBTREE || i < SET_GALLOP_WALK; ++i) {
+        curr = rg_curr(r);
+
+        if (curr == NULL || compare(curr, valaddr) >= 0) {
+            return;
+        }
+
+        rg_next(r);
+    }
+
+    if (r->last.curr && compare(it_curr(r->last), valaddr) < 0) {
+        r->it = r->last;
+    } else {
+        r->it = rbt_lower_bound(r->it.container, valaddr);
+    }
+}
+
+/**
+ *  @brief  Appends the rest of r to dest
+ *
+ *  @param[in]  r       pointer to range
+ *  @param[out] dest    pointer to vector
+ *
+ *  @return     number of elements appended to dest
+ */
+static size_t rg_drain(struct range *r, vector *dest) {
+    size_t n = 0;
+    void *curr = NULL;
+
+    while ((curr = rg_curr(r))) {
+        v_pushb(dest, curr);
+        rg_next(r);
+        ++n;
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Determines if two elements described by ttbl are equal
+ *          exactly when their bytes are equal
+ *
+ *  That holds for the integer types (and for any type without
+ *  a compare function, which is compared with memcmp anyway) --
+ *  but not for floating point (0.0 == -0.0), strings, or structs
+ *  with padding. Only the integer typetables are recognized,
+ *  by their equals functions -- _int64_ and _uint64_ among them,
+ *  since (long long) only exists (and is only checked) under C99.
+ *
+ *  @param[in]  ttbl    pointer to typetable
+ *
+ *  @return     true if elements may be compared with memcmp
+ */
+static bool alg_bytewise(struct typetable *ttbl) {
+    bool (*equals)(const void *, const void *) = ttbl->equals;
+
+    if (ttbl->compare == NULL) {
+        return true;
+    }
+
+#if __STDC_VERSION__ >= 199901L
+    if (equals == long_long_int_equals ||
+        equals == signed_long_long_int_equals ||
+        equals == unsigned_long_long_int_equals) {
+        return true;
+    }
+#endif
+
+    return (equals == char_equals || equals == signed_char_equals ||
+            equals == unsigned_char_equals || equals == short_int_equals ||
+            equals == signed_short_int_equals ||
+            equals == unsigned_short_int_equals || equals == int_equals ||
+            equals == signed_int_equals || equals == unsigned_int_equals ||
+            equals == long_int_equals || equals == signed_long_int_equals ||
+            equals == unsigned_long_int_equals || equals == int64_equals ||
+            equals == uint64_equals) ? true : false;
+}
+
+/**
+ *  @brief  Determines if a matches b
+ *
+ *  @param[in]  ttbl                typetable of a and b
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *  @param[in]  a                   address of an element
+ *  @param[in]  b                   address of an element
+ *
+ *  @return     binary_predicate(a, b) if given; otherwise, true if
+ *              a and b compare equal (or have equal bytes, without compare)
+ */
+static bool alg_match(struct typetable *ttbl,
+                      bool (*binary_predicate)(const void *, const void *),
+                      const void *a, const void *b) {
+    if (binary_predicate) {
+        return binary_predicate(a, b) ? true : false;
+    }
+
+    if (ttbl->compare) {
+        return ttbl->compare(a, b) == 0 ? true : false;
+    }
+
+    return memcmp(a, b, ttbl->width) == 0 ? true : false;
+}
+
+/**
+ *  @brief  Exchanges the width bytes at a with those at b
+ *
+ *  @param[in]  a       address of an element
+ *  @param[in]  b       address of an element
+ *  @param[in]  width   size of an element, in bytes
+ */
+static void alg_swap(void *a, void *b, size_t width) {
+    char buffer[64];
+    char *x = a;
+    char *y = b;
+
+    while (width > 0) {
+        size_t n = width < sizeof(buffer) ? width : sizeof(buffer);
+
+        memcpy(buffer, x, n);
+        memcpy(x, y, n);
+        memcpy(y, buffer, n);
+
+        x += n;
+        y += n;
+        width -= n;
+    }
+}
+
+/**
+ *  @def        ALG_FIND_WORDS
+ *  @brief      Scans [curr, finish) for the TYPE-wide word at valaddr,
+ *              four words per loop, and returns the match (or finish)
+ */
+#define ALG_FIND_WORDS(TYPE)                                                   \
+{                                                                              \
+    TYPE val;                                                                  \
+    TYPE *p = (TYPE *)(curr);                                                  \
+    TYPE *end = (TYPE *)(finish);                                              \
+                                                                               \
+    memcpy(&val, valaddr, sizeof(val));                                        \
+                                                                               \
+    while (end - p >= 4) {                                                     \
+        if (p[0] == val) return (char *)(p);                                   \
+        if (p[1] == val) return (char *)(p + 1);                               \
+        if (p[2] == val) return (char *)(p + 2);                               \
+        if (p[3] == val) return (char *)(p + 3);                               \
+        p += 4;                                                                \
+    }                                                                          \
+                                                                               \
+    while (p < end && *p != val) {                                             \
+        ++p;                                                                   \
+    }                                                                          \
+                                                                               \
+    return (char *)(p);                                                        \
+}
+
+/**
+ *  @def        ALG_COUNT_WORDS
+ *  @brief      Counts the TYPE-wide words in [curr, finish)
+ *              equal to the one at valaddr
+ */
+#define ALG_COUNT_WORDS(TYPE)                                                  \
+{                                                                              \
+    TYPE val;                                                                  \
+    TYPE *p = (TYPE *)(curr);                                                  \
+    size_t len = (size_t)(finish - curr) / sizeof(TYPE);                      \
+    size_t i = 0;                                                              \
+    size_t n = 0;                                                              \
+                                                                               \
+    memcpy(&val, valaddr, sizeof(val));                                        \
+                                                                               \
+    for (i = 0; i < len; ++i) {                                                \
+        n += (p[i] == val);                                                    \
+    }                                                                          \
+                                                                               \
+    return n;                                                                  \
+}
+
+/**
+ *  @brief  Finds the first element in [curr, finish)
+ *          whose bytes equal those at valaddr
+ *
+ *  Single bytes are found with memchr; 2, 4, and 8 byte elements
+ *  are compared as whole words; anything else with memcmp.
+ *
+ *  @param[in]  curr    address of the first element
+ *  @param[in]  finish  address one past the last element
+ *  @param[in]  width   size of an element, in bytes
+ *  @param[in]  valaddr address of the element to search for
+ *
+ *  @return     address of the first match, or finish if there is none
+ */
+static char *alg_find_bytes(char *curr, char *finish, size_t width,
+                            const void *valaddr) {
+    void *hit = NULL;
+
+    switch (width) {
+    case 1:
+        hit = memchr(curr, *(const unsigned char *)(valaddr),
+                     (size_t)(finish - curr));
+        return hit ? (char *)(hit) : finish;
+
+    case 2:
+        ALG_FIND_WORDS(uint16_t)
+
+    case 4:
+        ALG_FIND_WORDS(uint32_t)
+
+    case 8:
+        ALG_FIND_WORDS(uint64_t)
+
+    default:
+        while (curr < finish && memcmp(curr, valaddr, width) != 0) {
+            curr += width;
+        }
+
+        return curr;
+    }
+}
+
+/**
+ *  @brief  Counts the elements in [curr, finish)
+ *          whose bytes equal those at valaddr
+ *
+ *  @param[in]  curr    address of the first element
+ *  @param[in]  finish  address one past the last element
+ *  @param[in]  width   size of an element, in bytes
+ *  @param[in]  valaddr address of the element to count
+ *
+ *  @return     number of matching elements
+ */
+static size_t alg_count_bytes(char *curr, char *finish, size_t width,
+                              const void *valaddr) {
+    size_t n = 0;
+
+    switch (width) {
+    case 1:
+        ALG_COUNT_WORDS(uint8_t)
+
+    case 2:
+        ALG_COUNT_WORDS(uint16_t)
+
+    case 4:
+        ALG_COUNT_WORDS(uint32_t)
+
+    case 8:
+        ALG_COUNT_WORDS(uint64_t)
+
+    default:
+        for (; curr < finish; curr += width) {
+            n += (memcmp(curr, valaddr, width) == 0);
+        }
+
+        return n;
+    }
+}
+
+#undef ALG_FIND_WORDS
+#undef ALG_COUNT_WORDS
+
+/**
+ *  @brief  Finds the first element for which unary_predicate
+ *          returns want
+ *
+ *  @param[in]  first           iterator to the first element of the range
+ *  @param[in]  last            iterator to one past the end of the range
+ *  @param[in]  unary_predicate function to test each element with
+ *  @param[in]  want            result that ends the search
+ *
+ *  @return     iterator to the first match, or last if there is none
+ */
+static iterator alg_find_pred(iterator *first, iterator *last,
+                              bool (*unary_predicate)(const void *),
+                              bool want) {
+    struct range r;
+    void *curr = NULL;
+    bool stop = want ? true : false;
+
+    massert_pfunc(unary_predicate);
+    rg_init(&r, first, last);
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        while (r.curr < r.finish &&
+               (unary_predicate(r.curr) ? true : false) != stop) {
+            r.curr += r.width;
+        }
+
+        return rg_iter(&r);
+    }
+
+    while ((curr = rg_curr(&r)) &&
+           (unary_predicate(curr) ? true : false) != stop) {
+        rg_next(&r);
+    }
+
+    return rg_iter(&r);
+}
+
+/**
+ *  @brief  Determines if [first1, last1) matches the range starting
+ *          at first2, element for element
+ *
+ *  Two contiguous ranges of a bytewise-comparable type
+ *  are compared with a single memcmp.
+ *
+ *  @param[in]  first1              iterator to the first element of the first range
+ *  @param[in]  last1               iterator to one past the end of the first range
+ *  @param[in]  first2              iterator to the first element of the second range
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *
+ *  @return     true if every pair of elements matches
+ */
+static bool alg_equal(iterator *first1, iterator *last1, iterator *first2,
+                      bool (*binary_predicate)(const void *, const void *)) {
+    struct typetable *ttbl = NULL;
+    struct range r1, r2;
+    void *a = NULL;
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, first2);
+    ttbl = it_get_ttbl(*first1);
+
+    if (binary_predicate == NULL && r1.kind == RANGE_CONTIGUOUS &&
+        r2.kind == RANGE_CONTIGUOUS && r1.width == r2.width &&
+        alg_bytewise(ttbl)) {
+        return memcmp(r1.curr, r2.curr, (size_t)(r1.finish - r1.curr)) == 0
+                   ? true
+                   : false;
+    }
+
+    while ((a = rg_curr(&r1))) {
+        if (alg_match(ttbl, binary_predicate, a, rg_peek(&r2)) == false) {
+            return false;
+        }
+
+        rg_next(&r1);
+        rg_next(&r2);
+    }
+
+    return true;
+}
+
+/**
+ *  @brief  Finds the first occurrence of [first2, last2) in [first1, last1)
+ *
+ *  Over two contiguous ranges of a bytewise-comparable type,
+ *  candidates are found with alg_find_bytes (on the first element
+ *  of the sequence), then verified with a single memcmp.
+ *
+ *  @param[in]  first1              iterator to the first element searched
+ *  @param[in]  last1               iterator to one past the end searched
+ *  @param[in]  first2              iterator to the first element of the sequence
+ *  @param[in]  last2               iterator to one past the end of the sequence
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *
+ *  @return     iterator to the start of the first occurrence,
+ *              last1 if there is none, or first1 if the sequence is empty
+ */
+static iterator alg_search(iterator *first1, iterator *last1,
+                           iterator *first2, iterator *last2,
+                           bool (*binary_predicate)(const void *,
+                                                    const void *)) {
+    struct typetable *ttbl = NULL;
+    struct range r1, r2;
+
+    rg_init(&r1, first1, last1);
+    rg_init(&r2, first2, last2);
+    ttbl = it_get_ttbl(*first1);
+
+    if (rg_curr(&r2) == NULL) {
+        return *first1;
+    }
+
+    if (binary_predicate == NULL && r1.kind == RANGE_CONTIGUOUS &&
+        r2.kind == RANGE_CONTIGUOUS && r1.width == r2.width &&
+        alg_bytewise(ttbl)) {
+        size_t bytes = (size_t)(r2.finish - r2.curr);
+        char *limit = NULL;
+
+        if ((size_t)(r1.finish - r1.curr) < bytes) {
+            return *last1;
+        }
+
+        /**< an occurrence must start before limit */
+        limit = r1.finish - bytes + r1.width;
+
+        while ((r1.curr = alg_find_bytes(r1.curr, limit, r1.width,
+                                         r2.curr)) < limit) {
+            if (memcmp(r1.curr, r2.curr, bytes) == 0) {
+                return rg_iter(&r1);
+            }
+
+            r1.curr += r1.width;
+        }
+
+        return *last1;
+    }
+
+    for (;;) {
+        struct range a = r1;
+        struct range b = r2;
+        void *x = NULL;
+        void *y = NULL;
+
+        for (;;) {
+            if ((y = rg_curr(&b)) == NULL) {
+                return rg_iter(&r1);
+            }
+
+            if ((x = rg_curr(&a)) == NULL) {
+                return *last1;
+            }
+
+            if (alg_match(ttbl, binary_predicate, x, y) == false) {
+                break;
+            }
+
+            rg_next(&a);
+            rg_next(&b);
+        }
+
+        rg_next(&r1);
+    }
+}
+
+/**
+ *  @brief  Finds the first run of count consecutive elements
+ *          that match valaddr
+ *
+ *  @param[in]  first               iterator to the first element of the range
+ *  @param[in]  last                iterator to one past the end of the range
+ *  @param[in]  count               length of the run
+ *  @param[in]  valaddr             address of the element to match against
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *
+ *  @return     iterator to the start of the run,
+ *              last if there is none, or first if count is 0
+ */
+static iterator alg_search_n(iterator *first, iterator *last, size_t count,
+                             const void *valaddr,
+                             bool (*binary_predicate)(const void *,
+                                                      const void *)) {
+    struct typetable *ttbl = NULL;
+    struct range r;
+    void *curr = NULL;
+
+    massert_ptr(valaddr);
+
+    if (count == 0) {
+        return *first;
+    }
+
+    rg_init(&r, first, last);
+    ttbl = it_get_ttbl(*first);
+
+    if (binary_predicate == NULL && r.kind == RANGE_CONTIGUOUS &&
+        alg_bytewise(ttbl)) {
+        while ((r.curr = alg_find_bytes(r.curr, r.finish, r.width,
+                                        valaddr)) < r.finish) {
+            char *end = r.curr + r.width;
+            size_t run = 1;
+
+            while (run < count && end < r.finish &&
+                   memcmp(end, valaddr, r.width) == 0) {
+                end += r.width;
+                ++run;
+            }
+
+            if (run == count) {
+                return rg_iter(&r);
+            }
+
+            /**< no run can start before end */
+            r.curr = end;
+        }
+
+        return *last;
+    }
+
+    while ((curr = rg_curr(&r))) {
+        struct range start = r;
+        size_t run = 0;
+
+        while (run < count && (curr = rg_curr(&r)) &&
+               alg_match(ttbl, binary_predicate, curr, valaddr)) {
+            rg_next(&r);
+            ++run;
+        }
+
+        if (run == count) {
+            return rg_iter(&start);
+        }
+
+        if (run == 0) {
+            rg_next(&r);
+        }
+    }
+
+    return *last;
+}
+
+/**
+ *  @brief  Finds the last occurrence of [first2, last2) in [first1, last1)
+ *
+ *  @param[in]  first1              iterator to the first element searched
+ *  @param[in]  last1               iterator to one past the end searched
+ *  @param[in]  first2              iterator to the first element of the sequence
+ *  @param[in]  last2               iterator to one past the end of the sequence
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *
+ *  @return     iterator to the start of the last occurrence,
+ *              or last1 if there is none (or if the sequence is empty)
+ */
+static iterator alg_find_end(iterator *first1, iterator *last1,
+                             iterator *first2, iterator *last2,
+                             bool (*binary_predicate)(const void *,
+                                                      const void *)) {
+    iterator result = *last1;
+    iterator from = *first1;
+    struct range r2;
+
+    rg_init(&r2, first2, last2);
+
+    if (rg_curr(&r2) == NULL) {
+        return *last1;
+    }
+
+    for (;;) {
+        iterator hit = alg_search(&from, last1, first2, last2,
+                                  binary_predicate);
+        struct range r;
+
+        if (hit.curr == last1->curr) {
+            return result;
+        }
+
+        result = hit;
+
+        rg_init(&r, &hit, last1);
+        rg_next(&r);
+        from = rg_iter(&r);
+    }
+}
+
+/**
+ *  @brief  Finds the first element of [first1, last1)
+ *          that matches any element of [first2, last2)
+ *
+ *  @param[in]  first1              iterator to the first element searched
+ *  @param[in]  last1               iterator to one past the end searched
+ *  @param[in]  first2              iterator to the first element to search for
+ *  @param[in]  last2               iterator to one past the last of them
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *
+ *  @return     iterator to the first match, or last1 if there is none
+ */
+static iterator alg_find_first_of(iterator *first1, iterator *last1,
+                                  iterator *first2, iterator *last2,
+                                  bool (*binary_predicate)(const void *,
+                                                           const void *)) {
+    struct typetable *ttbl = NULL;
+    struct range r1, r2;
+    void *a = NULL;
+    void *b = NULL;
+
+    rg_init(&r1, first1, last1);
+    ttbl = it_get_ttbl(*first1);
+
+    while ((a = rg_curr(&r1))) {
+        rg_init(&r2, first2, last2);
+
+        while ((b = rg_curr(&r2))) {
+            if (alg_match(ttbl, binary_predicate, a, b)) {
+                return rg_iter(&r1);
+            }
+
+            rg_next(&r2);
+        }
+
+        rg_next(&r1);
+    }
+
+    return rg_iter(&r1);
+}
+
+/**
+ *  @brief  Finds the first of two adjacent elements that match
+ *
+ *  @param[in]  first               iterator to the first element of the range
+ *  @param[in]  last                iterator to one past the end of the range
+ *  @param[in]  binary_predicate    function that determines a match, or NULL
+ *
+ *  @return     iterator to the first of the pair, or last if there is none
+ */
+static iterator alg_adjacent_find(iterator *first, iterator *last,
+                                  bool (*binary_predicate)(const void *,
+                                                           const void *)) {
+    struct typetable *ttbl = NULL;
+    struct range r;
+    void *prev = NULL;
+    void *curr = NULL;
+
+    rg_init(&r, first, last);
+    ttbl = it_get_ttbl(*first);
+
+    if ((prev = rg_curr(&r)) == NULL) {
+        return *last;
+    }
+
+    if (binary_predicate == NULL && r.kind == RANGE_CONTIGUOUS &&
+        alg_bytewise(ttbl)) {
+        for (; r.curr + r.width < r.finish; r.curr += r.width) {
+            if (memcmp(r.curr, r.curr + r.width, r.width) == 0) {
+                return rg_iter(&r);
+            }
+        }
+
+        return *last;
+    }
+
+    for (;;) {
+        struct range at = r;
+
+        rg_next(&r);
+
+        if ((curr = rg_curr(&r)) == NULL) {
+            return *last;
+        }
+
+        if (alg_match(ttbl, binary_predicate, prev, curr)) {
+            return rg_iter(&at);
+        }
+
+        prev = curr;
+    }
+}
+
+/**
+ *  @brief  Finds the first element that does not compare less than
+ *          (or, if upper, that compares greater than) valaddr
+ *
+ *  The range is halved O(log n) times; halving a contiguous range
+ *  is O(1), any other range is walked.
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  valaddr address of the element to search for
+ *  @param[in]  compare comparator the range is sorted by
+ *  @param[in]  upper   true for the upper bound, false for the lower bound
+ *
+ *  @return     iterator to the bound, or last if there is none
+ */
+static iterator alg_bound(iterator *first, iterator *last,
+                          const void *valaddr,
+                          int (*compare)(const void *, const void *),
+                          bool upper) {
+    struct range r;
+    size_t n = 0;
+
+    massert_ptr(valaddr);
+    massert_pfunc(compare);
+
+    rg_init(&r, first, last);
+    n = rg_distance(&r);
+
+    while (n > 0) {
+        size_t half = n / 2;
+        struct range mid = r;
+        bool right = false;
+
+        rg_advance(&mid, half);
+
+        if (upper) {
+            right = compare(valaddr, rg_peek(&mid)) >= 0 ? true : false;
+        } else {
+            right = compare(rg_peek(&mid), valaddr) < 0 ? true : false;
+        }
+
+        if (right) {
+            r = mid;
+            rg_next(&r);
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+
+    return rg_iter(&r);
+}
+
+/**
+ *  @brief  Finds the first smallest (or, if max, the first largest) element
+ *
+ *  @param[in]  first   iterator to the first element of the range
+ *  @param[in]  last    iterator to one past the end of the range
+ *  @param[in]  compare comparator of the range's elements
+ *  @param[in]  max     true for the largest element, false for the smallest
+ *
+ *  @return     iterator to the element, or last if the range is empty
+ */
+static iterator alg_extreme(iterator *first, iterator *last,
+                            int (*compare)(const void *, const void *),
+                            bool max) {
+    struct range r;
+    struct range best;
+    void *curr = NULL;
+    void *found = NULL;
+
+    massert_pfunc(compare);
+    rg_init(&r, first, last);
+
+    if ((found = rg_curr(&r)) == NULL) {
+        return rg_iter(&r);
+    }
+
+    if (r.kind == RANGE_CONTIGUOUS) {
+        char *p = r.curr + r.width;
+        char *b = r.curr;
+
+        if (max) {
+            for (; p < r.finish; p += r.width) {
+                if (compare(b, p) < 0) {
+                    b = p;
+                }
+            }
+        } else {
+            for (; p < r.finish; p += r.width) {
+                if (compare(p, b) < 0) {
+                    b = p;
+                }
+            }
+        }
+
+        r.curr = b;
+        return rg_iter(&r);
+    }
+
+    best = r;
+    rg_next(&r);
+
+    while ((curr = rg_curr(&r))) {
+        if (max ? compare(found, curr) < 0 : compare(curr, found) < 0) {
+            found = curr;
+            best = r;
+        }
+
+        rg_next(&r);
+    }
+
+    return rg_iter(&best);
+}
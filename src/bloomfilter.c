@@ -0,0 +1,452 @@
+/**
+ *  @file       bloomfilter.c
+ *  @brief      Source file for a blocked Bloom filter
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bloomfilter.h"
+
+/**
+ *  @def        BLOOMFILTER_WORDS
+ *  @brief      Number of 64-bit words in a block
+ */
+#define BLOOMFILTER_WORDS (BLOOMFILTER_BLOCK_BYTES / 8)
+
+/**
+ *  @def        BLOOMFILTER_HEADER
+ *  @brief      Size of the header of the serialized format:
+ *              magic, number of blocks, count -- 8 bytes each
+ */
+#define BLOOMFILTER_HEADER 24
+
+/**
+ *  @struct     bloomfilter
+ *  @brief      Represents a blocked Bloom filter
+ *
+ *  Note that struct bloomfilter is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct bloomfilter be created on the stack.
+ *  This is done to enforce encapsulation.
+ *
+ *  blocks is alloc, aligned up to BLOOMFILTER_BLOCK_BYTES.
+ *  An element with hash h goes to block ((h >> 32) * nblocks) >> 32,
+ *  and sets, in word i of it, bit (lo32(h) * bf_salt[i]) >> 26.
+ */
+struct bloomfilter {
+    struct typetable *ttbl;
+
+    size_t nblocks;
+    size_t count;
+
+    uint64_t *blocks;
+    void *alloc;
+};
+
+/**
+ *  Odd multipliers that derive the bit of every word from one hash
+ */
+static const uint32_t bf_salt[BLOOMFILTER_WORDS] = {
+    0x47b6137bUL, 0x44974d91UL, 0x8824ad5bUL, 0xa2b7289dUL,
+    0x705495c7UL, 0x2df1424bUL, 0x9efc4947UL, 0x5c6bfb31UL
+};
+
+static const char bf_magic[8] = { 'G', 'C', 'S', 'B', 'L', 'O', 'O', 'M' };
+
+static bloomfilter *bf_allocate(struct typetable *ttbl, size_t nblocks);
+static uint64_t bf_hash(bloomfilter *bf, const void *valaddr);
+static uint64_t *bf_block(bloomfilter *bf, uint64_t hash);
+static bool bf_test(const uint64_t *block, uint64_t hash);
+
+static void bf_store64(unsigned char *dest, uint64_t x);
+static uint64_t bf_load64(const unsigned char *src);
+
+/**
+ *  @brief  Allocates and initializes a new, empty bloomfilter
+ *
+ *  @param[in]  ttbl    typetable of the elements
+ *  @param[in]  n       expected number of elements
+ *  @param[in]  fpr     target false positive rate once n elements
+ *                      were added, in (0, 1)
+ *
+ *  @return     pointer to bloomfilter
+ */
+bloomfilter *bf_new(struct typetable *ttbl, size_t n, double fpr) {
+    double bits = 0.0;
+
+    assert(fpr > 0.0 && fpr < 1.0);
+
+    /**
+     *  An unblocked filter needs -ln(fpr) / ln(2)^2 bits per element;
+     *  confining every element to one block costs about a fifth more.
+     *  (Rates well above 1% come out somewhat higher than asked:
+     *  BLOOMFILTER_K bits per element is then more than optimal.)
+     */
+    bits = (double)(n) * -log(fpr) / (log(2.0) * log(2.0)) * 1.2;
+
+    return bf_allocate(ttbl, (size_t)(bits / (BLOOMFILTER_BLOCK_BYTES * 8)) + 1);
+}
+
+/**
+ *  @brief  Releases (*bf)
+ *
+ *  @param[out] bf  address of pointer to bloomfilter
+ */
+void bf_delete(bloomfilter **bf) {
+    assert(bf);
+    assert(*bf);
+
+    free((*bf)->alloc);
+    (*bf)->alloc = NULL;
+    (*bf)->blocks = NULL;
+
+    free(*bf);
+    *bf = NULL;
+}
+
+/**
+ *  @brief  Returns the number of elements added to bf
+ *
+ *  @param[in]  bf  pointer to bloomfilter
+ *
+ *  @return     number of bf_add calls since creation (or bf_clear)
+ */
+size_t bf_count(bloomfilter *bf) {
+    assert(bf);
+    return bf->count;
+}
+
+/**
+ *  @brief  Returns the size of bf's bit array
+ *
+ *  @param[in]  bf  pointer to bloomfilter
+ *
+ *  @return     size of the bit array, in bytes
+ */
+size_t bf_bytes(bloomfilter *bf) {
+    assert(bf);
+    return bf->nblocks * BLOOMFILTER_BLOCK_BYTES;
+}
+
+/**
+ *  @brief  Adds valaddr to bf
+ *
+ *  @param[in]  bf      pointer to bloomfilter
+ *  @param[in]  valaddr address of the element
+ */
+void bf_add(bloomfilter *bf, const void *valaddr) {
+    uint64_t hash = 0;
+    uint64_t *block = NULL;
+    uint32_t lo = 0;
+    int i = 0;
+
+    assert(bf);
+    assert(valaddr);
+
+    hash = bf_hash(bf, valaddr);
+    block = bf_block(bf, hash);
+    lo = (uint32_t)(hash);
+
+    for (i = 0; i < BLOOMFILTER_WORDS; i++) {
+        block[i] |= (uint64_t)(1) << ((uint32_t)(lo * bf_salt[i]) >> 26);
+    }
+
+    ++bf->count;
+}
+
+/**
+ *  @brief  Determines if valaddr may have been added to bf
+ *
+ *  @param[in]  bf      pointer to bloomfilter
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     false if valaddr was certainly not added,
+ *              true if it probably was
+ */
+bool bf_maybe_contains(bloomfilter *bf, const void *valaddr) {
+    uint64_t hash = 0;
+
+    assert(bf);
+    assert(valaddr);
+
+    hash = bf_hash(bf, valaddr);
+    return bf_test(bf_block(bf, hash), hash);
+}
+
+/**
+ *  Tests n elements at once: out[i] receives what bf_maybe_contains
+ *  would return for the i-th element.
+ *
+ *  Tests proceed in groups of BLOOMFILTER_FIND_GROUP: every element
+ *  of the group is hashed and its block prefetched before any block
+ *  is read, so that on filters larger than the cache,
+ *  the misses of the group overlap instead of serializing.
+ *
+ *  @param[in]  bf      pointer to bloomfilter
+ *  @param[in]  base    address of n contiguous elements,
+ *                      ttbl->width each
+ *  @param[in]  n       number of elements
+ *  @param[out] out     array of n bools to fill
+ *
+ *  @return     number of elements that may have been added
+ */
+size_t bf_maybe_contains_many(bloomfilter *bf, const void *base, size_t n,
+                              bool *out) {
+    uint64_t hash[BLOOMFILTER_FIND_GROUP];
+    uint64_t *block[BLOOMFILTER_FIND_GROUP];
+    size_t width = 0;
+    size_t found = 0;
+    size_t first = 0;
+
+    assert(bf);
+    assert(n == 0 || (base && out));
+
+    width = bf->ttbl->width;
+
+    for (first = 0; first < n; first += BLOOMFILTER_FIND_GROUP) {
+        size_t m = n - first < BLOOMFILTER_FIND_GROUP ? n - first : BLOOMFILTER_FIND_GROUP;
+        const char *elem = (const char *)(base) + first * width;
+        size_t i = 0;
+
+        for (i = 0; i < m; i++) {
+            hash[i] = bf_hash(bf, elem + i * width);
+            block[i] = bf_block(bf, hash[i]);
+            PREFETCH(block[i]);
+        }
+
+        for (i = 0; i < m; i++) {
+            out[first + i] = bf_test(block[i], hash[i]);
+            found += out[first + i] != false;
+        }
+    }
+
+    return found;
+}
+
+/**
+ *  @brief  Removes every element from bf
+ *
+ *  @param[in]  bf  pointer to bloomfilter
+ */
+void bf_clear(bloomfilter *bf) {
+    assert(bf);
+
+    memset(bf->blocks, 0, bf->nblocks * BLOOMFILTER_BLOCK_BYTES);
+    bf->count = 0;
+}
+
+/**
+ *  @brief  Writes bf to dest, in a portable byte format
+ *
+ *  @param[in]  bf      pointer to bloomfilter
+ *  @param[out] dest    buffer of len bytes (may be NULL if len is 0)
+ *  @param[in]  len     size of dest
+ *
+ *  @return     size of the serialized filter, in bytes --
+ *              nothing was written if that is greater than len
+ */
+size_t bf_serialize(bloomfilter *bf, void *dest, size_t len) {
+    unsigned char *out = (unsigned char *)(dest);
+    size_t words = 0;
+    size_t size = 0;
+    size_t i = 0;
+
+    assert(bf);
+
+    words = bf->nblocks * BLOOMFILTER_WORDS;
+    size = BLOOMFILTER_HEADER + words * 8;
+
+    if (len < size) {
+        return size;
+    }
+
+    memcpy(out, bf_magic, sizeof bf_magic);
+    bf_store64(out + 8, bf->nblocks);
+    bf_store64(out + 16, bf->count);
+
+    out += BLOOMFILTER_HEADER;
+
+    for (i = 0; i < words; i++) {
+        bf_store64(out + i * 8, bf->blocks[i]);
+    }
+
+    return size;
+}
+
+/**
+ *  @brief  Allocates a new bloomfilter from the output of bf_serialize
+ *
+ *  @param[in]  ttbl    typetable of the elements
+ *  @param[in]  src     serialized filter
+ *  @param[in]  len     size of src, in bytes
+ *
+ *  @return     pointer to bloomfilter, or NULL if src is not
+ *              a serialized bloomfilter of len bytes
+ */
+bloomfilter *bf_deserialize(struct typetable *ttbl, const void *src,
+                            size_t len) {
+    const unsigned char *in = (const unsigned char *)(src);
+    bloomfilter *bf = NULL;
+    uint64_t nblocks = 0;
+    size_t words = 0;
+    size_t i = 0;
+
+    if (src == NULL || len < BLOOMFILTER_HEADER
+        || memcmp(in, bf_magic, sizeof bf_magic) != 0) {
+        return NULL;
+    }
+
+    nblocks = bf_load64(in + 8);
+
+    if (nblocks == 0
+        || nblocks != (len - BLOOMFILTER_HEADER) / BLOOMFILTER_BLOCK_BYTES
+        || (len - BLOOMFILTER_HEADER) % BLOOMFILTER_BLOCK_BYTES != 0) {
+        return NULL;
+    }
+
+    bf = bf_allocate(ttbl, (size_t)(nblocks));
+    bf->count = (size_t)(bf_load64(in + 16));
+
+    in += BLOOMFILTER_HEADER;
+    words = bf->nblocks * BLOOMFILTER_WORDS;
+
+    for (i = 0; i < words; i++) {
+        bf->blocks[i] = bf_load64(in + i * 8);
+    }
+
+    return bf;
+}
+
+/**
+ *  @brief  Returns the typetable of bf's elements
+ *
+ *  @param[in]  bf  pointer to bloomfilter
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *bf_get_ttbl(bloomfilter *bf) {
+    assert(bf);
+    return bf->ttbl;
+}
+
+/**
+ *  @brief  Allocates a bloomfilter of nblocks zeroed blocks
+ */
+static bloomfilter *bf_allocate(struct typetable *ttbl, size_t nblocks) {
+    bloomfilter *bf = NULL;
+    size_t addr = 0;
+
+    bf = malloc(sizeof *bf);
+    massert_malloc(bf);
+
+    bf->ttbl = ttbl ? ttbl : _void_ptr_;
+    bf->nblocks = nblocks;
+    bf->count = 0;
+
+    bf->alloc = malloc(nblocks * BLOOMFILTER_BLOCK_BYTES + BLOOMFILTER_BLOCK_BYTES);
+    massert_malloc(bf->alloc);
+
+    addr = (size_t)(bf->alloc) + BLOOMFILTER_BLOCK_BYTES - 1;
+    bf->blocks = (uint64_t *)(addr - addr % BLOOMFILTER_BLOCK_BYTES);
+
+    memset(bf->blocks, 0, nblocks * BLOOMFILTER_BLOCK_BYTES);
+    return bf;
+}
+
+/**
+ *  @brief  Hashes valaddr with ttbl->hash, or else by its bytes,
+ *          into 64 bits
+ */
+static uint64_t bf_hash(bloomfilter *bf, const void *valaddr) {
+    uint64_t hash = 0;
+
+    if (bf->ttbl->hash) {
+        hash = bf->ttbl->hash(valaddr);
+    } else {
+        hash = hash_bytes(valaddr, bf->ttbl->width);
+    }
+
+    if (sizeof(size_t) < sizeof(uint64_t)) {
+        /**< a 32-bit hash: derive the upper half from the lower */
+        hash |= (uint64_t)((uint32_t)(hash) * 0x9e3779b1UL) << 16 << 16;
+    }
+
+    return hash;
+}
+
+/**
+ *  @brief  Returns the block of bf that an element with hash belongs to
+ */
+static uint64_t *bf_block(bloomfilter *bf, uint64_t hash) {
+    uint64_t i = ((hash >> 32) * (uint64_t)(bf->nblocks)) >> 32;
+    return bf->blocks + (size_t)(i) * BLOOMFILTER_WORDS;
+}
+
+/**
+ *  @brief  Determines if every bit of hash is set in block
+ */
+static bool bf_test(const uint64_t *block, uint64_t hash) {
+    uint32_t lo = (uint32_t)(hash);
+    uint64_t missing = 0;
+    int i = 0;
+
+    for (i = 0; i < BLOOMFILTER_WORDS; i++) {
+        missing |= ~block[i] & ((uint64_t)(1) << ((uint32_t)(lo * bf_salt[i]) >> 26));
+    }
+
+    return missing == 0 ? true : false;
+}
+
+/**
+ *  @brief  Stores x at dest, least significant byte first
+ */
+static void bf_store64(unsigned char *dest, uint64_t x) {
+    int i = 0;
+
+    for (i = 0; i < 8; i++) {
+        dest[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+/**
+ *  @brief  Loads a uint64_t from src, least significant byte first
+ */
+static uint64_t bf_load64(const unsigned char *src) {
+    uint64_t x = 0;
+    int i = 0;
+
+    for (i = 7; i >= 0; i--) {
+        x = (x << 8) | src[i];
+    }
+
+    return x;
+}
@@ -0,0 +1,1192 @@
+/**
+ *  @file       btree.c
+ *  @brief      Source file for a B-tree ordered container
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "btree.h"
+
+/**
+ *  @def        BTREE_SLAB_NODES
+ *  @brief      Number of nodes carved out of each slab allocation
+ */
+#define BTREE_SLAB_NODES 64
+
+/**
+ *  @def        BTREE_KEY_ALIGN
+ *  @brief      Alignment of the first element of a node
+ */
+#define BTREE_KEY_ALIGN 16
+
+typedef struct btnode btnode;
+
+/**
+ *  @struct     btnode
+ *  @brief      Header of a B-tree node
+ *
+ *  Every node is node_bytes long and starts at a multiple of node_bytes,
+ *  so the node that holds an element can be recovered from the element's
+ *  address alone (btn_of) -- this is what lets an iterator be nothing
+ *  more than the address of the current element.
+ *
+ *  The header is followed by room for max + 1 elements (one more than
+ *  a node may keep, so that a node can overflow before it is split),
+ *  and, in an inner node, by room for max + 2 child pointers.
+ */
+struct btnode {
+    btnode *parent;
+    unsigned short nkeys;
+    bool leaf;
+};
+
+/**
+ *  @struct     btslab
+ *  @brief      Header of a raw slab allocation, chained for release
+ */
+struct btslab {
+    struct btslab *next;
+};
+
+struct btree {
+    btnode *root;
+    size_t size;
+    struct typetable *ttbl;
+
+    size_t node_bytes;      /**< power of two -- nodes are aligned to it */
+    size_t leaf_max;        /**< most elements a leaf may keep */
+    size_t inner_max;       /**< most elements an inner node may keep */
+    size_t kids_offset;     /**< offset of an inner node's child array */
+
+    struct btpool {
+        char *cursor;       /**< next unused node in the current slab */
+        char *limit;        /**< end of the current slab */
+        btnode *free;       /**< released nodes, linked through parent */
+        struct btslab *slabs;
+    } pool;
+};
+
+/*<< btnode: layout */
+#define BTN_KEYS_OFFSET                                                        \
+    (((sizeof(struct btnode) + BTREE_KEY_ALIGN - 1) / BTREE_KEY_ALIGN) *       \
+     BTREE_KEY_ALIGN)
+
+#define btn_key(T, N, I)                                                       \
+    ((char *)(N) + BTN_KEYS_OFFSET + (size_t)(I) * (T)->ttbl->width)
+#define btn_kids(T, N) ((btnode **)((char *)(N) + (T)->kids_offset))
+#define btn_max(T, N) ((N)->leaf ? (T)->leaf_max : (T)->inner_max)
+#define btn_min(T, N) (btn_max(T, N) / 2)
+#define btn_of(T, ADDR)                                                        \
+    ((btnode *)((size_t)(ADDR) & ~((T)->node_bytes - 1)))
+
+/*<< btree: allocation, layout, and initialization */
+static btree *bt_allocate();
+static void bt_init(btree *t, struct typetable *ttbl);
+static void bt_deinit(btree *t);
+static bool bt_inner_fits(size_t bytes, size_t width, size_t max);
+
+/*<< btnode: node pool */
+static btnode *btp_alloc(btree *t, bool leaf);
+static void btp_free(btree *t, btnode *n);
+static void btp_release(btree *t);
+
+/*<< btnode: search within a node */
+static size_t btn_lower(btree *t, btnode *n, const void *valaddr);
+static size_t btn_upper(btree *t, btnode *n, const void *valaddr);
+static size_t btn_child_index(btree *t, btnode *p, btnode *c);
+
+/*<< btnode: element movement */
+static void btn_put(btree *t, btnode *n, size_t i, const void *valaddr);
+static void btn_open(btree *t, btnode *n, size_t i, size_t count);
+static void btn_close(btree *t, btnode *n, size_t i, size_t count);
+
+/*<< btnode: structural changes */
+static void btn_split(btree *t, btnode *n);
+static void btn_remove(btree *t, btnode *n, size_t i);
+static void btn_rebalance(btree *t, btnode *n);
+static void btn_merge(btree *t, btnode *p, size_t k);
+
+/*<< btnode: in-order navigation, by element address */
+static char *btn_first(btree *t, btnode *n);
+static char *btn_last(btree *t, btnode *n);
+static char *btn_next(btree *t, char *key);
+static char *btn_prev(btree *t, char *key);
+static char *btn_find(btree *t, const void *valaddr);
+static char *btn_lower_bound(btree *t, const void *valaddr);
+
+iterator bti_begin(void *arg);
+iterator bti_end(void *arg);
+
+iterator bti_next(iterator it);
+iterator bti_next_n(iterator it, int n);
+
+iterator bti_prev(iterator it);
+iterator bti_prev_n(iterator it, int n);
+
+iterator *bti_advance(iterator *it, int n);
+iterator *bti_incr(iterator *it);
+iterator *bti_decr(iterator *it);
+
+void *bti_curr(iterator it);
+void *bti_start(iterator it);
+void *bti_finish(iterator it);
+
+int bti_distance(iterator *first, iterator *last);
+
+bool bti_has_next(iterator it);
+bool bti_has_prev(iterator it);
+
+struct typetable *bti_get_ttbl(void *arg);
+
+static int bti_index(iterator it);
+
+struct iterator_table itbl_btree = {
+    bti_begin,
+    bti_end,
+    bti_next,
+    bti_next_n,
+    bti_prev,
+    bti_prev_n,
+    bti_advance,
+    bti_incr,
+    bti_decr,
+    bti_curr,
+    bti_start,
+    bti_finish,
+    bti_distance,
+    bti_has_next,
+    bti_has_prev,
+    bti_get_ttbl,
+    ITERATOR_BIDIRECTIONAL
+};
+
+struct iterator_table *_btree_iterator_ = &itbl_btree;
+
+/**
+ *  @brief  Allocates, constructs, and returns a pointer to btree
+ *
+ *  @param[in]  ttbl    pointer to struct typetable for
+ *                      width/copy/dtor/swap/compare/print
+ *
+ *  @return     pointer to btree
+ */
+btree *bt_new(struct typetable *ttbl) {
+    btree *t = bt_allocate();
+    bt_init(t, ttbl);
+    return t;
+}
+
+/**
+ *  @brief  Releases the elements and nodes of a btree, then the btree
+ *
+ *  @param[out] t   address of pointer to btree
+ */
+void bt_delete(btree **t) {
+    assert((*t));
+
+    bt_deinit((*t));
+
+    free((*t));
+    (*t) = NULL;
+}
+
+iterator bt_begin(btree *t) {
+    return bti_begin(t);
+}
+
+iterator bt_end(btree *t) {
+    return bti_end(t);
+}
+
+size_t bt_size(btree *t) {
+    assert(t);
+    return t->size;
+}
+
+/**
+ *  @brief  Returns the number of levels below the root
+ *
+ *  All leaves of a B-tree are on the same level, so this is
+ *  the length of any root-to-leaf path (-1 for an empty btree).
+ *
+ *  @param[in]  t   pointer to btree
+ *
+ *  @return     height of t
+ */
+int bt_height(btree *t) {
+    btnode *n = NULL;
+    int height = -1;
+
+    assert(t);
+
+    for (n = t->root; n; n = n->leaf ? NULL : btn_kids(t, n)[0]) {
+        ++height;
+    }
+
+    return height;
+}
+
+bool bt_empty(btree *t) {
+    assert(t);
+    return t->root == NULL;
+}
+
+void *bt_min(btree *t) {
+    assert(t);
+    return t->root ? btn_first(t, t->root) : NULL;
+}
+
+void *bt_max(btree *t) {
+    assert(t);
+    return t->root ? btn_last(t, t->root) : NULL;
+}
+
+void *bt_predecessor(btree *t, const void *valaddr) {
+    char *key = NULL;
+
+    assert(t);
+
+    key = btn_find(t, valaddr);
+    return key ? btn_prev(t, key) : NULL;
+}
+
+void *bt_successor(btree *t, const void *valaddr) {
+    char *key = NULL;
+
+    assert(t);
+
+    key = btn_find(t, valaddr);
+    return key ? btn_next(t, key) : NULL;
+}
+
+/**
+ *  @brief  Searches t for an element matching valaddr
+ *
+ *  @param[in]  t       pointer to btree
+ *  @param[in]  valaddr address of the key to find
+ *
+ *  @return     address of a matching element, or NULL if not found
+ */
+void *bt_find(btree *t, const void *valaddr) {
+    assert(t);
+    assert(valaddr);
+
+    return btn_find(t, valaddr);
+}
+
+/**
+ *  @brief  Inserts a copy of valaddr into t
+ *
+ *  Equal elements are kept, in insertion order.
+ *  The element is placed in a leaf; a leaf that overflows is split
+ *  in two, and its middle element moves up into the parent,
+ *  which may overflow and split in turn, up to the root.
+ *
+ *  @param[in]  t       pointer to btree
+ *  @param[in]  valaddr address of the element to insert
+ */
+void bt_insert(btree *t, const void *valaddr) {
+    btnode *n = NULL;
+
+    assert(t);
+    assert(valaddr);
+
+    if (t->root == NULL) {
+        t->root = btp_alloc(t, true);
+    }
+
+    /**< equal elements go to the right, after those already present */
+    for (n = t->root; n->leaf == false; n = btn_kids(t, n)[btn_upper(t, n, valaddr)]) {
+        ;
+    }
+
+    btn_put(t, n, btn_upper(t, n, valaddr), valaddr);
+    ++t->size;
+
+    btn_split(t, n);
+}
+
+/**
+ *  @brief  Inserts a copy of valaddr into t, iff no equal element exists
+ *
+ *  @param[in]  t       pointer to btree
+ *  @param[in]  valaddr address of the element to insert
+ */
+void bt_insert_unique(btree *t, const void *valaddr) {
+    btnode *n = NULL;
+    size_t i = 0;
+
+    assert(t);
+    assert(valaddr);
+
+    if (t->root == NULL) {
+        t->root = btp_alloc(t, true);
+    }
+
+    for (n = t->root;; n = btn_kids(t, n)[i]) {
+        i = btn_lower(t, n, valaddr);
+
+        if (i < n->nkeys && t->ttbl->compare(btn_key(t, n, i), valaddr) == 0) {
+            ERROR(__FILE__, "insert failed - no duplicate elements allowed.");
+            return;
+        }
+
+        if (n->leaf) {
+            break;
+        }
+    }
+
+    btn_put(t, n, i, valaddr);
+    ++t->size;
+
+    btn_split(t, n);
+}
+
+/**
+ *  @brief  Erases an element matching valaddr from t, if there is one
+ *
+ *  An element in an inner node is replaced by its in-order predecessor,
+ *  which always lives in a leaf; a node left with too few elements
+ *  borrows one from a sibling, or is merged with it.
+ *
+ *  @param[in]  t       pointer to btree
+ *  @param[in]  valaddr address of the key to erase
+ */
+void bt_erase(btree *t, const void *valaddr) {
+    char *key = NULL;
+    btnode *n = NULL;
+
+    assert(t);
+    assert(valaddr);
+
+    key = btn_find(t, valaddr);
+
+    if (key) {
+        n = btn_of(t, key);
+        btn_remove(t, n, (size_t)(key - btn_key(t, n, 0)) / t->ttbl->width);
+    }
+}
+
+void bt_erase_min(btree *t) {
+    btnode *n = NULL;
+
+    assert(t);
+
+    if (t->root) {
+        n = btn_of(t, btn_first(t, t->root));
+        btn_remove(t, n, 0);
+    }
+}
+
+void bt_erase_max(btree *t) {
+    btnode *n = NULL;
+
+    assert(t);
+
+    if (t->root) {
+        n = btn_of(t, btn_last(t, t->root));
+        btn_remove(t, n, n->nkeys - 1);
+    }
+}
+
+/**
+ *  @brief  Destroys all elements of t, and releases all of its nodes
+ *
+ *  @param[in]  t   pointer to btree
+ */
+void bt_clear(btree *t) {
+    char *key = NULL;
+
+    assert(t);
+
+    if (t->root && t->ttbl->dtor) {
+        for (key = btn_first(t, t->root); key; key = btn_next(t, key)) {
+            t->ttbl->dtor(key);
+        }
+    }
+
+    /**< every node lives in t's pool -- release the slabs wholesale */
+    btp_release(t);
+
+    t->root = NULL;
+    t->size = 0;
+}
+
+/**
+ *  @brief  Applies consumer to every element e in t such that lo <= e < hi
+ *
+ *  Elements are visited in order, starting from a single O(log n)
+ *  descent to lo; the walk ends early once consumer returns false.
+ *  consumer receives ctx and the address of the element
+ *  (the argument order of bt_for_each_chunk),
+ *  and must not insert or erase elements of t.
+ *
+ *  @param[in]  t           pointer to btree
+ *  @param[in]  lo          address of the inclusive lower bound, or NULL
+ *  @param[in]  hi          address of the exclusive upper bound, or NULL
+ *  @param[in]  consumer    function to apply to each element in range
+ *  @param[in]  ctx         caller state, passed through to consumer
+ *
+ *  @return     number of elements passed to consumer
+ */
+size_t bt_foreach_range(btree *t, const void *lo, const void *hi,
+                        bool (*consumer)(void *, void *), void *ctx) {
+    int (*compare)(const void *, const void *) = NULL;
+    char *key = NULL;
+    size_t visited = 0;
+
+    assert(t);
+    assert(consumer);
+
+    compare = t->ttbl->compare;
+
+    if (lo) {
+        key = btn_lower_bound(t, lo);
+    } else {
+        key = t->root ? btn_first(t, t->root) : NULL;
+    }
+
+    while (key && (hi == NULL || compare(key, hi) < 0)) {
+        ++visited;
+
+        if (consumer(ctx, key) == false) {
+            break;
+        }
+
+        key = btn_next(t, key);
+    }
+
+    return visited;
+}
+
+/**
+ *  Hands every element of t to visitor, in order,
+ *  as runs of elements that sit next to each other in a node.
+ *
+ *  visitor receives ctx, the address of the first element of a run,
+ *  and the number of elements in it. Leaves hold nearly all elements,
+ *  and each leaf is handed out whole (one run per leaf);
+ *  the separators kept in inner nodes come one at a time,
+ *  between the leaves on either side of them.
+ *
+ *  The walk ends early once visitor returns false.
+ *  visitor must not insert or erase elements of t.
+ *
+ *  @param[in]  t       pointer to btree
+ *  @param[in]  visitor function to apply to each run
+ *  @param[in]  ctx     caller state, passed through to visitor
+ *
+ *  @return     number of elements passed to visitor
+ */
+size_t bt_for_each_chunk(btree *t, bool (*visitor)(void *, void *, size_t),
+                         void *ctx) {
+    size_t width = 0;
+    char *key = NULL;
+    size_t visited = 0;
+
+    assert(t);
+    assert(visitor);
+
+    width = t->ttbl->width;
+    key = t->root ? btn_first(t, t->root) : NULL;
+
+    while (key) {
+        btnode *n = btn_of(t, key);
+        size_t count = 1;
+
+        if (n->leaf != false) {
+            count = n->nkeys - (size_t)(key - btn_key(t, n, 0)) / width;
+        }
+
+        visited += count;
+
+        if (visitor(ctx, key, count) == false) {
+            break;
+        }
+
+        key = btn_next(t, key + (count - 1) * width);
+    }
+
+    return visited;
+}
+
+struct typetable *bt_get_ttbl(btree *t) {
+    assert(t);
+    return t->ttbl;
+}
+
+static btree *bt_allocate() {
+    btree *t = NULL;
+    t = malloc(sizeof((*t)));
+    massert_malloc(t);
+    return t;
+}
+
+/**
+ *  @brief  Initializes t, and fixes the node layout for ttbl->width
+ *
+ *  Nodes start at BTREE_NODE_BYTES, and double in size
+ *  until an inner node can keep at least 3 elements
+ *  (so that a node split or merge always leaves at least 1).
+ *
+ *  @param[in]  t       pointer to btree
+ *  @param[in]  ttbl    pointer to struct typetable
+ */
+static void bt_init(btree *t, struct typetable *ttbl) {
+    size_t width = 0;
+    size_t bytes = BTREE_NODE_BYTES;
+    size_t max = 3;
+
+    assert(t);
+
+    t->root = NULL;
+    t->size = 0;
+    t->ttbl = ttbl ? ttbl : _void_ptr_;
+
+    width = t->ttbl->width;
+
+    while (bt_inner_fits(bytes, width, max) == false) {
+        bytes *= 2;
+    }
+
+    while (bt_inner_fits(bytes, width, max + 1)) {
+        ++max;
+    }
+
+    t->node_bytes = bytes;
+
+    /**< a leaf has room for leaf_max + 1 elements */
+    t->leaf_max = (bytes - BTN_KEYS_OFFSET) / width - 1;
+    t->inner_max = max;
+
+    t->kids_offset = BTN_KEYS_OFFSET + (max + 1) * width;
+    t->kids_offset = ((t->kids_offset + sizeof(btnode *) - 1) /
+                      sizeof(btnode *)) * sizeof(btnode *);
+
+    t->pool.cursor = NULL;
+    t->pool.limit = NULL;
+    t->pool.free = NULL;
+    t->pool.slabs = NULL;
+}
+
+static void bt_deinit(btree *t) {
+    assert(t);
+    bt_clear(t);
+}
+
+static bool bt_inner_fits(size_t bytes, size_t width, size_t max) {
+    /**< room for max + 1 elements, then max + 2 aligned child pointers */
+    size_t kids = BTN_KEYS_OFFSET + (max + 1) * width;
+    kids = ((kids + sizeof(btnode *) - 1) / sizeof(btnode *)) * sizeof(btnode *);
+
+    return kids + (max + 2) * sizeof(btnode *) <= bytes;
+}
+
+static btnode *btp_alloc(btree *t, bool leaf) {
+    btnode *n = NULL;
+
+    if (t->pool.free) {
+        n = t->pool.free;
+        t->pool.free = n->parent;
+    } else {
+        if (t->pool.cursor == t->pool.limit) {
+            /**< one spare node's worth of bytes, to align the first node */
+            struct btslab *slab = NULL;
+            size_t start = 0;
+
+            slab = malloc(sizeof *slab + (BTREE_SLAB_NODES + 1) * t->node_bytes);
+            massert_malloc(slab);
+
+            slab->next = t->pool.slabs;
+            t->pool.slabs = slab;
+
+            start = (size_t)(slab + 1);
+            start = (start + t->node_bytes - 1) & ~(t->node_bytes - 1);
+
+            t->pool.cursor = (char *)(start);
+            t->pool.limit = t->pool.cursor + BTREE_SLAB_NODES * t->node_bytes;
+        }
+
+        n = (btnode *)(t->pool.cursor);
+        t->pool.cursor += t->node_bytes;
+    }
+
+    n->parent = NULL;
+    n->nkeys = 0;
+    n->leaf = leaf;
+
+    return n;
+}
+
+static void btp_free(btree *t, btnode *n) {
+    n->parent = t->pool.free;
+    t->pool.free = n;
+}
+
+static void btp_release(btree *t) {
+    struct btslab *slab = t->pool.slabs;
+
+    while (slab) {
+        struct btslab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    t->pool.cursor = NULL;
+    t->pool.limit = NULL;
+    t->pool.free = NULL;
+    t->pool.slabs = NULL;
+}
+
+static size_t btn_lower(btree *t, btnode *n, const void *valaddr) {
+    int (*compare)(const void *, const void *) = t->ttbl->compare;
+    size_t width = t->ttbl->width;
+    char *keys = btn_key(t, n, 0);
+    size_t base = 0;
+    size_t len = n->nkeys;
+
+    /**
+     *  Index of the first element not less than valaddr.
+     *  The interval shrinks by the same amount either way, so the
+     *  comparison result selects base (a conditional move) rather than
+     *  a branch -- there is nothing for the branch predictor to miss.
+     */
+    while (len > 1) {
+        size_t half = len / 2;
+        base += compare(keys + (base + half - 1) * width, valaddr) < 0 ? half : 0;
+        len -= half;
+    }
+
+    return base + (len == 1 && compare(keys + base * width, valaddr) < 0);
+}
+
+static size_t btn_upper(btree *t, btnode *n, const void *valaddr) {
+    int (*compare)(const void *, const void *) = t->ttbl->compare;
+    size_t width = t->ttbl->width;
+    char *keys = btn_key(t, n, 0);
+    size_t base = 0;
+    size_t len = n->nkeys;
+
+    /**< index of the first element greater than valaddr; as btn_lower */
+    while (len > 1) {
+        size_t half = len / 2;
+        base += compare(keys + (base + half - 1) * width, valaddr) <= 0 ? half : 0;
+        len -= half;
+    }
+
+    return base + (len == 1 && compare(keys + base * width, valaddr) <= 0);
+}
+
+static size_t btn_child_index(btree *t, btnode *p, btnode *c) {
+    btnode **kids = btn_kids(t, p);
+    size_t i = 0;
+
+    /**< scanning the parent's child array touches only the parent */
+    while (kids[i] != c) {
+        ++i;
+    }
+
+    return i;
+}
+
+static void btn_put(btree *t, btnode *n, size_t i, const void *valaddr) {
+    btn_open(t, n, i, 1);
+
+    if (t->ttbl->copy) {
+        t->ttbl->copy(btn_key(t, n, i), valaddr);
+    } else {
+        memcpy(btn_key(t, n, i), valaddr, t->ttbl->width);
+    }
+}
+
+static void btn_open(btree *t, btnode *n, size_t i, size_t count) {
+    /**< make room for count elements at i */
+    memmove(btn_key(t, n, i + count), btn_key(t, n, i),
+            (n->nkeys - i) * t->ttbl->width);
+    n->nkeys += count;
+}
+
+static void btn_close(btree *t, btnode *n, size_t i, size_t count) {
+    /**< drop count elements at i */
+    memmove(btn_key(t, n, i), btn_key(t, n, i + count),
+            (n->nkeys - i - count) * t->ttbl->width);
+    n->nkeys -= count;
+}
+
+static void btn_split(btree *t, btnode *n) {
+    size_t width = t->ttbl->width;
+
+    while (n->nkeys > btn_max(t, n)) {
+        btnode *p = n->parent;
+        btnode *right = NULL;
+        size_t mid = n->nkeys / 2;
+        size_t moved = n->nkeys - mid - 1;
+        size_t i = 0;
+
+        /**< elements after the middle one move to a new right sibling */
+        right = btp_alloc(t, n->leaf);
+        memcpy(btn_key(t, right, 0), btn_key(t, n, mid + 1), moved * width);
+        right->nkeys = moved;
+
+        if (n->leaf == false) {
+            memcpy(btn_kids(t, right), btn_kids(t, n) + mid + 1,
+                   (moved + 1) * sizeof(btnode *));
+
+            for (i = 0; i <= moved; i++) {
+                btn_kids(t, right)[i]->parent = right;
+            }
+        }
+
+        n->nkeys = mid;
+
+        if (p == NULL) {
+            /**< the root split -- the tree grows a level */
+            p = btp_alloc(t, false);
+            btn_kids(t, p)[0] = n;
+            n->parent = p;
+            t->root = p;
+        }
+
+        /**< the middle element moves up, between n and right */
+        i = btn_child_index(t, p, n);
+
+        btn_open(t, p, i, 1);
+        memcpy(btn_key(t, p, i), btn_key(t, n, mid), width);
+
+        memmove(btn_kids(t, p) + i + 2, btn_kids(t, p) + i + 1,
+                (p->nkeys - 1 - i) * sizeof(btnode *));
+        btn_kids(t, p)[i + 1] = right;
+        right->parent = p;
+
+        n = p;
+    }
+}
+
+static void btn_remove(btree *t, btnode *n, size_t i) {
+    if (t->ttbl->dtor) {
+        t->ttbl->dtor(btn_key(t, n, i));
+    }
+
+    if (n->leaf == false) {
+        /**< fill the hole with the in-order predecessor, from a leaf */
+        char *pred = btn_last(t, btn_kids(t, n)[i]);
+
+        memcpy(btn_key(t, n, i), pred, t->ttbl->width);
+
+        n = btn_of(t, pred);
+        i = n->nkeys - 1;
+    }
+
+    btn_close(t, n, i, 1);
+    --t->size;
+
+    btn_rebalance(t, n);
+}
+
+static void btn_rebalance(btree *t, btnode *n) {
+    size_t width = t->ttbl->width;
+
+    while (n != t->root && n->nkeys < btn_min(t, n)) {
+        btnode *p = n->parent;
+        btnode *left = NULL;
+        btnode *right = NULL;
+        size_t j = btn_child_index(t, p, n);
+
+        left = j > 0 ? btn_kids(t, p)[j - 1] : NULL;
+        right = j < p->nkeys ? btn_kids(t, p)[j + 1] : NULL;
+
+        if (left && left->nkeys > btn_min(t, left)) {
+            /**< rotate right: left's last -> separator -> n's first */
+            btn_open(t, n, 0, 1);
+            memcpy(btn_key(t, n, 0), btn_key(t, p, j - 1), width);
+            memcpy(btn_key(t, p, j - 1), btn_key(t, left, left->nkeys - 1), width);
+
+            if (n->leaf == false) {
+                memmove(btn_kids(t, n) + 1, btn_kids(t, n),
+                        n->nkeys * sizeof(btnode *));
+                btn_kids(t, n)[0] = btn_kids(t, left)[left->nkeys];
+                btn_kids(t, n)[0]->parent = n;
+            }
+
+            --left->nkeys;
+            return;
+        }
+
+        if (right && right->nkeys > btn_min(t, right)) {
+            /**< rotate left: right's first -> separator -> n's last */
+            memcpy(btn_key(t, n, n->nkeys), btn_key(t, p, j), width);
+            ++n->nkeys;
+            memcpy(btn_key(t, p, j), btn_key(t, right, 0), width);
+
+            if (n->leaf == false) {
+                btn_kids(t, n)[n->nkeys] = btn_kids(t, right)[0];
+                btn_kids(t, n)[n->nkeys]->parent = n;
+                memmove(btn_kids(t, right), btn_kids(t, right) + 1,
+                        right->nkeys * sizeof(btnode *));
+            }
+
+            btn_close(t, right, 0, 1);
+            return;
+        }
+
+        /**< neither sibling can spare one -- merge, then fix up p */
+        btn_merge(t, p, left ? j - 1 : j);
+        n = p;
+    }
+
+    if (t->root->nkeys == 0) {
+        /**< the root emptied -- the tree loses a level */
+        btnode *root = t->root;
+
+        t->root = root->leaf ? NULL : btn_kids(t, root)[0];
+
+        if (t->root) {
+            t->root->parent = NULL;
+        }
+
+        btp_free(t, root);
+    }
+}
+
+static void btn_merge(btree *t, btnode *p, size_t k) {
+    size_t width = t->ttbl->width;
+    btnode *a = btn_kids(t, p)[k];
+    btnode *b = btn_kids(t, p)[k + 1];
+    size_t i = 0;
+
+    /**< a, separator k, and b become a single node */
+    memcpy(btn_key(t, a, a->nkeys), btn_key(t, p, k), width);
+    memcpy(btn_key(t, a, a->nkeys + 1), btn_key(t, b, 0), b->nkeys * width);
+
+    if (a->leaf == false) {
+        memcpy(btn_kids(t, a) + a->nkeys + 1, btn_kids(t, b),
+               (b->nkeys + 1) * sizeof(btnode *));
+
+        for (i = 0; i <= b->nkeys; i++) {
+            btn_kids(t, b)[i]->parent = a;
+        }
+    }
+
+    a->nkeys += 1 + b->nkeys;
+
+    btn_close(t, p, k, 1);
+    memmove(btn_kids(t, p) + k + 1, btn_kids(t, p) + k + 2,
+            (p->nkeys - k) * sizeof(btnode *));
+
+    btp_free(t, b);
+}
+
+static char *btn_first(btree *t, btnode *n) {
+    while (n->leaf == false) {
+        n = btn_kids(t, n)[0];
+    }
+
+    return btn_key(t, n, 0);
+}
+
+static char *btn_last(btree *t, btnode *n) {
+    while (n->leaf == false) {
+        n = btn_kids(t, n)[n->nkeys];
+    }
+
+    return btn_key(t, n, n->nkeys - 1);
+}
+
+static char *btn_next(btree *t, char *key) {
+    btnode *n = btn_of(t, key);
+    size_t i = (size_t)(key - btn_key(t, n, 0)) / t->ttbl->width;
+
+    if (n->leaf == false) {
+        return btn_first(t, btn_kids(t, n)[i + 1]);
+    }
+
+    if (i + 1 < n->nkeys) {
+        return btn_key(t, n, i + 1);
+    }
+
+    /**< climb until n is not the last child; that separator is next */
+    while (n->parent) {
+        btnode *p = n->parent;
+        size_t j = btn_child_index(t, p, n);
+
+        if (j < p->nkeys) {
+            return btn_key(t, p, j);
+        }
+
+        n = p;
+    }
+
+    return NULL;
+}
+
+static char *btn_prev(btree *t, char *key) {
+    btnode *n = btn_of(t, key);
+    size_t i = (size_t)(key - btn_key(t, n, 0)) / t->ttbl->width;
+
+    if (n->leaf == false) {
+        return btn_last(t, btn_kids(t, n)[i]);
+    }
+
+    if (i > 0) {
+        return btn_key(t, n, i - 1);
+    }
+
+    /**< climb until n is not the first child; that separator is prev */
+    while (n->parent) {
+        btnode *p = n->parent;
+        size_t j = btn_child_index(t, p, n);
+
+        if (j > 0) {
+            return btn_key(t, p, j - 1);
+        }
+
+        n = p;
+    }
+
+    return NULL;
+}
+
+static char *btn_find(btree *t, const void *valaddr) {
+    btnode *n = t->root;
+
+    while (n) {
+        size_t i = btn_lower(t, n, valaddr);
+
+        if (i < n->nkeys && t->ttbl->compare(btn_key(t, n, i), valaddr) == 0) {
+            return btn_key(t, n, i);
+        }
+
+        n = n->leaf ? NULL : btn_kids(t, n)[i];
+    }
+
+    return NULL;
+}
+
+static char *btn_lower_bound(btree *t, const void *valaddr) {
+    btnode *n = t->root;
+    char *bound = NULL;
+
+    /**< the deepest candidate seen on the way down is the smallest */
+    while (n) {
+        size_t i = btn_lower(t, n, valaddr);
+
+        if (i < n->nkeys) {
+            bound = btn_key(t, n, i);
+        }
+
+        n = n->leaf ? NULL : btn_kids(t, n)[i];
+    }
+
+    return bound;
+}
+
+/**
+ *  btree iterators store the address of the current element in it.curr;
+ *  NULL denotes the position one past the maximum (end).
+ *
+ *  Stepping is amortized O(1). There are no subtree counts, so
+ *  distance and advance walk element by element -- O(n).
+ *
+ *  Iterators are invalidated by insert/erase.
+ */
+iterator bti_begin(void *arg) {
+    btree *t = (btree *)(arg);
+    iterator it;
+
+    assert(t);
+
+    it.itbl = _btree_iterator_;
+    it.container = t;
+    it.curr = t->root ? btn_first(t, t->root) : NULL;
+
+    return it;
+}
+
+iterator bti_end(void *arg) {
+    btree *t = (btree *)(arg);
+    iterator it;
+
+    assert(t);
+
+    it.itbl = _btree_iterator_;
+    it.container = t;
+    it.curr = NULL;
+
+    return it;
+}
+
+iterator bti_next(iterator it) {
+    iterator iter = it;
+    bti_incr(&iter);
+    return iter;
+}
+
+iterator bti_next_n(iterator it, int n) {
+    iterator iter = it;
+    bti_advance(&iter, n);
+    return iter;
+}
+
+iterator bti_prev(iterator it) {
+    iterator iter = it;
+    bti_decr(&iter);
+    return iter;
+}
+
+iterator bti_prev_n(iterator it, int n) {
+    iterator iter = it;
+    bti_advance(&iter, -n);
+    return iter;
+}
+
+iterator *bti_advance(iterator *it, int n) {
+    btree *t = NULL;
+    int pos = 0;
+
+    massert_iterator(it);
+
+    t = it->container;
+    pos = bti_index(*it);
+
+    if (pos + n < 0 || (size_t)(pos + n) > t->size) {
+        char str[256];
+        sprintf(str, "Cannot advance %d times from position %d.", n, pos);
+        ERROR(__FILE__, str);
+    } else {
+        for (; n > 0; n--) {
+            bti_incr(it);
+        }
+
+        for (; n < 0; n++) {
+            bti_decr(it);
+        }
+    }
+
+    return it;
+}
+
+iterator *bti_incr(iterator *it) {
+    massert_iterator(it);
+
+    if (it->curr == NULL) {
+        ERROR(__FILE__, "Cannot increment - already at end.");
+    } else {
+        it->curr = btn_next(it->container, it->curr);
+    }
+
+    return it;
+}
+
+iterator *bti_decr(iterator *it) {
+    btree *t = NULL;
+    char *key = NULL;
+
+    massert_iterator(it);
+
+    t = it->container;
+
+    if (it->curr) {
+        key = btn_prev(t, it->curr);
+    } else {
+        key = t->root ? btn_last(t, t->root) : NULL;
+    }
+
+    if (key == NULL) {
+        ERROR(__FILE__, "Cannot decrement this iterator, already at begin.");
+    } else {
+        it->curr = key;
+    }
+
+    return it;
+}
+
+void *bti_curr(iterator it) {
+    return it.curr;
+}
+
+void *bti_start(iterator it) {
+    btree *t = it.container;
+    return t->root ? btn_first(t, t->root) : NULL;
+}
+
+void *bti_finish(iterator it) {
+    /**< end has no element; bti_curr yields NULL there, as does finish */
+    (void)it;
+    return NULL;
+}
+
+int bti_distance(iterator *first, iterator *last) {
+    if (first == NULL && last != NULL) {
+        return bti_index(*last);
+    } else if (last == NULL && first != NULL) {
+        return bti_index(*first);
+    } else if (first == NULL && last == NULL) {
+        ERROR(__FILE__, "Both iterator first and last are NULL.");
+        return 0;
+    } else {
+        return bti_index(*last) - bti_index(*first);
+    }
+}
+
+bool bti_has_next(iterator it) {
+    return it.curr != NULL;
+}
+
+bool bti_has_prev(iterator it) {
+    btree *t = it.container;
+
+    if (it.curr == NULL) {
+        return t->root != NULL;
+    }
+
+    return btn_prev(t, it.curr) != NULL;
+}
+
+struct typetable *bti_get_ttbl(void *arg) {
+    btree *t = (btree *)(arg);
+    return t->ttbl;
+}
+
+static int bti_index(iterator it) {
+    btree *t = it.container;
+    char *key = NULL;
+    int index = 0;
+
+    if (it.curr == NULL) {
+        return (int)(t->size);
+    }
+
+    for (key = btn_first(t, t->root); key != it.curr; key = btn_next(t, key)) {
+        ++index;
+    }
+
+    return index;
+}
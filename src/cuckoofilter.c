@@ -0,0 +1,641 @@
+/**
+ *  @file       cuckoofilter.c
+ *  @brief      Source file for a cuckoo filter
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cuckoofilter.h"
+
+/**
+ *  @def        CUCKOOFILTER_MAX_KICKS
+ *  @brief      Number of fingerprints cf_add relocates, at most,
+ *              before it gives up and keeps the last one aside
+ */
+#define CUCKOOFILTER_MAX_KICKS 500
+
+/**
+ *  @def        CUCKOOFILTER_HEADER
+ *  @brief      Size of the header of the serialized format: magic,
+ *              number of buckets, count, victim index, victim -- 8 bytes each
+ */
+#define CUCKOOFILTER_HEADER 40
+
+/**
+ *  @def        CUCKOOFILTER_LANES
+ *  @brief      Returns a bucket with every 16-bit slot set to X
+ */
+#define CUCKOOFILTER_LANES(X) ((uint64_t)(X) * ((uint64_t)(0x00010001UL) << 32 | 0x00010001UL))
+
+/**
+ *  @struct     cuckoofilter
+ *  @brief      Represents a cuckoo filter
+ *
+ *  Note that struct cuckoofilter is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct cuckoofilter be created on the stack.
+ *  This is done to enforce encapsulation.
+ *
+ *  Bucket i is buckets[i]; its slot j is bits [16j, 16j + 16) of it,
+ *  0 if empty. nbuckets is a power of two. An element with hash h
+ *  has fingerprint h >> 48 (or 1, if that is 0), and buckets
+ *  h & (nbuckets - 1) and cf_alt of that -- cf_alt is its own inverse,
+ *  so a fingerprint can be moved between its buckets knowing only one.
+ *
+ *  If victim is nonzero, it is a fingerprint that belongs in bucket
+ *  victim_index (or its alternate), and found no room in either.
+ */
+struct cuckoofilter {
+    struct typetable *ttbl;
+
+    size_t nbuckets;
+    size_t count;
+
+    uint64_t *buckets;
+
+    size_t victim_index;
+    unsigned victim;
+
+    uint32_t rng;
+};
+
+static const char cf_magic[8] = { 'G', 'C', 'S', 'C', 'U', 'C', 'K', 'O' };
+
+static cuckoofilter *cf_allocate(struct typetable *ttbl, size_t nbuckets);
+static uint64_t cf_hash(cuckoofilter *cf, const void *valaddr);
+static unsigned cf_fingerprint(uint64_t hash);
+static size_t cf_alt(cuckoofilter *cf, size_t i, unsigned fp);
+static uint32_t cf_random(cuckoofilter *cf);
+
+static bool cf_bucket_has(uint64_t bucket, unsigned fp);
+static bool cf_bucket_put(cuckoofilter *cf, size_t i, unsigned fp);
+static bool cf_bucket_take(cuckoofilter *cf, size_t i, unsigned fp);
+static bool cf_test(cuckoofilter *cf, uint64_t hash);
+static void cf_place(cuckoofilter *cf, size_t i, unsigned fp);
+
+static void cf_store64(unsigned char *dest, uint64_t x);
+static uint64_t cf_load64(const unsigned char *src);
+
+/**
+ *  @brief  Allocates and initializes a new, empty cuckoofilter
+ *
+ *  @param[in]  ttbl    typetable of the elements
+ *  @param[in]  n       expected number of elements
+ *
+ *  @return     pointer to cuckoofilter
+ */
+cuckoofilter *cf_new(struct typetable *ttbl, size_t n) {
+    size_t nbuckets = 1;
+
+    /**< room for n elements at 95% of the slots */
+    while (nbuckets * CUCKOOFILTER_SLOTS / 20 * 19 < n) {
+        nbuckets *= 2;
+    }
+
+    return cf_allocate(ttbl, nbuckets);
+}
+
+/**
+ *  @brief  Releases (*cf)
+ *
+ *  @param[out] cf  address of pointer to cuckoofilter
+ */
+void cf_delete(cuckoofilter **cf) {
+    assert(cf);
+    assert(*cf);
+
+    free((*cf)->buckets);
+    (*cf)->buckets = NULL;
+
+    free(*cf);
+    *cf = NULL;
+}
+
+/**
+ *  @brief  Returns the number of elements in cf
+ *
+ *  @param[in]  cf  pointer to cuckoofilter
+ *
+ *  @return     number of elements added and not removed
+ */
+size_t cf_count(cuckoofilter *cf) {
+    assert(cf);
+    return cf->count;
+}
+
+/**
+ *  @brief  Returns the number of slots in cf
+ *
+ *  @param[in]  cf  pointer to cuckoofilter
+ *
+ *  @return     number of fingerprint slots
+ */
+size_t cf_capacity(cuckoofilter *cf) {
+    assert(cf);
+    return cf->nbuckets * CUCKOOFILTER_SLOTS;
+}
+
+/**
+ *  @brief  Returns the size of cf's buckets
+ *
+ *  @param[in]  cf  pointer to cuckoofilter
+ *
+ *  @return     size of the buckets, in bytes
+ */
+size_t cf_bytes(cuckoofilter *cf) {
+    assert(cf);
+    return cf->nbuckets * sizeof *cf->buckets;
+}
+
+/**
+ *  @brief  Adds valaddr to cf
+ *
+ *  @param[in]  cf      pointer to cuckoofilter
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     true if valaddr was added,
+ *              false if cf was already full
+ */
+bool cf_add(cuckoofilter *cf, const void *valaddr) {
+    uint64_t hash = 0;
+    unsigned fp = 0;
+    size_t i = 0;
+
+    assert(cf);
+    assert(valaddr);
+
+    if (cf->victim) {
+        return false;
+    }
+
+    hash = cf_hash(cf, valaddr);
+    fp = cf_fingerprint(hash);
+    i = (size_t)(hash) & (cf->nbuckets - 1);
+
+    ++cf->count;
+    cf_place(cf, i, fp);
+
+    return true;
+}
+
+/**
+ *  @brief  Removes valaddr from cf -- valaddr must have been added
+ *
+ *  @param[in]  cf      pointer to cuckoofilter
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     true if a fingerprint of valaddr was removed,
+ *              false if there was none
+ */
+bool cf_remove(cuckoofilter *cf, const void *valaddr) {
+    uint64_t hash = 0;
+    unsigned fp = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+    assert(cf);
+    assert(valaddr);
+
+    hash = cf_hash(cf, valaddr);
+    fp = cf_fingerprint(hash);
+    i = (size_t)(hash) & (cf->nbuckets - 1);
+    j = cf_alt(cf, i, fp);
+
+    if (cf_bucket_take(cf, i, fp) || cf_bucket_take(cf, j, fp)) {
+        --cf->count;
+
+        /**
+         *  there is room now: put the victim back, if there is one --
+         *  the free slot need not be in one of its buckets, so this may
+         *  relocate fingerprints, and leave another one aside
+         */
+        if (cf->victim) {
+            unsigned victim = cf->victim;
+
+            cf->victim = 0;
+            cf_place(cf, cf->victim_index, victim);
+        }
+
+        return true;
+    }
+
+    if (cf->victim == fp && (cf->victim_index == i || cf->victim_index == j)) {
+        cf->victim = 0;
+        --cf->count;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ *  @brief  Determines if valaddr may be in cf
+ *
+ *  @param[in]  cf      pointer to cuckoofilter
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     false if valaddr is certainly not in cf,
+ *              true if it probably is
+ */
+bool cf_maybe_contains(cuckoofilter *cf, const void *valaddr) {
+    assert(cf);
+    assert(valaddr);
+
+    return cf_test(cf, cf_hash(cf, valaddr));
+}
+
+/**
+ *  Tests n elements at once: out[i] receives what cf_maybe_contains
+ *  would return for the i-th element.
+ *
+ *  Tests proceed in groups of CUCKOOFILTER_FIND_GROUP: both buckets
+ *  of every element of the group are prefetched before any is read.
+ *
+ *  @param[in]  cf      pointer to cuckoofilter
+ *  @param[in]  base    address of n contiguous elements,
+ *                      ttbl->width each
+ *  @param[in]  n       number of elements
+ *  @param[out] out     array of n bools to fill
+ *
+ *  @return     number of elements that may be in cf
+ */
+size_t cf_maybe_contains_many(cuckoofilter *cf, const void *base, size_t n,
+                              bool *out) {
+    uint64_t hash[CUCKOOFILTER_FIND_GROUP];
+    size_t width = 0;
+    size_t found = 0;
+    size_t first = 0;
+
+    assert(cf);
+    assert(n == 0 || (base && out));
+
+    width = cf->ttbl->width;
+
+    for (first = 0; first < n; first += CUCKOOFILTER_FIND_GROUP) {
+        size_t m = n - first < CUCKOOFILTER_FIND_GROUP ? n - first : CUCKOOFILTER_FIND_GROUP;
+        const char *elem = (const char *)(base) + first * width;
+        size_t i = 0;
+
+        for (i = 0; i < m; i++) {
+            size_t k = 0;
+
+            hash[i] = cf_hash(cf, elem + i * width);
+            k = (size_t)(hash[i]) & (cf->nbuckets - 1);
+
+            PREFETCH(cf->buckets + k);
+            PREFETCH(cf->buckets + cf_alt(cf, k, cf_fingerprint(hash[i])));
+        }
+
+        for (i = 0; i < m; i++) {
+            out[first + i] = cf_test(cf, hash[i]);
+            found += out[first + i] != false;
+        }
+    }
+
+    return found;
+}
+
+/**
+ *  @brief  Removes every element from cf
+ *
+ *  @param[in]  cf  pointer to cuckoofilter
+ */
+void cf_clear(cuckoofilter *cf) {
+    assert(cf);
+
+    memset(cf->buckets, 0, cf->nbuckets * sizeof *cf->buckets);
+
+    cf->count = 0;
+    cf->victim = 0;
+    cf->victim_index = 0;
+}
+
+/**
+ *  @brief  Writes cf to dest, in a portable byte format
+ *
+ *  @param[in]  cf      pointer to cuckoofilter
+ *  @param[out] dest    buffer of len bytes (may be NULL if len is 0)
+ *  @param[in]  len     size of dest
+ *
+ *  @return     size of the serialized filter, in bytes --
+ *              nothing was written if that is greater than len
+ */
+size_t cf_serialize(cuckoofilter *cf, void *dest, size_t len) {
+    unsigned char *out = (unsigned char *)(dest);
+    size_t size = 0;
+    size_t i = 0;
+
+    assert(cf);
+
+    size = CUCKOOFILTER_HEADER + cf->nbuckets * 8;
+
+    if (len < size) {
+        return size;
+    }
+
+    memcpy(out, cf_magic, sizeof cf_magic);
+    cf_store64(out + 8, cf->nbuckets);
+    cf_store64(out + 16, cf->count);
+    cf_store64(out + 24, cf->victim_index);
+    cf_store64(out + 32, cf->victim);
+
+    out += CUCKOOFILTER_HEADER;
+
+    for (i = 0; i < cf->nbuckets; i++) {
+        cf_store64(out + i * 8, cf->buckets[i]);
+    }
+
+    return size;
+}
+
+/**
+ *  @brief  Allocates a new cuckoofilter from the output of cf_serialize
+ *
+ *  @param[in]  ttbl    typetable of the elements
+ *  @param[in]  src     serialized filter
+ *  @param[in]  len     size of src, in bytes
+ *
+ *  @return     pointer to cuckoofilter, or NULL if src is not
+ *              a serialized cuckoofilter of len bytes
+ */
+cuckoofilter *cf_deserialize(struct typetable *ttbl, const void *src,
+                             size_t len) {
+    const unsigned char *in = (const unsigned char *)(src);
+    cuckoofilter *cf = NULL;
+    uint64_t nbuckets = 0;
+    uint64_t victim_index = 0;
+    uint64_t victim = 0;
+    size_t i = 0;
+
+    if (src == NULL || len < CUCKOOFILTER_HEADER
+        || memcmp(in, cf_magic, sizeof cf_magic) != 0) {
+        return NULL;
+    }
+
+    nbuckets = cf_load64(in + 8);
+    victim_index = cf_load64(in + 24);
+    victim = cf_load64(in + 32);
+
+    if (nbuckets == 0 || (nbuckets & (nbuckets - 1)) != 0
+        || nbuckets != (len - CUCKOOFILTER_HEADER) / 8
+        || (len - CUCKOOFILTER_HEADER) % 8 != 0
+        || victim_index >= nbuckets || victim > 0xFFFF) {
+        return NULL;
+    }
+
+    cf = cf_allocate(ttbl, (size_t)(nbuckets));
+
+    cf->count = (size_t)(cf_load64(in + 16));
+    cf->victim_index = (size_t)(victim_index);
+    cf->victim = (unsigned)(victim);
+
+    in += CUCKOOFILTER_HEADER;
+
+    for (i = 0; i < cf->nbuckets; i++) {
+        cf->buckets[i] = cf_load64(in + i * 8);
+    }
+
+    return cf;
+}
+
+/**
+ *  @brief  Returns the typetable of cf's elements
+ *
+ *  @param[in]  cf  pointer to cuckoofilter
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *cf_get_ttbl(cuckoofilter *cf) {
+    assert(cf);
+    return cf->ttbl;
+}
+
+/**
+ *  @brief  Allocates a cuckoofilter of nbuckets empty buckets
+ */
+static cuckoofilter *cf_allocate(struct typetable *ttbl, size_t nbuckets) {
+    cuckoofilter *cf = NULL;
+
+    cf = malloc(sizeof *cf);
+    massert_malloc(cf);
+
+    cf->ttbl = ttbl ? ttbl : _void_ptr_;
+    cf->nbuckets = nbuckets;
+    cf->count = 0;
+
+    cf->buckets = calloc(nbuckets, sizeof *cf->buckets);
+    massert_malloc(cf->buckets);
+
+    cf->victim_index = 0;
+    cf->victim = 0;
+
+    cf->rng = 0x9e3779b9UL;
+    return cf;
+}
+
+/**
+ *  @brief  Hashes valaddr with ttbl->hash, or else by its bytes,
+ *          into 64 bits
+ */
+static uint64_t cf_hash(cuckoofilter *cf, const void *valaddr) {
+    uint64_t hash = 0;
+
+    if (cf->ttbl->hash) {
+        hash = cf->ttbl->hash(valaddr);
+    } else {
+        hash = hash_bytes(valaddr, cf->ttbl->width);
+    }
+
+    if (sizeof(size_t) < sizeof(uint64_t)) {
+        /**< a 32-bit hash: derive the upper half from the lower */
+        hash |= (uint64_t)((uint32_t)(hash) * 0x9e3779b1UL) << 16 << 16;
+    }
+
+    return hash;
+}
+
+/**
+ *  @brief  Returns the (nonzero) fingerprint of an element with hash
+ */
+static unsigned cf_fingerprint(uint64_t hash) {
+    unsigned fp = (unsigned)(hash >> 48);
+    return fp ? fp : 1;
+}
+
+/**
+ *  @brief  Returns the alternate bucket of fingerprint fp in bucket i
+ */
+static size_t cf_alt(cuckoofilter *cf, size_t i, unsigned fp) {
+    return (i ^ (size_t)((uint32_t)(fp) * 0x5bd1e995UL)) & (cf->nbuckets - 1);
+}
+
+/**
+ *  @brief  Returns the next number of cf's xorshift generator
+ */
+static uint32_t cf_random(cuckoofilter *cf) {
+    uint32_t x = cf->rng;
+
+    x ^= (uint32_t)(x << 13);
+    x ^= x >> 17;
+    x ^= (uint32_t)(x << 5);
+
+    cf->rng = x;
+    return x;
+}
+
+/**
+ *  @brief  Determines if any slot of bucket holds fp, testing all at once
+ */
+static bool cf_bucket_has(uint64_t bucket, unsigned fp) {
+    uint64_t x = bucket ^ CUCKOOFILTER_LANES(fp);
+
+    /**< a zero slot in x is a slot equal to fp */
+    return ((x - CUCKOOFILTER_LANES(1)) & ~x & CUCKOOFILTER_LANES(0x8000)) != 0
+           ? true : false;
+}
+
+/**
+ *  @brief  Puts fp in an empty slot of bucket i, if there is one
+ */
+static bool cf_bucket_put(cuckoofilter *cf, size_t i, unsigned fp) {
+    unsigned shift = 0;
+
+    for (shift = 0; shift < 16 * CUCKOOFILTER_SLOTS; shift += 16) {
+        if (((cf->buckets[i] >> shift) & 0xFFFF) == 0) {
+            cf->buckets[i] |= (uint64_t)(fp) << shift;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  @brief  Empties a slot of bucket i that holds fp, if there is one
+ */
+static bool cf_bucket_take(cuckoofilter *cf, size_t i, unsigned fp) {
+    unsigned shift = 0;
+
+    for (shift = 0; shift < 16 * CUCKOOFILTER_SLOTS; shift += 16) {
+        if (((cf->buckets[i] >> shift) & 0xFFFF) == fp) {
+            cf->buckets[i] &= ~((uint64_t)(0xFFFF) << shift);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  @brief  Determines if the fingerprint of an element with hash
+ *          is in one of its buckets (or aside, as the victim)
+ */
+static bool cf_test(cuckoofilter *cf, uint64_t hash) {
+    unsigned fp = cf_fingerprint(hash);
+    size_t i = (size_t)(hash) & (cf->nbuckets - 1);
+    size_t j = cf_alt(cf, i, fp);
+
+    if (cf_bucket_has(cf->buckets[i], fp) || cf_bucket_has(cf->buckets[j], fp)) {
+        return true;
+    }
+
+    return (cf->victim == fp && (cf->victim_index == i || cf->victim_index == j))
+           ? true : false;
+}
+
+/**
+ *  @brief  Puts fp in bucket i or its alternate, evicting fingerprints
+ *          to their alternate buckets if both are full
+ *
+ *  After CUCKOOFILTER_MAX_KICKS evictions, the fingerprint left
+ *  without a slot becomes cf's victim -- cf must not have one already.
+ *
+ *  @param[in]  cf  pointer to cuckoofilter
+ *  @param[in]  i   one of the buckets of fp
+ *  @param[in]  fp  fingerprint
+ */
+static void cf_place(cuckoofilter *cf, size_t i, unsigned fp) {
+    int kick = 0;
+
+    assert(cf->victim == 0);
+
+    if (cf_bucket_put(cf, i, fp) || cf_bucket_put(cf, cf_alt(cf, i, fp), fp)) {
+        return;
+    }
+
+    /**< evict a random fingerprint to its alternate bucket, and so on */
+    if (cf_random(cf) & 1) {
+        i = cf_alt(cf, i, fp);
+    }
+
+    for (kick = 0; kick < CUCKOOFILTER_MAX_KICKS; kick++) {
+        unsigned shift = 16 * (cf_random(cf) % CUCKOOFILTER_SLOTS);
+        unsigned displaced = (unsigned)(cf->buckets[i] >> shift) & 0xFFFF;
+
+        cf->buckets[i] &= ~((uint64_t)(0xFFFF) << shift);
+        cf->buckets[i] |= (uint64_t)(fp) << shift;
+
+        fp = displaced;
+        i = cf_alt(cf, i, fp);
+
+        if (cf_bucket_put(cf, i, fp)) {
+            return;
+        }
+    }
+
+    cf->victim = fp;
+    cf->victim_index = i;
+}
+
+/**
+ *  @brief  Stores x at dest, least significant byte first
+ */
+static void cf_store64(unsigned char *dest, uint64_t x) {
+    int i = 0;
+
+    for (i = 0; i < 8; i++) {
+        dest[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+/**
+ *  @brief  Loads a uint64_t from src, least significant byte first
+ */
+static uint64_t cf_load64(const unsigned char *src) {
+    uint64_t x = 0;
+    int i = 0;
+
+    for (i = 7; i >= 0; i--) {
+        x = (x << 8) | src[i];
+    }
+
+    return x;
+}
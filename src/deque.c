@@ -0,0 +1,1448 @@
+/**
+ *  @file       deque.c
+ *  @brief      Source file for a double-ended queue ADT
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "deque.h"
+#include "iterator.h"
+#include "utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ *  @def        DEQUE_INITIAL_MAP_SIZE
+ *  @brief      Number of block pointers in the map of a new deque
+ */
+#define DEQUE_INITIAL_MAP_SIZE 8
+
+/**
+ *  @struct     deque
+ *  @brief      Represents a double-ended queue ADT
+ *
+ *  Note that struct deque is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct deque be created on the stack.
+ *  This is done to enforce encapsulation.
+ *
+ *  Positions are absolute: position p lives in block map[p >> shift],
+ *  at slot (p & mask) of that block. The front element is at position
+ *  first, the back element at (first + size - 1).
+ *
+ *  Invariant: the blocks holding positions [first, first + size]
+ *  are allocated -- including the block of the one-past-the-end
+ *  position, so that the finish address is always valid.
+ *  Every other map entry is NULL.
+ */
+struct deque {
+    struct deque_base {
+        char **map;         /**< array of block pointers */
+        size_t map_size;    /**< number of entries in map */
+        size_t first;       /**< absolute position of the front element */
+        size_t size;        /**< number of elements */
+        char *spare;        /**< one cached block, to avoid alloc thrash */
+    } impl;
+
+    size_t shift;           /**< log2 of elements per block */
+    size_t mask;            /**< elements per block - 1 */
+
+    struct typetable *ttbl; /**< data width, cpy, dtor, swap, compare, print */
+};
+
+static deque *dq_allocate(void);
+static void dq_init(deque *dq, struct typetable *ttbl);
+static void dq_deinit(deque *dq);
+
+static void *dq_slot(deque *dq, size_t pos);
+static char *dq_block_acquire(deque *dq);
+static void dq_block_release(deque *dq, size_t index);
+static void dq_map_reserve(deque *dq);
+
+struct typetable ttbl_deque = {
+    sizeof(deque *),
+    deque_copy,
+    deque_dtor,
+    deque_swap,
+    deque_compare,
+    deque_print
+};
+
+struct typetable *_deque_ = &ttbl_deque;
+
+static iterator dqi_begin(void *arg);
+static iterator dqi_end(void *arg);
+
+static iterator dqi_next(iterator it);
+static iterator dqi_next_n(iterator it, int n);
+
+static iterator dqi_prev(iterator it);
+static iterator dqi_prev_n(iterator it, int n);
+
+static int dqi_distance(iterator *first, iterator *last);
+
+static iterator *dqi_advance(iterator *it, int n);
+static iterator *dqi_incr(iterator *it);
+static iterator *dqi_decr(iterator *it);
+
+static void *dqi_curr(iterator it);
+static void *dqi_start(iterator it);
+static void *dqi_finish(iterator it);
+
+static bool dqi_has_next(iterator it);
+static bool dqi_has_prev(iterator it);
+
+static struct typetable *dqi_get_ttbl(void *arg);
+
+static size_t dqi_index(iterator it);
+static iterator dqi_make(deque *dq, size_t index);
+
+struct iterator_table itbl_deque = {
+    dqi_begin,
+    dqi_end,
+    dqi_next,
+    dqi_next_n,
+    dqi_prev,
+    dqi_prev_n,
+    dqi_advance,
+    dqi_incr,
+    dqi_decr,
+    dqi_curr,
+    dqi_start,
+    dqi_finish,
+    dqi_distance,
+    dqi_has_next,
+    dqi_has_prev,
+    dqi_get_ttbl,
+    ITERATOR_RANDOM_ACCESS
+};
+
+struct iterator_table *_deque_iterator_ = &itbl_deque;
+
+/**
+ *  @brief  Allocates, constructs, and returns a pointer to deque
+ *
+ *  @param[in]  ttbl    pointer to struct typetable for
+ *                      width/copy/dtor/swap/compare/print
+ *
+ *  @return     pointer to deque
+ */
+deque *dq_new(struct typetable *ttbl) {
+    deque *dq = dq_allocate();                  /* allocate */
+    dq_init(dq, ttbl);                          /* construct */
+    return dq;                                  /* return */
+}
+
+/**
+ *  @brief  Calls dq_new and returns a pointer to deque,
+ *          filled with n copies of valaddr
+ *
+ *  @param[in]  ttbl    pointer to struct typetable for
+ *                      width/copy/dtor/swap/compare/print
+ *  @param[in]  n       number of elements to copy
+ *  @param[in]  valaddr address of element to copy
+ *
+ *  @return     pointer to deque
+ */
+deque *dq_newfill(struct typetable *ttbl, size_t n, void *valaddr) {
+    deque *dq = NULL;
+    size_t i = 0;
+
+    massert_ptr(valaddr);
+
+    dq = dq_new(ttbl);
+
+    for (i = 0; i < n; i++) {
+        dq_pushb(dq, valaddr);
+    }
+
+    return dq;
+}
+
+/**
+ *  @brief  Calls dq_new and returns a pointer to deque,
+ *          filled with elements from the range [first, last)
+ *
+ *  @param[in]  first   iterator referring to the first element to copy
+ *  @param[in]  last    iterator referring to one past the last element
+ *
+ *  @return     pointer to deque
+ */
+deque *dq_newrnge(iterator first, iterator last) {
+    struct typetable *ttbl_first = NULL;
+    deque *dq = NULL;
+
+    void *sentinel = NULL;
+    void *curr = NULL;
+
+    if (first.itbl != last.itbl) {
+        ERROR(__FILE__, "first and last must have matching container types and refer to the same container.");
+        return NULL;
+    }
+
+    ttbl_first = it_get_ttbl(first);
+    dq = dq_new(ttbl_first);
+
+    sentinel = it_curr(last);         /* iteration range is [first, last) */
+
+    while ((curr = it_curr(first)) != sentinel) {
+        dq_pushb(dq, curr);
+        it_incr(&first);
+    }
+
+    return dq;
+}
+
+/**
+ *  @brief  Calls dq_new and returns a pointer to deque,
+ *          filled with copies of the elements of dq
+ *
+ *  @param[in]  dq  pointer to deque, containing the desired source elements
+ *
+ *  @return     pointer to deque, with copies of dq's elements
+ */
+deque *dq_newcopy(deque *dq) {
+    deque *copy = NULL;
+    size_t i = 0;
+
+    massert_container(dq);
+
+    copy = dq_new(dq->ttbl);
+
+    for (i = 0; i < dq->impl.size; i++) {
+        dq_pushb(copy, dq_slot(dq, dq->impl.first + i));
+    }
+
+    return copy;
+}
+
+/**
+ *  @brief  Returns a pointer to deque that takes ownership of
+ *          the contents of (*dq); (*dq) is left empty, but valid
+ *
+ *  @param[out] dq  address of pointer to deque
+ *
+ *  @return     pointer to deque, with dq's former contents
+ */
+deque *dq_newmove(deque **dq) {
+    deque *move = NULL;
+
+    massert_container((*dq));
+
+    move = dq_allocate();
+
+    (*move) = (**dq);
+    dq_init((*dq), move->ttbl);
+
+    return move;
+}
+
+/**
+ *  @brief  Calls dq_deinit (destructor), then frees memory at dq
+ *
+ *  @param[out] dq  Address of a pointer to deque
+ */
+void dq_delete(deque **dq) {
+    massert_container((*dq));
+
+    dq_deinit((*dq));
+
+    free((*dq));
+    (*dq) = NULL;
+}
+
+/**
+ *  @brief  Returns an iterator that refers to the front element of dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     iterator that refers to dq
+ */
+iterator dq_begin(deque *dq) {
+    massert_container(dq);
+    return dqi_begin(dq);
+}
+
+/**
+ *  @brief  Returns an iterator that refers to one past
+ *          the back element of dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     iterator that refers to dq
+ */
+iterator dq_end(deque *dq) {
+    massert_container(dq);
+    return dqi_end(dq);
+}
+
+/**
+ *  @brief  Returns the logical length of dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     number of elements in dq
+ */
+size_t dq_size(deque *dq) {
+    massert_container(dq);
+    return dq->impl.size;
+}
+
+/**
+ *  @brief  Returns the theoretical maximum number of elements of dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     maximum element count
+ */
+size_t dq_maxsize(deque *dq) {
+    massert_container(dq);
+    return ((size_t)(-1)) / dq->ttbl->width;
+}
+
+/**
+ *  @brief  Determines if dq has no elements
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     true if dq is empty, false otherwise
+ */
+bool dq_empty(deque *dq) {
+    massert_container(dq);
+    return dq->impl.size == 0;
+}
+
+/**
+ *  @brief  Releases the cached spare block and shrinks the map
+ *          to the blocks in use
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  Element addresses remain valid.
+ */
+void dq_shrink_to_fit(deque *dq) {
+    size_t first_block = 0;
+    size_t nblocks = 0;
+    size_t map_size = 0;
+    size_t new_first_block = 0;
+    char **map = NULL;
+
+    massert_container(dq);
+
+    free(dq->impl.spare);
+    dq->impl.spare = NULL;
+
+    first_block = dq->impl.first >> dq->shift;
+    nblocks = ((dq->impl.first + dq->impl.size) >> dq->shift) - first_block + 1;
+
+    /* keep one free entry on each side, so the next push is O(1) */
+    map_size = nblocks + 2;
+
+    if (map_size >= dq->impl.map_size) {
+        return;
+    }
+
+    map = calloc(map_size, sizeof *map);
+    massert_calloc(map);
+
+    new_first_block = 1;
+    memcpy(map + new_first_block, dq->impl.map + first_block,
+           nblocks * sizeof *map);
+
+    free(dq->impl.map);
+
+    dq->impl.map = map;
+    dq->impl.map_size = map_size;
+    dq->impl.first = (new_first_block << dq->shift) +
+                     (dq->impl.first & dq->mask);
+}
+
+/**
+ *  @brief  Retrieves the address of an element from dq at index n
+ *
+ *  @param[in]  dq  pointer to deque
+ *  @param[in]  n   index of desired element
+ *
+ *  @return     address of element at n, NULL if n is out of bounds
+ */
+void *dq_at(deque *dq, size_t n) {
+    massert_container(dq);
+
+    if (n >= dq->impl.size) {
+        char str[256];
+        sprintf(str, "Input %lu is greater than deque's logical length, %lu -- index out of bounds.", n, dq->impl.size);
+        ERROR(__FILE__, str);
+        return NULL;
+    }
+
+    return dq_slot(dq, dq->impl.first + n);
+}
+
+/**
+ *  @brief  Retrieves the address of the front element from dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     address of front element, NULL if dq is empty
+ */
+void *dq_front(deque *dq) {
+    massert_container(dq);
+    return dq->impl.size ? dq_slot(dq, dq->impl.first) : NULL;
+}
+
+/**
+ *  @brief  Retrieves the address of the back element from dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     address of back element, NULL if dq is empty
+ */
+void *dq_back(deque *dq) {
+    massert_container(dq);
+    return dq->impl.size ? dq_slot(dq, dq->impl.first + dq->impl.size - 1)
+                         : NULL;
+}
+
+/**
+ *  @brief  Calls dq_at
+ */
+const void *dq_at_const(deque *dq, size_t n) {
+    return dq_at(dq, n);
+}
+
+/**
+ *  @brief  Calls dq_front
+ */
+const void *dq_front_const(deque *dq) {
+    return dq_front(dq);
+}
+
+/**
+ *  @brief  Calls dq_back
+ */
+const void *dq_back_const(deque *dq) {
+    return dq_back(dq);
+}
+
+/**
+ *  @brief  Prepends an element to dq, in O(1) time
+ *
+ *  @param[in]  dq      pointer to deque
+ *  @param[in]  valaddr address of element to copy into dq
+ *
+ *  No existing element is moved.
+ */
+void dq_pushf(deque *dq, const void *valaddr) {
+    size_t pos = 0;
+    void *target = NULL;
+
+    massert_container(dq);
+    massert_ptr(valaddr);
+
+    if (dq->impl.first == 0) {
+        /* no room left of the front block -- recenter or grow the map */
+        dq_map_reserve(dq);
+    }
+
+    pos = dq->impl.first - 1;
+
+    if ((dq->impl.first & dq->mask) == 0) {
+        /* the front block is full; the new element opens a new block */
+        dq->impl.map[pos >> dq->shift] = dq_block_acquire(dq);
+    }
+
+    target = dq_slot(dq, pos);
+
+    if (dq->ttbl->copy) {
+        /* if copy fn defined in ttbl, deep copy */
+        dq->ttbl->copy(target, valaddr);
+    } else {
+        /* if no copy defined in ttbl, shallow copy */
+        memcpy(target, valaddr, dq->ttbl->width);
+    }
+
+    dq->impl.first = pos;
+    ++dq->impl.size;
+}
+
+/**
+ *  @brief  Removes the front element of dq, in O(1) time
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  dq_popf is a no-op if dq is empty.
+ */
+void dq_popf(deque *dq) {
+    size_t pos = 0;
+
+    massert_container(dq);
+
+    if (dq->impl.size == 0) {
+        return;
+    }
+
+    pos = dq->impl.first;
+
+    if (dq->ttbl->dtor) {
+        dq->ttbl->dtor(dq_slot(dq, pos));
+    }
+
+    ++dq->impl.first;
+    --dq->impl.size;
+
+    if ((dq->impl.first & dq->mask) == 0) {
+        /* the former front block no longer holds any elements */
+        dq_block_release(dq, pos >> dq->shift);
+    }
+}
+
+/**
+ *  @brief  Appends an element to dq, in O(1) time
+ *
+ *  @param[in]  dq      pointer to deque
+ *  @param[in]  valaddr address of element to copy into dq
+ *
+ *  No existing element is moved.
+ */
+void dq_pushb(deque *dq, const void *valaddr) {
+    size_t pos = 0;
+    void *target = NULL;
+
+    massert_container(dq);
+    massert_ptr(valaddr);
+
+    pos = dq->impl.first + dq->impl.size;
+
+    if (((pos + 1) & dq->mask) == 0 &&
+        ((pos + 1) >> dq->shift) == dq->impl.map_size) {
+        /* no room right of the back block -- recenter or grow the map */
+        dq_map_reserve(dq);
+        pos = dq->impl.first + dq->impl.size;
+    }
+
+    target = dq_slot(dq, pos);
+
+    if (dq->ttbl->copy) {
+        /* if copy fn defined in ttbl, deep copy */
+        dq->ttbl->copy(target, valaddr);
+    } else {
+        /* if no copy defined in ttbl, shallow copy */
+        memcpy(target, valaddr, dq->ttbl->width);
+    }
+
+    ++dq->impl.size;
+    ++pos;
+
+    if ((pos & dq->mask) == 0) {
+        /* the new one-past-the-end position opens a new block */
+        dq->impl.map[pos >> dq->shift] = dq_block_acquire(dq);
+    }
+}
+
+/**
+ *  @brief  Removes the back element of dq, in O(1) time
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  dq_popb is a no-op if dq is empty.
+ */
+void dq_popb(deque *dq) {
+    size_t pos = 0;
+
+    massert_container(dq);
+
+    if (dq->impl.size == 0) {
+        return;
+    }
+
+    pos = dq->impl.first + dq->impl.size;
+
+    if (dq->ttbl->dtor) {
+        dq->ttbl->dtor(dq_slot(dq, pos - 1));
+    }
+
+    --dq->impl.size;
+
+    if ((pos & dq->mask) == 0) {
+        /* the former one-past-the-end block is no longer reachable */
+        dq_block_release(dq, pos >> dq->shift);
+    }
+}
+
+/**
+ *  @brief  Swaps the contents of dq and other
+ *
+ *  @param[out] dq      address of pointer to deque
+ *  @param[out] other   address of pointer to deque
+ */
+void dq_swap(deque **dq, deque **other) {
+    deque temp;
+
+    massert_container((*dq));
+    massert_container((*other));
+
+    temp = (**dq);
+    (**dq) = (**other);
+    (**other) = temp;
+}
+
+/**
+ *  @brief  Destroys elements from within dq
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  Memory management of dynamically allocated elements
+ *  and/or elements with dynamically allocated fields
+ *  become the client's responsibility if a dtor function
+ *  is NOT defined within dq's ttbl.
+ */
+void dq_clear(deque *dq) {
+    massert_container(dq);
+
+    while (dq->impl.size > 0) {
+        dq_popb(dq);
+    }
+}
+
+/**
+ *  @brief  Hands dq's elements to visitor, one block's worth at a time
+ *
+ *  @param[in]  dq      pointer to deque
+ *  @param[in]  visitor function to apply to each run
+ *  @param[in]  ctx     caller state, passed through to visitor
+ *
+ *  @return     number of elements passed to visitor
+ *
+ *  visitor receives ctx, the address of the first element of a run,
+ *  and the number of elements in it. Elements are contiguous within
+ *  a block, so every run is as long as the block it lies in allows --
+ *  only the first and last runs may be shorter.
+ *
+ *  The walk ends early once visitor returns false.
+ *  visitor must not insert or erase elements of dq.
+ */
+size_t dq_for_each_chunk(deque *dq, bool (*visitor)(void *, void *, size_t),
+                         void *ctx) {
+    size_t pos = 0;
+    size_t last = 0;
+    size_t visited = 0;
+
+    massert_container(dq);
+    massert_pfunc(visitor);
+
+    pos = dq->impl.first;
+    last = dq->impl.first + dq->impl.size;
+
+    while (pos < last) {
+        /**< the rest of pos's block, or the rest of dq if that is less */
+        size_t count = (dq->mask + 1) - (pos & dq->mask);
+
+        if (count > last - pos) {
+            count = last - pos;
+        }
+
+        visited += count;
+
+        if (visitor(ctx, dq_slot(dq, pos), count) == false) {
+            break;
+        }
+
+        pos += count;
+    }
+
+    return visited;
+}
+
+/**
+ *  @brief  Prints a diagnostic of deque to stdout
+ *
+ *  @param[in]  dq  pointer to deque
+ */
+void dq_puts(deque *dq) {
+    /* redirect to dq_fputs with stream stdout */
+    dq_fputs(dq, stdout);
+}
+
+/**
+ *  @brief  Prints the contents of deque with user-defined formatting
+ *
+ *  @param[in]  dq          pointer to deque
+ *  @param[in]  before      string that appears before any elements appear
+ *  @param[in]  after       string that appears after all the elements have appeared
+ *  @param[in]  postelem    string that appears after each element, except the last one
+ *  @param[in]  breaklim    amount of elements that print before a line break occurs.
+ *                          0 means no line breaks
+ */
+void dq_putsf(deque *dq, const char *before, const char *after,
+              const char *postelem, const char *empty, size_t breaklim) {
+    /* redirect to dq_fputsf with stream stdout */
+    dq_fputsf(dq, stdout, before, after, postelem, empty, breaklim);
+}
+
+/**
+ *  @brief  Prints a diagnostic of deque to file stream dest
+ *
+ *  @param[in]  dq      pointer to deque
+ *  @param[in]  dest    file stream (e.g stdout, stderr, a file)
+ */
+void dq_fputs(deque *dq, FILE *dest) {
+    char buffer1[MAXIMUM_STACK_BUFFER_SIZE];
+    char buffer2[MAXIMUM_STACK_BUFFER_SIZE];
+
+    const char *link = "------------------------------";
+    const char *bytes_label = NULL;
+    const char *postelem = "";
+    const char *empty = "--- Container is empty ---";
+
+    const size_t breaklim = 1;
+
+    massert_container(dq);
+    massert_ptr(dest);
+
+    sprintf(buffer1, "\n%s\n%s\n%s\n", link, "Elements", link);
+
+    bytes_label = dq->ttbl->width == 1 ? "byte" : "bytes";
+
+    sprintf(buffer2, "%s\n%s\t\t%lu\n%s\t%lu\n%s\t%lu %s\n%s\n", link, "Size",
+            dq->impl.size, "Block length", dq->mask + 1, "Element size",
+            dq->ttbl->width, bytes_label, link);
+
+    dq_fputsf(dq, dest, buffer1, buffer2, postelem, empty, breaklim);
+}
+
+/**
+ *  @brief  Prints the contents of deque with user-defined formatting,
+ *          to file stream dest
+ *
+ *  @param[in]  dq          pointer to deque
+ *  @param[in]  dest        file stream (e.g. stdout, stderr, a file)
+ *  @param[in]  before      string that appears before any elements appear
+ *  @param[in]  after       string that appears after all the elements have appeared
+ *  @param[in]  postelem    string that appears after each element, except the last one
+ *  @param[in]  breaklim    amount of elements that print before a line break occurs.
+ *                          0 means no line breaks
+ */
+void dq_fputsf(deque *dq, FILE *dest, const char *before, const char *after,
+               const char *postelem, const char *empty, size_t breaklim) {
+    void (*print)(const void *, FILE *dest) = NULL;
+
+    size_t size = 0;
+    size_t i = 0;
+    size_t curr = 0;
+
+    void *target = NULL;
+
+    massert_container(dq);
+    massert_ptr(dest);
+
+    fprintf(dest, "%s", before ? before : "");
+
+    print = dq->ttbl->print ? dq->ttbl->print : void_ptr_print;
+
+    size = dq->impl.size;
+
+    if (size == 0) {
+        fprintf(dest, "%s\n", empty ? empty : "");
+    } else {
+        for (i = 0, curr = 1; i < size; i++, curr++) {
+            target = dq_slot(dq, dq->impl.first + i);
+
+            print(target, dest);
+
+            /* address - disable for release */
+            fprintf(dest, "\t\t(%s%p%s)", KCYN, target, KNRM);
+
+            if (i < size - 1) {
+                fprintf(dest, "%s", postelem ? postelem : "");
+            }
+
+            if (curr == breaklim) {
+                curr = 0;
+                fprintf(dest, "\n");
+            }
+        }
+    }
+
+    fprintf(dest, "%s", after ? after : "");
+}
+
+/**
+ *  @brief  Wrapper function for a struct typetable
+ *
+ *  @param[in]  arg     address of a deque pointer
+ *  @param[in]  other   address of a deque pointer
+ *
+ *  @return     a pointer to deque
+ */
+void *deque_copy(void *arg, const void *other) {
+    deque **dest = NULL;
+    deque **source = NULL;
+
+    massert_container(other);
+
+    dest = (deque **)(arg);
+    source = (deque **)(other);
+
+    (*dest) = dq_newcopy((*source));
+
+    return (*dest);
+}
+
+/**
+ *  @brief  Wrapper function for a struct typetable
+ *
+ *  @param[in]  arg     address of a deque pointer
+ */
+void deque_dtor(void *arg) {
+    deque **dq = NULL;
+
+    massert_ptr(arg);
+
+    dq = (deque **)(arg);
+    dq_delete(dq);
+}
+
+/**
+ *  @brief  Wrapper function for a struct typetable
+ *
+ *  @param[in]  s1  address of a deque pointer
+ *  @param[in]  s2  address of a deque pointer
+ */
+void deque_swap(void *s1, void *s2) {
+    deque **dq1 = (deque **)(s1);
+    deque **dq2 = (deque **)(s2);
+
+    if ((*dq1)) {
+        dq_swap(dq1, dq2);
+    } else {
+        (*dq1) = (*dq2);
+        (*dq2) = NULL;
+    }
+}
+
+/**
+ *  @brief  Wrapper function for a struct typetable
+ *
+ *  @param[in]  c1  address of a deque pointer
+ *  @param[in]  c2  address of a deque pointer
+ *
+ *  @return     lexicographical comparison of the two deques,
+ *              by the compare function of the first deque's ttbl
+ */
+int deque_compare(const void *c1, const void *c2) {
+    deque *dq1 = NULL;
+    deque *dq2 = NULL;
+
+    size_t size = 0;
+    size_t i = 0;
+
+    int delta = 0;
+
+    massert_container(c1);
+    massert_container(c2);
+
+    dq1 = *(deque **)(c1);
+    dq2 = *(deque **)(c2);
+
+    if (dq1->ttbl->compare != dq2->ttbl->compare) {
+        return -1;
+    }
+
+    size = dq1->impl.size < dq2->impl.size ? dq1->impl.size : dq2->impl.size;
+
+    for (i = 0; i < size && dq1->ttbl->compare; i++) {
+        delta = dq1->ttbl->compare(dq_slot(dq1, dq1->impl.first + i),
+                                   dq_slot(dq2, dq2->impl.first + i));
+        if (delta != 0) {
+            return delta;
+        }
+    }
+
+    if (dq1->impl.size == dq2->impl.size) {
+        return 0;
+    }
+
+    return dq1->impl.size < dq2->impl.size ? -1 : 1;
+}
+
+/**
+ *  @brief  Wrapper function for a struct typetable
+ *
+ *  @param[in]  arg     address of a deque pointer
+ *  @param[in]  dest    file stream (stdout, stderr, a file)
+ */
+void deque_print(const void *arg, FILE *dest) {
+    deque *dq = NULL;
+
+    massert_container(arg);
+    massert_ptr(dest);
+
+    dq = *(deque **)(arg);
+    dq_fputs(dq, dest);
+}
+
+/**
+ *  @brief  Retrieves width (data size) in dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     size of data type
+ */
+size_t dq_get_width(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl->width;
+}
+
+/**
+ *  @brief  Retrieves copy function in dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     copy function used by dq
+ */
+copy_fn dq_get_copy(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl->copy;
+}
+
+/**
+ *  @brief  Retrieves dtor function in dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     dtor function used by dq
+ */
+dtor_fn dq_get_dtor(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl->dtor;
+}
+
+/**
+ *  @brief  Retrieves swap function in dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     swap function used by dq
+ */
+swap_fn dq_get_swap(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl->swap;
+}
+
+/**
+ *  @brief  Retrieves compare function in dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     compare function used by dq
+ */
+compare_fn dq_get_compare(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl->compare;
+}
+
+/**
+ *  @brief  Retrieves print function in dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     print function used by dq
+ */
+print_fn dq_get_print(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl->print;
+}
+
+/**
+ *  @brief  Retrieves dq's ttbl
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *dq_get_ttbl(deque *dq) {
+    massert_container(dq);
+    return dq->ttbl;
+}
+
+/**
+ *  @brief  Allocates memory for a deque
+ *
+ *  @return     pointer to uninitialized deque
+ */
+static deque *dq_allocate(void) {
+    deque *dq = NULL;
+    dq = malloc(sizeof *dq);
+    massert_malloc(dq);
+    return dq;
+}
+
+/**
+ *  @brief  Initializes an empty deque with one block,
+ *          positioned in the middle of the map
+ *
+ *  @param[in]  dq      pointer to deque
+ *  @param[in]  ttbl    pointer to struct typetable
+ */
+static void dq_init(deque *dq, struct typetable *ttbl) {
+    size_t per_block = 1;
+    size_t middle = 0;
+
+    massert_container(dq);
+
+    dq->ttbl = ttbl ? ttbl : _void_ptr_;
+
+    massert((dq->ttbl->width > 0),
+            "[deque requires a typetable with a nonzero width]");
+
+    /* largest power of two such that a block fits DEQUE_BLOCK_BYTES */
+    dq->shift = 0;
+
+    while ((per_block << 1) * dq->ttbl->width <= DEQUE_BLOCK_BYTES) {
+        per_block <<= 1;
+        ++dq->shift;
+    }
+
+    dq->mask = per_block - 1;
+
+    dq->impl.map_size = DEQUE_INITIAL_MAP_SIZE;
+    dq->impl.map = calloc(dq->impl.map_size, sizeof *dq->impl.map);
+    massert_calloc(dq->impl.map);
+
+    dq->impl.spare = NULL;
+    dq->impl.size = 0;
+
+    /* start mid-block, so a few pushes at either end stay in one block */
+    middle = dq->impl.map_size / 2;
+    dq->impl.first = (middle << dq->shift) + (per_block / 2);
+    dq->impl.map[middle] = dq_block_acquire(dq);
+}
+
+/**
+ *  @brief  Destroys all elements and releases all blocks of dq
+ *
+ *  @param[in]  dq  pointer to deque
+ */
+static void dq_deinit(deque *dq) {
+    size_t i = 0;
+
+    massert_container(dq);
+
+    dq_clear(dq);
+
+    for (i = 0; i < dq->impl.map_size; i++) {
+        free(dq->impl.map[i]);
+    }
+
+    free(dq->impl.map);
+    dq->impl.map = NULL;
+    dq->impl.map_size = 0;
+
+    free(dq->impl.spare);
+    dq->impl.spare = NULL;
+}
+
+/**
+ *  @brief  Computes the address of absolute position pos
+ *
+ *  @param[in]  dq  pointer to deque
+ *  @param[in]  pos absolute position, within [first, first + size]
+ *
+ *  @return     address of the slot at pos
+ */
+static void *dq_slot(deque *dq, size_t pos) {
+    return dq->impl.map[pos >> dq->shift] + ((pos & dq->mask) * dq->ttbl->width);
+}
+
+/**
+ *  @brief  Returns the spare block if there is one,
+ *          otherwise allocates a new block
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  @return     uninitialized block of (mask + 1) elements
+ */
+static char *dq_block_acquire(deque *dq) {
+    char *block = dq->impl.spare;
+
+    if (block) {
+        dq->impl.spare = NULL;
+    } else {
+        block = malloc((dq->mask + 1) * dq->ttbl->width);
+        massert_malloc(block);
+    }
+
+    return block;
+}
+
+/**
+ *  @brief  Detaches the block at map[index], keeping it as the spare
+ *          block if there is none, freeing it otherwise
+ *
+ *  @param[in]  dq      pointer to deque
+ *  @param[in]  index   map index of a block that holds no elements
+ */
+static void dq_block_release(deque *dq, size_t index) {
+    if (dq->impl.spare) {
+        free(dq->impl.map[index]);
+    } else {
+        dq->impl.spare = dq->impl.map[index];
+    }
+
+    dq->impl.map[index] = NULL;
+}
+
+/**
+ *  @brief  Makes room for one more block at both ends of the map
+ *
+ *  @param[in]  dq  pointer to deque
+ *
+ *  If the map is more than twice as large as the number of blocks
+ *  in use, the blocks are recentered within the current map;
+ *  otherwise, the map is doubled. Only block pointers move --
+ *  elements stay where they are.
+ */
+static void dq_map_reserve(deque *dq) {
+    size_t first_block = dq->impl.first >> dq->shift;
+    size_t nblocks =
+        ((dq->impl.first + dq->impl.size) >> dq->shift) - first_block + 1;
+    size_t new_first_block = 0;
+    size_t i = 0;
+
+    if (dq->impl.map_size > 2 * (nblocks + 1)) {
+        new_first_block = (dq->impl.map_size - nblocks) / 2;
+
+        memmove(dq->impl.map + new_first_block, dq->impl.map + first_block,
+                nblocks * sizeof *dq->impl.map);
+
+        for (i = 0; i < dq->impl.map_size; i++) {
+            if (i < new_first_block || i >= new_first_block + nblocks) {
+                dq->impl.map[i] = NULL;
+            }
+        }
+    } else {
+        size_t map_size = dq->impl.map_size * 2 + 2;
+        char **map = calloc(map_size, sizeof *map);
+        massert_calloc(map);
+
+        new_first_block = (map_size - nblocks) / 2;
+
+        memcpy(map + new_first_block, dq->impl.map + first_block,
+               nblocks * sizeof *map);
+
+        free(dq->impl.map);
+
+        dq->impl.map = map;
+        dq->impl.map_size = map_size;
+    }
+
+    dq->impl.first = (new_first_block << dq->shift) + (dq->impl.first & dq->mask);
+}
+
+/**
+ *  @brief  Retrieves the logical index held by a deque iterator
+ *
+ *  A deque iterator stores the logical index of its position in curr,
+ *  rather than an address -- the address alone does not identify
+ *  which block of the map an element lives in.
+ */
+static size_t dqi_index(iterator it) {
+    return (size_t)(it.curr);
+}
+
+/**
+ *  @brief  Initializes an iterator to logical index index of dq
+ */
+static iterator dqi_make(deque *dq, size_t index) {
+    iterator it;
+
+    it.itbl = _deque_iterator_;
+    it.container = dq;
+    it.curr = (void *)(index);
+
+    return it;
+}
+
+/**
+ *  @brief  Initializes and returns an iterator that refers to arg
+ *
+ *  @param[in]  arg     pointer to deque
+ *
+ *  @return     iterator that refers to dq,
+ *              position is at dq's first element
+ */
+static iterator dqi_begin(void *arg) {
+    return dqi_make((deque *)(arg), 0);
+}
+
+/**
+ *  @brief  Initializes and returns an iterator that refers to arg
+ *
+ *  @param[in]  arg     pointer to deque
+ *
+ *  @return     iterator that refers to dq;
+ *              position is at one block past dq's last element
+ */
+static iterator dqi_end(void *arg) {
+    deque *dq = (deque *)(arg);
+    return dqi_make(dq, dq->impl.size);
+}
+
+/**
+ *  @brief  Initializes and returns an iterator that
+ *          is one block past it's current position
+ *
+ *  @param[in]  it      iterator that refers to a deque
+ *
+ *  @return     a new iterator that is one block past it's current position
+ */
+static iterator dqi_next(iterator it) {
+    iterator iter = it;
+    dqi_incr(&iter);
+    return iter;
+}
+
+/**
+ *  @brief  Initializes and returns an iterator that
+ *          is n blocks past it's current position
+ *
+ *  @param[in]  it      iterator that refers to a deque
+ *  @param[in]  n       desired amount of blocks to move
+ *
+ *  @return     a new iterator that is n block's past it's current position
+ */
+static iterator dqi_next_n(iterator it, int n) {
+    iterator iter = it;
+    dqi_advance(&iter, n);
+    return iter;
+}
+
+/**
+ *  @brief  Initializes and returns an iterator that
+ *          is one block behind it's current position
+ *
+ *  @param[in]  it      iterator that refers to a deque
+ *
+ *  @return     a new iterator that is one block behind it's current position
+ */
+static iterator dqi_prev(iterator it) {
+    iterator iter = it;
+    dqi_decr(&iter);
+    return iter;
+}
+
+/**
+ *  @brief  Initializes and returns an iterator that
+ *          is n blocks behind it's current position
+ *
+ *  @param[in]  it      iterator that refers to a deque
+ *  @param[in]  n       desired amount of blocks to move
+ *
+ *  @return     a new iterator that is n block's behind it's current position
+ */
+static iterator dqi_prev_n(iterator it, int n) {
+    iterator iter = it;
+    dqi_advance(&iter, -n);
+    return iter;
+}
+
+/**
+ *  @brief  Determines the distance between first and last numerically
+ *
+ *  @param[in]  first   pointer to iterator that refers to a deque
+ *  @param[in]  last    pointer to iterator that refers to a deque
+ *
+ *  @return     numerical distance between first and last
+ *
+ *  To find the index position of an iterator, leave one of the parameters
+ *  NULL when calling the distance function.
+ */
+static int dqi_distance(iterator *first, iterator *last) {
+    if (first == NULL && last != NULL) {
+        return (int)(dqi_index(*last));
+    } else if (last == NULL && first != NULL) {
+        return (int)(dqi_index(*first));
+    } else if (first == NULL && last == NULL) {
+        ERROR(__FILE__, "Both iterator first and last are NULL.");
+        return 0;
+    } else {
+        return (int)(dqi_index(*last)) - (int)(dqi_index(*first));
+    }
+}
+
+/**
+ *  @brief  Advances the position of it n blocks
+ *
+ *  @param[in]  it      pointer to iterator that refers to a deque
+ *  @param[in]  n       desired amount of blocks to move (may be negative)
+ *
+ *  @return     pointer to iterator
+ */
+static iterator *dqi_advance(iterator *it, int n) {
+    deque *dq = NULL;
+    int pos = 0;
+
+    massert_iterator(it);
+
+    dq = it->container;
+    pos = (int)(dqi_index(*it));
+
+    if (pos + n < 0 || (size_t)(pos + n) > dq->impl.size) {
+        char str[256];
+        sprintf(str, "Cannot advance %d times from position %d.", n, pos);
+        ERROR(__FILE__, str);
+    } else {
+        it->curr = (void *)((size_t)(pos + n));
+    }
+
+    return it;
+}
+
+/**
+ *  @brief  Increments the position of it 1 block forward
+ *
+ *  @param[in]  it     pointer to iterator that refers to a deque
+ *
+ *  @return     pointer to iterator
+ */
+static iterator *dqi_incr(iterator *it) {
+    deque *dq = NULL;
+    size_t index = 0;
+
+    massert_iterator(it);
+
+    dq = it->container;
+    index = dqi_index(*it);
+
+    if (index == dq->impl.size) {
+        ERROR(__FILE__, "Cannot increment - already at end.");
+    } else {
+        it->curr = (void *)(index + 1);
+    }
+
+    return it;
+}
+
+/**
+ *  @brief  Decrements the position of it 1 block backward
+ *
+ *  @param[in]  it     pointer to iterator that refers to a deque
+ *
+ *  @return     pointer to iterator
+ */
+static iterator *dqi_decr(iterator *it) {
+    size_t index = 0;
+
+    massert_iterator(it);
+
+    index = dqi_index(*it);
+
+    if (index == 0) {
+        ERROR(__FILE__, "Cannot decrement this iterator, already at begin.");
+    } else {
+        it->curr = (void *)(index - 1);
+    }
+
+    return it;
+}
+
+/**
+ *  @brief  Retrieves the address of the value referred to
+ *          by it's current position
+ *
+ *  @param[in]  it  iterator that refers to a deque
+ *
+ *  @return     address of an element from within a deque
+ */
+static void *dqi_curr(iterator it) {
+    deque *dq = it.container;
+    return dq_slot(dq, dq->impl.first + dqi_index(it));
+}
+
+/**
+ *  @brief  Retrieves the address of first element from
+ *          the deque it is iterating
+ *
+ *  @param[in]  it  iterator that refers to a deque
+ *
+ *  @return     address of the first element from within a deque
+ */
+static void *dqi_start(iterator it) {
+    deque *dq = it.container;
+    return dq_slot(dq, dq->impl.first);
+}
+
+/**
+ *  @brief  Retrieves the address of the block one past
+ *          the last element from within the deque it is iterating
+ *
+ *  @param[in]  it  iterator that refers to a deque
+ *
+ *  @return     address of the element that is one block past
+ *              the rear element from within the deque being iterated
+ */
+static void *dqi_finish(iterator it) {
+    deque *dq = it.container;
+    return dq_slot(dq, dq->impl.first + dq->impl.size);
+}
+
+/**
+ *  @brief  Determines if it has elements to visit in the forward direction
+ *
+ *  @param[in]  it  iterator that refers to a deque
+ *
+ *  @return     true if elements remain in the forward direction,
+ *              false otherwise
+ */
+static bool dqi_has_next(iterator it) {
+    deque *dq = it.container;
+    return dqi_index(it) != dq->impl.size;
+}
+
+/**
+ *  @brief  Determines if it has elements to visit in the backward direction
+ *
+ *  @param[in]  it  iterator that refers to a deque
+ *
+ *  @return     true if elements remain in the backward direction,
+ *              false otherwise
+ */
+static bool dqi_has_prev(iterator it) {
+    return dqi_index(it) != 0;
+}
+
+/**
+ *  @brief  Retrieve a container's typetable
+ *
+ *  @param[in]  arg     pointer to deque
+ *
+ *  @return     pointer to typetable
+ */
+static struct typetable *dqi_get_ttbl(void *arg) {
+    deque *dq = arg;
+    return dq->ttbl;
+}
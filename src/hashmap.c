@@ -0,0 +1,1142 @@
+/**
+ *  @file       hashmap.c
+ *  @brief      Source file for an open-addressing hash map
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* defined(__SSE2__) */
+
+#include "hashmap.h"
+
+/**
+ *  @def        HASHMAP_EMPTY
+ *  @brief      Control byte of a slot that has never held an entry
+ *              (since the last rehash)
+ */
+#define HASHMAP_EMPTY ((signed char)-128)
+
+/**
+ *  @def        HASHMAP_DELETED
+ *  @brief      Control byte of a slot whose entry was erased (a tombstone)
+ */
+#define HASHMAP_DELETED ((signed char)-2)
+
+/**
+ *  @def        HASHMAP_MAX_ALIGN
+ *  @brief      Largest alignment a key or value is given within an entry
+ */
+#define HASHMAP_MAX_ALIGN 16
+
+/**
+ *  @def        HASHMAP_MAX_LOAD
+ *  @brief      Number of entries (and tombstones) a table of capacity
+ *              CAP may hold before it is rehashed -- 7/8 of CAP
+ */
+#define HASHMAP_MAX_LOAD(CAP) ((CAP) - (CAP) / 8)
+
+/**
+ *  @struct     hashmap
+ *  @brief      Represents an open-addressing hash map
+ *
+ *  Note that struct hashmap is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct hashmap be created on the stack.
+ *  This is done to enforce encapsulation.
+ *
+ *  capacity is 0 (nothing allocated), or a power of two no smaller than
+ *  HASHMAP_GROUP. Slot i has control byte ctrl[i]: HASHMAP_EMPTY,
+ *  HASHMAP_DELETED, or -- if full -- the low 7 bits of its key's hash.
+ *  The entry of slot i is at slots + i * entry_width.
+ *
+ *  A key's probe sequence visits whole, aligned groups of HASHMAP_GROUP
+ *  slots, starting from the group picked by the rest of its hash and
+ *  stepping by 1, 2, 3, ... groups (which visits every group, as the
+ *  number of groups is a power of two). A lookup stops at the first
+ *  group with an empty slot -- so an erased slot may only become empty
+ *  again if its group already has one (no probe sequence can have
+ *  passed through that group); otherwise it becomes a tombstone.
+ *
+ *  growth_left is the number of empty slots that may still be filled
+ *  before the load (entries plus tombstones) reaches HASHMAP_MAX_LOAD.
+ */
+struct hashmap {
+    struct typetable *ttbl_key;
+    struct typetable *ttbl_val;
+
+    size_t val_offset;
+    size_t entry_width;
+
+    size_t capacity;
+    size_t size;
+    size_t growth_left;
+
+    signed char *ctrl;
+    char *slots;
+};
+
+static size_t hm_align(size_t width);
+static size_t hm_hash(hashmap *h, const void *key);
+static unsigned hm_ctz(unsigned mask);
+
+static unsigned hm_match(const signed char *group, signed char h2);
+static unsigned hm_match_empty(const signed char *group);
+static unsigned hm_match_free(const signed char *group);
+
+static char *hm_lookup(hashmap *h, const void *key, size_t hash);
+static size_t hm_free_slot(hashmap *h, size_t hash);
+static char *hm_emplace(hashmap *h, size_t hash);
+static void hm_resize(hashmap *h, size_t capacity);
+static void hm_put(hashmap *h, char *entry, const void *key, const void *val);
+static void hm_destroy(hashmap *h, char *entry);
+
+static iterator hmi_begin(void *arg);
+static iterator hmi_end(void *arg);
+
+static iterator hmi_next(iterator it);
+static iterator hmi_next_n(iterator it, int n);
+
+static iterator hmi_prev(iterator it);
+static iterator hmi_prev_n(iterator it, int n);
+
+static int hmi_distance(iterator *first, iterator *last);
+
+static iterator *hmi_advance(iterator *it, int n);
+static iterator *hmi_incr(iterator *it);
+static iterator *hmi_decr(iterator *it);
+
+static void *hmi_curr(iterator it);
+static void *hmi_start(iterator it);
+static void *hmi_finish(iterator it);
+
+static bool hmi_has_next(iterator it);
+static bool hmi_has_prev(iterator it);
+
+static struct typetable *hmi_get_ttbl(void *arg);
+
+static char *hmi_first(hashmap *h, size_t from);
+static char *hmi_last(hashmap *h, size_t before);
+static int hmi_index(iterator it);
+
+struct iterator_table itbl_hashmap = {
+    hmi_begin,
+    hmi_end,
+    hmi_next,
+    hmi_next_n,
+    hmi_prev,
+    hmi_prev_n,
+    hmi_advance,
+    hmi_incr,
+    hmi_decr,
+    hmi_curr,
+    hmi_start,
+    hmi_finish,
+    hmi_distance,
+    hmi_has_next,
+    hmi_has_prev,
+    hmi_get_ttbl,
+    ITERATOR_BIDIRECTIONAL
+};
+
+struct iterator_table *_hashmap_iterator_ = &itbl_hashmap;
+
+/**
+ *  @brief  Allocates and initializes a new, empty hashmap
+ *
+ *  No table is allocated until the first insertion (or hm_reserve).
+ *
+ *  @param[in]  ttbl_key    typetable of the keys
+ *                          (must have equals or compare)
+ *  @param[in]  ttbl_val    typetable of the values
+ *
+ *  @return     pointer to hashmap
+ */
+hashmap *hm_new(struct typetable *ttbl_key, struct typetable *ttbl_val) {
+    hashmap *h = NULL;
+    size_t align_key = 0;
+    size_t align_val = 0;
+    size_t align = 0;
+
+    h = malloc(sizeof *h);
+    massert_malloc(h);
+
+    h->ttbl_key = ttbl_key ? ttbl_key : _void_ptr_;
+    h->ttbl_val = ttbl_val ? ttbl_val : _void_ptr_;
+
+    assert(h->ttbl_key->equals || h->ttbl_key->compare);
+
+    align_key = hm_align(h->ttbl_key->width);
+    align_val = hm_align(h->ttbl_val->width);
+    align = align_key > align_val ? align_key : align_val;
+
+    /**
+     *  The value follows the key at its own alignment, and the entry
+     *  is padded so that the key of the next slot is aligned as well.
+     */
+    h->val_offset
+    = (h->ttbl_key->width + align_val - 1) / align_val * align_val;
+    h->entry_width
+    = (h->val_offset + h->ttbl_val->width + align - 1) / align * align;
+
+    h->capacity = 0;
+    h->size = 0;
+    h->growth_left = 0;
+
+    h->ctrl = NULL;
+    h->slots = NULL;
+
+    return h;
+}
+
+/**
+ *  @brief  Allocates a new hashmap and deep copies the entries of h into it
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     pointer to hashmap
+ */
+hashmap *hm_newcopy(hashmap *h) {
+    hashmap *copy = NULL;
+    size_t i = 0;
+
+    assert(h);
+
+    copy = hm_new(h->ttbl_key, h->ttbl_val);
+    hm_reserve(copy, h->size);
+
+    for (i = 0; i < h->capacity; i++) {
+        if (h->ctrl[i] >= 0) {
+            char *entry = h->slots + i * h->entry_width;
+            char *slot = hm_emplace(copy, hm_hash(h, entry));
+
+            hm_put(copy, slot, entry, entry + h->val_offset);
+        }
+    }
+
+    return copy;
+}
+
+/**
+ *  @brief  Releases every entry of (*h), then (*h) itself
+ *
+ *  @param[out] h   address of pointer to hashmap
+ */
+void hm_delete(hashmap **h) {
+    assert(h);
+    assert(*h);
+
+    hm_clear(*h);
+
+    free((*h)->ctrl);
+    (*h)->ctrl = NULL;
+
+    free((*h)->slots);
+    (*h)->slots = NULL;
+
+    free(*h);
+    *h = NULL;
+}
+
+/**
+ *  @brief  Returns an iterator to the first full slot of h
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     iterator at the first entry (in slot order)
+ */
+iterator hm_begin(hashmap *h) {
+    return hmi_begin(h);
+}
+
+/**
+ *  @brief  Returns an iterator to one past the last full slot of h
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     iterator at end
+ */
+iterator hm_end(hashmap *h) {
+    return hmi_end(h);
+}
+
+/**
+ *  @brief  Returns the number of entries in h
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     number of entries
+ */
+size_t hm_size(hashmap *h) {
+    assert(h);
+    return h->size;
+}
+
+/**
+ *  @brief  Returns the number of slots in h's table
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     number of slots (up to 7/8 of which may be full)
+ */
+size_t hm_capacity(hashmap *h) {
+    assert(h);
+    return h->capacity;
+}
+
+/**
+ *  @brief  Determines if h has no entries
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     true if h is empty, false otherwise
+ */
+bool hm_empty(hashmap *h) {
+    assert(h);
+    return h->size == 0;
+}
+
+/**
+ *  @brief  Makes room for n entries, so that inserting up to n
+ *          entries in all does not rehash
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  n   number of entries to make room for
+ */
+void hm_reserve(hashmap *h, size_t n) {
+    size_t capacity = HASHMAP_GROUP;
+
+    assert(h);
+
+    while (HASHMAP_MAX_LOAD(capacity) < n) {
+        capacity *= 2;
+    }
+
+    if (capacity > h->capacity) {
+        hm_resize(h, capacity);
+    }
+}
+
+/**
+ *  @brief  Returns the address of the key of the entry at it
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  it  iterator into h
+ *
+ *  @return     address of the key, or NULL if it is at end
+ */
+void *hm_key(hashmap *h, iterator it) {
+    assert(h);
+    return it.curr;
+}
+
+/**
+ *  @brief  Returns the address of the value of the entry at it
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  it  iterator into h
+ *
+ *  @return     address of the value, or NULL if it is at end
+ */
+void *hm_val(hashmap *h, iterator it) {
+    char *entry = it.curr;
+
+    assert(h);
+    return entry ? entry + h->val_offset : NULL;
+}
+
+/**
+ *  @brief  Returns the address of the value mapped to key
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  key address of the key to search for
+ *
+ *  @return     address of the value, or NULL if key is not in h
+ */
+void *hm_find(hashmap *h, const void *key) {
+    char *entry = NULL;
+
+    assert(h);
+    assert(key);
+
+    entry = hm_lookup(h, key, hm_hash(h, key));
+    return entry ? entry + h->val_offset : NULL;
+}
+
+/**
+ *  @brief  Returns the address of the key in h that equals key
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  key address of the key to search for
+ *
+ *  @return     address of h's own copy of the key,
+ *              or NULL if key is not in h
+ */
+void *hm_find_key(hashmap *h, const void *key) {
+    assert(h);
+    assert(key);
+
+    return hm_lookup(h, key, hm_hash(h, key));
+}
+
+/**
+ *  Looks up n keys at once: out[i] receives what hm_find would return
+ *  for the i-th key (the address of its value, or NULL).
+ *
+ *  Lookups proceed in groups of HASHMAP_FIND_GROUP: every key of
+ *  the group is hashed and the control bytes of its first group are
+ *  prefetched, then the first candidate slot of every key is prefetched,
+ *  and only then is any key compared -- so on tables larger than the
+ *  cache, the misses of the group overlap instead of serializing.
+ *
+ *  @param[in]  h       pointer to hashmap
+ *  @param[in]  keys    address of n contiguous keys, ttbl_key->width each
+ *  @param[in]  n       number of keys
+ *  @param[out] out     array of n pointers to fill
+ *
+ *  @return     number of keys found
+ */
+size_t hm_find_many(hashmap *h, const void *keys, size_t n, void **out) {
+    size_t hash[HASHMAP_FIND_GROUP];
+    size_t width = 0;
+    size_t found = 0;
+    size_t base = 0;
+
+    assert(h);
+    assert(n == 0 || (keys && out));
+
+    width = h->ttbl_key->width;
+
+    for (base = 0; base < n; base += HASHMAP_FIND_GROUP) {
+        size_t m = n - base < HASHMAP_FIND_GROUP ? n - base : HASHMAP_FIND_GROUP;
+        const char *key = (const char *)(keys) + base * width;
+        size_t i = 0;
+
+        if (h->capacity == 0) {
+            for (i = 0; i < m; i++) {
+                out[base + i] = NULL;
+            }
+
+            continue;
+        }
+
+        for (i = 0; i < m; i++) {
+            hash[i] = hm_hash(h, key + i * width);
+            PREFETCH(h->ctrl + ((hash[i] >> 7) & (h->capacity - 1) & ~(size_t)(HASHMAP_GROUP - 1)));
+        }
+
+        for (i = 0; i < m; i++) {
+            size_t g = (hash[i] >> 7) & (h->capacity - 1) & ~(size_t)(HASHMAP_GROUP - 1);
+            unsigned match = hm_match(h->ctrl + g, (signed char)(hash[i] & 0x7F));
+
+            if (match) {
+                PREFETCH(h->slots + (g + hm_ctz(match)) * h->entry_width);
+            }
+        }
+
+        for (i = 0; i < m; i++) {
+            char *entry = hm_lookup(h, key + i * width, hash[i]);
+
+            out[base + i] = entry ? entry + h->val_offset : NULL;
+            found += entry != NULL;
+        }
+    }
+
+    return found;
+}
+
+/**
+ *  @brief  Maps key to val, unless key is already in h
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  key address of the key
+ *  @param[in]  val address of the value
+ *
+ *  @return     true if the entry was inserted, false if key was found
+ */
+bool hm_insert(hashmap *h, const void *key, const void *val) {
+    size_t hash = 0;
+
+    assert(h);
+    assert(key);
+    assert(val);
+
+    hash = hm_hash(h, key);
+
+    if (hm_lookup(h, key, hash)) {
+        return false;
+    }
+
+    hm_put(h, hm_emplace(h, hash), key, val);
+    return true;
+}
+
+/**
+ *  @brief  Maps key to val, replacing the value key had, if any
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  key address of the key
+ *  @param[in]  val address of the value
+ *
+ *  @return     true if the entry was inserted, false if it was assigned
+ */
+bool hm_assign(hashmap *h, const void *key, const void *val) {
+    size_t hash = 0;
+    char *entry = NULL;
+    char *slot = NULL;
+
+    assert(h);
+    assert(key);
+    assert(val);
+
+    hash = hm_hash(h, key);
+    entry = hm_lookup(h, key, hash);
+
+    if (entry == NULL) {
+        hm_put(h, hm_emplace(h, hash), key, val);
+        return true;
+    }
+
+    slot = entry + h->val_offset;
+
+    if (slot != val) {
+        if (h->ttbl_val->dtor) {
+            h->ttbl_val->dtor(slot);
+        }
+
+        if (h->ttbl_val->copy) {
+            h->ttbl_val->copy(slot, val);
+        } else {
+            memcpy(slot, val, h->ttbl_val->width);
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  @brief  Removes the entry with key from h, if there is one
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  key address of the key
+ */
+void hm_erase(hashmap *h, const void *key) {
+    char *entry = NULL;
+    size_t i = 0;
+
+    assert(h);
+    assert(key);
+
+    entry = hm_lookup(h, key, hm_hash(h, key));
+
+    if (entry == NULL) {
+        return;
+    }
+
+    i = (size_t)(entry - h->slots) / h->entry_width;
+
+    if (hm_match_empty(h->ctrl + (i & ~(size_t)(HASHMAP_GROUP - 1)))) {
+        h->ctrl[i] = HASHMAP_EMPTY;
+        ++h->growth_left;
+    } else {
+        h->ctrl[i] = HASHMAP_DELETED;
+    }
+
+    --h->size;
+    hm_destroy(h, entry);
+}
+
+/**
+ *  @brief  Removes every entry from h, keeping its table
+ *
+ *  @param[in]  h   pointer to hashmap
+ */
+void hm_clear(hashmap *h) {
+    size_t i = 0;
+
+    assert(h);
+
+    if (h->ttbl_key->dtor || h->ttbl_val->dtor) {
+        for (i = 0; i < h->capacity; i++) {
+            if (h->ctrl[i] >= 0) {
+                hm_destroy(h, h->slots + i * h->entry_width);
+            }
+        }
+    }
+
+    if (h->capacity > 0) {
+        memset(h->ctrl, HASHMAP_EMPTY, h->capacity);
+    }
+
+    h->size = 0;
+    h->growth_left = HASHMAP_MAX_LOAD(h->capacity);
+}
+
+/**
+ *  @brief  Returns the typetable of h's keys
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     ttbl_key
+ */
+struct typetable *hm_get_key_ttbl(hashmap *h) {
+    assert(h);
+    return h->ttbl_key;
+}
+
+/**
+ *  @brief  Returns the typetable of h's values
+ *
+ *  @param[in]  h   pointer to hashmap
+ *
+ *  @return     ttbl_val
+ */
+struct typetable *hm_get_val_ttbl(hashmap *h) {
+    assert(h);
+    return h->ttbl_val;
+}
+
+/**
+ *  @brief  Returns the alignment a key or value of width bytes needs
+ *
+ *  That is the largest power of two that divides width,
+ *  capped at HASHMAP_MAX_ALIGN -- or 1, for a value of no width,
+ *  so that such entries are exactly as wide as their keys.
+ *
+ *  @param[in]  width   size of the key or value type
+ *
+ *  @return     alignment, in bytes
+ */
+static size_t hm_align(size_t width) {
+    size_t align = 1;
+
+    if (width == 0) {
+        return align;
+    }
+
+    while (align < HASHMAP_MAX_ALIGN && width % (align * 2) == 0) {
+        align *= 2;
+    }
+
+    return align;
+}
+
+/**
+ *  @brief  Hashes key with ttbl_key->hash, or else by its bytes
+ *
+ *  @param[in]  h   pointer to hashmap
+ *  @param[in]  key address of the key
+ *
+ *  @return     hash of key
+ */
+static size_t hm_hash(hashmap *h, const void *key) {
+    if (h->ttbl_key->hash) {
+        return h->ttbl_key->hash(key);
+    }
+
+    return hash_bytes(key, h->ttbl_key->width);
+}
+
+/**
+ *  @brief  Returns the index of the lowest set bit of mask (nonzero)
+ */
+static unsigned hm_ctz(unsigned mask) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i = 0;
+
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++i;
+    }
+
+    return i;
+#endif /* defined(__GNUC__) */
+}
+
+/**
+ *  @brief  Returns a mask with bit i set iff group[i] == h2
+ *
+ *  @param[in]  group   address of HASHMAP_GROUP control bytes
+ *  @param[in]  h2      control byte to match
+ */
+static unsigned hm_match(const signed char *group, signed char h2) {
+#if defined(__SSE2__)
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)(group));
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+#else
+    unsigned mask = 0;
+    int i = 0;
+
+    for (i = 0; i < HASHMAP_GROUP; i++) {
+        mask |= (unsigned)(group[i] == h2) << i;
+    }
+
+    return mask;
+#endif /* defined(__SSE2__) */
+}
+
+/**
+ *  @brief  Returns a mask with bit i set iff group[i] is empty
+ *
+ *  @param[in]  group   address of HASHMAP_GROUP control bytes
+ */
+static unsigned hm_match_empty(const signed char *group) {
+    return hm_match(group, HASHMAP_EMPTY);
+}
+
+/**
+ *  @brief  Returns a mask with bit i set iff group[i] is empty or deleted
+ *
+ *  Those are exactly the control bytes with the sign bit set.
+ *
+ *  @param[in]  group   address of HASHMAP_GROUP control bytes
+ */
+static unsigned hm_match_free(const signed char *group) {
+#if defined(__SSE2__)
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(group)));
+#else
+    unsigned mask = 0;
+    int i = 0;
+
+    for (i = 0; i < HASHMAP_GROUP; i++) {
+        mask |= (unsigned)(group[i] < 0) << i;
+    }
+
+    return mask;
+#endif /* defined(__SSE2__) */
+}
+
+/**
+ *  @brief  Finds the entry of h whose key equals key
+ *
+ *  @param[in]  h       pointer to hashmap
+ *  @param[in]  key     address of the key
+ *  @param[in]  hash    hm_hash(h, key)
+ *
+ *  @return     address of the entry, or NULL if key is not in h
+ */
+static char *hm_lookup(hashmap *h, const void *key, size_t hash) {
+    int (*compare)(const void *, const void *) = h->ttbl_key->compare;
+    bool (*equals)(const void *, const void *) = h->ttbl_key->equals;
+    signed char h2 = (signed char)(hash & 0x7F);
+    size_t mask = h->capacity - 1;
+    size_t g = 0;
+    size_t step = 0;
+
+    if (h->capacity == 0) {
+        return NULL;
+    }
+
+    g = (hash >> 7) & mask & ~(size_t)(HASHMAP_GROUP - 1);
+
+    for (;;) {
+        const signed char *group = h->ctrl + g;
+        unsigned match = hm_match(group, h2);
+
+        while (match) {
+            char *entry = h->slots + (g + hm_ctz(match)) * h->entry_width;
+
+            if (equals ? equals(entry, key) != false
+                       : compare(entry, key) == 0) {
+                return entry;
+            }
+
+            match &= match - 1;
+        }
+
+        if (hm_match_empty(group)) {
+            return NULL;
+        }
+
+        step += HASHMAP_GROUP;
+        g = (g + step) & mask;
+    }
+}
+
+/**
+ *  @brief  Returns the index of the first empty or deleted slot
+ *          in the probe sequence of hash
+ *
+ *  @param[in]  h       pointer to hashmap (capacity > 0)
+ *  @param[in]  hash    hash of the key to place
+ */
+static size_t hm_free_slot(hashmap *h, size_t hash) {
+    size_t mask = h->capacity - 1;
+    size_t g = (hash >> 7) & mask & ~(size_t)(HASHMAP_GROUP - 1);
+    size_t step = 0;
+
+    for (;;) {
+        unsigned match = hm_match_free(h->ctrl + g);
+
+        if (match) {
+            return g + hm_ctz(match);
+        }
+
+        step += HASHMAP_GROUP;
+        g = (g + step) & mask;
+    }
+}
+
+/**
+ *  @brief  Claims a slot for a new entry with the given hash
+ *
+ *  The key must not be in h. If the slot the key would take is empty
+ *  and no growth is left, the table is rehashed first: in place,
+ *  if tombstones are taking up most of the load (so the table
+ *  is cleaned up instead of grown), or else into twice the capacity.
+ *
+ *  @param[in]  h       pointer to hashmap
+ *  @param[in]  hash    hash of the key of the new entry
+ *
+ *  @return     address of the new entry's (uninitialized) slot
+ */
+static char *hm_emplace(hashmap *h, size_t hash) {
+    size_t i = 0;
+
+    if (h->capacity == 0) {
+        hm_resize(h, HASHMAP_GROUP);
+    }
+
+    i = hm_free_slot(h, hash);
+
+    if (h->growth_left == 0 && h->ctrl[i] == HASHMAP_EMPTY) {
+        if (h->size < HASHMAP_MAX_LOAD(h->capacity) / 2) {
+            hm_resize(h, h->capacity);
+        } else {
+            hm_resize(h, h->capacity * 2);
+        }
+
+        i = hm_free_slot(h, hash);
+    }
+
+    if (h->ctrl[i] == HASHMAP_EMPTY) {
+        --h->growth_left;
+    }
+
+    h->ctrl[i] = (signed char)(hash & 0x7F);
+    ++h->size;
+
+    return h->slots + i * h->entry_width;
+}
+
+/**
+ *  @brief  Moves every entry of h into a new table of the given capacity
+ *
+ *  Tombstones are dropped along the way; entries are moved with memcpy.
+ *
+ *  @param[in]  h           pointer to hashmap
+ *  @param[in]  capacity    power of two, no smaller than HASHMAP_GROUP,
+ *                          with room for h->size entries
+ */
+static void hm_resize(hashmap *h, size_t capacity) {
+    signed char *ctrl = h->ctrl;
+    char *slots = h->slots;
+    size_t old_capacity = h->capacity;
+    size_t i = 0;
+
+    h->ctrl = malloc(capacity);
+    massert_malloc(h->ctrl);
+    memset(h->ctrl, HASHMAP_EMPTY, capacity);
+
+    h->slots = malloc(capacity * h->entry_width);
+    massert_malloc(h->slots);
+
+    h->capacity = capacity;
+    h->growth_left = HASHMAP_MAX_LOAD(capacity) - h->size;
+
+    for (i = 0; i < old_capacity; i++) {
+        if (ctrl[i] >= 0) {
+            char *entry = slots + i * h->entry_width;
+            size_t hash = hm_hash(h, entry);
+            size_t j = hm_free_slot(h, hash);
+
+            h->ctrl[j] = (signed char)(hash & 0x7F);
+            memcpy(h->slots + j * h->entry_width, entry, h->entry_width);
+        }
+    }
+
+    free(ctrl);
+    free(slots);
+}
+
+/**
+ *  @brief  Copies key and val into entry, with their copy functions if any
+ *
+ *  @param[in]  h       pointer to hashmap
+ *  @param[out] entry   address of an entry of h
+ *  @param[in]  key     address of the key
+ *  @param[in]  val     address of the value
+ */
+static void hm_put(hashmap *h, char *entry, const void *key, const void *val) {
+    if (h->ttbl_key->copy) {
+        h->ttbl_key->copy(entry, key);
+    } else {
+        memcpy(entry, key, h->ttbl_key->width);
+    }
+
+    if (h->ttbl_val->copy) {
+        h->ttbl_val->copy(entry + h->val_offset, val);
+    } else {
+        memcpy(entry + h->val_offset, val, h->ttbl_val->width);
+    }
+}
+
+/**
+ *  @brief  Applies the key and value dtor functions (if any) to entry
+ *
+ *  @param[in]  h       pointer to hashmap
+ *  @param[in]  entry   address of an entry of h
+ */
+static void hm_destroy(hashmap *h, char *entry) {
+    if (h->ttbl_key->dtor) {
+        h->ttbl_key->dtor(entry);
+    }
+
+    if (h->ttbl_val->dtor) {
+        h->ttbl_val->dtor(entry + h->val_offset);
+    }
+}
+
+static iterator hmi_begin(void *arg) {
+    hashmap *h = (hashmap *)(arg);
+    iterator it;
+
+    assert(h);
+
+    it.itbl = _hashmap_iterator_;
+    it.container = h;
+    it.curr = hmi_first(h, 0);
+
+    return it;
+}
+
+static iterator hmi_end(void *arg) {
+    hashmap *h = (hashmap *)(arg);
+    iterator it;
+
+    assert(h);
+
+    it.itbl = _hashmap_iterator_;
+    it.container = h;
+    it.curr = NULL;
+
+    return it;
+}
+
+static iterator hmi_next(iterator it) {
+    iterator iter = it;
+    hmi_incr(&iter);
+    return iter;
+}
+
+static iterator hmi_next_n(iterator it, int n) {
+    iterator iter = it;
+    hmi_advance(&iter, n);
+    return iter;
+}
+
+static iterator hmi_prev(iterator it) {
+    iterator iter = it;
+    hmi_decr(&iter);
+    return iter;
+}
+
+static iterator hmi_prev_n(iterator it, int n) {
+    iterator iter = it;
+    hmi_advance(&iter, -n);
+    return iter;
+}
+
+static int hmi_distance(iterator *first, iterator *last) {
+    if (first == NULL && last != NULL) {
+        return hmi_index(*last);
+    } else if (last == NULL && first != NULL) {
+        return hmi_index(*first);
+    } else if (first == NULL && last == NULL) {
+        ERROR(__FILE__, "Both iterator first and last are NULL.");
+        return 0;
+    } else {
+        return hmi_index(*last) - hmi_index(*first);
+    }
+}
+
+static iterator *hmi_advance(iterator *it, int n) {
+    hashmap *h = NULL;
+    int pos = 0;
+
+    massert_iterator(it);
+
+    h = it->container;
+    pos = hmi_index(*it);
+
+    if (pos + n < 0 || (size_t)(pos + n) > h->size) {
+        char str[256];
+        sprintf(str, "Cannot advance %d times from position %d.", n, pos);
+        ERROR(__FILE__, str);
+    } else {
+        for (; n > 0; n--) {
+            hmi_incr(it);
+        }
+
+        for (; n < 0; n++) {
+            hmi_decr(it);
+        }
+    }
+
+    return it;
+}
+
+static iterator *hmi_incr(iterator *it) {
+    hashmap *h = NULL;
+
+    massert_iterator(it);
+
+    h = it->container;
+
+    if (it->curr == NULL) {
+        ERROR(__FILE__, "Cannot increment - already at end.");
+    } else {
+        size_t i = (size_t)((char *)(it->curr) - h->slots) / h->entry_width;
+        it->curr = hmi_first(h, i + 1);
+    }
+
+    return it;
+}
+
+static iterator *hmi_decr(iterator *it) {
+    hashmap *h = NULL;
+    char *entry = NULL;
+
+    massert_iterator(it);
+
+    h = it->container;
+
+    if (it->curr) {
+        entry = hmi_last(h, (size_t)((char *)(it->curr) - h->slots) / h->entry_width);
+    } else {
+        entry = hmi_last(h, h->capacity);
+    }
+
+    if (entry == NULL) {
+        ERROR(__FILE__, "Cannot decrement this iterator, already at begin.");
+    } else {
+        it->curr = entry;
+    }
+
+    return it;
+}
+
+static void *hmi_curr(iterator it) {
+    return it.curr;
+}
+
+static void *hmi_start(iterator it) {
+    return hmi_first(it.container, 0);
+}
+
+static void *hmi_finish(iterator it) {
+    /**< end has no entry; hmi_curr yields NULL there, as does finish */
+    (void)it;
+    return NULL;
+}
+
+static bool hmi_has_next(iterator it) {
+    return it.curr != NULL;
+}
+
+static bool hmi_has_prev(iterator it) {
+    hashmap *h = it.container;
+    size_t i = h->capacity;
+
+    if (it.curr) {
+        i = (size_t)((char *)(it.curr) - h->slots) / h->entry_width;
+    }
+
+    return hmi_last(h, i) != NULL;
+}
+
+static struct typetable *hmi_get_ttbl(void *arg) {
+    hashmap *h = (hashmap *)(arg);
+    return h->ttbl_key;
+}
+
+/**
+ *  @brief  Returns the first full entry at or after slot from, or NULL
+ */
+static char *hmi_first(hashmap *h, size_t from) {
+    size_t i = 0;
+
+    for (i = from; i < h->capacity; i++) {
+        if (h->ctrl[i] >= 0) {
+            return h->slots + i * h->entry_width;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ *  @brief  Returns the last full entry before slot before, or NULL
+ */
+static char *hmi_last(hashmap *h, size_t before) {
+    size_t i = before;
+
+    while (i > 0) {
+        --i;
+
+        if (h->ctrl[i] >= 0) {
+            return h->slots + i * h->entry_width;
+        }
+    }
+
+    return NULL;
+}
+
+static int hmi_index(iterator it) {
+    hashmap *h = it.container;
+    char *entry = NULL;
+    int index = 0;
+
+    if (it.curr == NULL) {
+        return (int)(h->size);
+    }
+
+    for (entry = hmi_first(h, 0); entry != it.curr;
+         entry = hmi_first(h, (size_t)(entry - h->slots) / h->entry_width + 1)) {
+        ++index;
+    }
+
+    return index;
+}
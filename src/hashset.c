@@ -0,0 +1,254 @@
+/**
+ *  @file       hashset.c
+ *  @brief      Source file for an unordered container of unique elements
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hashset.h"
+#include "hashmap.h"
+
+/**
+ *  @struct     hashset
+ *  @brief      A hashmap of elements to values of no width
+ */
+struct hashset {
+    hashmap *h;
+};
+
+/**
+ *  Values of a hashset's hashmap -- they take up no room in the slots
+ */
+static struct typetable ttbl_hashset_none = {
+    0,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+/**
+ *  @brief  Allocates and initializes a new, empty hashset
+ *
+ *  @param[in]  ttbl    typetable of the elements
+ *                      (must have equals or compare)
+ *
+ *  @return     pointer to hashset
+ */
+hashset *hs_new(struct typetable *ttbl) {
+    hashset *s = malloc(sizeof *s);
+    massert_malloc(s);
+
+    s->h = hm_new(ttbl, &ttbl_hashset_none);
+    return s;
+}
+
+/**
+ *  @brief  Allocates a new hashset and deep copies the elements of s into it
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     pointer to hashset
+ */
+hashset *hs_newcopy(hashset *s) {
+    hashset *copy = NULL;
+
+    assert(s);
+
+    copy = malloc(sizeof *copy);
+    massert_malloc(copy);
+
+    copy->h = hm_newcopy(s->h);
+    return copy;
+}
+
+/**
+ *  @brief  Releases every element of (*s), then (*s) itself
+ *
+ *  @param[out] s   address of pointer to hashset
+ */
+void hs_delete(hashset **s) {
+    assert(s);
+    assert(*s);
+
+    hm_delete(&(*s)->h);
+
+    free(*s);
+    *s = NULL;
+}
+
+/**
+ *  @brief  Returns an iterator to the first full slot of s
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     iterator at the first element (in slot order)
+ */
+iterator hs_begin(hashset *s) {
+    assert(s);
+    return hm_begin(s->h);
+}
+
+/**
+ *  @brief  Returns an iterator to one past the last full slot of s
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     iterator at end
+ */
+iterator hs_end(hashset *s) {
+    assert(s);
+    return hm_end(s->h);
+}
+
+/**
+ *  @brief  Returns the number of elements in s
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     number of elements
+ */
+size_t hs_size(hashset *s) {
+    assert(s);
+    return hm_size(s->h);
+}
+
+/**
+ *  @brief  Returns the number of slots in s's table
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     number of slots (up to 7/8 of which may be full)
+ */
+size_t hs_capacity(hashset *s) {
+    assert(s);
+    return hm_capacity(s->h);
+}
+
+/**
+ *  @brief  Determines if s has no elements
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     true if s is empty, false otherwise
+ */
+bool hs_empty(hashset *s) {
+    assert(s);
+    return hm_empty(s->h);
+}
+
+/**
+ *  @brief  Makes room for n elements, so that inserting up to n
+ *          elements in all does not rehash
+ *
+ *  @param[in]  s   pointer to hashset
+ *  @param[in]  n   number of elements to make room for
+ */
+void hs_reserve(hashset *s, size_t n) {
+    assert(s);
+    hm_reserve(s->h, n);
+}
+
+/**
+ *  @brief  Inserts valaddr into s, unless an equal element is present
+ *
+ *  @param[in]  s       pointer to hashset
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     true if valaddr was inserted, false if it was found
+ */
+bool hs_insert(hashset *s, const void *valaddr) {
+    assert(s);
+
+    /**< the value has no width: any address will do */
+    return hm_insert(s->h, valaddr, valaddr);
+}
+
+/**
+ *  @brief  Removes the element equal to valaddr from s, if there is one
+ *
+ *  @param[in]  s       pointer to hashset
+ *  @param[in]  valaddr address of the element
+ */
+void hs_erase(hashset *s, const void *valaddr) {
+    assert(s);
+    hm_erase(s->h, valaddr);
+}
+
+/**
+ *  @brief  Removes every element from s, keeping its table
+ *
+ *  @param[in]  s   pointer to hashset
+ */
+void hs_clear(hashset *s) {
+    assert(s);
+    hm_clear(s->h);
+}
+
+/**
+ *  @brief  Returns the address of the element in s equal to valaddr
+ *
+ *  @param[in]  s       pointer to hashset
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     address of s's own copy of the element,
+ *              or NULL if valaddr is not in s
+ */
+void *hs_find(hashset *s, const void *valaddr) {
+    assert(s);
+    return hm_find_key(s->h, valaddr);
+}
+
+/**
+ *  @brief  Returns the number of elements equal to valaddr (0 or 1)
+ *
+ *  @param[in]  s       pointer to hashset
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     1 if valaddr is in s, 0 otherwise
+ */
+size_t hs_count(hashset *s, const void *valaddr) {
+    return hs_find(s, valaddr) ? 1 : 0;
+}
+
+/**
+ *  @brief  Returns the typetable of s's elements
+ *
+ *  @param[in]  s   pointer to hashset
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *hs_get_ttbl(hashset *s) {
+    assert(s);
+    return hm_get_key_ttbl(s->h);
+}
@@ -0,0 +1,327 @@
+/**
+ *  @file       ilist.c
+ *  @brief      Source file for an intrusive doubly-linked list
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ilist.h"
+#include "utils.h"
+
+#include <stdlib.h>
+
+/**
+ *  @brief  Initializes an empty ilist
+ *
+ *  @param[in]  l   pointer to ilist
+ */
+void il_init(ilist *l) {
+    massert_container(l);
+
+    l->head.next = &(l->head);
+    l->head.prev = &(l->head);
+    l->size = 0;
+}
+
+/**
+ *  @brief  Initializes a node as unlinked (self-linked)
+ *
+ *  @param[in]  n   pointer to list_node_base embedded in a client struct
+ *
+ *  Calling this on a node before it is first linked
+ *  makes il_linked meaningful for that node.
+ */
+void il_node_init(list_node_base *n) {
+    massert_ptr(n);
+
+    n->next = n;
+    n->prev = n;
+}
+
+/**
+ *  @brief  Returns the number of nodes linked into l
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     number of nodes in l
+ */
+size_t il_size(ilist *l) {
+    massert_container(l);
+    return l->size;
+}
+
+/**
+ *  @brief  Determines if l has no nodes
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     true if l is empty, false otherwise
+ */
+bool il_empty(ilist *l) {
+    massert_container(l);
+    return l->head.next == &(l->head);
+}
+
+/**
+ *  @brief  Determines if n is currently linked into a list
+ *
+ *  @param[in]  n   pointer to list_node_base
+ *
+ *  @return     true if n is linked, false if n is self-linked
+ */
+bool il_linked(list_node_base *n) {
+    massert_ptr(n);
+    return n->next != n;
+}
+
+/**
+ *  @brief  Retrieves the front node of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     front node, NULL if l is empty
+ */
+list_node_base *il_front(ilist *l) {
+    massert_container(l);
+    return l->head.next != &(l->head) ? l->head.next : NULL;
+}
+
+/**
+ *  @brief  Retrieves the back node of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     back node, NULL if l is empty
+ */
+list_node_base *il_back(ilist *l) {
+    massert_container(l);
+    return l->head.prev != &(l->head) ? l->head.prev : NULL;
+}
+
+/**
+ *  @brief  Retrieves the front node of l, or il_end(l) if l is empty
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     first node of the range [il_begin(l), il_end(l))
+ */
+list_node_base *il_begin(ilist *l) {
+    massert_container(l);
+    return l->head.next;
+}
+
+/**
+ *  @brief  Retrieves the sentinel of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     one-past-the-end node of l (never dereference its entry)
+ */
+list_node_base *il_end(ilist *l) {
+    massert_container(l);
+    return &(l->head);
+}
+
+/**
+ *  @brief  Links n at the front of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *  @param[in]  n   unlinked node
+ */
+void il_pushf(ilist *l, list_node_base *n) {
+    il_insert(l, l->head.next, n);
+}
+
+/**
+ *  @brief  Links n at the back of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *  @param[in]  n   unlinked node
+ */
+void il_pushb(ilist *l, list_node_base *n) {
+    il_insert(l, &(l->head), n);
+}
+
+/**
+ *  @brief  Unlinks and returns the front node of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     former front node, NULL if l was empty
+ */
+list_node_base *il_popf(ilist *l) {
+    list_node_base *n = il_front(l);
+
+    if (n) {
+        il_erase(l, n);
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Unlinks and returns the back node of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *
+ *  @return     former back node, NULL if l was empty
+ */
+list_node_base *il_popb(ilist *l) {
+    list_node_base *n = il_back(l);
+
+    if (n) {
+        il_erase(l, n);
+    }
+
+    return n;
+}
+
+/**
+ *  @brief  Links n into l, immediately before pos
+ *
+ *  @param[in]  l   pointer to ilist
+ *  @param[in]  pos node of l (or il_end(l)) to insert before
+ *  @param[in]  n   unlinked node
+ */
+void il_insert(ilist *l, list_node_base *pos, list_node_base *n) {
+    massert_container(l);
+    massert_ptr(pos);
+    massert_ptr(n);
+
+    lnb_hook(n, pos);
+    ++l->size;
+}
+
+/**
+ *  @brief  Unlinks n from l; n is left self-linked
+ *
+ *  @param[in]  l   pointer to ilist that n is linked into
+ *  @param[in]  n   node of l
+ */
+void il_erase(ilist *l, list_node_base *n) {
+    massert_container(l);
+    massert_ptr(n);
+
+    lnb_unhook(n);
+    il_node_init(n);
+
+    --l->size;
+}
+
+/**
+ *  @brief  Relinks n, already in l, at the front of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *  @param[in]  n   node of l
+ */
+void il_move_front(ilist *l, list_node_base *n) {
+    massert_container(l);
+    massert_ptr(n);
+
+    if (l->head.next != n) {
+        lnb_unhook(n);
+        lnb_hook(n, l->head.next);
+    }
+}
+
+/**
+ *  @brief  Relinks n, already in l, at the back of l
+ *
+ *  @param[in]  l   pointer to ilist
+ *  @param[in]  n   node of l
+ */
+void il_move_back(ilist *l, list_node_base *n) {
+    massert_container(l);
+    massert_ptr(n);
+
+    if (l->head.prev != n) {
+        lnb_unhook(n);
+        lnb_hook(n, &(l->head));
+    }
+}
+
+/**
+ *  @brief  Moves every node of other into l, before pos, in O(1)
+ *
+ *  @param[in]  l       pointer to ilist
+ *  @param[in]  pos     node of l (or il_end(l)) to insert before
+ *  @param[in]  other   pointer to ilist; left empty
+ */
+void il_splice(ilist *l, list_node_base *pos, ilist *other) {
+    massert_container(l);
+    massert_container(other);
+    massert_ptr(pos);
+
+    if (other->head.next != &(other->head)) {
+        lnb_transfer(pos, other->head.next, &(other->head));
+
+        l->size += other->size;
+        other->size = 0;
+    }
+}
+
+/**
+ *  @brief  Exchanges the nodes of l and other, in O(1)
+ *
+ *  @param[in]  l       pointer to ilist
+ *  @param[in]  other   pointer to ilist
+ */
+void il_swap(ilist *l, ilist *other) {
+    ilist temp;
+
+    massert_container(l);
+    massert_container(other);
+
+    il_init(&temp);
+
+    il_splice(&temp, &(temp.head), l);
+    il_splice(l, &(l->head), other);
+    il_splice(other, &(other->head), &temp);
+}
+
+/**
+ *  @brief  Unlinks every node of l
+ *
+ *  @param[in]  l       pointer to ilist
+ *  @param[in]  release function to call on each node after it is
+ *                      unlinked (e.g. to free its entry), or NULL
+ */
+void il_clear(ilist *l, void (*release)(list_node_base *)) {
+    list_node_base *pos = NULL;
+    list_node_base *tmp = NULL;
+
+    massert_container(l);
+
+    il_foreach_safe(pos, tmp, l) {
+        il_node_init(pos);
+
+        if (release) {
+            release(pos);
+        }
+    }
+
+    il_init(l);
+}
@@ -0,0 +1,438 @@
+/**
+ *  @file       intern.c
+ *  @brief      Source file for a pool of interned (canonical) strings
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intern.h"
+#include "hashset.h"
+
+/**
+ *  @struct     intern_entry
+ *  @brief      An interned string, preceded by what the pool knows of it
+ *
+ *  The canonical address of the string is that of str; the entry is
+ *  carved out of an intern_block, with room for the whole string
+ *  (and its null terminator). self is the address of str, so that
+ *  a (char *) that merely lands inside a block (e.g. a suffix of an
+ *  interned string) is not mistaken for the start of an entry.
+ *  rank is the string's position (from 1) in sorted order, as of the
+ *  last str_intern_rank, or 0 if it was interned since.
+ */
+struct intern_entry {
+    const char *self;
+    size_t hash;
+    size_t rank;
+    char str[1];
+};
+
+/**
+ *  @def        INTERN_ENTRY
+ *  @brief      Returns the (struct intern_entry *) of interned string STR
+ */
+#define INTERN_ENTRY(STR) \
+((struct intern_entry *)((char *)(STR) - offsetof(struct intern_entry, str)))
+
+/**
+ *  @def        INTERN_ALIGN
+ *  @brief      Alignment of every entry within a block
+ */
+#define INTERN_ALIGN \
+(sizeof(size_t) > sizeof(char *) ? sizeof(size_t) : sizeof(char *))
+
+/**
+ *  @def        INTERN_BLOCK_SIZE
+ *  @brief      Size of the first block; each new block is twice
+ *              the size of the last, up to INTERN_BLOCK_SIZE << 16
+ */
+#define INTERN_BLOCK_SIZE 4096
+#define INTERN_BLOCK_MAX 64
+
+/**
+ *  @struct     intern_block
+ *  @brief      A range of memory that the pool carves entries out of
+ *
+ *  Blocks are only ever appended (until str_intern_clear), and
+ *  intern_block_count is published after the block it counts, so
+ *  str_interned_entry may scan the blocks without taking intern_lock.
+ */
+struct intern_block {
+    char *begin;
+    char *end;
+};
+
+static struct intern_block intern_blocks[INTERN_BLOCK_MAX];
+static size_t intern_block_count = 0;
+static char *intern_block_next = NULL;
+
+/**
+ *  The pool indexes the canonical (char *) of every entry, by content.
+ *  It is created upon the first str_intern, and guarded by intern_lock.
+ */
+static struct typetable ttbl_intern_pool = {
+    sizeof(char *),
+    NULL,
+    NULL,
+    str_swap,
+    str_compare,
+    str_print,
+    str_hash,
+    str_equals
+};
+
+static hashset *intern_pool = NULL;
+static pthread_mutex_t intern_lock = PTHREAD_MUTEX_INITIALIZER;
+
+struct typetable ttbl_str_interned = {
+    sizeof(char *),
+    str_interned_copy,
+    str_interned_dtor,
+    str_swap,
+    str_interned_compare,
+    str_print,
+    str_interned_hash,
+    str_interned_equals
+};
+
+struct typetable *_str_interned_ = &ttbl_str_interned;
+
+static struct intern_entry *intern_alloc(size_t len);
+static struct intern_entry *str_interned_entry(const char *str);
+
+/**
+ *  @brief  Returns the canonical copy of str, interning it if needed
+ *
+ *  @param[in]  str     null-terminated string
+ *
+ *  @return     address of the pool's copy of str -- the same address
+ *              for every string equal to str, until str_intern_clear
+ */
+const char *str_intern(const char *str) {
+    char *canonical = NULL;
+    void *found = NULL;
+
+    assert(str);
+
+    pthread_mutex_lock(&intern_lock);
+
+    if (intern_pool == NULL) {
+        intern_pool = hs_new(&ttbl_intern_pool);
+    }
+
+    found = hs_find(intern_pool, &str);
+
+    if (found) {
+        canonical = *(char **)(found);
+    } else {
+        size_t len = strlen(str);
+        struct intern_entry *entry = NULL;
+
+        entry = intern_alloc(len);
+
+        entry->self = entry->str;
+        entry->hash = str_hash(&str);
+        entry->rank = 0;
+        memcpy(entry->str, str, len + 1);
+
+        canonical = entry->str;
+        hs_insert(intern_pool, &canonical);
+    }
+
+    pthread_mutex_unlock(&intern_lock);
+    return canonical;
+}
+
+/**
+ *  @brief  Returns the canonical copy of str, if str was interned
+ *
+ *  @param[in]  str     null-terminated string
+ *
+ *  @return     address of the pool's copy of str, or NULL
+ */
+const char *str_intern_find(const char *str) {
+    char *canonical = NULL;
+
+    assert(str);
+
+    pthread_mutex_lock(&intern_lock);
+
+    if (intern_pool) {
+        void *found = hs_find(intern_pool, &str);
+        canonical = found ? *(char **)(found) : NULL;
+    }
+
+    pthread_mutex_unlock(&intern_lock);
+    return canonical;
+}
+
+/**
+ *  @brief  Returns the number of distinct strings in the pool
+ *
+ *  @return     number of interned strings
+ */
+size_t str_intern_count(void) {
+    size_t count = 0;
+
+    pthread_mutex_lock(&intern_lock);
+    count = intern_pool ? hs_size(intern_pool) : 0;
+    pthread_mutex_unlock(&intern_lock);
+
+    return count;
+}
+
+/**
+ *  @brief  Sorts the pool, and stores every string's rank alongside it
+ *
+ *  Afterwards, str_interned_compare orders any two strings in the pool
+ *  by comparing their ranks. Call it once the strings of interest
+ *  have been interned (e.g. after loading a data set) -- it takes
+ *  O(k log k) string comparisons, for k interned strings.
+ */
+void str_intern_rank(void) {
+    char **sorted = NULL;
+    size_t count = 0;
+    size_t i = 0;
+    iterator it;
+
+    pthread_mutex_lock(&intern_lock);
+
+    count = intern_pool ? hs_size(intern_pool) : 0;
+
+    if (count > 0) {
+        sorted = malloc(count * sizeof *sorted);
+        massert_malloc(sorted);
+
+        for (it = hs_begin(intern_pool); it_curr(it); it_incr(&it)) {
+            sorted[i++] = *(char **)(it_curr(it));
+        }
+
+        qsort(sorted, count, sizeof *sorted, str_compare);
+
+        for (i = 0; i < count; i++) {
+            INTERN_ENTRY(sorted[i])->rank = i + 1;
+        }
+
+        free(sorted);
+    }
+
+    pthread_mutex_unlock(&intern_lock);
+}
+
+/**
+ *  @brief  Frees every interned string, and the pool itself
+ *
+ *  Every address returned by str_intern (and every container element
+ *  of type _str_interned_) is invalid afterwards.
+ */
+void str_intern_clear(void) {
+    size_t i = 0;
+
+    pthread_mutex_lock(&intern_lock);
+
+    if (intern_pool) {
+        hs_delete(&intern_pool);
+    }
+
+    for (i = 0; i < intern_block_count; i++) {
+        free(intern_blocks[i].begin);
+    }
+
+    intern_block_count = 0;
+    intern_block_next = NULL;
+
+    pthread_mutex_unlock(&intern_lock);
+}
+
+/**
+ *  @brief  Stores the canonical copy of (*other) at arg
+ *
+ *  @param[out] arg     address of a (char *)
+ *  @param[in]  other   address of a (char *) -- interned or not
+ *
+ *  @return     the canonical (char *)
+ */
+void *str_interned_copy(void *arg, const void *other) {
+    char **target = (char **)(arg);
+    char **source = (char **)(other);
+
+    (*target) = (char *)(str_intern((*source)));
+    return (*target);
+}
+
+/**
+ *  @brief  Does nothing -- the pool owns every interned string
+ *
+ *  @param[in]  arg     address of a (char *)
+ */
+void str_interned_dtor(void *arg) {
+    (void)arg;
+}
+
+/**
+ *  @brief  Compares two strings, as str_compare would
+ *
+ *  @param[in]  c1  address of a (char *) -- interned or not
+ *  @param[in]  c2  address of a (char *) -- interned or not
+ *
+ *  @return     < 0, 0, > 0, as (*c1) sorts before, equal to, after (*c2)
+ */
+int str_interned_compare(const void *c1, const void *c2) {
+    char *first = *(char **)(c1);
+    char *second = *(char **)(c2);
+    struct intern_entry *entry_first = NULL;
+    struct intern_entry *entry_second = NULL;
+
+    if (first == second) {
+        return 0;
+    }
+
+    entry_first = str_interned_entry(first);
+    entry_second = entry_first ? str_interned_entry(second) : NULL;
+
+    if (entry_second && entry_first->rank && entry_second->rank) {
+        return entry_first->rank < entry_second->rank ? -1 : 1;
+    }
+
+    return strcmp(first, second);
+}
+
+/**
+ *  @brief  Returns the hash of a string (equal to str_hash of it) --
+ *          for an interned string, the one computed when it was interned
+ *
+ *  @param[in]  arg     address of a (char *) -- interned or not
+ */
+size_t str_interned_hash(const void *arg) {
+    struct intern_entry *entry = str_interned_entry(*(char **)(arg));
+    return entry ? entry->hash : str_hash(arg);
+}
+
+/**
+ *  @brief  Determines if two strings are equal -- two interned strings,
+ *          by their addresses alone
+ *
+ *  @param[in]  c1  address of a (char *) -- interned or not
+ *  @param[in]  c2  address of a (char *) -- interned or not
+ */
+bool str_interned_equals(const void *c1, const void *c2) {
+    char *first = *(char **)(c1);
+    char *second = *(char **)(c2);
+
+    if (first == second) {
+        return true;
+    }
+
+    if (str_interned_entry(first) && str_interned_entry(second)) {
+        return false;
+    }
+
+    return strcmp(first, second) == 0 ? true : false;
+}
+
+/**
+ *  @brief  Carves an entry with room for a string of length len
+ *          out of the last block, appending a block if need be
+ *
+ *  Must be called with intern_lock held.
+ *
+ *  @param[in]  len     length of the string, less its null terminator
+ *
+ *  @return     an uninitialized entry
+ */
+static struct intern_entry *intern_alloc(size_t len) {
+    struct intern_entry *entry = NULL;
+    size_t size = offsetof(struct intern_entry, str) + len + 1;
+    size_t count = intern_block_count;
+
+    size = (size + INTERN_ALIGN - 1) / INTERN_ALIGN * INTERN_ALIGN;
+
+    if (count == 0 ||
+        (size_t)(intern_blocks[count - 1].end - intern_block_next) < size) {
+        struct intern_block *block = NULL;
+        size_t shift = count < 16 ? count : 16;
+        size_t block_size = (size_t)(INTERN_BLOCK_SIZE) << shift;
+
+        if (count == INTERN_BLOCK_MAX) {
+            ERROR(__FILE__, "intern pool is out of blocks.");
+            abort();
+        }
+
+        block_size = block_size > size ? block_size : size;
+
+        block = &intern_blocks[count];
+        block->begin = malloc(block_size);
+        massert_malloc(block->begin);
+        block->end = block->begin + block_size;
+
+        intern_block_next = block->begin;
+        __atomic_store_n(&intern_block_count, count + 1, __ATOMIC_RELEASE);
+    }
+
+    entry = (struct intern_entry *)(intern_block_next);
+    intern_block_next += size;
+
+    return entry;
+}
+
+/**
+ *  @brief  Returns the entry of str, if str is the canonical address
+ *          of an interned string -- without reading any memory
+ *          outside of the pool's blocks
+ *
+ *  @param[in]  str     null-terminated string -- interned or not
+ *
+ *  @return     the (struct intern_entry *) of str, or NULL
+ */
+static struct intern_entry *str_interned_entry(const char *str) {
+    size_t count = __atomic_load_n(&intern_block_count, __ATOMIC_ACQUIRE);
+    size_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        char *begin = intern_blocks[i].begin;
+        char *end = intern_blocks[i].end;
+
+        if (str >= begin + offsetof(struct intern_entry, str) && str < end) {
+            struct intern_entry *entry = INTERN_ENTRY(str);
+            size_t offset = (size_t)((char *)(entry) - begin);
+
+            if (offset % INTERN_ALIGN != 0) {
+                return NULL;
+            }
+
+            return entry->self == str ? entry : NULL;
+        }
+    }
+
+    return NULL;
+}
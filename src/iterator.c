@@ -123,6 +123,8 @@ iterator it_prev_n(iterator it, int n) {
  *  @param[in]  it  pointer to iterator
  *
  *  @return     same pointer to iterator, but advanced n blocks
+ *
+ *  O(1) if it_random_access(*it), otherwise O(n).
  */
 iterator *it_advance(iterator *it, int n) {
     assert(it);
@@ -201,6 +203,9 @@ void *it_finish(iterator it) {
  *
  *  To find the index position of an iterator, leave one of the parameters
  *  NULL when calling the distance function.
+ *
+ *  O(1) if the iterators are random access (see it_random_access),
+ *  otherwise this walks from first to last.
  */
 int it_distance(iterator *first, iterator *last) {
     if (first == NULL && last != NULL) {
@@ -256,3 +261,77 @@ bool it_has_prev(iterator it) {
 struct typetable *it_get_ttbl(iterator it) {
     return it.itbl->get_ttbl(it.container);
 }
+
+/**
+ *  @brief  Returns the iterator category of it
+ *
+ *  @param[in]  it  iterator representing a container
+ *
+ *  @return     ITERATOR_FORWARD, ITERATOR_BIDIRECTIONAL,
+ *              ITERATOR_RANDOM_ACCESS, or ITERATOR_CONTIGUOUS
+ *
+ *  Range functions can use the category to decide whether the length
+ *  of [first, last) is known up front (random access or better),
+ *  or can only be found by walking the range.
+ */
+enum iterator_category it_category(iterator it) {
+    massert_ptr(it.itbl);
+    return it.itbl->category;
+}
+
+/**
+ *  @brief  Determines if it_distance and it_advance run in O(1) for it
+ *
+ *  @param[in]  it  iterator representing a container
+ *
+ *  @return     true if it is a random access (or contiguous) iterator,
+ *              false otherwise
+ */
+bool it_random_access(iterator it) {
+    massert_ptr(it.itbl);
+    return it.itbl->category >= ITERATOR_RANDOM_ACCESS ? true : false;
+}
+
+/**
+ *  @brief  Determines if the elements it refers to are stored
+ *          back to back in memory, such that the element after
+ *          it_curr(it) is always at it_curr(it) + width
+ *
+ *  @param[in]  it  iterator representing a container
+ *
+ *  @return     true if it traverses a contiguous buffer, false otherwise
+ */
+bool it_contiguous(iterator it) {
+    massert_ptr(it.itbl);
+    return it.itbl->category == ITERATOR_CONTIGUOUS ? true : false;
+}
+
+/**
+ *  @brief  Returns the range [first, last) as a base pointer and count
+ *
+ *  @param[in]  first   iterator at the start of the range
+ *  @param[in]  last    iterator one past the end of the range
+ *
+ *  @return     span over [first, last) if first is contiguous,
+ *              otherwise a span with a NULL base and a count of 0
+ *
+ *  Generic algorithms can test it_contiguous(first) and, when it holds,
+ *  loop over the returned span with a raw pointer instead of calling
+ *  it_incr/it_curr for every element.
+ */
+span it_span(iterator first, iterator last) {
+    span s;
+    massert_ptr(first.itbl);
+
+    s.width = it_get_ttbl(first)->width;
+
+    if (first.itbl->category != ITERATOR_CONTIGUOUS || first.curr == NULL) {
+        s.base = NULL;
+        s.count = 0;
+        return s;
+    }
+
+    s.base = first.curr;
+    s.count = (size_t)(ptr_distance(first.curr, last.curr, s.width));
+    return s;
+}
@@ -29,6 +29,7 @@
  */
 
 #include "list.h"
+#include "hashset.h"
 #include "iterator.h"
 #include "mergesort.h"
 #include "utils.h"
@@ -74,6 +75,8 @@ static void l_deinit(list *l);
 static list_node *l_node_at(list *l, int index);
 static list_node *l_traverse_h(list *l, int index);
 static list_node *l_traverse_t(list *l, int index);
+static void l_hookrnge(list *l, list_node_base *position, iterator first,
+                       iterator last);
 
 struct typetable ttbl_list = {sizeof(list), list_copy,    list_dtor,
                               list_swap,    list_compare, list_print};
@@ -107,7 +110,8 @@ static struct typetable *li_get_ttbl(void *arg);
 struct iterator_table itbl_list = {
     li_begin,    li_end,      li_next,     li_next_n,  li_prev,  li_prev_n,
     li_advance,  li_incr,     li_decr,     li_curr,    li_start, li_finish,
-    li_distance, li_has_next, li_has_prev, li_get_ttbl};
+    li_distance, li_has_next, li_has_prev, li_get_ttbl,
+    ITERATOR_BIDIRECTIONAL};
 
 struct iterator_table *_list_iterator_ = &itbl_list;
 
@@ -137,8 +141,6 @@ list *l_newrnge(iterator first, iterator last) {
     list *l = NULL;
 
     struct typetable *ttbl_first = NULL;
-    void *sentinel = NULL;
-    void *curr = NULL;
 
     if (first.itbl != last.itbl) {
         ERROR(__FILE__, "first and last must have matching container types and refer to the same container.");
@@ -148,14 +150,7 @@ list *l_newrnge(iterator first, iterator last) {
     ttbl_first = it_get_ttbl(first);
     l = l_new(ttbl_first);
 
-    sentinel = it_curr(last);
-
-    while ((curr = it_curr(first)) != sentinel) {
-        list_node *new_node = ln_new(l->ttbl, curr);
-        lnb_hook(*(list_node_base **)(&new_node), &(l->impl.node));
-
-        it_incr(&first);
-    }
+    l_hookrnge(l, &(l->impl.node), first, last);
 
     return l;
 }
@@ -404,20 +399,10 @@ const void *l_back_const(list *l) {
 }
 
 void l_assignrnge(list *l, iterator first, iterator last) {
-    void *curr = NULL;
-    void *sentinel = NULL;
-
     massert_container(l);
     l_clear(l);
 
-    sentinel = it_curr(last);
-
-    while ((curr = it_curr(first)) != sentinel) {
-        list_node *new_node = ln_new(l->ttbl, curr);
-        lnb_hook(*(list_node_base **)(&new_node), &(l->impl.node));
-
-        it_incr(&first);
-    }
+    l_hookrnge(l, &(l->impl.node), first, last);
 }
 
 void l_assignfill(list *l, size_t n, const void *valaddr) {
@@ -499,18 +484,9 @@ iterator l_insertfill(list *l, iterator pos, size_t n,
 
 iterator l_insertrnge(list *l, iterator pos, iterator first,
                        iterator last) {
-    void *curr = NULL;
-    void *sentinel = NULL;
-
     massert_container(l);
-    sentinel = it_curr(last);
 
-    while ((curr = it_curr(first)) != sentinel) {
-        list_node *new_node = ln_new(l->ttbl, curr);
-        lnb_hook(*(list_node_base **)(&new_node), pos.curr);
-
-        it_incr(&first);
-    }
+    l_hookrnge(l, pos.curr, first, last);
 
     return pos;
 }
@@ -837,51 +813,124 @@ void l_remove_if(list *l, bool (*unary_predicate)(const void *)) {
 }
 
 void l_unique(list *l) {
-    /*
-    iterator first = begin();
-    iterator last = end();
+    list_node_base *sentinel = NULL;
+    list_node_base *first = NULL;
+    list_node_base *next = NULL;
+
+    int (*compare)(const void *, const void *) = NULL;
 
-    if (first == last) {
+    massert_container(l);
+
+    sentinel = &(l->impl.node);
+    first = sentinel->next;
+
+    if (first == sentinel) {
         return;
     }
 
-    iterator next = first;
+    compare = l->ttbl->compare ? l->ttbl->compare : void_ptr_compare;
+
+    /**< erases every node equal to the node before it */
+    while ((next = first->next) != sentinel) {
+        if (compare(((list_node *)(first))->data,
+                    ((list_node *)(next))->data) == 0) {
+            list_node *n = (list_node *)(next);
 
-    while (++next != last) {
-        if (*first == *next) {
-            erase(next);
+            lnb_unhook(next);
+            ln_delete(&n, l->ttbl);
         } else {
             first = next;
         }
+    }
+}
+
+void l_unique_unordered(list *l) {
+    struct typetable shallow;
+    hashset *seen = NULL;
+
+    list_node_base *sentinel = NULL;
+    list_node_base *curr = NULL;
+
+    massert_container(l);
+
+    sentinel = &(l->impl.node);
+    curr = sentinel->next;
 
-        next = first;
+    if (curr == sentinel) {
+        return;
     }
-    */
 
-    /* TODO - not working
-    iterator first = { NULL, NULL, NULL };
-    iterator last = { NULL, NULL, NULL };
-    iterator next = { NULL, NULL, NULL };
-    void *curr = NULL;
-    void *sentinel = NULL;
+    /**
+     *  seen holds shallow copies of the elements kept so far --
+     *  they stay valid as long as the kept nodes do.
+     *  The first occurrence of every element is kept, in place;
+     *  the nodes of later occurrences are unhooked and deleted.
+     */
+    shallow = *(l->ttbl);
+    shallow.copy = NULL;
+    shallow.dtor = NULL;
 
-    int (*compare)(const void *, const void *) = NULL;
+    seen = hs_new(&shallow);
+
+    while (curr != sentinel) {
+        list_node_base *next = curr->next;
+        list_node *n = (list_node *)(curr);
+
+        if (hs_insert(seen, n->data) == false) {
+            lnb_unhook(curr);
+            ln_delete(&n, l->ttbl);
+        }
+
+        curr = next;
+    }
+
+    hs_delete(&seen);
+}
+
+/**
+ *  Applies visitor to every element of l, front to back.
+ *
+ *  visitor receives ctx, the address of an element, and a count of 1 --
+ *  list elements are allocated one at a time, so no run is longer.
+ *  The signature matches v_for_each_chunk, so the same visitor
+ *  serves both containers.
+ *
+ *  The walk ends early once visitor returns false.
+ *  visitor must not insert or erase elements of l.
+ *
+ *  @param[in]  l       pointer to list
+ *  @param[in]  visitor function to apply to each element
+ *  @param[in]  ctx     caller state, passed through to visitor
+ *
+ *  @return     number of elements passed to visitor
+ */
+size_t l_for_each(list *l, bool (*visitor)(void *, void *, size_t),
+                  void *ctx) {
+    list_node_base *sentinel = NULL;
+    list_node_base *curr = NULL;
+    size_t visited = 0;
 
     massert_container(l);
+    massert_pfunc(visitor);
 
-    first = l_begin(l);
-    last = l_end(l);
-    sentinel = it_curr(last);
+    sentinel = &(l->impl.node);
+    curr = sentinel->next;
 
-    next.itbl = _list_iterator_;
-    next.container = l;
-    next.curr = first.curr;
+    if (curr == NULL) {
+        return 0;
+    }
 
-    while (next.curr != last.curr) {
-        printf("%d\n", *(int *)(it_curr(next)));
-        it_incr(&next);
+    while (curr != sentinel) {
+        ++visited;
+
+        if (visitor(ctx, ((list_node *)(curr))->data, 1) == false) {
+            break;
+        }
+
+        curr = curr->next;
     }
-    */
+
+    return visited;
 }
 
 list *l_merge(list *l, list *other) {
@@ -1455,6 +1504,40 @@ static list_node *l_traverse_t(list *l, int index) {
     return *(list_node **)(&n);
 }
 
+/**
+ *  @brief  Hooks a copy of each element in [first, last) before position
+ *
+ *  A contiguous range is walked with a raw pointer, rather than
+ *  through first's iterator table once per element.
+ */
+static void l_hookrnge(list *l, list_node_base *position, iterator first,
+                       iterator last) {
+    void *curr = NULL;
+    void *sentinel = NULL;
+
+    if (it_contiguous(first)) {
+        span s = it_span(first, last);
+        char *elem = s.base;
+        size_t i = 0;
+
+        for (i = 0; i < s.count; i++, elem += s.width) {
+            list_node *new_node = ln_new(l->ttbl, elem);
+            lnb_hook(*(list_node_base **)(&new_node), position);
+        }
+
+        return;
+    }
+
+    sentinel = it_curr(last);
+
+    while ((curr = it_curr(first)) != sentinel) {
+        list_node *new_node = ln_new(l->ttbl, curr);
+        lnb_hook(*(list_node_base **)(&new_node), position);
+
+        it_incr(&first);
+    }
+}
+
 static iterator li_begin(void *arg) {
     list *l = NULL;
     iterator it;
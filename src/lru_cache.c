@@ -0,0 +1,958 @@
+/**
+ *  @file       lru_cache.c
+ *  @brief      Source file for a bounded cache with LRU or CLOCK eviction
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lru_cache.h"
+#include "hashmap.h"
+
+/**
+ *  @def        LRU_MAX_ALIGN
+ *  @brief      Largest alignment a key or value is given within a node
+ */
+#define LRU_MAX_ALIGN 16
+
+/**
+ *  @def        LRU_CACHELINE
+ *  @brief      Size each shard of an lru_sharded is padded to
+ */
+#define LRU_CACHELINE 64
+
+/**
+ *  @def        LRU_NODE
+ *  @brief      Returns the address of node I of cache C
+ */
+#define LRU_NODE(C, I) ((struct lru_node *)((C)->nodes + (I) * (C)->node_width))
+
+/**
+ *  @def        LRU_KEY / LRU_VAL
+ *  @brief      Returns the address of the key/value of node I of cache C
+ */
+#define LRU_KEY(C, I) ((C)->nodes + (I) * (C)->node_width + (C)->key_offset)
+#define LRU_VAL(C, I) ((C)->nodes + (I) * (C)->node_width + (C)->val_offset)
+
+/**
+ *  @struct     lru_node
+ *  @brief      Header of a node; the key and value follow it, inline
+ *
+ *  prev and next are node indices; node 0 is the sentinel of the
+ *  (circular) recency list, whose front is the most recently used entry.
+ *  A free node is on the free list, through next.
+ */
+struct lru_node {
+    size_t prev;
+    size_t next;
+    size_t charge;
+    int referenced;
+};
+
+/**
+ *  @struct     lru_cache
+ *  @brief      Represents a bounded cache
+ *
+ *  Note that struct lru_cache is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct lru_cache be created on the stack.
+ *  This is done to enforce encapsulation.
+ *
+ *  Nodes own their keys and values. index maps a shallow copy of every
+ *  key (with ttbl_index: ttbl_key without copy and dtor) to the index
+ *  of its node -- node indices stay valid as nodes grows, and the
+ *  shallow copies stay valid for as long as their nodes' keys do.
+ *
+ *  nodes has room for nodes_len nodes; nodes [0, nodes_used) have been
+ *  handed out at least once, and free_list (0 if empty) chains the
+ *  nodes that were released since.
+ */
+struct lru_cache {
+    hashmap *index;
+
+    struct typetable *ttbl_key;
+    struct typetable *ttbl_val;
+    struct typetable ttbl_index;
+
+    size_t (*charge)(const void *, const void *);
+    void (*evict)(const void *, void *, void *);
+    void *evict_ctx;
+    enum lru_policy policy;
+
+    size_t capacity;
+    size_t total;
+
+    size_t key_offset;
+    size_t val_offset;
+    size_t node_width;
+
+    char *nodes;
+    size_t nodes_len;
+    size_t nodes_used;
+    size_t free_list;
+};
+
+/**
+ *  @struct     lru_shard
+ *  @brief      An lru_cache and the lock that guards it
+ */
+struct lru_shard {
+    pthread_mutex_t lock;
+    lru_cache *cache;
+};
+
+/**
+ *  @union      lru_shard_slot
+ *  @brief      Pads an lru_shard, so that neighboring shards
+ *              do not share a cache line
+ */
+union lru_shard_slot {
+    struct lru_shard shard;
+    char pad[LRU_CACHELINE];
+};
+
+/**
+ *  @struct     lru_sharded
+ *  @brief      Represents a bounded cache split into locked shards
+ *
+ *  count is a power of two; a key's shard is picked by the top bits
+ *  of its hash (the hashmap of the shard consumes the low bits).
+ */
+struct lru_sharded {
+    union lru_shard_slot *shards;
+    size_t count;
+    unsigned shift;
+
+    struct typetable *ttbl_key;
+    struct typetable *ttbl_val;
+};
+
+/**
+ *  Node indices, the values of an lru_cache's index
+ */
+static struct typetable ttbl_lru_index = {
+    sizeof(size_t),
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+static size_t lru_align(size_t width);
+static size_t lru_round(size_t n, size_t align);
+
+static size_t lru_node_alloc(lru_cache *c);
+static void lru_node_free(lru_cache *c, size_t i);
+
+static void lru_unlink(lru_cache *c, size_t i);
+static void lru_link_front(lru_cache *c, size_t i);
+static void lru_touch(lru_cache *c, size_t i);
+
+static size_t lru_victim(lru_cache *c);
+static void lru_remove(lru_cache *c, size_t i);
+static void lru_shrink(lru_cache *c);
+
+static struct lru_shard *lrus_shard(lru_sharded *c, const void *key);
+
+/**
+ *  @brief  Allocates and initializes a new, empty lru_cache
+ *
+ *  @param[in]  ttbl_key    typetable of the keys
+ *                          (must have equals or compare)
+ *  @param[in]  ttbl_val    typetable of the values
+ *  @param[in]  capacity    greatest total charge of the entries held
+ *  @param[in]  charge      function returning the charge of an entry,
+ *                          given the addresses of its key and value --
+ *                          or NULL, to charge 1 per entry
+ *  @param[in]  policy      LRU_STRICT or LRU_CLOCK
+ *
+ *  @return     pointer to lru_cache
+ */
+lru_cache *lru_new(struct typetable *ttbl_key, struct typetable *ttbl_val,
+                   size_t capacity,
+                   size_t (*charge)(const void *, const void *),
+                   enum lru_policy policy) {
+    lru_cache *c = NULL;
+    size_t align_key = 0;
+    size_t align_val = 0;
+    size_t align = sizeof(size_t);
+
+    c = malloc(sizeof *c);
+    massert_malloc(c);
+
+    c->ttbl_key = ttbl_key ? ttbl_key : _void_ptr_;
+    c->ttbl_val = ttbl_val ? ttbl_val : _void_ptr_;
+
+    c->ttbl_index = *(c->ttbl_key);
+    c->ttbl_index.copy = NULL;
+    c->ttbl_index.dtor = NULL;
+
+    c->index = hm_new(&c->ttbl_index, &ttbl_lru_index);
+
+    c->charge = charge;
+    c->evict = NULL;
+    c->evict_ctx = NULL;
+    c->policy = policy;
+
+    c->capacity = capacity;
+    c->total = 0;
+
+    align_key = lru_align(c->ttbl_key->width);
+    align_val = lru_align(c->ttbl_val->width);
+
+    align = align_key > align ? align_key : align;
+    align = align_val > align ? align_val : align;
+
+    c->key_offset = lru_round(sizeof(struct lru_node), align_key);
+    c->val_offset = lru_round(c->key_offset + c->ttbl_key->width, align_val);
+    c->node_width = lru_round(c->val_offset + c->ttbl_val->width, align);
+
+    c->nodes_len = 16;
+    c->nodes = malloc(c->nodes_len * c->node_width);
+    massert_malloc(c->nodes);
+
+    /**< node 0 is the sentinel */
+    c->nodes_used = 1;
+    c->free_list = 0;
+
+    LRU_NODE(c, 0)->prev = 0;
+    LRU_NODE(c, 0)->next = 0;
+
+    return c;
+}
+
+/**
+ *  @brief  Releases every entry of (*c), then (*c) itself
+ *
+ *  @param[out] c   address of pointer to lru_cache
+ */
+void lru_delete(lru_cache **c) {
+    assert(c);
+    assert(*c);
+
+    lru_clear(*c);
+    hm_delete(&(*c)->index);
+
+    free((*c)->nodes);
+    (*c)->nodes = NULL;
+
+    free(*c);
+    *c = NULL;
+}
+
+/**
+ *  @brief  Sets the function called on every evicted entry
+ *
+ *  evict receives the addresses of the key and value of the entry,
+ *  and ctx; the entry is destroyed when it returns, so it must copy
+ *  (not keep) whatever it needs of them.
+ *
+ *  @param[in]  c       pointer to lru_cache
+ *  @param[in]  evict   pointer to function, or NULL
+ *  @param[in]  ctx     passed to every call of evict
+ */
+void lru_set_evict(lru_cache *c, void (*evict)(const void *, void *, void *),
+                   void *ctx) {
+    assert(c);
+
+    c->evict = evict;
+    c->evict_ctx = ctx;
+}
+
+/**
+ *  @brief  Returns the number of entries in c
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *
+ *  @return     number of entries
+ */
+size_t lru_size(lru_cache *c) {
+    assert(c);
+    return hm_size(c->index);
+}
+
+/**
+ *  @brief  Returns the total charge of the entries in c
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *
+ *  @return     total charge (no greater than lru_capacity(c))
+ */
+size_t lru_charge(lru_cache *c) {
+    assert(c);
+    return c->total;
+}
+
+/**
+ *  @brief  Returns the greatest total charge c may hold
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *
+ *  @return     capacity
+ */
+size_t lru_capacity(lru_cache *c) {
+    assert(c);
+    return c->capacity;
+}
+
+/**
+ *  @brief  Determines if c has no entries
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *
+ *  @return     true if c is empty, false otherwise
+ */
+bool lru_empty(lru_cache *c) {
+    assert(c);
+    return hm_empty(c->index);
+}
+
+/**
+ *  @brief  Returns the address of the value mapped to key,
+ *          and counts the lookup as a use of its entry
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *  @param[in]  key address of the key
+ *
+ *  @return     address of the value, or NULL if key is not in c
+ */
+void *lru_get(lru_cache *c, const void *key) {
+    size_t *found = NULL;
+
+    assert(c);
+    assert(key);
+
+    found = hm_find(c->index, key);
+
+    if (found == NULL) {
+        return NULL;
+    }
+
+    lru_touch(c, *found);
+    return LRU_VAL(c, *found);
+}
+
+/**
+ *  @brief  Returns the address of the value mapped to key,
+ *          leaving the recency of its entry as it was
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *  @param[in]  key address of the key
+ *
+ *  @return     address of the value, or NULL if key is not in c
+ */
+void *lru_peek(lru_cache *c, const void *key) {
+    size_t *found = NULL;
+
+    assert(c);
+    assert(key);
+
+    found = hm_find(c->index, key);
+    return found ? LRU_VAL(c, *found) : NULL;
+}
+
+/**
+ *  @brief  Maps key to val (replacing the value key had, if any),
+ *          as the most recently used entry, then evicts entries
+ *          until the total charge is within capacity
+ *
+ *  An entry whose charge alone exceeds the capacity is evicted, too.
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *  @param[in]  key address of the key
+ *  @param[in]  val address of the value
+ *
+ *  @return     true if the entry was inserted, false if it was assigned
+ */
+bool lru_put(lru_cache *c, const void *key, const void *val) {
+    size_t *found = NULL;
+    struct lru_node *node = NULL;
+    char *slot = NULL;
+    size_t i = 0;
+
+    assert(c);
+    assert(key);
+    assert(val);
+
+    found = hm_find(c->index, key);
+
+    if (found) {
+        i = *found;
+        node = LRU_NODE(c, i);
+        slot = LRU_VAL(c, i);
+
+        if (slot != val) {
+            if (c->ttbl_val->dtor) {
+                c->ttbl_val->dtor(slot);
+            }
+
+            if (c->ttbl_val->copy) {
+                c->ttbl_val->copy(slot, val);
+            } else {
+                memcpy(slot, val, c->ttbl_val->width);
+            }
+        }
+
+        c->total -= node->charge;
+        node->charge = c->charge ? c->charge(LRU_KEY(c, i), slot) : 1;
+        c->total += node->charge;
+
+        lru_touch(c, i);
+        lru_shrink(c);
+
+        return false;
+    }
+
+    i = lru_node_alloc(c);
+    node = LRU_NODE(c, i);
+
+    if (c->ttbl_key->copy) {
+        c->ttbl_key->copy(LRU_KEY(c, i), key);
+    } else {
+        memcpy(LRU_KEY(c, i), key, c->ttbl_key->width);
+    }
+
+    if (c->ttbl_val->copy) {
+        c->ttbl_val->copy(LRU_VAL(c, i), val);
+    } else {
+        memcpy(LRU_VAL(c, i), val, c->ttbl_val->width);
+    }
+
+    node->charge = c->charge ? c->charge(LRU_KEY(c, i), LRU_VAL(c, i)) : 1;
+    node->referenced = 0;
+
+    lru_link_front(c, i);
+    hm_insert(c->index, LRU_KEY(c, i), &i);
+
+    c->total += node->charge;
+    lru_shrink(c);
+
+    return true;
+}
+
+/**
+ *  @brief  Removes the entry with key from c, if there is one
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *  @param[in]  key address of the key
+ */
+void lru_erase(lru_cache *c, const void *key) {
+    size_t *found = NULL;
+
+    assert(c);
+    assert(key);
+
+    found = hm_find(c->index, key);
+
+    if (found) {
+        lru_remove(c, *found);
+    }
+}
+
+/**
+ *  @brief  Removes every entry from c, keeping its storage
+ *
+ *  @param[in]  c   pointer to lru_cache
+ */
+void lru_clear(lru_cache *c) {
+    size_t i = 0;
+
+    assert(c);
+
+    if (c->ttbl_key->dtor || c->ttbl_val->dtor) {
+        for (i = LRU_NODE(c, 0)->next; i != 0; i = LRU_NODE(c, i)->next) {
+            if (c->ttbl_key->dtor) {
+                c->ttbl_key->dtor(LRU_KEY(c, i));
+            }
+
+            if (c->ttbl_val->dtor) {
+                c->ttbl_val->dtor(LRU_VAL(c, i));
+            }
+        }
+    }
+
+    hm_clear(c->index);
+
+    c->total = 0;
+    c->nodes_used = 1;
+    c->free_list = 0;
+
+    LRU_NODE(c, 0)->prev = 0;
+    LRU_NODE(c, 0)->next = 0;
+}
+
+/**
+ *  @brief  Returns the eviction policy of c
+ *
+ *  @param[in]  c   pointer to lru_cache
+ *
+ *  @return     LRU_STRICT or LRU_CLOCK
+ */
+enum lru_policy lru_get_policy(lru_cache *c) {
+    assert(c);
+    return c->policy;
+}
+
+/**
+ *  @brief  Allocates and initializes a new, empty lru_sharded
+ *
+ *  @param[in]  ttbl_key    typetable of the keys
+ *                          (must have equals or compare)
+ *  @param[in]  ttbl_val    typetable of the values
+ *  @param[in]  capacity    greatest total charge of the entries held,
+ *                          split evenly among the shards
+ *  @param[in]  charge      as with lru_new
+ *  @param[in]  policy      LRU_STRICT or LRU_CLOCK (for every shard)
+ *  @param[in]  shards      number of shards -- rounded up to
+ *                          the next power of two
+ *
+ *  @return     pointer to lru_sharded
+ */
+lru_sharded *lrus_new(struct typetable *ttbl_key, struct typetable *ttbl_val,
+                      size_t capacity,
+                      size_t (*charge)(const void *, const void *),
+                      enum lru_policy policy, size_t shards) {
+    lru_sharded *c = NULL;
+    size_t i = 0;
+
+    c = malloc(sizeof *c);
+    massert_malloc(c);
+
+    c->ttbl_key = ttbl_key ? ttbl_key : _void_ptr_;
+    c->ttbl_val = ttbl_val ? ttbl_val : _void_ptr_;
+
+    c->count = 1;
+    c->shift = sizeof(size_t) * CHAR_BIT;
+
+    while (c->count < shards) {
+        c->count *= 2;
+        --c->shift;
+    }
+
+    c->shards = malloc(c->count * sizeof *c->shards);
+    massert_malloc(c->shards);
+
+    for (i = 0; i < c->count; i++) {
+        struct lru_shard *shard = &c->shards[i].shard;
+
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->cache = lru_new(c->ttbl_key, c->ttbl_val,
+                               (capacity + c->count - 1) / c->count,
+                               charge, policy);
+    }
+
+    return c;
+}
+
+/**
+ *  @brief  Releases every shard of (*c), then (*c) itself
+ *
+ *  @param[out] c   address of pointer to lru_sharded
+ */
+void lrus_delete(lru_sharded **c) {
+    size_t i = 0;
+
+    assert(c);
+    assert(*c);
+
+    for (i = 0; i < (*c)->count; i++) {
+        struct lru_shard *shard = &(*c)->shards[i].shard;
+
+        lru_delete(&shard->cache);
+        pthread_mutex_destroy(&shard->lock);
+    }
+
+    free((*c)->shards);
+    (*c)->shards = NULL;
+
+    free(*c);
+    *c = NULL;
+}
+
+/**
+ *  @brief  Sets the function called on every evicted entry, for every
+ *          shard (see lru_set_evict) -- evict runs with the shard locked
+ *
+ *  @param[in]  c       pointer to lru_sharded
+ *  @param[in]  evict   pointer to function, or NULL
+ *  @param[in]  ctx     passed to every call of evict
+ */
+void lrus_set_evict(lru_sharded *c,
+                    void (*evict)(const void *, void *, void *), void *ctx) {
+    size_t i = 0;
+
+    assert(c);
+
+    for (i = 0; i < c->count; i++) {
+        lru_set_evict(c->shards[i].shard.cache, evict, ctx);
+    }
+}
+
+/**
+ *  @brief  Returns the number of entries in c
+ *
+ *  Shards are counted one at a time, so the result is only exact
+ *  if no other thread modifies c meanwhile.
+ *
+ *  @param[in]  c   pointer to lru_sharded
+ *
+ *  @return     number of entries
+ */
+size_t lrus_size(lru_sharded *c) {
+    size_t size = 0;
+    size_t i = 0;
+
+    assert(c);
+
+    for (i = 0; i < c->count; i++) {
+        struct lru_shard *shard = &c->shards[i].shard;
+
+        pthread_mutex_lock(&shard->lock);
+        size += lru_size(shard->cache);
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    return size;
+}
+
+/**
+ *  @brief  Returns the total charge of the entries in c
+ *          (counted as lrus_size counts entries)
+ *
+ *  @param[in]  c   pointer to lru_sharded
+ *
+ *  @return     total charge
+ */
+size_t lrus_charge(lru_sharded *c) {
+    size_t total = 0;
+    size_t i = 0;
+
+    assert(c);
+
+    for (i = 0; i < c->count; i++) {
+        struct lru_shard *shard = &c->shards[i].shard;
+
+        pthread_mutex_lock(&shard->lock);
+        total += lru_charge(shard->cache);
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    return total;
+}
+
+/**
+ *  @brief  Returns the number of shards of c
+ *
+ *  @param[in]  c   pointer to lru_sharded
+ *
+ *  @return     number of shards (a power of two)
+ */
+size_t lrus_shards(lru_sharded *c) {
+    assert(c);
+    return c->count;
+}
+
+/**
+ *  @brief  Copies the value mapped to key to dest, and counts
+ *          the lookup as a use of its entry
+ *
+ *  The value is copied with ttbl_val->copy, if there is one
+ *  (dest then owns a deep copy), or else bitwise.
+ *
+ *  @param[in]  c       pointer to lru_sharded
+ *  @param[in]  key     address of the key
+ *  @param[out] dest    address of a value-sized buffer
+ *
+ *  @return     true if key was found (and dest written), false otherwise
+ */
+bool lrus_get(lru_sharded *c, const void *key, void *dest) {
+    struct lru_shard *shard = NULL;
+    void *val = NULL;
+
+    assert(c);
+    assert(dest);
+
+    shard = lrus_shard(c, key);
+
+    pthread_mutex_lock(&shard->lock);
+
+    val = lru_get(shard->cache, key);
+
+    if (val) {
+        if (c->ttbl_val->copy) {
+            c->ttbl_val->copy(dest, val);
+        } else {
+            memcpy(dest, val, c->ttbl_val->width);
+        }
+    }
+
+    pthread_mutex_unlock(&shard->lock);
+    return val ? true : false;
+}
+
+/**
+ *  @brief  Maps key to val in its shard (see lru_put)
+ *
+ *  @param[in]  c   pointer to lru_sharded
+ *  @param[in]  key address of the key
+ *  @param[in]  val address of the value
+ *
+ *  @return     true if the entry was inserted, false if it was assigned
+ */
+bool lrus_put(lru_sharded *c, const void *key, const void *val) {
+    struct lru_shard *shard = NULL;
+    bool inserted = false;
+
+    assert(c);
+
+    shard = lrus_shard(c, key);
+
+    pthread_mutex_lock(&shard->lock);
+    inserted = lru_put(shard->cache, key, val);
+    pthread_mutex_unlock(&shard->lock);
+
+    return inserted;
+}
+
+/**
+ *  @brief  Removes the entry with key from c, if there is one
+ *
+ *  @param[in]  c   pointer to lru_sharded
+ *  @param[in]  key address of the key
+ */
+void lrus_erase(lru_sharded *c, const void *key) {
+    struct lru_shard *shard = NULL;
+
+    assert(c);
+
+    shard = lrus_shard(c, key);
+
+    pthread_mutex_lock(&shard->lock);
+    lru_erase(shard->cache, key);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+/**
+ *  @brief  Removes every entry from every shard of c
+ *
+ *  @param[in]  c   pointer to lru_sharded
+ */
+void lrus_clear(lru_sharded *c) {
+    size_t i = 0;
+
+    assert(c);
+
+    for (i = 0; i < c->count; i++) {
+        struct lru_shard *shard = &c->shards[i].shard;
+
+        pthread_mutex_lock(&shard->lock);
+        lru_clear(shard->cache);
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+/**
+ *  @brief  Returns the alignment a key or value of width bytes needs
+ *
+ *  That is the largest power of two that divides width,
+ *  capped at LRU_MAX_ALIGN (or 1, for no width).
+ */
+static size_t lru_align(size_t width) {
+    size_t align = 1;
+
+    if (width == 0) {
+        return align;
+    }
+
+    while (align < LRU_MAX_ALIGN && width % (align * 2) == 0) {
+        align *= 2;
+    }
+
+    return align;
+}
+
+/**
+ *  @brief  Rounds n up to a multiple of align
+ */
+static size_t lru_round(size_t n, size_t align) {
+    return (n + align - 1) / align * align;
+}
+
+/**
+ *  @brief  Returns the index of an unused node of c, growing nodes
+ *          if there is none -- which moves every node
+ */
+static size_t lru_node_alloc(lru_cache *c) {
+    size_t i = c->free_list;
+
+    if (i != 0) {
+        c->free_list = LRU_NODE(c, i)->next;
+        return i;
+    }
+
+    if (c->nodes_used == c->nodes_len) {
+        char *nodes = NULL;
+
+        nodes = realloc(c->nodes, 2 * c->nodes_len * c->node_width);
+        massert_malloc(nodes);
+
+        c->nodes = nodes;
+        c->nodes_len *= 2;
+    }
+
+    return c->nodes_used++;
+}
+
+/**
+ *  @brief  Puts node i of c on the free list
+ */
+static void lru_node_free(lru_cache *c, size_t i) {
+    LRU_NODE(c, i)->next = c->free_list;
+    c->free_list = i;
+}
+
+/**
+ *  @brief  Unlinks node i of c from the recency list
+ */
+static void lru_unlink(lru_cache *c, size_t i) {
+    struct lru_node *node = LRU_NODE(c, i);
+
+    LRU_NODE(c, node->prev)->next = node->next;
+    LRU_NODE(c, node->next)->prev = node->prev;
+}
+
+/**
+ *  @brief  Links node i of c at the front of the recency list
+ */
+static void lru_link_front(lru_cache *c, size_t i) {
+    struct lru_node *sentinel = LRU_NODE(c, 0);
+    struct lru_node *node = LRU_NODE(c, i);
+
+    node->prev = 0;
+    node->next = sentinel->next;
+
+    LRU_NODE(c, sentinel->next)->prev = i;
+    sentinel->next = i;
+}
+
+/**
+ *  @brief  Records a use of node i of c, as c's policy would
+ */
+static void lru_touch(lru_cache *c, size_t i) {
+    if (c->policy == LRU_CLOCK) {
+        LRU_NODE(c, i)->referenced = 1;
+    } else if (LRU_NODE(c, 0)->next != i) {
+        lru_unlink(c, i);
+        lru_link_front(c, i);
+    }
+}
+
+/**
+ *  @brief  Returns the node c evicts next (c must not be empty)
+ *
+ *  With LRU_CLOCK, referenced nodes at the back are given
+ *  a second chance: unmarked, and moved to the front. Every node
+ *  passed over is unmarked, so this ends within one sweep of the list.
+ */
+static size_t lru_victim(lru_cache *c) {
+    size_t i = LRU_NODE(c, 0)->prev;
+
+    if (c->policy == LRU_CLOCK) {
+        while (LRU_NODE(c, i)->referenced) {
+            LRU_NODE(c, i)->referenced = 0;
+
+            lru_unlink(c, i);
+            lru_link_front(c, i);
+
+            i = LRU_NODE(c, 0)->prev;
+        }
+    }
+
+    return i;
+}
+
+/**
+ *  @brief  Removes the entry of node i from c, and releases the node
+ */
+static void lru_remove(lru_cache *c, size_t i) {
+    hm_erase(c->index, LRU_KEY(c, i));
+    lru_unlink(c, i);
+
+    c->total -= LRU_NODE(c, i)->charge;
+
+    if (c->ttbl_key->dtor) {
+        c->ttbl_key->dtor(LRU_KEY(c, i));
+    }
+
+    if (c->ttbl_val->dtor) {
+        c->ttbl_val->dtor(LRU_VAL(c, i));
+    }
+
+    lru_node_free(c, i);
+}
+
+/**
+ *  @brief  Evicts entries of c until its total charge is within capacity
+ */
+static void lru_shrink(lru_cache *c) {
+    while (c->total > c->capacity && hm_size(c->index) > 0) {
+        size_t i = lru_victim(c);
+
+        if (c->evict) {
+            c->evict(LRU_KEY(c, i), LRU_VAL(c, i), c->evict_ctx);
+        }
+
+        lru_remove(c, i);
+    }
+}
+
+/**
+ *  @brief  Returns the shard of c that key belongs to
+ */
+static struct lru_shard *lrus_shard(lru_sharded *c, const void *key) {
+    size_t hash = 0;
+
+    if (c->count == 1) {
+        return &c->shards[0].shard;
+    }
+
+    if (c->ttbl_key->hash) {
+        hash = c->ttbl_key->hash(key);
+    } else {
+        hash = hash_bytes(key, c->ttbl_key->width);
+    }
+
+    return &c->shards[hash >> c->shift].shard;
+}
@@ -0,0 +1,580 @@
+/**
+ *  @file       map.c
+ *  @brief      Source file for an ordered associative container (key to value)
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "map.h"
+#include "rbtree.h"
+
+/**
+ *  @def        MAP_MAX_ALIGN
+ *  @brief      Largest alignment a value is given within an entry
+ */
+#define MAP_MAX_ALIGN 16
+
+/**
+ *  @struct     map
+ *  @brief      An rbtree of entries, each a key followed by its value
+ *
+ *  entry describes an entry to the rbtree: it is val_offset + ttbl_val->width
+ *  bytes wide and is ordered by ttbl_key->compare, which only ever looks at
+ *  the key at the start of the entry -- so a bare key may be passed to any
+ *  rbtree lookup. Its copy and dtor are NULL: the rbtree moves entries
+ *  with memcpy, and the map applies ttbl_key/ttbl_val's copy and dtor
+ *  to each half of an entry itself.
+ *
+ *  scratch is one entry wide; it stages an entry for insertion,
+ *  and holds an erased entry until its key and value are destroyed.
+ */
+struct map {
+    rbtree *t;
+
+    struct typetable *ttbl_key;
+    struct typetable *ttbl_val;
+    struct typetable entry;
+
+    size_t val_offset;
+    char *scratch;
+};
+
+/**
+ *  @struct     m_copy_ctx
+ *  @brief      State for m_copy_entry, used by m_newcopy
+ */
+struct m_copy_ctx {
+    map *dst;
+    iterator hint;
+};
+
+static size_t m_val_align(size_t width);
+static void m_put(map *m, void *entry, const void *key, const void *val);
+static void m_destroy(map *m, void *entry);
+static bool m_destroy_entry(void *ctx, void *entry);
+static bool m_copy_entry(void *ctx, void *entry);
+
+/**
+ *  @brief  Allocates and initializes a new map
+ *
+ *  @param[in]  ttbl_key    typetable of the keys (must have compare)
+ *  @param[in]  ttbl_val    typetable of the values
+ *
+ *  @return     pointer to map
+ */
+map *m_new(struct typetable *ttbl_key, struct typetable *ttbl_val) {
+    map *m = NULL;
+    size_t align = 0;
+
+    m = malloc(sizeof *m);
+    massert_malloc(m);
+
+    m->ttbl_key = ttbl_key ? ttbl_key : _void_ptr_;
+    m->ttbl_val = ttbl_val ? ttbl_val : _void_ptr_;
+
+    assert(m->ttbl_key->compare);
+
+    align = m_val_align(m->ttbl_val->width);
+    m->val_offset = (m->ttbl_key->width + align - 1) / align * align;
+
+    m->entry.width = m->val_offset + m->ttbl_val->width;
+    m->entry.copy = NULL;
+    m->entry.dtor = NULL;
+    m->entry.swap = NULL;
+    m->entry.compare = m->ttbl_key->compare;
+    m->entry.print = NULL;
+
+    /**< an entry starts with its key, so it hashes and matches as one */
+    m->entry.hash = m->ttbl_key->hash;
+    m->entry.equals = m->ttbl_key->equals;
+
+    m->scratch = malloc(m->entry.width);
+    massert_malloc(m->scratch);
+
+    m->t = rbt_new(&m->entry);
+    return m;
+}
+
+/**
+ *  @brief  Allocates a new map and deep copies the entries of m into it
+ *
+ *  m's entries are already in order, so each one is inserted with
+ *  the end of the new map as its hint -- no search from the root is made.
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     pointer to map
+ */
+map *m_newcopy(map *m) {
+    struct m_copy_ctx ctx;
+
+    assert(m);
+
+    ctx.dst = m_new(m->ttbl_key, m->ttbl_val);
+    ctx.hint = m_end(ctx.dst);
+
+    rbt_foreach_range(m->t, NULL, NULL, m_copy_entry, &ctx);
+    return ctx.dst;
+}
+
+/**
+ *  @brief  Releases every entry of (*m), then (*m) itself
+ *
+ *  @param[out] m   address of pointer to map
+ */
+void m_delete(map **m) {
+    assert(m);
+    assert(*m);
+
+    m_clear(*m);
+    rbt_delete(&(*m)->t);
+
+    free((*m)->scratch);
+    (*m)->scratch = NULL;
+
+    free(*m);
+    *m = NULL;
+}
+
+/**
+ *  @brief  Returns an iterator to the entry with the least key
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     iterator at the first entry (in key order)
+ */
+iterator m_begin(map *m) {
+    assert(m);
+    return rbt_begin(m->t);
+}
+
+/**
+ *  @brief  Returns an iterator to one past the entry with the greatest key
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     iterator at end
+ */
+iterator m_end(map *m) {
+    assert(m);
+    return rbt_end(m->t);
+}
+
+/**
+ *  @brief  Returns the number of entries in m
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     number of entries
+ */
+size_t m_size(map *m) {
+    assert(m);
+    return rbt_size(m->t);
+}
+
+/**
+ *  @brief  Determines if m has no entries
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     true if m is empty, false otherwise
+ */
+bool m_empty(map *m) {
+    assert(m);
+    return rbt_empty(m->t);
+}
+
+/**
+ *  @brief  Returns the address of the value mapped to key
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key to search for
+ *
+ *  @return     address of the value, or NULL if key is not in m
+ */
+void *m_at(map *m, const void *key) {
+    char *entry = NULL;
+
+    assert(m);
+    assert(key);
+
+    entry = rbt_find(m->t, key);
+    return entry ? entry + m->val_offset : NULL;
+}
+
+/**
+ *  @brief  Returns the address of the key of the entry at it
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  it  iterator into m
+ *
+ *  @return     address of the key, or NULL if it is at end
+ */
+void *m_key(map *m, iterator it) {
+    assert(m);
+    return it_curr(it);
+}
+
+/**
+ *  @brief  Returns the address of the value of the entry at it
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  it  iterator into m
+ *
+ *  @return     address of the value, or NULL if it is at end
+ */
+void *m_val(map *m, iterator it) {
+    char *entry = NULL;
+
+    assert(m);
+
+    entry = it_curr(it);
+    return entry ? entry + m->val_offset : NULL;
+}
+
+/**
+ *  @brief  Maps key to val, unless key is already in m
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ *  @param[in]  val address of the value
+ *
+ *  @return     true if the entry was inserted, false if key was found
+ */
+bool m_insert(map *m, const void *key, const void *val) {
+    /**< no hint: rbt_insert_hint searches from the root */
+    iterator hint = { NULL, NULL, NULL };
+    return m_inserthint(m, &hint, key, val);
+}
+
+/**
+ *  @brief  Maps key to val, unless key is already in m,
+ *          using hint as a guess for where key belongs
+ *
+ *  See rbt_insert_hint -- if key belongs right before or after hint,
+ *  no search from the root is made. *hint is updated to refer to the
+ *  inserted entry, or to the entry with key that was found.
+ *
+ *  @param[in]  m       pointer to map
+ *  @param[out] hint    iterator into m
+ *  @param[in]  key     address of the key
+ *  @param[in]  val     address of the value
+ *
+ *  @return     true if the entry was inserted, false if key was found
+ */
+bool m_inserthint(map *m, iterator *hint, const void *key, const void *val) {
+    assert(m);
+    assert(hint);
+    assert(key);
+    assert(val);
+
+    /**< the tree stores a shallow copy of scratch; m_put deep copies over it */
+    memcpy(m->scratch, key, m->ttbl_key->width);
+    memcpy(m->scratch + m->val_offset, val, m->ttbl_val->width);
+
+    if (rbt_insert_hint(m->t, hint, m->scratch) == false) {
+        return false;
+    }
+
+    m_put(m, it_curr(*hint), key, val);
+    return true;
+}
+
+/**
+ *  @brief  Maps key to val, replacing the value key had, if any
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ *  @param[in]  val address of the value
+ *
+ *  @return     true if the entry was inserted, false if it was assigned
+ */
+bool m_assign(map *m, const void *key, const void *val) {
+    iterator hint = { NULL, NULL, NULL };
+    char *slot = NULL;
+
+    if (m_inserthint(m, &hint, key, val)) {
+        return true;
+    }
+
+    slot = m_val(m, hint);
+
+    if (slot != val) {
+        if (m->ttbl_val->dtor) {
+            m->ttbl_val->dtor(slot);
+        }
+
+        if (m->ttbl_val->copy) {
+            m->ttbl_val->copy(slot, val);
+        } else {
+            memcpy(slot, val, m->ttbl_val->width);
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  @brief  Removes the entry with key from m, if there is one
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ */
+void m_erase(map *m, const void *key) {
+    void *entry = NULL;
+
+    assert(m);
+    assert(key);
+
+    entry = rbt_find(m->t, key);
+
+    if (entry == NULL) {
+        return;
+    }
+
+    /**< key may be the entry's own -- erase by (and destroy) a copy */
+    memcpy(m->scratch, entry, m->entry.width);
+    rbt_erase(m->t, m->scratch);
+    m_destroy(m, m->scratch);
+}
+
+/**
+ *  @brief  Removes every entry from m
+ *
+ *  @param[in]  m   pointer to map
+ */
+void m_clear(map *m) {
+    assert(m);
+
+    if (m->ttbl_key->dtor || m->ttbl_val->dtor) {
+        rbt_foreach_range(m->t, NULL, NULL, m_destroy_entry, m);
+    }
+
+    rbt_clear(m->t);
+}
+
+/**
+ *  @brief  Returns an iterator to the entry with key
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ *
+ *  @return     iterator at the entry, or m_end(m) if key is not in m
+ */
+iterator m_find(map *m, const void *key) {
+    iterator it = m_lowerbound(m, key);
+    void *curr = it_curr(it);
+
+    if (curr && m->ttbl_key->compare(curr, key) != 0) {
+        return m_end(m);
+    }
+
+    return it;
+}
+
+/**
+ *  @brief  Returns the number of entries with key (0 or 1)
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ *
+ *  @return     1 if key is in m, 0 otherwise
+ */
+size_t m_count(map *m, const void *key) {
+    assert(m);
+    assert(key);
+
+    return rbt_find(m->t, key) ? 1 : 0;
+}
+
+/**
+ *  @brief  Returns an iterator to the first entry whose key
+ *          does not compare less than key, in O(log n)
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ *
+ *  @return     iterator at the lower bound, or m_end(m)
+ */
+iterator m_lowerbound(map *m, const void *key) {
+    assert(m);
+    return rbt_lower_bound(m->t, key);
+}
+
+/**
+ *  @brief  Returns an iterator to the first entry whose key
+ *          compares greater than key, in O(log n)
+ *
+ *  @param[in]  m   pointer to map
+ *  @param[in]  key address of the key
+ *
+ *  @return     iterator at the upper bound, or m_end(m)
+ */
+iterator m_upperbound(map *m, const void *key) {
+    assert(m);
+    return rbt_upper_bound(m->t, key);
+}
+
+/**
+ *  @brief  Retrieves the range [*first, *last) of entries with key
+ *
+ *  Keys are unique, so the range is empty or holds a single entry.
+ *
+ *  @param[in]  m       pointer to map
+ *  @param[in]  key     address of the key
+ *  @param[out] first   receives m_lowerbound(m, key)
+ *  @param[out] last    receives m_upperbound(m, key)
+ */
+void m_equalrange(map *m, const void *key, iterator *first, iterator *last) {
+    assert(first);
+    assert(last);
+
+    *first = m_lowerbound(m, key);
+    *last = m_upperbound(m, key);
+}
+
+/**
+ *  @brief  Returns the comparator of m's keys
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     ttbl_key->compare
+ */
+compare_fn m_key_comp(map *m) {
+    assert(m);
+    return m->ttbl_key->compare;
+}
+
+/**
+ *  @brief  Returns the typetable of m's keys
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     ttbl_key
+ */
+struct typetable *m_get_key_ttbl(map *m) {
+    assert(m);
+    return m->ttbl_key;
+}
+
+/**
+ *  @brief  Returns the typetable of m's values
+ *
+ *  @param[in]  m   pointer to map
+ *
+ *  @return     ttbl_val
+ */
+struct typetable *m_get_val_ttbl(map *m) {
+    assert(m);
+    return m->ttbl_val;
+}
+
+/**
+ *  @brief  Returns the alignment a value of width bytes needs
+ *
+ *  That is the largest power of two that divides width (a type's
+ *  alignment always divides its size), capped at MAP_MAX_ALIGN.
+ *
+ *  @param[in]  width   size of the value type
+ *
+ *  @return     alignment, in bytes
+ */
+static size_t m_val_align(size_t width) {
+    size_t align = 1;
+
+    while (align < MAP_MAX_ALIGN && width % (align * 2) == 0) {
+        align *= 2;
+    }
+
+    return align;
+}
+
+/**
+ *  @brief  Copies key and val into entry, with their copy functions if any
+ *
+ *  @param[in]  m       pointer to map
+ *  @param[out] entry   address of an entry of m
+ *  @param[in]  key     address of the key
+ *  @param[in]  val     address of the value
+ */
+static void m_put(map *m, void *entry, const void *key, const void *val) {
+    char *slot = entry;
+
+    if (m->ttbl_key->copy) {
+        m->ttbl_key->copy(slot, key);
+    } else {
+        memcpy(slot, key, m->ttbl_key->width);
+    }
+
+    if (m->ttbl_val->copy) {
+        m->ttbl_val->copy(slot + m->val_offset, val);
+    } else {
+        memcpy(slot + m->val_offset, val, m->ttbl_val->width);
+    }
+}
+
+/**
+ *  @brief  Applies the key and value dtor functions (if any) to entry
+ *
+ *  @param[in]  m       pointer to map
+ *  @param[in]  entry   address of an entry of m
+ */
+static void m_destroy(map *m, void *entry) {
+    char *slot = entry;
+
+    if (m->ttbl_key->dtor) {
+        m->ttbl_key->dtor(slot);
+    }
+
+    if (m->ttbl_val->dtor) {
+        m->ttbl_val->dtor(slot + m->val_offset);
+    }
+}
+
+/**
+ *  @brief  rbt_foreach_range consumer for m_clear
+ */
+static bool m_destroy_entry(void *ctx, void *entry) {
+    m_destroy(ctx, entry);
+    return true;
+}
+
+/**
+ *  @brief  rbt_foreach_range consumer for m_newcopy
+ */
+static bool m_copy_entry(void *ctx, void *entry) {
+    struct m_copy_ctx *copy = ctx;
+
+    m_inserthint(copy->dst, &copy->hint, entry,
+                 (char *)entry + copy->dst->val_offset);
+    return true;
+}
@@ -0,0 +1,840 @@
+/**
+ *  @file       queue.c
+ *  @brief      Source file for a bounded ring-buffer queue ADT
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define _GNU_SOURCE
+
+/**
+ *  System headers come first here: with _GNU_SOURCE defined,
+ *  <string.h> declares strdup, which utils.h shadows with a macro.
+ */
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif /* defined(__linux__) */
+
+#include "queue.h"
+#include "utils.h"
+
+/**
+ *  @def        QUEUE_CACHELINE
+ *  @brief      Assumed size of a cache line, in bytes
+ *
+ *  Producers hammer enqueue_pos and consumers hammer dequeue_pos;
+ *  the two counters (and the futex words) are padded apart
+ *  so that they never share a cache line.
+ */
+#define QUEUE_CACHELINE 64
+
+/**
+ *  @struct     queue
+ *  @brief      Represents a bounded ring-buffer queue ADT
+ *
+ *  Note that struct queue is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct queue be created on the stack.
+ *  This is done to enforce encapsulation.
+ *
+ *  enqueue_pos and dequeue_pos increase monotonically;
+ *  the slot for a position is (pos & mask).
+ *
+ *  In QUEUE_LOCKFREE and QUEUE_BLOCKING mode, seq[i] holds the
+ *  sequence number of slot i (Vyukov's bounded MPMC scheme):
+ *      seq == pos              slot is free for the producer at pos
+ *      seq == pos + 1          slot holds the element written at pos
+ *      seq == pos + capacity   slot was consumed, free for the next lap
+ *
+ *  not_empty/not_full are event counters used as futex words;
+ *  a parked thread sleeps until the counter moves.
+ *  The waiter counts let the opposite side skip the wake syscall
+ *  when nobody is parked.
+ */
+struct queue {
+    size_t enqueue_pos;
+    char pad_enqueue[QUEUE_CACHELINE - sizeof(size_t)];
+
+    size_t dequeue_pos;
+    char pad_dequeue[QUEUE_CACHELINE - sizeof(size_t)];
+
+    int not_empty;
+    int not_empty_waiters;
+    int not_full;
+    int not_full_waiters;
+    char pad_futex[QUEUE_CACHELINE - 4 * sizeof(int)];
+
+    char *buffer;
+    size_t *seq;
+    size_t mask;
+    enum queue_mode mode;
+    struct typetable *ttbl;
+};
+
+static queue *q_allocate(void);
+static void q_init(queue *q, struct typetable *ttbl, size_t capacity,
+                   enum queue_mode mode);
+static void q_deinit(queue *q);
+
+static size_t q_round_capacity(size_t n);
+
+static void q_copy_in_run(queue *q, size_t pos, const char *src, size_t n);
+static void q_move_out_run(queue *q, size_t pos, char *dest, size_t n);
+
+static size_t q_serial_push_n(queue *q, const char *base, size_t n);
+static size_t q_serial_pop_n(queue *q, char *dest, size_t n);
+
+static size_t q_mpmc_push_n(queue *q, const char *base, size_t n);
+static size_t q_mpmc_pop_n(queue *q, char *dest, size_t n);
+
+static size_t q_blocking_push_n(queue *q, const char *base, size_t n);
+static size_t q_blocking_pop_n(queue *q, char *dest, size_t n);
+
+static void q_park(queue *q, int *event, int *waiters, bool producer);
+static void q_notify(int *event, int *waiters, size_t n);
+
+/**
+ *  @brief  Allocates, constructs, and returns a pointer to queue
+ *
+ *  @param[in]  ttbl        pointer to struct typetable for
+ *                          width/copy/dtor/swap/compare/print
+ *  @param[in]  capacity    minimum number of elements the queue can hold;
+ *                          rounded up to the next power of two
+ *  @param[in]  mode        QUEUE_SERIAL, QUEUE_LOCKFREE, or QUEUE_BLOCKING
+ *
+ *  @return     pointer to queue
+ */
+queue *q_new(struct typetable *ttbl, size_t capacity, enum queue_mode mode) {
+    queue *q = q_allocate();                    /* allocate */
+    q_init(q, ttbl, capacity, mode);            /* construct */
+    return q;                                   /* return */
+}
+
+/**
+ *  @brief  Calls q_deinit (destructor), then frees memory at q
+ *
+ *  @param[out] q   Address of a pointer to queue
+ *
+ *  Any elements remaining in the queue are released
+ *  with the typetable's dtor, if one is defined.
+ */
+void q_delete(queue **q) {
+    massert_container((*q));
+
+    q_deinit((*q));
+
+    free((*q));
+    (*q) = NULL;
+}
+
+/**
+ *  @brief  Returns the number of elements in q
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     number of elements in q
+ *
+ *  Under concurrent access, the result is a snapshot
+ *  that may be stale by the time it is returned.
+ */
+size_t q_size(queue *q) {
+    size_t deq = 0;
+    size_t enq = 0;
+    size_t size = 0;
+
+    massert_container(q);
+
+    /**
+     *  dequeue_pos is read first -- enqueue_pos never falls behind it,
+     *  so the difference can not underflow.
+     */
+    deq = __atomic_load_n(&q->dequeue_pos, __ATOMIC_ACQUIRE);
+    enq = __atomic_load_n(&q->enqueue_pos, __ATOMIC_ACQUIRE);
+    size = enq - deq;
+
+    return size > q->mask + 1 ? q->mask + 1 : size;
+}
+
+/**
+ *  @brief  Returns the maximum number of elements q can hold
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     capacity of q (a power of two)
+ */
+size_t q_capacity(queue *q) {
+    massert_container(q);
+    return q->mask + 1;
+}
+
+/**
+ *  @brief  Determines if q is empty
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     true if q holds no elements, false otherwise
+ */
+bool q_empty(queue *q) {
+    return q_size(q) == 0;
+}
+
+/**
+ *  @brief  Determines if q is full
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     true if q holds capacity elements, false otherwise
+ */
+bool q_full(queue *q) {
+    return q_size(q) == q->mask + 1;
+}
+
+/**
+ *  @brief  Appends an element to the back of q
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[in]  valaddr address of element to copy into q
+ *
+ *  @return     true if the element was enqueued, false if q was full
+ *
+ *  In QUEUE_BLOCKING mode, the caller is parked until room is available,
+ *  so the return value is always true.
+ */
+bool q_push(queue *q, const void *valaddr) {
+    return q_push_n(q, valaddr, 1) == 1;
+}
+
+/**
+ *  @brief  Removes the front element of q and moves it to dest
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[out] dest    address of storage for one element
+ *
+ *  @return     true if an element was dequeued, false if q was empty
+ *
+ *  In QUEUE_BLOCKING mode, the caller is parked until
+ *  an element is available, so the return value is always true.
+ */
+bool q_pop(queue *q, void *dest) {
+    return q_pop_n(q, dest, 1) == 1;
+}
+
+/**
+ *  @brief  Appends an element to the back of q, without blocking
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[in]  valaddr address of element to copy into q
+ *
+ *  @return     true if the element was enqueued, false if q was full
+ */
+bool q_trypush(queue *q, const void *valaddr) {
+    size_t k = 0;
+
+    massert_container(q);
+    massert_ptr(valaddr);
+
+    if (q->mode == QUEUE_SERIAL) {
+        return q_serial_push_n(q, valaddr, 1) == 1;
+    }
+
+    k = q_mpmc_push_n(q, valaddr, 1);
+
+    if (k > 0 && q->mode == QUEUE_BLOCKING) {
+        q_notify(&q->not_empty, &q->not_empty_waiters, k);
+    }
+
+    return k == 1;
+}
+
+/**
+ *  @brief  Removes the front element of q and moves it to dest,
+ *          without blocking
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[out] dest    address of storage for one element
+ *
+ *  @return     true if an element was dequeued, false if q was empty
+ */
+bool q_trypop(queue *q, void *dest) {
+    size_t k = 0;
+
+    massert_container(q);
+    massert_ptr(dest);
+
+    if (q->mode == QUEUE_SERIAL) {
+        return q_serial_pop_n(q, dest, 1) == 1;
+    }
+
+    k = q_mpmc_pop_n(q, dest, 1);
+
+    if (k > 0 && q->mode == QUEUE_BLOCKING) {
+        q_notify(&q->not_full, &q->not_full_waiters, k);
+    }
+
+    return k == 1;
+}
+
+/**
+ *  @brief  Appends up to n elements from base to the back of q
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[in]  base    address of an array of n elements
+ *  @param[in]  n       number of elements at base
+ *
+ *  @return     number of elements enqueued
+ *
+ *  In QUEUE_SERIAL and QUEUE_LOCKFREE mode, as many elements as fit
+ *  are enqueued, and the count is returned.
+ *  A run of consecutive free slots is claimed with a single
+ *  atomic operation, so a batch costs one CAS instead of n.
+ *
+ *  In QUEUE_BLOCKING mode, the caller is parked whenever q is full,
+ *  and the function returns only once all n elements are enqueued.
+ */
+size_t q_push_n(queue *q, const void *base, size_t n) {
+    massert_container(q);
+    massert_ptr(base);
+
+    switch (q->mode) {
+    case QUEUE_SERIAL:
+        return q_serial_push_n(q, base, n);
+    case QUEUE_LOCKFREE:
+        return q_mpmc_push_n(q, base, n);
+    case QUEUE_BLOCKING:
+        return q_blocking_push_n(q, base, n);
+    }
+
+    return 0;
+}
+
+/**
+ *  @brief  Removes up to n elements from the front of q,
+ *          moving them to dest in FIFO order
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[out] dest    address of storage for n elements
+ *  @param[in]  n       maximum number of elements to dequeue
+ *
+ *  @return     number of elements dequeued
+ *
+ *  In QUEUE_BLOCKING mode, the caller is parked while q is empty;
+ *  once at least one element is available, up to n are dequeued
+ *  and the function returns.
+ */
+size_t q_pop_n(queue *q, void *dest, size_t n) {
+    massert_container(q);
+    massert_ptr(dest);
+
+    switch (q->mode) {
+    case QUEUE_SERIAL:
+        return q_serial_pop_n(q, dest, n);
+    case QUEUE_LOCKFREE:
+        return q_mpmc_pop_n(q, dest, n);
+    case QUEUE_BLOCKING:
+        return q_blocking_pop_n(q, dest, n);
+    }
+
+    return 0;
+}
+
+/**
+ *  @brief  Destroys all elements in q, leaving it empty
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  Not thread-safe -- no other thread may access q during this call.
+ */
+void q_clear(queue *q) {
+    size_t pos = 0;
+    size_t enq = 0;
+
+    massert_container(q);
+
+    enq = q->enqueue_pos;
+
+    for (pos = q->dequeue_pos; pos != enq; pos++) {
+        size_t index = pos & q->mask;
+
+        if (q->ttbl->dtor) {
+            q->ttbl->dtor(q->buffer + (index * q->ttbl->width));
+        }
+
+        if (q->seq) {
+            q->seq[index] = pos + q->mask + 1;
+        }
+    }
+
+    q->dequeue_pos = enq;
+}
+
+/**
+ *  @brief  Returns the synchronization mode of q
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     mode given to q_new
+ */
+enum queue_mode q_get_mode(queue *q) {
+    massert_container(q);
+    return q->mode;
+}
+
+/**
+ *  @brief  Returns the size of a single element in q, in bytes
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     q->ttbl->width
+ */
+size_t q_get_width(queue *q) {
+    massert_container(q);
+    return q->ttbl->width;
+}
+
+/**
+ *  @brief  Returns the typetable of q
+ *
+ *  @param[in]  q   pointer to queue
+ *
+ *  @return     q->ttbl
+ */
+struct typetable *q_get_ttbl(queue *q) {
+    massert_container(q);
+    return q->ttbl;
+}
+
+/**
+ *  @brief  Allocates memory for a queue
+ *
+ *  @return     pointer to uninitialized queue
+ */
+static queue *q_allocate(void) {
+    queue *q = NULL;
+    q = malloc(sizeof *q);
+    massert_malloc(q);
+    return q;
+}
+
+/**
+ *  @brief  Initializes a queue with a ring of capacity slots
+ *
+ *  @param[in]  q           pointer to queue
+ *  @param[in]  ttbl        pointer to struct typetable
+ *  @param[in]  capacity    requested capacity
+ *  @param[in]  mode        synchronization mode
+ */
+static void q_init(queue *q, struct typetable *ttbl, size_t capacity,
+                   enum queue_mode mode) {
+    size_t cap = 0;
+    size_t i = 0;
+
+    massert_container(q);
+
+    q->ttbl = ttbl ? ttbl : _void_ptr_;
+    q->mode = mode;
+
+    massert((q->ttbl->width > 0),
+            "[queue requires a typetable with a nonzero width]");
+
+    cap = q_round_capacity(capacity);
+
+    massert((cap <= ((size_t)(-1)) / q->ttbl->width),
+            "[Requested queue capacity overflows size_t]");
+
+    q->mask = cap - 1;
+    q->enqueue_pos = 0;
+    q->dequeue_pos = 0;
+
+    q->not_empty = 0;
+    q->not_empty_waiters = 0;
+    q->not_full = 0;
+    q->not_full_waiters = 0;
+
+    q->buffer = malloc(cap * q->ttbl->width);
+    massert_malloc(q->buffer);
+
+    q->seq = NULL;
+
+    if (mode != QUEUE_SERIAL) {
+        q->seq = malloc(cap * sizeof *q->seq);
+        massert_malloc(q->seq);
+
+        for (i = 0; i < cap; i++) {
+            q->seq[i] = i;
+        }
+    }
+
+    /**
+     *  Publish the initialized ring before q is handed to other threads.
+     */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ *  @brief  Releases remaining elements and the ring of q
+ *
+ *  @param[in]  q   pointer to queue
+ */
+static void q_deinit(queue *q) {
+    massert_container(q);
+
+    q_clear(q);
+
+    free(q->buffer);
+    q->buffer = NULL;
+
+    free(q->seq);
+    q->seq = NULL;
+
+    q->mask = 0;
+}
+
+/**
+ *  @brief  Rounds n up to the next power of two (minimum 2)
+ *
+ *  @param[in]  n   requested capacity
+ *
+ *  @return     smallest power of two >= n
+ */
+static size_t q_round_capacity(size_t n) {
+    size_t cap = 2;
+
+    while (cap < n) {
+        massert((cap <= (((size_t)(-1)) >> 1)),
+                "[Requested queue capacity overflows size_t]");
+        cap <<= 1;
+    }
+
+    return cap;
+}
+
+/**
+ *  @brief  Copies n elements from src into the slots starting at pos
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[in]  pos     position of the first slot (not yet masked)
+ *  @param[in]  src     address of n contiguous elements
+ *  @param[in]  n       number of elements, n <= capacity
+ *
+ *  Without a copy function, the run is written with at most
+ *  two memcpy calls (one on each side of the wraparound).
+ */
+static void q_copy_in_run(queue *q, size_t pos, const char *src, size_t n) {
+    const size_t width = q->ttbl->width;
+    size_t index = pos & q->mask;
+    size_t i = 0;
+
+    if (q->ttbl->copy) {
+        for (i = 0; i < n; i++) {
+            q->ttbl->copy(q->buffer + (index * width), src + (i * width));
+            index = (index + 1) & q->mask;
+        }
+    } else {
+        size_t first = (q->mask + 1) - index;
+        first = first < n ? first : n;
+
+        memcpy(q->buffer + (index * width), src, first * width);
+        memcpy(q->buffer, src + (first * width), (n - first) * width);
+    }
+}
+
+/**
+ *  @brief  Moves n elements from the slots starting at pos to dest
+ *
+ *  @param[in]  q       pointer to queue
+ *  @param[in]  pos     position of the first slot (not yet masked)
+ *  @param[out] dest    address of storage for n elements
+ *  @param[in]  n       number of elements, n <= capacity
+ */
+static void q_move_out_run(queue *q, size_t pos, char *dest, size_t n) {
+    const size_t width = q->ttbl->width;
+    size_t index = pos & q->mask;
+    size_t first = (q->mask + 1) - index;
+
+    first = first < n ? first : n;
+
+    memcpy(dest, q->buffer + (index * width), first * width);
+    memcpy(dest + (first * width), q->buffer, (n - first) * width);
+}
+
+/**
+ *  @brief  QUEUE_SERIAL push: no atomics
+ */
+static size_t q_serial_push_n(queue *q, const char *base, size_t n) {
+    size_t room = (q->mask + 1) - (q->enqueue_pos - q->dequeue_pos);
+    size_t k = n < room ? n : room;
+
+    q_copy_in_run(q, q->enqueue_pos, base, k);
+    q->enqueue_pos += k;
+
+    return k;
+}
+
+/**
+ *  @brief  QUEUE_SERIAL pop: no atomics
+ */
+static size_t q_serial_pop_n(queue *q, char *dest, size_t n) {
+    size_t size = q->enqueue_pos - q->dequeue_pos;
+    size_t k = n < size ? n : size;
+
+    q_move_out_run(q, q->dequeue_pos, dest, k);
+    q->dequeue_pos += k;
+
+    return k;
+}
+
+/**
+ *  @brief  Lock-free multi-producer push of up to n elements
+ *
+ *  @return     number of elements enqueued, 0 if q was full
+ *
+ *  The producer scans the run of free slots starting at enqueue_pos,
+ *  then claims the whole run by advancing enqueue_pos with one CAS.
+ *  Each claimed slot is published individually by a release store
+ *  of its sequence number, so consumers never see a partial element.
+ */
+static size_t q_mpmc_push_n(queue *q, const char *base, size_t n) {
+    const size_t cap = q->mask + 1;
+    size_t pos = 0;
+    size_t k = 0;
+    size_t i = 0;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        size_t seq = __atomic_load_n(&q->seq[pos & q->mask], __ATOMIC_ACQUIRE);
+        long dif = (long)(seq - pos);
+
+        if (dif == 0) {
+            for (k = 1; k < n && k < cap; k++) {
+                size_t s = __atomic_load_n(&q->seq[(pos + k) & q->mask],
+                                           __ATOMIC_ACQUIRE);
+                if (s != pos + k) {
+                    break;
+                }
+            }
+
+            if (__atomic_compare_exchange_n(&q->enqueue_pos, &pos, pos + k,
+                                            0, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+
+            /* CAS failure reloaded pos; rescan */
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    q_copy_in_run(q, pos, base, k);
+
+    for (i = 0; i < k; i++) {
+        __atomic_store_n(&q->seq[(pos + i) & q->mask], pos + i + 1,
+                         __ATOMIC_RELEASE);
+    }
+
+    return k;
+}
+
+/**
+ *  @brief  Lock-free multi-consumer pop of up to n elements
+ *
+ *  @return     number of elements dequeued, 0 if q was empty
+ *
+ *  Mirror image of q_mpmc_push_n: a run of published slots is claimed
+ *  with one CAS on dequeue_pos, moved out, then each slot is released
+ *  to producers of the next lap.
+ */
+static size_t q_mpmc_pop_n(queue *q, char *dest, size_t n) {
+    const size_t cap = q->mask + 1;
+    size_t pos = 0;
+    size_t k = 0;
+    size_t i = 0;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        size_t seq = __atomic_load_n(&q->seq[pos & q->mask], __ATOMIC_ACQUIRE);
+        long dif = (long)(seq - (pos + 1));
+
+        if (dif == 0) {
+            for (k = 1; k < n && k < cap; k++) {
+                size_t s = __atomic_load_n(&q->seq[(pos + k) & q->mask],
+                                           __ATOMIC_ACQUIRE);
+                if (s != pos + k + 1) {
+                    break;
+                }
+            }
+
+            if (__atomic_compare_exchange_n(&q->dequeue_pos, &pos, pos + k,
+                                            0, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    q_move_out_run(q, pos, dest, k);
+
+    for (i = 0; i < k; i++) {
+        __atomic_store_n(&q->seq[(pos + i) & q->mask], pos + i + cap,
+                         __ATOMIC_RELEASE);
+    }
+
+    return k;
+}
+
+/**
+ *  @brief  QUEUE_BLOCKING push: parks while q is full,
+ *          returns once all n elements are enqueued
+ */
+static size_t q_blocking_push_n(queue *q, const char *base, size_t n) {
+    const size_t width = q->ttbl->width;
+    size_t done = 0;
+
+    while (done < n) {
+        size_t k = q_mpmc_push_n(q, base + (done * width), n - done);
+
+        if (k > 0) {
+            done += k;
+            q_notify(&q->not_empty, &q->not_empty_waiters, k);
+        } else {
+            q_park(q, &q->not_full, &q->not_full_waiters, true);
+        }
+    }
+
+    return done;
+}
+
+/**
+ *  @brief  QUEUE_BLOCKING pop: parks while q is empty,
+ *          then dequeues up to n elements
+ */
+static size_t q_blocking_pop_n(queue *q, char *dest, size_t n) {
+    size_t k = 0;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    while ((k = q_mpmc_pop_n(q, dest, n)) == 0) {
+        q_park(q, &q->not_empty, &q->not_empty_waiters, false);
+    }
+
+    q_notify(&q->not_full, &q->not_full_waiters, k);
+    return k;
+}
+
+/**
+ *  @brief  Sleeps on event until the opposite side makes progress
+ *
+ *  @param[in]  q           pointer to queue
+ *  @param[in]  event       futex word to sleep on
+ *  @param[in]  waiters     waiter count paired with event
+ *  @param[in]  producer    true if the caller waits for room,
+ *                          false if it waits for an element
+ *
+ *  The waiter count is raised, the event is sampled, and the ring is
+ *  re-checked before sleeping. Paired with the fence in q_notify,
+ *  either this re-check observes the other side's progress,
+ *  or the other side observes this waiter and bumps the event --
+ *  in which case FUTEX_WAIT returns immediately. No wakeup is lost.
+ *
+ *  The caller retries its operation after this function returns.
+ */
+static void q_park(queue *q, int *event, int *waiters, bool producer) {
+    size_t pos = 0;
+    size_t seq = 0;
+    bool ready = false;
+    int ev = 0;
+
+    __atomic_fetch_add(waiters, 1, __ATOMIC_SEQ_CST);
+    ev = __atomic_load_n(event, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (producer) {
+        pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+        seq = __atomic_load_n(&q->seq[pos & q->mask], __ATOMIC_ACQUIRE);
+        ready = (long)(seq - pos) >= 0;
+    } else {
+        pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+        seq = __atomic_load_n(&q->seq[pos & q->mask], __ATOMIC_ACQUIRE);
+        ready = (long)(seq - (pos + 1)) >= 0;
+    }
+
+    if (!ready) {
+#if defined(__linux__)
+        syscall(SYS_futex, event, FUTEX_WAIT_PRIVATE, ev, NULL, NULL, 0);
+#else
+        sched_yield();
+#endif /* defined(__linux__) */
+    }
+
+    __atomic_fetch_sub(waiters, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ *  @brief  Wakes up to n threads parked on event, if any are parked
+ *
+ *  @param[in]  event       futex word
+ *  @param[in]  waiters     waiter count paired with event
+ *  @param[in]  n           number of slots/elements just made available
+ */
+static void q_notify(int *event, int *waiters, size_t n) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(waiters, __ATOMIC_RELAXED) > 0) {
+        __atomic_fetch_add(event, 1, __ATOMIC_SEQ_CST);
+#if defined(__linux__)
+        syscall(SYS_futex, event, FUTEX_WAKE_PRIVATE,
+                n > (size_t)INT_MAX ? INT_MAX : (int)n, NULL, NULL, 0);
+#else
+        (void)n;
+#endif /* defined(__linux__) */
+    }
+}
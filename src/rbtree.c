@@ -22,43 +22,77 @@
 
 #include "rbtree.h"
 
-typedef void (*delfn)(void *);
-typedef void (*delete_rbnode_fn)(rbnode **, delfn);
+/*<< rbnode: parent/color, packed into n->parent_color */
+#define rbn_parent(N)                                                          \
+    ((rbnode *)((N)->parent_color & ~(size_t)(1)))
+#define rbn_color(N)                                                           \
+    ((enum node_color)((N)->parent_color & 1))
+#define rbn_set_parent(N, P)                                                   \
+    ((N)->parent_color = (size_t)(P) | ((N)->parent_color & 1))
+#define rbn_set_color(N, C)                                                    \
+    ((N)->parent_color = ((N)->parent_color & ~(size_t)(1)) | (size_t)(C))
+#define rbn_toggle_color(N) ((N)->parent_color ^= 1)
 
-/**< rbnode: allocation/initialization */
-static rbnode *rbn_allocate(void);
-static void rbn_init(rbnode *n, const void *valaddr, size_t width);
-static void rbn_deinit(rbnode *n, void (*dtor)(void *));
+/**
+ *  Nodes are carved from slabs owned by the tree;
+ *  slabs double in size from RBT_SLAB_MIN up to RBT_SLAB_MAX nodes.
+ *  Erased nodes go on a free list (linked through left),
+ *  and rbt_clear/rbt_delete release every slab at once.
+ */
+#define RBT_SLAB_MIN 16
+#define RBT_SLAB_MAX 4096
+
+struct rbpool {
+    char *slab;         /**< newest slab; each slab begins with the previous */
+    char *cursor;       /**< next unused node in the newest slab */
+    char *limit;        /**< end of the newest slab */
+    rbnode *free;       /**< erased nodes, linked through left */
+    size_t stride;      /**< bytes per node, element included */
+    size_t slab_nodes;  /**< node count of the next slab */
+};
 
-/**< rbnode: new/newcopy/delete */
-static rbnode *rbn_new(const void *valaddr, size_t width);
-static rbnode *rbn_newcopy(rbnode *n, size_t width, void *(*copy)(void *, const void *));
-static void rbn_delete(rbnode **n, void (*dtor)(void *));
+/*<< rbpool: node allocation */
+static void rbp_init(struct rbpool *p, size_t width);
+static rbnode *rbp_alloc(struct rbpool *p);
+static void rbp_free(struct rbpool *p, rbnode *n);
+static void rbp_release(struct rbpool *p);
+static void rbp_reserve(struct rbpool *p, size_t n);
 
-/**< rbnode: traversal to copy/destroy tree */
-static void rbn_copytree_recursive(rbnode **n, size_t width, rbnode *o,
-                                   void *(*copy)(void *, const void *));
+/**< rbnode: new/newcopy/delete */
+static rbnode *rbn_new(rbtree *t, const void *valaddr);
+static rbnode *rbn_newmove(rbtree *t, const void *valaddr);
+static rbnode *rbn_newcopy(rbtree *t, rbnode *n);
+static void rbn_delete(rbtree *t, rbnode **n);
+static void rbn_swap_values(rbnode *a, rbnode *b, size_t width);
 
-static void rbn_deltree_recursive(rbnode **n, delete_rbnode_fn delrbnfn,
-                                  void (*dtor)(void *));
+/**< rbnode: traversal to copy tree */
+static rbnode *rbn_copytree(rbtree *t, rbnode *o);
 
 /*<< rbnode: determine node color */
 static bool rbn_red(rbnode *n);
 
 /*<< rbnode: length functions */
 static size_t rbn_size(rbnode *n);
+static void rbn_update_count(rbnode *n);
 static int rbn_height(rbnode *n);
 static int rbn_level_compare(int x, int y);
 static size_t rbn_leafct(rbnode *n);
 
 /*<< rbnode: lookup */
 static rbnode *rbn_find(rbnode *n, const void *valaddr, int (*compare)(const void *, const void *));
+static rbnode *rbn_lower_bound(rbnode *n, const void *valaddr, int (*compare)(const void *, const void *));
+static rbnode *rbn_upper_bound(rbnode *n, const void *valaddr, int (*compare)(const void *, const void *));
 
 /*<< rbnode: node access functions */
 static rbnode *rbn_min(rbnode *n);
 static rbnode *rbn_max(rbnode *n);
 static rbnode *rbn_successor(rbnode *n);
-static rbnode *rbn_predecessor(rbnode *n);
+static rbnode *rbn_next(rbnode *n);
+static rbnode *rbn_prev(rbnode *n);
+
+/*<< rbnode: order statistics */
+static rbnode *rbn_select(rbnode *n, size_t k);
+static size_t rbn_index(rbnode *n);
 
 /*<< rbnode: node rotation */
 static rbnode *rbn_rotate_left(rbnode *n);
@@ -66,22 +100,25 @@ static rbnode *rbn_rotate_right(rbnode *n);
 static void rbn_color_flip(rbnode *n);
 
 /*<< rbnode: mutators - insert/erase/fixup */
-static rbnode *rbn_insert(rbnode *n, const void *valaddr, size_t width,
-                          int (*compare)(const void *, const void *));
 static rbnode *rbn_move_red_left(rbnode *n);
 static rbnode *rbn_move_red_right(rbnode *n);
-static rbnode *rbn_erase_min(rbnode *n, void (*dtor)(void *));
-static rbnode *rbn_erase_max(rbnode *n, void (*dtor)(void *));
-static rbnode *rbn_erase(rbnode *n, const void *valaddr, void (*dtor)(void *),
-                         int (*compare)(const void *, const void *));
+static void rbn_erase_min(rbtree *t, rbnode *n);
+static void rbn_erase_max(rbtree *t, rbnode *n);
+static void rbn_erase(rbtree *t, rbnode *n, const void *valaddr);
+static void rbn_unlink(rbtree *t, rbnode *n);
 static rbnode *rbn_fixup(rbnode *n);
+static rbnode *rbn_replace(rbtree *t, rbnode *n, rbnode *(*op)(rbnode *));
+
+/*<< rbnode: bulk construction from sorted elements */
+static rbnode *rbn_build(rbtree *t, const char *base, size_t count, int bh,
+                         bool move);
+static size_t rbn_most_nodes(int bh);
+static int rbn_build_height(size_t count);
 
 /*<< rbnode: traversal functions - recursive */
 static void rbn_inorder_recursive(rbnode **n, void (*consumer)(void *));
 static void rbn_preorder_recursive(rbnode **n, void (*consumer)(void *));
 static void rbn_postorder_recursive(rbnode **n, void (*consumer)(void *));
-static void rbn_levelorder_recursive(rbnode **n, void (*consumer)(void *));
-static void rbn_levelorder_helper(rbnode **n, void (*consumer)(void *), int level);
 
 /*<< rbnode: traversal functions - iterative */
 static void rbn_inorder(rbnode **n, void (*consumer)(void *));
@@ -89,15 +126,10 @@ static void rbn_preorder(rbnode **n, void (*consumer)(void *));
 static void rbn_postorder(rbnode **n, void (*consumer)(void *));
 static void rbn_levelorder(rbnode **n, void (*consumer)(void *));
 
-/*<< rbnode: traversal in buffer (used by iterator) - iterative */
-/*
-static rbnode **rbn_inorder_buffer(rbnode **n);
-static rbnode **rbn_preorder_buffer(rbnode **n);
-static rbnode **rbn_postorder_buffer(rbnode **n);
-static rbnode **rbn_levelorder_buffer(rbnode **n);
-
-static void **rbn_inorder_base(rbnode **n);
-*/
+/*<< rbnode: traversal steps - follow parent pointers, never leave root */
+static rbnode *rbn_preorder_next(rbnode *n, rbnode *root);
+static rbnode *rbn_postorder_first(rbnode *n);
+static rbnode *rbn_postorder_next(rbnode *n, rbnode *root);
 
 /*<< rbnode: output tree to FILE stream */
 static void rbn_fputs(rbnode *n, FILE *dest, char *b, bool last,
@@ -105,7 +137,9 @@ static void rbn_fputs(rbnode *n, FILE *dest, char *b, bool last,
 
 struct rbtree {
     rbnode *root;
+    size_t size;
     struct typetable *ttbl;
+    struct rbpool pool;
 };
 
 struct typetable ttbl_rbtree = {
@@ -119,6 +153,41 @@ struct typetable ttbl_rbtree = {
 
 struct typetable *_rbtree_ = &ttbl_rbtree;
 
+/**
+ *  Frozen snapshot of an rbtree: (size + 1) slots of ttbl->width bytes,
+ *  elements in Eytzinger order at slots 1 through size (see rbt_freeze).
+ */
+struct rbfrozen {
+    char *base;
+    size_t size;
+    struct typetable *ttbl;
+};
+
+/**
+ *  rbt_find_many advances up to RBT_FIND_GROUP lookups in lockstep,
+ *  so that the cache misses of one are overlapped with the others.
+ */
+#define RBT_FIND_GROUP 16
+
+/*<< rbfrozen: implicit tree navigation -- slot 0 means none/end */
+static size_t rbf_lower_index(rbfrozen *f, const void *valaddr);
+static size_t rbf_first(rbfrozen *f);
+static size_t rbf_last(rbfrozen *f);
+static size_t rbf_next(rbfrozen *f, size_t k);
+static size_t rbf_prev(rbfrozen *f, size_t k);
+
+/*<< rbfrozen: order statistics */
+static size_t rbf_subtree_size(rbfrozen *f, size_t k);
+static size_t rbf_rank(rbfrozen *f, size_t k);
+static size_t rbf_select(rbfrozen *f, size_t r);
+
+/**
+ *  rbt_insert_bulk rebuilds the whole tree instead of inserting
+ *  one element at a time once the batch has at least
+ *  1/RBT_BULK_REBUILD_RATIO as many elements as the tree.
+ */
+#define RBT_BULK_REBUILD_RATIO 4
+
 iterator rbti_begin(void *arg);
 iterator rbti_end(void *arg);
 
@@ -143,6 +212,8 @@ bool rbti_has_prev(iterator it);
 
 struct typetable *rbti_get_ttbl(void *arg);
 
+static size_t rbti_index(iterator it);
+
 struct iterator_table itbl_rbtree = {
     rbti_begin,
     rbti_end,
@@ -159,11 +230,65 @@ struct iterator_table itbl_rbtree = {
     rbti_distance,
     rbti_has_next,
     rbti_has_prev,
-    rbti_get_ttbl
+    rbti_get_ttbl,
+    ITERATOR_BIDIRECTIONAL
 };
 
 struct iterator_table *_rbtree_iterator_ = &itbl_rbtree;
 
+iterator rbfi_begin(void *arg);
+iterator rbfi_end(void *arg);
+
+iterator rbfi_next(iterator it);
+iterator rbfi_next_n(iterator it, int n);
+
+iterator rbfi_prev(iterator it);
+iterator rbfi_prev_n(iterator it, int n);
+
+iterator *rbfi_advance(iterator *it, int n);
+iterator *rbfi_incr(iterator *it);
+iterator *rbfi_decr(iterator *it);
+
+void *rbfi_curr(iterator it);
+void *rbfi_start(iterator it);
+void *rbfi_finish(iterator it);
+
+int rbfi_distance(iterator *first, iterator *last);
+
+bool rbfi_has_next(iterator it);
+bool rbfi_has_prev(iterator it);
+
+struct typetable *rbfi_get_ttbl(void *arg);
+
+static size_t rbfi_slot(iterator it);
+
+struct iterator_table itbl_rbfrozen = {
+    rbfi_begin,
+    rbfi_end,
+    rbfi_next,
+    rbfi_next_n,
+    rbfi_prev,
+    rbfi_prev_n,
+    rbfi_advance,
+    rbfi_incr,
+    rbfi_decr,
+    rbfi_curr,
+    rbfi_start,
+    rbfi_finish,
+    rbfi_distance,
+    rbfi_has_next,
+    rbfi_has_prev,
+    rbfi_get_ttbl,
+    ITERATOR_BIDIRECTIONAL
+};
+
+struct iterator_table *_rbfrozen_iterator_ = &itbl_rbfrozen;
+
+/*<< rbtree: leaf insertion with bottom-up fixup, merge-and-rebuild */
+static rbnode *rbt_attach(rbtree *t, rbnode *parent, bool left,
+                          const void *valaddr);
+static size_t rbt_merge_rebuild(rbtree *t, const char *batch, size_t m);
+
 /*<< rbtree: allocation/initialization */
 static rbtree *rbt_allocate();
 static void rbt_init(rbtree *t, struct typetable *ttbl);
@@ -181,35 +306,138 @@ rbtree *rbt_newcopy(rbtree *t) {
 
     copy = rbt_new(t->ttbl);
 
-    rbn_copytree_recursive(&(copy->root), t->ttbl->width, t->root,
-                           t->ttbl->copy);
+    copy->root = rbn_copytree(copy, t->root);
+    copy->size = t->size;
 
     return copy;
 }
 
+/**
+ *  Builds an rbtree from the elements in [first, last), in O(n)
+ *  if they are already in order (see rbt_build_sorted).
+ *
+ *  @param[in]  first   iterator referring to the first element to copy
+ *  @param[in]  last    iterator referring to one past the last element
+ *
+ *  @return     pointer to rbtree
+ */
 rbtree *rbt_newrnge(iterator *first, iterator *last) {
+    struct typetable *ttbl = NULL;
     rbtree *t = NULL;
-    /*
-    int delta = 0;
-    int i = 0;
+
+    iterator it;
+    void *sentinel = NULL;
+    void *curr = NULL;
+
+    char *buffer = NULL;
+    size_t width = 0;
+    size_t n = 0;
 
     assert(first);
     assert(last);
 
-    t = rbt_new(it_get_ttbl(first));
+    if (first->itbl != last->itbl) {
+        ERROR(__FILE__, "first and last must have matching container types and refer to the same container.");
+        return NULL;
+    }
+
+    ttbl = it_get_ttbl((*first));
+    width = ttbl ? ttbl->width : _void_ptr_->width;
+    sentinel = it_curr((*last));     /**< iteration range is [first, last) */
+
+    /**< count first, so that the elements can be gathered contiguously */
+    it = (*first);
+    while ((curr = it_curr(it)) != sentinel) {
+        ++n;
+        it_incr(&it);
+    }
+
+    if (n > 0) {
+        char *pos = NULL;
+
+        buffer = malloc(n * width);
+        massert_malloc(buffer);
+
+        /**< shallow copies -- rbt_build_sorted applies ttbl->copy */
+        pos = buffer;
+        it = (*first);
+        while ((curr = it_curr(it)) != sentinel) {
+            memcpy(pos, curr, width);
+            pos += width;
+            it_incr(&it);
+        }
+    }
+
+    t = rbt_build_sorted(ttbl, buffer, n);
+
+    free(buffer);
+    buffer = NULL;
+
+    return t;
+}
+
+/**
+ *  Builds an rbtree from n contiguous elements at base in a single pass.
+ *
+ *  If base is sorted (non-decreasing by ttbl->compare), the tree is built
+ *  bottom-up in O(n) -- no comparisons beyond the sortedness check,
+ *  no rotations -- with all n nodes allocated as a single slab.
+ *  Otherwise, a sorted copy of base is made first (O(n log n)).
+ *
+ *  The result is black-perfect: every path from the root to a leaf
+ *  has the same number of nodes, each of them black, save for
+ *  red left children that absorb whatever does not fill a full level.
+ *
+ *  @param[in]  ttbl    pointer to struct typetable for
+ *                      width/copy/dtor/swap/compare/print
+ *  @param[in]  base    address of the first of n elements
+ *  @param[in]  n       number of elements at base
+ *
+ *  @return     pointer to rbtree
+ */
+rbtree *rbt_build_sorted(struct typetable *ttbl, const void *base, size_t n) {
+    rbtree *t = NULL;
+    const char *src = base;
+    char *sorted = NULL;
+    size_t width = 0;
+    size_t i = 0;
+
+    t = rbt_new(ttbl);
+
+    if (n == 0) {
+        return t;
+    }
 
-    delta = it_distance(first, last);
+    assert(base);
 
-    for (i = 0; i < delta; i++) {
-        void *next = it_has_next(first) ? it_next(first) : NULL;
+    width = t->ttbl->width;
 
-        if (next == NULL) {
+    for (i = 1; i < n; i++) {
+        if (t->ttbl->compare(src + (i - 1) * width, src + i * width) > 0) {
             break;
-        } else {
-            rbt_insert(t, next);
         }
     }
-    */
+
+    if (i < n) {
+        /**< out of order -- sort a shallow copy, then build from that */
+        sorted = malloc(n * width);
+        massert_malloc(sorted);
+
+        memcpy(sorted, base, n * width);
+        qsort(sorted, n, width, t->ttbl->compare);
+
+        src = sorted;
+    }
+
+    rbp_reserve(&t->pool, n);
+
+    t->root = rbn_build(t, src, n, rbn_build_height(n), false);
+    rbn_set_parent(t->root, NULL);
+    t->size = n;
+
+    free(sorted);
+    sorted = NULL;
+
     return t;
 }
 
@@ -221,7 +449,9 @@ rbtree *rbt_newmove(rbtree **t) {
     move = rbt_allocate();
 
     move->root = (*t)->root;
+    move->size = (*t)->size;
     move->ttbl = (*t)->ttbl;
+    move->pool = (*t)->pool;
 
     rbt_init((*t), (*t)->ttbl);
 
@@ -238,20 +468,16 @@ void rbt_delete(rbtree **t) {
 }
 
 iterator rbt_begin(rbtree *t) {
-    iterator it;
-
-    return it;
+    return rbti_begin(t);
 }
 
 iterator rbt_end(rbtree *t) {
-    iterator it;
-
-    return it;
+    return rbti_end(t);
 }
 
 size_t rbt_size(rbtree *t) {
     assert(t);
-    return rbn_size(t->root);
+    return t->size;
 }
 
 size_t rbt_maxsize(rbtree *t) {
@@ -283,7 +509,7 @@ bool rbt_empty(rbtree *t) {
 
 void *rbt_front(rbtree *t) {
     assert(t);
-    return t->root ? t->root->valaddr : NULL;
+    return t->root ? rbn_valaddr(t->root) : NULL;
 }
 
 void *rbt_min(rbtree *t) {
@@ -292,7 +518,7 @@ void *rbt_min(rbtree *t) {
 
     if (t->root) {
         rbnode *min = rbn_min(t->root);
-        result = min ? min->valaddr : NULL;
+        result = min ? rbn_valaddr(min) : NULL;
     }
 
     return result;
@@ -304,7 +530,7 @@ void *rbt_max(rbtree *t) {
 
     if (t->root) {
         rbnode *max = rbn_max(t->root);
-        result = max ? max->valaddr : NULL;
+        result = max ? rbn_valaddr(max) : NULL;
     }
 
     return result;
@@ -316,7 +542,8 @@ void *rbt_predecessor(rbtree *t, const void *valaddr) {
 
     if (t->root) {
         rbnode *n = rbn_find(t->root, valaddr, t->ttbl->compare);
-        result = n ? rbn_predecessor(n)->valaddr : NULL;
+        n = n ? rbn_prev(n) : NULL;
+        result = n ? rbn_valaddr(n) : NULL;
     }
 
     return result;
@@ -328,7 +555,8 @@ void *rbt_successor(rbtree *t, const void *valaddr) {
 
     if (t->root) {
         rbnode *n = rbn_find(t->root, valaddr, t->ttbl->compare);
-        result = n ? rbn_successor(n)->valaddr : NULL;
+        n = n ? rbn_next(n) : NULL;
+        result = n ? rbn_valaddr(n) : NULL;
     }
 
     return result;
@@ -358,182 +586,710 @@ void *rbt_find(rbtree *t, const void *valaddr) {
     assert(t);
 
     n = rbn_find(t->root, valaddr, t->ttbl->compare);
-    return n ? n->valaddr : NULL;
+    return n ? rbn_valaddr(n) : NULL;
 }
 
-void rbt_insert(rbtree *t, const void *valaddr) {
+/**
+ *  Looks up n keys at once: out[i] receives what rbt_find would return
+ *  for the i-th key (the address of a matching element, or NULL).
+ *
+ *  Lookups proceed in groups of RBT_FIND_GROUP, one level per round:
+ *  each round prefetches the next node of every lookup in the group
+ *  before any of them is compared again, so that on trees larger than
+ *  the cache, the misses of the group overlap instead of serializing.
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[in]  keys    address of n contiguous keys, ttbl->width bytes each
+ *  @param[in]  n       number of keys
+ *  @param[out] out     array of n pointers to fill
+ *
+ *  @return     number of keys found
+ */
+size_t rbt_find_many(rbtree *t, const void *keys, size_t n, void **out) {
+    int (*compare)(const void *, const void *) = NULL;
+    rbnode *lane[RBT_FIND_GROUP];
+    size_t width = 0;
+    size_t found = 0;
+    size_t base = 0;
+
     assert(t);
-    assert(valaddr);
+    assert(keys || n == 0);
+    assert(out || n == 0);
 
-    t->root = rbn_insert(t->root, valaddr, t->ttbl->width, t->ttbl->compare);
-    t->root->color = BLACK;
-}
+    compare = t->ttbl->compare;
+    width = t->ttbl->width;
 
-void rbt_insert_unique(rbtree *t, const void *valaddr) {
-    assert(t);
-    assert(valaddr);
+    for (base = 0; base < n; base += RBT_FIND_GROUP) {
+        size_t group = n - base < RBT_FIND_GROUP ? n - base : RBT_FIND_GROUP;
+        size_t active = group;
+        size_t j = 0;
 
-    if (t->root != NULL) {
-        bool duplicate = rbt_find(t, valaddr) != NULL;
+        for (j = 0; j < group; j++) {
+            lane[j] = t->root;
+            out[base + j] = NULL;
+        }
 
-        if (duplicate) {
-            ERROR(__FILE__, "insert failed - no duplicate elements allowed.");
-            return;
+        active = t->root ? group : 0;
+
+        while (active > 0) {
+            for (j = 0; j < group; j++) {
+                rbnode *node = lane[j];
+                int cmp = 0;
+
+                if (node == NULL) {
+                    /**< this lookup has already finished */
+                    continue;
+                }
+
+                cmp = compare(rbn_valaddr(node), ADDR_AT(keys, base + j, width));
+
+                if (cmp == 0) {
+                    out[base + j] = rbn_valaddr(node);
+                    ++found;
+                    node = NULL;
+                } else {
+                    node = cmp > 0 ? node->left : node->right;
+                }
+
+                if (node) {
+                    PREFETCH(node);
+                } else {
+                    --active;
+                }
+
+                lane[j] = node;
+            }
         }
     }
 
-    t->root = rbn_insert(t->root, valaddr, t->ttbl->width, t->ttbl->compare);
+    return found;
 }
 
-void rbt_erase(rbtree *t, const void *valaddr) {
-    assert(t);
-    assert(valaddr);
+/**
+ *  Returns an iterator to the first element of t that does not
+ *  compare less than valaddr, in O(log n).
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[in]  valaddr address of the key to search for
+ *
+ *  @return     iterator at the lower bound, or rbt_end(t) if there is none
+ */
+iterator rbt_lower_bound(rbtree *t, const void *valaddr) {
+    iterator it = rbti_end(t);
 
-    if (t->root != NULL) {
-        rbnode *temp = t->root;
-        t->root = rbn_erase(t->root, valaddr, t->ttbl->dtor, t->ttbl->compare);
+    assert(valaddr);
 
-        t->root->color = BLACK;
-    }
+    it.curr = rbn_lower_bound(t->root, valaddr, t->ttbl->compare);
+    return it;
 }
 
-void rbt_erase_min(rbtree *t) {
-    assert(t);
-    t->root = rbn_erase_min(t->root, t->ttbl->dtor);
-    t->root->color = BLACK;
-}
+/**
+ *  Returns an iterator to the first element of t that compares
+ *  greater than valaddr, in O(log n).
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[in]  valaddr address of the key to search for
+ *
+ *  @return     iterator at the upper bound, or rbt_end(t) if there is none
+ */
+iterator rbt_upper_bound(rbtree *t, const void *valaddr) {
+    iterator it = rbti_end(t);
 
-void rbt_erase_max(rbtree *t) {
-    assert(t);
-    t->root = rbn_erase_max(t->root, t->ttbl->dtor);
-    t->root->color = BLACK;
+    assert(valaddr);
+
+    it.curr = rbn_upper_bound(t->root, valaddr, t->ttbl->compare);
+    return it;
 }
 
-void rbt_clear(rbtree *t) {
+/**
+ *  Returns the k-th smallest element of t (k = 0 is the minimum),
+ *  in O(log n), using the subtree counts kept in each rbnode.
+ *
+ *  @param[in]  t   pointer to rbtree
+ *  @param[in]  k   zero-based rank of the desired element
+ *
+ *  @return     address of the element, or NULL if k >= rbt_size(t)
+ */
+void *rbt_select(rbtree *t, size_t k) {
+    rbnode *n = NULL;
     assert(t);
 
-    if (t->root) {
-        rbn_deltree_recursive(&(t->root), rbn_delete, t->ttbl->dtor);
-    }
+    n = k < t->size ? rbn_select(t->root, k) : NULL;
+    return n ? rbn_valaddr(n) : NULL;
 }
 
-void rbt_swap(rbtree **t, rbtree **other) {
-    rbtree *temp = NULL;
+/**
+ *  Returns the number of elements in t that compare less than valaddr,
+ *  in O(log n) -- valaddr need not be in t.
+ *
+ *  If valaddr is in t, this is the index rbt_select would take
+ *  to return (the first of) its matching element(s).
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[in]  valaddr address of the key to rank
+ *
+ *  @return     count of elements less than valaddr
+ */
+size_t rbt_rank(rbtree *t, const void *valaddr) {
+    rbnode *n = NULL;
+    size_t rank = 0;
 
-    assert((*t));
-    assert((*other));
+    assert(t);
+    assert(valaddr);
+
+    n = t->root;
 
-    temp = (*t);
-    (*t)->root = (*other)->root;
-    (*t)->ttbl = (*other)->ttbl;
+    while (n) {
+        if (t->ttbl->compare(rbn_valaddr(n), valaddr) < 0) {
+            rank += rbn_size(n->left) + 1;
+            n = n->right;
+        } else {
+            n = n->left;
+        }
+    }
 
-    (*other)->root = temp->root;
-    (*other)->ttbl = temp->ttbl;
+    return rank;
 }
 
-void rbt_foreach(rbtree *t, void (*consumer)(void *), enum node_traversal ttype) {
+/**
+ *  Returns the number of elements e in t such that lo <= e < hi,
+ *  in O(log n), using the subtree counts kept in each rbnode.
+ *
+ *  @param[in]  t   pointer to rbtree
+ *  @param[in]  lo  address of the inclusive lower bound, or NULL for none
+ *  @param[in]  hi  address of the exclusive upper bound, or NULL for none
+ *
+ *  @return     count of elements in [lo, hi); 0 if hi is not above lo
+ */
+size_t rbt_count_range(rbtree *t, const void *lo, const void *hi) {
+    size_t first = 0;
+    size_t last = 0;
+
     assert(t);
 
-    if (t->root) {
-        switch (ttype) {
-        case INORDER:
-            rbn_inorder(&t->root, consumer);
-            break;
+    first = lo ? rbt_rank(t, lo) : 0;
+    last = hi ? rbt_rank(t, hi) : t->size;
 
-        case PREORDER:
-            rbn_preorder(&t->root, consumer);
-            break;
+    return last > first ? last - first : 0;
+}
 
-        case POSTORDER:
-            rbn_postorder(&t->root, consumer);
-            break;
+void rbt_insert(rbtree *t, const void *valaddr) {
+    rbnode *n = NULL;
+    rbnode *parent = NULL;
+    bool left = false;
 
-        case LEVELORDER:
-            rbn_levelorder(&t->root, consumer);
-            break;
-        }
+    assert(t);
+    assert(valaddr);
+
+    /**< equal elements go to the right, after those already present */
+    for (n = t->root; n; n = left ? n->left : n->right) {
+        parent = n;
+        left = t->ttbl->compare(rbn_valaddr(n), valaddr) > 0;
     }
-}
 
-void rbt_foreach_recursive(rbtree *t, void (*consumer)(void *),
-                           enum node_traversal ttype) {
-    assert(t);
+    rbt_attach(t, parent, left, valaddr);
+}
 
-    if (t->root) {
-        switch (ttype) {
-        case INORDER:
-            rbn_inorder_recursive(&t->root, consumer);
-            break;
+void rbt_insert_unique(rbtree *t, const void *valaddr) {
+    rbnode *n = NULL;
+    rbnode *parent = NULL;
+    bool left = false;
 
-        case PREORDER:
-            rbn_preorder_recursive(&t->root, consumer);
-            break;
+    assert(t);
+    assert(valaddr);
 
-        case POSTORDER:
-            rbn_postorder_recursive(&t->root, consumer);
-            break;
+    for (n = t->root; n; n = left ? n->left : n->right) {
+        int cmp = t->ttbl->compare(rbn_valaddr(n), valaddr);
 
-        case LEVELORDER:
-            rbn_levelorder_recursive(&t->root, consumer);
-            break;
+        if (cmp == 0) {
+            ERROR(__FILE__, "insert failed - no duplicate elements allowed.");
+            return;
         }
+
+        parent = n;
+        left = cmp > 0;
     }
+
+    rbt_attach(t, parent, left, valaddr);
 }
 
-void rbt_puts(rbtree *t) { rbt_fputs(t, stdout); }
+/**
+ *  Inserts valaddr into t, unless an equal element is present,
+ *  using hint as a guess for where valaddr belongs.
+ *
+ *  If valaddr belongs immediately before or after the element at hint
+ *  (or before end, if hint is rbt_end), the new node is linked in
+ *  without a search from the root -- at most two comparisons are made.
+ *  Otherwise, this falls back to an ordinary descent.
+ *
+ *  Either way, *hint is updated to refer to the inserted element,
+ *  or to the equal element that was found -- so inserting an ascending
+ *  stream with the same hint makes every insertion a neighbor of the last.
+ *
+ *  Subtree counts are kept, so the walk back up to the root for
+ *  rebalancing is still O(log n), but it makes no comparisons.
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[out] hint    iterator into t (another container's is ignored)
+ *  @param[in]  valaddr address of the element to insert
+ *
+ *  @return     true if valaddr was inserted, false if it was found
+ */
+bool rbt_insert_hint(rbtree *t, iterator *hint, const void *valaddr) {
+    int (*compare)(const void *, const void *) = NULL;
+    rbnode *found = NULL;
+    rbnode *parent = NULL;
+    bool left = false;
+    bool placed = false;
 
-void rbt_fputs(rbtree *t, FILE *dest) {
     assert(t);
-    assert(dest);
+    assert(hint);
+    assert(valaddr);
 
-    if (t->root != NULL) {
-        const char *link = "---------------------------";
+    compare = t->ttbl->compare;
 
-        char buffer1[128];
-        char buffer2[BUFFER_SIZE_4K];
-        const char *bytes_label = NULL;
+    if (hint->itbl == _rbtree_iterator_ && hint->container == t) {
+        rbnode *h = hint->curr;
+        rbnode *p = NULL;
+        int cmp = 0;
 
-        sprintf(buffer1, "\n%s\n%s\n%s\n", link, "RED-BLACK Tree Elements",
-                link);
+        if (h == NULL) {
+            /**< end: valaddr must follow the maximum */
+            p = t->root ? rbn_max(t->root) : NULL;
+            cmp = p ? compare(rbn_valaddr(p), valaddr) : -1;
 
-        bytes_label = t->ttbl->width == 1 ? "byte" : "bytes";
+            if (cmp < 0) {
+                parent = p;
+                left = false;
+                placed = true;
+            } else if (cmp == 0) {
+                found = p;
+            }
+        } else if ((cmp = compare(rbn_valaddr(h), valaddr)) == 0) {
+            found = h;
+        } else if (cmp > 0) {
+            /**< valaddr < h: fits if h's predecessor is less than it */
+            p = rbn_prev(h);
+            cmp = p ? compare(rbn_valaddr(p), valaddr) : -1;
+
+            if (cmp < 0) {
+                /**< h->left, or else the right of h's predecessor, is free */
+                parent = h->left ? p : h;
+                left = h->left == NULL;
+                placed = true;
+            } else if (cmp == 0) {
+                found = p;
+            }
+        } else {
+            /**< valaddr > h: fits if h's successor is greater than it */
+            p = rbn_next(h);
+            cmp = p ? compare(rbn_valaddr(p), valaddr) : 1;
+
+            if (cmp > 0) {
+                /**< h->right, or else the left of h's successor, is free */
+                parent = h->right ? p : h;
+                left = h->right != NULL;
+                placed = true;
+            } else if (cmp == 0) {
+                found = p;
+            }
+        }
+    }
 
-        sprintf(buffer2, "%s\t\t%lu\n%s\t\t%lu %s\n%s\t\t%d\n%s\t%lu\n%s\n",
-        "Size         ", rbn_size(t->root),
-        "Element size  ", t->ttbl->width, bytes_label,
-        "Height       ", rbn_height(t->root),
-        "Leaf ct. (non nil)", rbn_leafct(t->root),
-        link);
+    if (found == NULL && placed == false) {
+        /**< hint did not help -- search from the root */
+        rbnode *n = t->root;
 
-        fprintf(dest, "%s", buffer1);
-        fprintf(dest, "\n");
-        rbn_fputs(t->root, dest, "", true, t->ttbl->print);
-        fprintf(dest, "\n");
+        parent = NULL;
 
-        fprintf(dest, "%s\n", link);
+        while (n) {
+            int cmp = compare(rbn_valaddr(n), valaddr);
 
-        fprintf(dest, "%s\t\t", "Minimum value");
-        t->ttbl->print(rbn_min(t->root)->valaddr, dest);
-        fprintf(dest, "\n");
+            if (cmp == 0) {
+                found = n;
+                break;
+            }
 
-        fprintf(dest, "%s\t\t", "Maximum value");
-        t->ttbl->print(rbn_max(t->root)->valaddr, dest);
-        fprintf(dest, "\n");
+            parent = n;
+            left = cmp > 0;
+            n = cmp > 0 ? n->left : n->right;
+        }
+    }
 
-        fprintf(dest, "%s\t\t", "Root value   ");
-        t->ttbl->print(t->root->valaddr, dest);
-        fprintf(dest, "\n\n");
+    hint->itbl = _rbtree_iterator_;
+    hint->container = t;
 
-        fprintf(dest, "%s", buffer2);
-    } else {
-        fprintf(dest, "\n%s\tno elements found\n\n", EMPTY_SET_SYMBOL);
+    if (found) {
+        hint->curr = found;
+        return false;
     }
+
+    hint->curr = rbt_attach(t, parent, left, valaddr);
+    return true;
 }
 
 /**
- *  Compares node counts between two rbtrees
+ *  Inserts the n elements at base into t, skipping any element that is
+ *  equal to one already in t (or to an earlier one in the batch).
  *
- *  @param[in]  c1      the first rbtree to compare
+ *  The batch is sorted first. If it is large relative to t
+ *  (see RBT_BULK_REBUILD_RATIO), t and the batch are merged in one pass
+ *  and t is rebuilt with rbt_build_sorted's linear construction;
+ *  otherwise, the batch is fed in order through rbt_insert_hint.
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[in]  base    address of the first of n elements
+ *  @param[in]  n       number of elements at base
+ *
+ *  @return     number of elements inserted; n minus that were found
+ */
+size_t rbt_insert_bulk(rbtree *t, const void *base, size_t n) {
+    int (*compare)(const void *, const void *) = NULL;
+    char *batch = NULL;
+    size_t width = 0;
+    size_t inserted = 0;
+    size_t m = 0;
+    size_t i = 0;
+
+    assert(t);
+
+    if (n == 0) {
+        return 0;
+    }
+
+    assert(base);
+
+    compare = t->ttbl->compare;
+    width = t->ttbl->width;
+
+    /**< sort a shallow copy of the batch, then drop its duplicates */
+    batch = malloc(n * width);
+    massert_malloc(batch);
+
+    memcpy(batch, base, n * width);
+    qsort(batch, n, width, compare);
+
+    for (m = 1, i = 1; i < n; i++) {
+        if (compare(batch + (m - 1) * width, batch + i * width) != 0) {
+            if (m != i) {
+                memcpy(batch + m * width, batch + i * width, width);
+            }
+
+            ++m;
+        }
+    }
+
+    if (m * RBT_BULK_REBUILD_RATIO >= t->size) {
+        inserted = rbt_merge_rebuild(t, batch, m);
+    } else {
+        iterator hint = rbti_end(t);
+
+        for (i = 0; i < m; i++) {
+            if (rbt_insert_hint(t, &hint, batch + i * width)) {
+                ++inserted;
+            }
+        }
+    }
+
+    free(batch);
+    batch = NULL;
+
+    return inserted;
+}
+
+void rbt_erase(rbtree *t, const void *valaddr) {
+    assert(t);
+    assert(valaddr);
+
+    /**< rbn_erase assumes the key is present */
+    if (rbn_find(t->root, valaddr, t->ttbl->compare) != NULL) {
+        if (!rbn_red(t->root->left) && !rbn_red(t->root->right)) {
+            /**< let the root take part in move_red_left/right */
+            rbn_set_color(t->root, RED);
+        }
+
+        rbn_erase(t, t->root, valaddr);
+
+        if (t->root) {
+            rbn_set_color(t->root, BLACK);
+        }
+
+        --t->size;
+    }
+}
+
+void rbt_erase_min(rbtree *t) {
+    assert(t);
+
+    if (t->root) {
+        if (!rbn_red(t->root->left) && !rbn_red(t->root->right)) {
+            /**< let the root take part in move_red_left/right */
+            rbn_set_color(t->root, RED);
+        }
+
+        rbn_erase_min(t, t->root);
+
+        if (t->root) {
+            rbn_set_color(t->root, BLACK);
+        }
+
+        --t->size;
+    }
+}
+
+void rbt_erase_max(rbtree *t) {
+    assert(t);
+
+    if (t->root) {
+        if (!rbn_red(t->root->left) && !rbn_red(t->root->right)) {
+            /**< let the root take part in move_red_left/right */
+            rbn_set_color(t->root, RED);
+        }
+
+        rbn_erase_max(t, t->root);
+
+        if (t->root) {
+            rbn_set_color(t->root, BLACK);
+        }
+
+        --t->size;
+    }
+}
+
+void rbt_clear(rbtree *t) {
+    assert(t);
+
+    if (t->root && t->ttbl->dtor) {
+        /**< only elements that own resources need to be visited */
+        rbnode *n = rbn_min(t->root);
+
+        while (n) {
+            t->ttbl->dtor(rbn_valaddr(n));
+            n = rbn_next(n);
+        }
+    }
+
+    /**< every node lives in t's pool -- release the slabs wholesale */
+    rbp_release(&t->pool);
+
+    t->root = NULL;
+    t->size = 0;
+}
+
+void rbt_swap(rbtree **t, rbtree **other) {
+    rbtree temp;
+
+    assert((*t));
+    assert((*other));
+
+    temp = (**t);
+    (**t) = (**other);
+    (**other) = temp;
+}
+
+/**
+ *  Applies consumer to every node of t, in the order given by ttype,
+ *  in O(n). INORDER, PREORDER and POSTORDER follow parent links,
+ *  and allocate nothing; LEVELORDER allocates (and frees) one queue
+ *  of n node pointers, since breadth-first order cannot be recovered
+ *  from the links alone.
+ *
+ *  @param[in]  t           pointer to rbtree
+ *  @param[in]  consumer    function to apply to each node, as an (rbnode **)
+ *  @param[in]  ttype       INORDER, PREORDER, POSTORDER, or LEVELORDER
+ */
+void rbt_foreach(rbtree *t, void (*consumer)(void *), enum node_traversal ttype) {
+    assert(t);
+
+    if (t->root) {
+        switch (ttype) {
+        case INORDER:
+            rbn_inorder(&t->root, consumer);
+            break;
+
+        case PREORDER:
+            rbn_preorder(&t->root, consumer);
+            break;
+
+        case POSTORDER:
+            rbn_postorder(&t->root, consumer);
+            break;
+
+        case LEVELORDER:
+            rbn_levelorder(&t->root, consumer);
+            break;
+        }
+    }
+}
+
+void rbt_foreach_recursive(rbtree *t, void (*consumer)(void *),
+                           enum node_traversal ttype) {
+    assert(t);
+
+    if (t->root) {
+        switch (ttype) {
+        case INORDER:
+            rbn_inorder_recursive(&t->root, consumer);
+            break;
+
+        case PREORDER:
+            rbn_preorder_recursive(&t->root, consumer);
+            break;
+
+        case POSTORDER:
+            rbn_postorder_recursive(&t->root, consumer);
+            break;
+
+        case LEVELORDER:
+            /**< breadth-first by nature -- shares rbn_levelorder */
+            rbn_levelorder(&t->root, consumer);
+            break;
+        }
+    }
+}
+
+/**
+ *  Applies consumer to every element e in t such that lo <= e < hi,
+ *  in order, starting from a single O(log n) descent to lo --
+ *  so the cost is O(log n + k) for k elements visited,
+ *  rather than that of a full traversal.
+ *
+ *  consumer receives ctx and the address of the element
+ *  (the argument order of rbt_for_each_ctx);
+ *  the walk ends early once consumer returns false.
+ *  consumer must not insert or erase elements of t.
+ *
+ *  @param[in]  t           pointer to rbtree
+ *  @param[in]  lo          address of the inclusive lower bound, or NULL
+ *  @param[in]  hi          address of the exclusive upper bound, or NULL
+ *  @param[in]  consumer    function to apply to each element in range
+ *  @param[in]  ctx         caller state, passed through to consumer
+ *
+ *  @return     number of elements passed to consumer
+ */
+size_t rbt_foreach_range(rbtree *t, const void *lo, const void *hi,
+                         bool (*consumer)(void *, void *), void *ctx) {
+    int (*compare)(const void *, const void *) = NULL;
+    rbnode *n = NULL;
+    size_t visited = 0;
+
+    assert(t);
+    assert(consumer);
+
+    compare = t->ttbl->compare;
+    if (lo) {
+        n = rbn_lower_bound(t->root, lo, compare);
+    } else {
+        n = t->root ? rbn_min(t->root) : NULL;
+    }
+
+    while (n && (hi == NULL || compare(rbn_valaddr(n), hi) < 0)) {
+        ++visited;
+
+        if (consumer(ctx, rbn_valaddr(n)) == false) {
+            break;
+        }
+
+        n = rbn_next(n);
+    }
+
+    return visited;
+}
+
+/**
+ *  Applies visitor to every element of t, in order.
+ *
+ *  visitor receives ctx, the address of an element, and a count of 1 --
+ *  each rbnode holds a single element, so no run is longer.
+ *  Unlike rbt_foreach, caller state travels through ctx rather than
+ *  through globals, and the walk is iterative (no recursion, no queue).
+ *
+ *  The walk ends early once visitor returns false.
+ *  visitor must not insert or erase elements of t.
+ *
+ *  @param[in]  t       pointer to rbtree
+ *  @param[in]  visitor function to apply to each element
+ *  @param[in]  ctx     caller state, passed through to visitor
+ *
+ *  @return     number of elements passed to visitor
+ */
+size_t rbt_for_each_ctx(rbtree *t, bool (*visitor)(void *, void *, size_t),
+                        void *ctx) {
+    rbnode *n = NULL;
+    size_t visited = 0;
+
+    assert(t);
+    assert(visitor);
+
+    n = t->root ? rbn_min(t->root) : NULL;
+
+    while (n) {
+        ++visited;
+
+        if (visitor(ctx, rbn_valaddr(n), 1) == false) {
+            break;
+        }
+
+        n = rbn_next(n);
+    }
+
+    return visited;
+}
+
+void rbt_puts(rbtree *t) { rbt_fputs(t, stdout); }
+
+void rbt_fputs(rbtree *t, FILE *dest) {
+    assert(t);
+    assert(dest);
+
+    if (t->root != NULL) {
+        const char *link = "---------------------------";
+
+        char buffer1[128];
+        char buffer2[BUFFER_SIZE_4K];
+        const char *bytes_label = NULL;
+
+        sprintf(buffer1, "\n%s\n%s\n%s\n", link, "RED-BLACK Tree Elements",
+                link);
+
+        bytes_label = t->ttbl->width == 1 ? "byte" : "bytes";
+
+        sprintf(buffer2, "%s\t\t%lu\n%s\t\t%lu %s\n%s\t\t%d\n%s\t%lu\n%s\n",
+        "Size         ", rbn_size(t->root),
+        "Element size  ", t->ttbl->width, bytes_label,
+        "Height       ", rbn_height(t->root),
+        "Leaf ct. (non nil)", rbn_leafct(t->root),
+        link);
+
+        fprintf(dest, "%s", buffer1);
+        fprintf(dest, "\n");
+        rbn_fputs(t->root, dest, "", true, t->ttbl->print);
+        fprintf(dest, "\n");
+
+        fprintf(dest, "%s\n", link);
+
+        fprintf(dest, "%s\t\t", "Minimum value");
+        t->ttbl->print(rbn_valaddr(rbn_min(t->root)), dest);
+        fprintf(dest, "\n");
+
+        fprintf(dest, "%s\t\t", "Maximum value");
+        t->ttbl->print(rbn_valaddr(rbn_max(t->root)), dest);
+        fprintf(dest, "\n");
+
+        fprintf(dest, "%s\t\t", "Root value   ");
+        t->ttbl->print(rbn_valaddr(t->root), dest);
+        fprintf(dest, "\n\n");
+
+        fprintf(dest, "%s", buffer2);
+    } else {
+        fprintf(dest, "\n%s\tno elements found\n\n", EMPTY_SET_SYMBOL);
+    }
+}
+
+/**
+ *  Compares node counts between two rbtrees
+ *
+ *  @param[in]  c1      the first rbtree to compare
  *  @param[in]  c2      the second rbtree to compare
  *
  *  @return     node count delta between c1 and c2
@@ -595,131 +1351,242 @@ void rbtree_delete(void *arg) {
     rbt_delete(&t);
 }
 
-static rbnode *rbn_allocate(void) {
+static void rbp_init(struct rbpool *p, size_t width) {
+    size_t align = 0;
+
+    assert(p);
+    assert(width > 0);
+
+    /**< keep every inline element aligned for its widest likely member */
+    align = width >= 16 ? 16 : sizeof(void *);
+
+    p->slab = NULL;
+    p->cursor = NULL;
+    p->limit = NULL;
+    p->free = NULL;
+    p->stride = (sizeof(rbnode) + width + align - 1) / align * align;
+    p->slab_nodes = RBT_SLAB_MIN;
+}
+
+static rbnode *rbp_alloc(struct rbpool *p) {
     rbnode *n = NULL;
-    n = malloc(sizeof((*n)));
-    assert(n);
+
+    if (p->free) {
+        n = p->free;
+        p->free = n->left;
+        return n;
+    }
+
+    if (p->cursor == p->limit) {
+        /**< slab header is padded to sizeof(rbnode) to keep nodes aligned */
+        char *slab = malloc(sizeof(rbnode) + p->slab_nodes * p->stride);
+        massert_malloc(slab);
+
+        *(char **)(slab) = p->slab;
+        p->slab = slab;
+        p->cursor = slab + sizeof(rbnode);
+        p->limit = p->cursor + p->slab_nodes * p->stride;
+
+        if (p->slab_nodes < RBT_SLAB_MAX) {
+            p->slab_nodes *= 2;
+        }
+    }
+
+    n = (rbnode *)(p->cursor);
+    p->cursor += p->stride;
+
     return n;
 }
 
-static void rbn_init(rbnode *n, const void *valaddr, size_t width) {
-    void *data = NULL;
+static void rbp_free(struct rbpool *p, rbnode *n) {
+    n->left = p->free;
+    p->free = n;
+}
 
-    assert(n);
-    assert(valaddr);
-    assert(width > 0);
+static void rbp_release(struct rbpool *p) {
+    while (p->slab) {
+        char *prev = *(char **)(p->slab);
+        free(p->slab);
+        p->slab = prev;
+    }
+
+    p->cursor = NULL;
+    p->limit = NULL;
+    p->free = NULL;
+    p->slab_nodes = RBT_SLAB_MIN;
+}
 
-    data = malloc(width);
-    assert(width);
-    memcpy(data, valaddr, width);
+static void rbp_reserve(struct rbpool *p, size_t n) {
+    char *slab = NULL;
 
-    n->valaddr = data;
+    if ((size_t)(p->limit - p->cursor) >= n * p->stride) {
+        return;
+    }
 
-    n->left = NULL;
-    n->right = NULL;
+    /**< one slab of exactly n nodes; the rest of the current one is unused */
+    slab = malloc(sizeof(rbnode) + n * p->stride);
+    massert_malloc(slab);
 
-    n->color = RED;
+    *(char **)(slab) = p->slab;
+    p->slab = slab;
+    p->cursor = slab + sizeof(rbnode);
+    p->limit = p->cursor + n * p->stride;
 }
 
-static void rbn_deinit(rbnode *n, void (*dtor)(void *)) {
-    assert(n);
+static rbnode *rbn_new(rbtree *t, const void *valaddr) {
+    rbnode *n = rbn_newmove(t, valaddr);
 
-    if (dtor) {
-        /**< for dynamically allocated valaddr/fields */
-        dtor(n->valaddr);
+    if (t->ttbl->copy) {
+        t->ttbl->copy(rbn_valaddr(n), valaddr);
     }
 
-    free(n->valaddr);
-    n->valaddr = NULL;
+    return n;
+}
+
+static rbnode *rbn_newmove(rbtree *t, const void *valaddr) {
+    rbnode *n = NULL;
+
+    assert(valaddr);
+
+    n = rbp_alloc(&t->pool);
+    memcpy(rbn_valaddr(n), valaddr, t->ttbl->width);
 
     n->left = NULL;
     n->right = NULL;
+    n->parent_color = (size_t)(RED);
+    n->count = 1;
 
-    n->color = BLACK;
-}
-
-static rbnode *rbn_new(const void *valaddr, size_t width) {
-    rbnode *n = rbn_allocate();
-    rbn_init(n, valaddr, width);
     return n;
 }
 
-static rbnode *rbn_newcopy(rbnode *n, size_t width, void *(*copy)(void *, const void *)) {
-    void *copy_valaddr = NULL;
+static rbnode *rbn_newcopy(rbtree *t, rbnode *n) {
     rbnode *copy_node = NULL;
 
     assert(n);
 
-    if (copy) {
-        copy_valaddr = copy(copy_valaddr, n->valaddr);
-    } else {
-        copy_valaddr = n->valaddr;
-    }
-
-    copy_node = rbn_new(copy_valaddr, width);
-    copy_node->color = n->color;
+    copy_node = rbn_new(t, rbn_valaddr(n));
+    rbn_set_color(copy_node, rbn_color(n));
+    copy_node->count = n->count;
 
     return copy_node;
 }
 
-static void rbn_delete(rbnode **n, void (*dtor)(void *)) {
+static void rbn_delete(rbtree *t, rbnode **n) {
     assert((*n));
 
-    rbn_deinit((*n), dtor);
+    if (t->ttbl->dtor) {
+        /**< for dynamically allocated valaddr/fields */
+        t->ttbl->dtor(rbn_valaddr((*n)));
+    }
 
-    free((*n));
+    rbp_free(&t->pool, (*n));
     (*n) = NULL;
 }
 
-static void rbn_copytree_recursive(rbnode **n, size_t width, rbnode *o,
-                                   void *(*copy)(void *, const void *)) {
-    if (o == NULL) {
-        (*n) = NULL;
-    } else {
-        (*n) = rbn_newcopy(o, width, copy);
+static void rbn_swap_values(rbnode *a, rbnode *b, size_t width) {
+    unsigned char *x = rbn_valaddr(a);
+    unsigned char *y = rbn_valaddr(b);
 
-        rbn_copytree_recursive(&((*n)->left), width, o->left, copy);
-        rbn_copytree_recursive(&((*n)->right), width, o->right, copy);
+    while (width--) {
+        unsigned char temp = *x;
+        *x++ = *y;
+        *y++ = temp;
     }
 }
 
-static void rbn_deltree_recursive(rbnode **n, delete_rbnode_fn delrbnfn,
-                                  void (*dtor)(void *)) {
-    if ((*n)) {
-        rbn_deltree_recursive(&((*n)->left), delrbnfn, dtor);
-        rbn_deltree_recursive(&((*n)->right), delrbnfn, dtor);
+static rbnode *rbn_copytree(rbtree *t, rbnode *o) {
+    rbnode *root = NULL;
+    rbnode *n = NULL;
+    rbnode *src = o;
+
+    if (o == NULL) {
+        return NULL;
+    }
+
+    root = n = rbn_newcopy(t, o);
+
+    /**< walk o and the copy in lockstep; an absent child means unvisited */
+    for (;;) {
+        if (src->left && n->left == NULL) {
+            n->left = rbn_newcopy(t, src->left);
+            rbn_set_parent(n->left, n);
 
-        delrbnfn(n, dtor);
+            src = src->left;
+            n = n->left;
+        } else if (src->right && n->right == NULL) {
+            n->right = rbn_newcopy(t, src->right);
+            rbn_set_parent(n->right, n);
+
+            src = src->right;
+            n = n->right;
+        } else if (src == o) {
+            break;
+        } else {
+            src = rbn_parent(src);
+            n = rbn_parent(n);
+        }
     }
+
+    return root;
 }
 
-static bool rbn_red(rbnode *n) { return n ? n->color == RED : false; }
+static bool rbn_red(rbnode *n) { return n ? rbn_color(n) == RED : false; }
 
 static size_t rbn_size(rbnode *n) {
-    return n ? (1 + rbn_size(n->left) + rbn_size(n->right)) : 0;
+    return n ? n->count : 0;
+}
+
+static void rbn_update_count(rbnode *n) {
+    n->count = 1 + rbn_size(n->left) + rbn_size(n->right);
 }
 
 static int rbn_height(rbnode *n) {
-    return n ? (1 +
-                rbn_level_compare(rbn_height(n->left), rbn_height(n->right)))
-             : -1;
+    rbnode *root = n;
+    int height = -1;
+    int depth = 0;
+
+    while (n) {
+        rbnode *p = NULL;
+
+        height = rbn_level_compare(height, depth);
+
+        if (n->left || n->right) {
+            n = n->left ? n->left : n->right;
+            ++depth;
+            continue;
+        }
+
+        /**< climb to the nearest unvisited right sibling */
+        while (n != root && ((p = rbn_parent(n))->right == n || p->right == NULL)) {
+            n = p;
+            --depth;
+        }
+
+        n = n == root ? NULL : rbn_parent(n)->right;
+    }
+
+    return height;
 }
 
 static int rbn_level_compare(int x, int y) { return x >= y ? x : y; }
 
 static size_t rbn_leafct(rbnode *n) {
-    if (n == NULL) {
-        return 0;
-    } else if (n->left == NULL && n->right == NULL) {
-        return 1;
-    } else {
-        return rbn_leafct(n->left) + rbn_leafct(n->right);
+    rbnode *root = n;
+    size_t leafct = 0;
+
+    for (n = n ? rbn_postorder_first(n) : NULL; n;
+         n = rbn_postorder_next(n, root)) {
+        if (n->left == NULL && n->right == NULL) {
+            ++leafct;
+        }
     }
+
+    return leafct;
 }
 
 static rbnode *rbn_find(rbnode *n, const void *valaddr, int (*compare)(const void *, const void *)) {
     while (n) {
-        int cmp = compare(n->valaddr, valaddr);
+        int cmp = compare(rbn_valaddr(n), valaddr);
 
         if (cmp == 0) {
             /**< desired node was found. */
@@ -738,6 +1605,38 @@ static rbnode *rbn_find(rbnode *n, const void *valaddr, int (*compare)(const voi
     return n;
 }
 
+static rbnode *rbn_lower_bound(rbnode *n, const void *valaddr, int (*compare)(const void *, const void *)) {
+    rbnode *bound = NULL;
+
+    /**< leftmost node not less than valaddr */
+    while (n) {
+        if (compare(rbn_valaddr(n), valaddr) < 0) {
+            n = n->right;
+        } else {
+            bound = n;
+            n = n->left;
+        }
+    }
+
+    return bound;
+}
+
+static rbnode *rbn_upper_bound(rbnode *n, const void *valaddr, int (*compare)(const void *, const void *)) {
+    rbnode *bound = NULL;
+
+    /**< leftmost node greater than valaddr */
+    while (n) {
+        if (compare(rbn_valaddr(n), valaddr) <= 0) {
+            n = n->right;
+        } else {
+            bound = n;
+            n = n->left;
+        }
+    }
+
+    return bound;
+}
+
 static rbnode *rbn_min(rbnode *n) {
     assert(n);
 
@@ -760,7 +1659,69 @@ static rbnode *rbn_max(rbnode *n) {
 
 static rbnode *rbn_successor(rbnode *n) { return rbn_min(n->right); }
 
-static rbnode *rbn_predecessor(rbnode *n) { return rbn_max(n->left); }
+static rbnode *rbn_next(rbnode *n) {
+    assert(n);
+
+    if (n->right) {
+        return rbn_min(n->right);
+    }
+
+    /**< climb until we arrive from a left subtree */
+    while (rbn_parent(n) && n == rbn_parent(n)->right) {
+        n = rbn_parent(n);
+    }
+
+    return rbn_parent(n);
+}
+
+static rbnode *rbn_prev(rbnode *n) {
+    assert(n);
+
+    if (n->left) {
+        return rbn_max(n->left);
+    }
+
+    /**< climb until we arrive from a right subtree */
+    while (rbn_parent(n) && n == rbn_parent(n)->left) {
+        n = rbn_parent(n);
+    }
+
+    return rbn_parent(n);
+}
+
+static rbnode *rbn_select(rbnode *n, size_t k) {
+    while (n) {
+        size_t left = rbn_size(n->left);
+
+        if (k < left) {
+            n = n->left;
+        } else if (k > left) {
+            k -= left + 1;
+            n = n->right;
+        } else {
+            break;
+        }
+    }
+
+    return n;
+}
+
+static size_t rbn_index(rbnode *n) {
+    size_t index = 0;
+    assert(n);
+
+    index = rbn_size(n->left);
+
+    while (rbn_parent(n)) {
+        if (n == rbn_parent(n)->right) {
+            index += rbn_size(rbn_parent(n)->left) + 1;
+        }
+
+        n = rbn_parent(n);
+    }
+
+    return index;
+}
 
 static rbnode *rbn_rotate_left(rbnode *n) {
     rbnode *x = NULL;
@@ -770,8 +1731,16 @@ static rbnode *rbn_rotate_left(rbnode *n) {
     n->right = x->left;
     x->left = n;
 
-    x->color = n->color;
-    n->color = RED;
+    if (n->right) {
+        rbn_set_parent(n->right, n);
+    }
+
+    /**< x takes over n's parent and color; n becomes x's red child */
+    x->parent_color = n->parent_color;
+    n->parent_color = (size_t)(x) | (size_t)(RED);
+
+    x->count = n->count;
+    rbn_update_count(n);
 
     return x;
 }
@@ -784,8 +1753,16 @@ static rbnode *rbn_rotate_right(rbnode *n) {
     n->left = x->right;
     x->right = n;
 
-    x->color = n->color;
-    n->color = RED;
+    if (n->left) {
+        rbn_set_parent(n->left, n);
+    }
+
+    /**< x takes over n's parent and color; n becomes x's red child */
+    x->parent_color = n->parent_color;
+    n->parent_color = (size_t)(x) | (size_t)(RED);
+
+    x->count = n->count;
+    rbn_update_count(n);
 
     return x;
 }
@@ -793,61 +1770,18 @@ static rbnode *rbn_rotate_right(rbnode *n) {
 static void rbn_color_flip(rbnode *n) {
     if (n) {
         /**< if n != NULL, toggle n's colors/n's children's colors */
-        n->color = !n->color;
+        rbn_toggle_color(n);
 
         if (n->left) {
-            n->left->color = !(n->left->color);
+            rbn_toggle_color(n->left);
         }
 
         if (n->right) {
-            n->right->color = !(n->right->color);
+            rbn_toggle_color(n->right);
         }
     }
 }
 
-static rbnode *rbn_insert(rbnode *n, const void *valaddr, size_t width,
-                          int (*compare)(const void *, const void *)) {
-    int cmp = 0;
-
-    if (n == NULL) {
-        /**< base case: n is a leaf, return new node */
-        return rbn_new(valaddr, width);
-    }
-
-    if (rbn_red(n->left) && rbn_red(n->right)) {
-        rbn_color_flip(n);
-    }
-
-    /**< standard recursive bst insertion */
-    cmp = compare(n->valaddr, valaddr);
-
-    if (cmp > 0) {
-        /**< recursive case 1: val < n->data */
-        /**< go to left child and return result of recursive call to it */
-        n->left = rbn_insert(n->left, valaddr, width, compare);
-    } else {
-        /**< RECURSIVE CASE 2: val > n->data */
-        /**< go to right child and return result of recursive call to it */
-        n->right = rbn_insert(n->right, valaddr, width, compare);
-    }
-
-    /**< llrbt functionality - rotations */
-    if (rbn_red(n->right)) {
-        /**< if n's right child is red */
-        /**< rotate left to fix right-leaning red nodes */
-        n = rbn_rotate_left(n);
-    }
-
-    if (rbn_red(n->left) && rbn_red(n->left->left)) {
-        /**< if n's left child is red */
-        /**< if n's left grandchild is red */
-        /**< rotate right to fix left-leaning double-red nodes */
-        n = rbn_rotate_right(n);
-    }
-
-    return n;
-}
-
 static rbnode *rbn_move_red_left(rbnode *n) {
     /**< start by toggling colors */
     rbn_color_flip(n);
@@ -876,110 +1810,140 @@ static rbnode *rbn_move_red_right(rbnode *n) {
     return n;
 }
 
-static rbnode *rbn_erase_min(rbnode *n, void (*dtor)(void *)) {
-    if (n->left == NULL) {
-        /**< BASE CASE: n->left is a leaf, min node found. */
-        rbn_delete(&n, dtor);
-        return NULL;
-    }
-
-    if (!rbn_red(n->left) && !rbn_red(n->left->left)) {
-        /**< n's left child is black */
-        /**< n's left grandchild is black */
-        n = rbn_move_red_left(n);
-    }
+/**
+ *  Erasure is top-down and iterative: on the way down, each transformation
+ *  of a node is linked back into its parent (rbn_replace), so that
+ *  the node to erase ends up a red leaf; rbn_unlink then removes it
+ *  and walks back up to the root through the parent pointers,
+ *  applying rbn_fixup at every level.
+ */
+static void rbn_erase_min(rbtree *t, rbnode *n) {
+    for (;;) {
+        if (n->left == NULL) {
+            /**< min node found */
+            rbn_unlink(t, n);
+            return;
+        }
 
-    /**< RECURSIVE CASE: left leaf node not found yet */
-    n->left = rbn_erase_min(n->left, dtor);
+        if (!rbn_red(n->left) && !rbn_red(n->left->left)) {
+            /**< n's left child is black */
+            /**< n's left grandchild is black */
+            n = rbn_replace(t, n, rbn_move_red_left);
+        }
 
-    return rbn_fixup(n);
+        n = n->left;
+    }
 }
 
-static rbnode *rbn_erase_max(rbnode *n, void (*dtor)(void *)) {
-    if (rbn_red(n->left->left)) {
-        /**< if n's left child is red, */
-        /**< rotate right at n */
-        n = rbn_rotate_right(n);
-    }
+static void rbn_erase_max(rbtree *t, rbnode *n) {
+    for (;;) {
+        if (rbn_red(n->left)) {
+            /**< if n's left child is red, */
+            /**< rotate right at n */
+            n = rbn_replace(t, n, rbn_rotate_right);
+        }
+
+        if (n->right == NULL) {
+            /**< max node found */
+            rbn_unlink(t, n);
+            return;
+        }
 
-    if (n->right == NULL) {
-        /**< BASE CASE: n->right is a leaf, max node found */
-        rbn_delete(&n, dtor);
-        return NULL;
-    }
+        if (!rbn_red(n->right) && !rbn_red(n->right->left)) {
+            /**< n's right child is black, */
+            /**< n's left grandchild is black (left child of n's right child) */
+            n = rbn_replace(t, n, rbn_move_red_right);
+        }
 
-    if (!rbn_red(n->right) && !rbn_red(n->right->left)) {
-        /**< n's right child is black, */
-        /**< n's left grandchild is black (left child of n's right child) */
-        n = rbn_move_red_right(n);
+        n = n->right;
     }
+}
 
-    /**< RECURSIVE CASE: right leaf node not found yet */
-    n->right = rbn_erase_max(n->right, dtor);
+static void rbn_erase(rbtree *t, rbnode *n, const void *valaddr) {
+    int (*compare)(const void *, const void *) = t->ttbl->compare;
 
-    return rbn_fixup(n);
-}
+    for (;;) {
+        int cmp = compare(rbn_valaddr(n), valaddr);
 
-static rbnode *rbn_erase(rbnode *n, const void *valaddr, void (*dtor)(void *),
-                         int (*compare)(const void *, const void *)) {
-    int cmp = compare(n->valaddr, valaddr);
+        if (cmp > 0) {
+            /**< val is less than n->data */
+            if (!rbn_red(n->left) && !rbn_red(n->left->left)) {
+                /**< if n's left child is black */
+                /**< if n's left grandchild is black (left child of n's left child) */
+                n = rbn_replace(t, n, rbn_move_red_left);
+            }
 
-    if (cmp > 0) {
-        /**< val is less than n->data */
-        if (!rbn_red(n->left) && !rbn_red(n->left->left)) {
-            /**< if n's left child is black */
-            /**< if n's left grandchild is black (left child of n's left child) */
-            n = rbn_move_red_left(n);
+            n = n->left;
+            continue;
         }
 
-        /**< RECURSIVE CASE */
-        n->left = rbn_erase(n->left, valaddr, dtor, compare);
-    } else {
         /**< val is greater than or equal to n->data */
         if (rbn_red(n->left)) {
             /**< if n's left child is red */
-            n = rbn_rotate_right(n);
+            n = rbn_replace(t, n, rbn_rotate_right);
+            cmp = compare(rbn_valaddr(n), valaddr);
         }
 
         if (cmp == 0 && n->right == NULL) {
-            /**< RECURSIVE CASE: n is the node to erase, */
-            /**< and has no right child */
-            fprintf(stdout, "]\n");
-
-            rbn_delete(&n, dtor);
-            return NULL;
+            /**< n is the node to erase, and has no right child */
+            rbn_unlink(t, n);
+            return;
         }
 
         if (!rbn_red(n->right) && !rbn_red(n->right->left)) {
             /**< if n's right child is black */
             /**< if n's left grandchild is black (left child of n's right child) */
-            n = rbn_move_red_right(n);
+            rbnode *m = rbn_replace(t, n, rbn_move_red_right);
+
+            if (m != n) {
+                /**< n was rotated into m's right subtree, along with val; */
+                /**< m may hold a duplicate of val, but must not be erased */
+                /**< here, since m->right may be temporarily right-leaning */
+                n = m;
+                cmp = -1;
+            }
         }
 
         if (cmp == 0) {
-            /**< BASE CASE: if n is the node to delete, */
-            /**< but has a right child -- will replace n's data with that of its */
-            /**< inorder successor,  then delete the inorder successor node */
-            rbnode *successor = rbn_successor(n);
-
-            void *to_delete = n->valaddr;
-            n->valaddr = successor->valaddr;
-            successor->valaddr = to_delete;
-
-            /**< data fields were switched between rbnode n and its */
-            /**< inorder-successor. (change of pointer ownership) */
-            n->right = rbn_erase_min(n->right, dtor);
-        } else {
-            /**< RECURSIVE CASE: n is not the node to delete */
-            /**< proceed to right child, since val is greater than n->data */
-            n->right = rbn_erase(n->right, valaddr, dtor, compare);
+            /**< n is the node to delete, but has a right child -- */
+            /**< swap n's element with that of its inorder successor, */
+            /**< then delete the inorder successor node */
+            rbn_swap_values(n, rbn_successor(n), t->ttbl->width);
+            rbn_erase_min(t, n->right);
+            return;
         }
+
+        /**< n is not the node to delete; val is greater than n->data */
+        n = n->right;
+    }
+}
+
+static void rbn_unlink(rbtree *t, rbnode *n) {
+    rbnode *p = rbn_parent(n);
+
+    assert(n->left == NULL && n->right == NULL);
+
+    if (p == NULL) {
+        t->root = NULL;
+    } else if (p->left == n) {
+        p->left = NULL;
+    } else {
+        p->right = NULL;
     }
 
-    return rbn_fixup(n);
+    rbn_delete(t, &n);
+
+    while (p) {
+        rbnode *pp = rbn_parent(p);
+        rbn_replace(t, p, rbn_fixup);
+        p = pp;
+    }
 }
 
 static rbnode *rbn_fixup(rbnode *n) {
+    /**< a node was removed below n; rotations below keep counts exact */
+    rbn_update_count(n);
+
     if (rbn_red(n->right)) {
         /**< if n's right child is red */
         /**< rotate left to fix right-leaning nodes */
@@ -1000,6 +1964,125 @@ static rbnode *rbn_fixup(rbnode *n) {
     return n;
 }
 
+static rbnode *rbn_replace(rbtree *t, rbnode *n, rbnode *(*op)(rbnode *)) {
+    rbnode *p = rbn_parent(n);
+    bool from_left = p && p->left == n;
+    rbnode *m = op(n);
+
+    /**< op keeps m's parent pointer; point the parent (or t) at m */
+    if (p == NULL) {
+        t->root = m;
+    } else if (from_left) {
+        p->left = m;
+    } else {
+        p->right = m;
+    }
+
+    return m;
+}
+
+static rbnode *rbn_build(rbtree *t, const char *base, size_t count, int bh,
+                         bool move) {
+    rbnode *(*make)(rbtree *, const void *) = move ? rbn_newmove : rbn_new;
+    size_t width = t->ttbl->width;
+    size_t most = 0;
+    rbnode *root = NULL;
+    rbnode *left = NULL;
+
+    /**
+     *  Builds a subtree of count elements with black height bh, where
+     *  2^bh - 1 <= count <= 3^bh - 1 -- i.e. a 2-3 tree of height bh,
+     *  whose 3-nodes are a black node with a red left child.
+     *
+     *  Nodes are created in order, so they are laid out in order
+     *  within the pool. If move is true, elements are taken bitwise
+     *  (ownership passes to t); otherwise ttbl->copy is applied.
+     */
+    if (count == 0) {
+        return NULL;
+    }
+
+    assert(bh > 0);
+
+    most = rbn_most_nodes(bh - 1);
+
+    if (count - 1 - (count - 1) / 2 <= most) {
+        /**< 2-node: split the rest in two */
+        size_t l = (count - 1) / 2;
+
+        left = rbn_build(t, base, l, bh - 1, move);
+        root = make(t, base + l * width);
+        root->left = left;
+        root->right = rbn_build(t, base + (l + 1) * width, count - 1 - l,
+                                bh - 1, move);
+    } else {
+        /**< 3-node: red left child, black root, three subtrees between */
+        size_t a = (count - 2) / 3;
+        size_t b = (count - 2 - a) / 2;
+        size_t c = count - 2 - a - b;
+        rbnode *red = NULL;
+
+        left = rbn_build(t, base, a, bh - 1, move);
+        red = make(t, base + a * width);
+        red->left = left;
+        red->right = rbn_build(t, base + (a + 1) * width, b, bh - 1, move);
+
+        root = make(t, base + (a + 1 + b) * width);
+        root->left = red;
+        root->right = rbn_build(t, base + (a + b + 2) * width, c, bh - 1, move);
+
+        if (red->left) {
+            rbn_set_parent(red->left, red);
+        }
+
+        if (red->right) {
+            rbn_set_parent(red->right, red);
+        }
+
+        rbn_set_color(red, RED);
+        rbn_update_count(red);
+    }
+
+    if (root->left) {
+        rbn_set_parent(root->left, root);
+    }
+
+    if (root->right) {
+        rbn_set_parent(root->right, root);
+    }
+
+    rbn_set_color(root, BLACK);
+    rbn_update_count(root);
+
+    return root;
+}
+
+static size_t rbn_most_nodes(int bh) {
+    /**< 3^bh - 1, saturating: a 2-3 tree of height bh, all 3-nodes */
+    size_t most = 1;
+
+    while (bh-- > 0) {
+        if (most > ((size_t)(-1)) / 3) {
+            return (size_t)(-1);
+        }
+
+        most *= 3;
+    }
+
+    return most - 1;
+}
+
+static int rbn_build_height(size_t count) {
+    /**< the largest bh such that 2^bh - 1 <= count */
+    int bh = 0;
+
+    for (count = count + 1; count > 1; count >>= 1) {
+        ++bh;
+    }
+
+    return bh;
+}
+
 static void rbn_inorder_recursive(rbnode **n, void (*consumer)(void *)) {
     if ((*n)) {
         rbn_inorder_recursive(&(*n)->left, consumer);
@@ -1024,565 +2107,971 @@ static void rbn_postorder_recursive(rbnode **n, void (*consumer)(void *)) {
     }
 }
 
-static void rbn_levelorder_recursive(rbnode **n, void (*consumer)(void *)) {
-    int height_plus_one = 0;
-    int i = 0;
+static void rbn_inorder(rbnode **n, void (*consumer)(void *)) {
+    rbnode *current = NULL;
+    rbnode *next = NULL;
+
+    assert((*n));
 
-    assert(n);
+    /**< follows parent pointers; no auxiliary stack is needed */
+    current = rbn_min((*n));
+
+    while (current) {
+        /**< fetch the successor first -- consumer receives &current */
+        next = rbn_next(current);
+        consumer(&current);
+        current = next;
+    }
+}
+
+static void rbn_preorder(rbnode **n, void (*consumer)(void *)) {
+    rbnode *root = NULL;
+    rbnode *current = NULL;
+
+    assert((*n));
     assert(consumer);
 
-    height_plus_one = rbn_height((*n)) + 1;
-    for (i = 0; i <= height_plus_one; i++) {
-        rbn_levelorder_helper(&(*n), consumer, i);
+    root = (*n);
+
+    for (current = root; current; current = rbn_preorder_next(current, root)) {
+        rbnode *visit = current;
+        consumer(&visit);
     }
 }
 
-static void rbn_levelorder_helper(rbnode **n, void (*consumer)(void *), int level) {
-    if ((*n) == NULL) {
-        return;
-    } else if (level == 1) {
-        consumer(n);
-    } else if (level > 1) {
-        rbn_levelorder_helper(&(*n)->left, consumer, level - 1);
-        rbn_levelorder_helper(&(*n)->right, consumer, level - 1);
+static void rbn_postorder(rbnode **n, void (*consumer)(void *)) {
+    rbnode *root = NULL;
+    rbnode *current = NULL;
+    rbnode *next = NULL;
+
+    assert((*n));
+    assert(consumer);
+
+    root = (*n);
+    current = rbn_postorder_first(root);
+
+    while (current) {
+        /**< fetch the successor first -- consumer may release current */
+        next = rbn_postorder_next(current, root);
+        consumer(&current);
+        current = next;
     }
 }
 
-static void rbn_inorder(rbnode **n, void (*consumer)(void *)) {
-    size_t sz = 0;
-    rbnode **s = NULL;
-    int s_size = 0;
+static void rbn_levelorder(rbnode **n, void (*consumer)(void *)) {
+    rbnode **queue = NULL;
     rbnode *current = NULL;
 
+    size_t head = 0;
+    size_t tail = 0;
+
     assert((*n));
+    assert(consumer);
+
+    /**
+     *  Breadth-first, with an explicit queue -- each node is enqueued
+     *  exactly once, so the root's count bounds its length.
+     *  Node fields are only read, never written.
+     */
+    queue = malloc(sizeof *queue * (*n)->count);
+    massert_malloc(queue);
+
+    queue[tail++] = (*n);
+
+    while (head < tail) {
+        current = queue[head++];
+
+        /**< enqueue the children first -- consumer may release current */
+        if (current->left) {
+            queue[tail++] = current->left;
+        }
+
+        if (current->right) {
+            queue[tail++] = current->right;
+        }
+
+        consumer(&current);
+    }
+
+    free(queue);
+    queue = NULL;
+}
+
+static rbnode *rbn_preorder_next(rbnode *n, rbnode *root) {
+    rbnode *p = NULL;
+
+    if (n->left || n->right) {
+        return n->left ? n->left : n->right;
+    }
+
+    /**< climb to the nearest unvisited right sibling */
+    while (n != root && ((p = rbn_parent(n))->right == n || p->right == NULL)) {
+        n = p;
+    }
+
+    return n == root ? NULL : rbn_parent(n)->right;
+}
+
+static rbnode *rbn_postorder_first(rbnode *n) {
+    while (n->left || n->right) {
+        n = n->left ? n->left : n->right;
+    }
+
+    return n;
+}
+
+static rbnode *rbn_postorder_next(rbnode *n, rbnode *root) {
+    rbnode *p = NULL;
+
+    if (n == root) {
+        return NULL;
+    }
 
-    sz = rbn_size((*n));
+    p = rbn_parent(n);
 
-    s = calloc(sz, sizeof((*s)));
-    assert(s);
+    /**< coming up from the left, the right subtree is next, if any */
+    return (n == p->left && p->right) ? rbn_postorder_first(p->right) : p;
+}
+
+static void rbn_fputs(rbnode *n, FILE *dest, char *b, bool last,
+                      void (*print)(const void *, FILE *dest)) {
+    /**
+     *  Custom recursive preorder traversal
+     */
+
+    char newbuf[BUFFER_SIZE_4K];
+    bool is_red = false;
+
+    strcpy(newbuf, b);
+
+    fprintf(dest, "%s", b);
+
+    if (last) {
+        fprintf(dest, "%sR%s----", KGRY, KNRM);
+        strcat(newbuf, "      ");
+    } else {
+        fprintf(dest, "%sL%s----", KGRY, KNRM);
+        strcat(newbuf, "|     ");
+    }
+
+    is_red = rbn_red(n);
+
+    if (n != NULL) {
+        const char *label_color = is_red ? KRED_b : KNRM_b;
+        fprintf(dest, "%s[", label_color);
+        print(rbn_valaddr(n), dest);
+
+        fprintf(dest, "]%s ", KNRM);
+
+        fprintf(dest, "(%s%p%s)", KCYN, (void *)(n), KNRM);
+
+        fprintf(dest, "\n");
+        rbn_fputs(n->left, dest, newbuf, false, print);
+        rbn_fputs(n->right, dest, newbuf, true, print);
+    } else {
+        fprintf(dest, "%s[%s]", KGRY, DIAMOND_SYMBOL);
+
+        fprintf(dest, "%s(%p)", KGRY, NULL);
+
+        fprintf(dest, "%s\n", KNRM);
+    }
+}
+
+
+static rbtree *rbt_allocate() {
+    rbtree *t = NULL;
+    t = malloc(sizeof((*t)));
+    assert(t);
+    return t;
+}
+
+static void rbt_init(rbtree *t, struct typetable *ttbl) {
+    assert(t);
+    t->root = NULL;
+    t->size = 0;
+    t->ttbl = ttbl ? ttbl : _void_ptr_;
+    rbp_init(&t->pool, t->ttbl->width);
+}
+
+static void rbt_deinit(rbtree *t) {
+    assert(t);
+    rbt_clear(t);
+
+    t->root = NULL;
+}
 
-    current = (*n);
+static rbnode *rbt_attach(rbtree *t, rbnode *parent, bool left,
+                          const void *valaddr) {
+    rbnode *n = rbn_new(t, valaddr);
+    rbnode *p = parent;
 
-    while (current || (s_size > 0)) {
-        if (current) {
-            s[s_size++] = current;
-            current = current->left;
+    if (parent == NULL) {
+        t->root = n;
+    } else {
+        if (left) {
+            parent->left = n;
         } else {
-            rbnode *top = s[--s_size];
-            current = top;
+            parent->right = n;
+        }
+
+        rbn_set_parent(n, parent);
+    }
+
+    /**
+     *  Retrace the path to the root: lean red links left,
+     *  rotate away double reds, and split 4-nodes (2-3 variant),
+     *  as a recursive LLRB insert would while unwinding.
+     */
+    while (p) {
+        rbnode *pp = rbn_parent(p);
+        bool from_left = pp && pp->left == p;
 
-            consumer(&current);
-            current = current->right;
+        ++p->count;
+
+        if (rbn_red(p->right)) {
+            p = rbn_rotate_left(p);
+        }
+
+        if (rbn_red(p->left) && rbn_red(p->left->left)) {
+            p = rbn_rotate_right(p);
+        }
+
+        if (rbn_red(p->left) && rbn_red(p->right)) {
+            rbn_color_flip(p);
+        }
+
+        if (pp == NULL) {
+            t->root = p;
+        } else if (from_left) {
+            pp->left = p;
+        } else {
+            pp->right = p;
         }
+
+        p = pp;
     }
 
-    free(s);
-    s = NULL;
+    rbn_set_color(t->root, BLACK);
+    ++t->size;
+
+    return n;
 }
 
-static void rbn_preorder(rbnode **n, void (*consumer)(void *)) {
-    size_t sz = 0;
-    rbnode **s = NULL;
-    int s_size = 0;
-    rbnode *current = NULL;
+static size_t rbt_merge_rebuild(rbtree *t, const char *batch, size_t m) {
+    int (*compare)(const void *, const void *) = t->ttbl->compare;
+    size_t width = t->ttbl->width;
+    struct rbpool old;
+    char *merged = NULL;
+    rbnode *n = NULL;
+    size_t inserted = 0;
+    size_t i = 0;
+    size_t k = 0;
+
+    merged = malloc((t->size + m) * width);
+    massert_malloc(merged);
+
+    /**
+     *  Elements from t are moved bitwise (their nodes are discarded below,
+     *  without running the dtor); elements from batch are copied.
+     */
+    n = t->root ? rbn_min(t->root) : NULL;
+
+    while (n || i < m) {
+        int cmp = n == NULL ? 1 : i == m ? -1
+                : compare(rbn_valaddr(n), batch + i * width);
+
+        if (cmp <= 0) {
+            memcpy(merged + k * width, rbn_valaddr(n), width);
+            n = rbn_next(n);
+
+            if (cmp == 0) {
+                /**< already present */
+                ++i;
+            }
+        } else {
+            if (t->ttbl->copy) {
+                t->ttbl->copy(merged + k * width, batch + i * width);
+            } else {
+                memcpy(merged + k * width, batch + i * width, width);
+            }
+
+            ++i;
+            ++inserted;
+        }
+
+        ++k;
+    }
+
+    old = t->pool;
+    rbp_init(&t->pool, width);
+    rbp_reserve(&t->pool, k);
+
+    t->root = rbn_build(t, merged, k, rbn_build_height(k), true);
+
+    if (t->root) {
+        rbn_set_parent(t->root, NULL);
+    }
+
+    t->size = k;
+
+    rbp_release(&old);
+
+    free(merged);
+    merged = NULL;
+
+    return inserted;
+}
+
+/**
+ *  rbtree iterators store the current rbnode in it.curr;
+ *  NULL denotes the position one past the maximum (end).
+ *
+ *  Stepping follows parent pointers -- amortized O(1) per step,
+ *  with no allocation. Positions are computed from subtree counts,
+ *  so distance/advance are O(log n).
+ *
+ *  Iterators are invalidated by insert/erase.
+ */
+iterator rbti_begin(void *arg) {
+    rbtree *t = (rbtree *)(arg);
+    iterator it;
+
+    assert(t);
+
+    it.itbl = _rbtree_iterator_;
+    it.container = t;
+    it.curr = t->root ? rbn_min(t->root) : NULL;
+
+    return it;
+}
+
+iterator rbti_end(void *arg) {
+    rbtree *t = (rbtree *)(arg);
+    iterator it;
+
+    assert(t);
 
-    assert((*n));
-    assert(consumer);
+    it.itbl = _rbtree_iterator_;
+    it.container = t;
+    it.curr = NULL;
 
-    sz = rbn_size((*n));
+    return it;
+}
 
-    s = calloc(sz, sizeof((*s)));
-    assert(s);
+iterator rbti_next(iterator it) {
+    iterator iter = it;
+    rbti_incr(&iter);
+    return iter;
+}
 
-    current = (*n);
+iterator rbti_next_n(iterator it, int n) {
+    iterator iter = it;
+    rbti_advance(&iter, n);
+    return iter;
+}
 
-    while (current || (s_size > 0)) {
-        if (current) {
-            s[s_size++] = current;
-            consumer(&current);
+iterator rbti_prev(iterator it) {
+    iterator iter = it;
+    rbti_decr(&iter);
+    return iter;
+}
 
-            current = current->left;
-        } else {
-            rbnode *top = s[--s_size];
-            current = top;
+iterator rbti_prev_n(iterator it, int n) {
+    iterator iter = it;
+    rbti_advance(&iter, -n);
+    return iter;
+}
 
-            current = current->right;
-        }
+iterator *rbti_advance(iterator *it, int n) {
+    rbtree *t = NULL;
+    int pos = 0;
+
+    massert_iterator(it);
+
+    t = it->container;
+    pos = (int)(rbti_index(*it));
+
+    if (pos + n < 0 || (size_t)(pos + n) > t->size) {
+        char str[256];
+        sprintf(str, "Cannot advance %d times from position %d.", n, pos);
+        ERROR(__FILE__, str);
+    } else if (n == 1) {
+        rbti_incr(it);
+    } else if (n == -1) {
+        rbti_decr(it);
+    } else if (n != 0) {
+        it->curr = rbn_select(t->root, (size_t)(pos + n));
     }
 
-    free(s);
-    s = NULL;
+    return it;
 }
 
-static void rbn_postorder(rbnode **n, void (*consumer)(void *)) {
-    size_t sz = 0;
-    rbnode **s = NULL;
-    int s_size = 0;
-    int *is = NULL;
-    int is_size = 0;
-    rbnode *current = NULL;
-    int value = -1;
-    int to_push = 0;
-
-    assert((*n));
-    assert(consumer);
+iterator *rbti_incr(iterator *it) {
+    massert_iterator(it);
 
-    sz = rbn_size((*n));
+    if (it->curr == NULL) {
+        ERROR(__FILE__, "Cannot increment - already at end.");
+    } else {
+        it->curr = rbn_next(it->curr);
+    }
 
-    s = calloc(sz, sizeof((*s)));
-    assert(s);
-;
-    is = calloc(sz, sizeof((*is)));
-    assert(is);
+    return it;
+}
 
-    value = -1;
+iterator *rbti_decr(iterator *it) {
+    rbtree *t = NULL;
+    rbnode *n = NULL;
 
-    current = (*n);
-    value = 0;
+    massert_iterator(it);
 
-    if (current == NULL) {
+    t = it->container;
+    n = it->curr ? rbn_prev(it->curr) : (t->root ? rbn_max(t->root) : NULL);
 
+    if (n == NULL) {
+        ERROR(__FILE__, "Cannot decrement this iterator, already at begin.");
     } else {
-        s[s_size++] = current;
-
-        to_push = 1;
-        is[is_size++] = to_push;
+        it->curr = n;
+    }
 
-        current = current->left;
+    return it;
+}
 
-        while (s_size > 0) {
-            if (current && value == 0) {
-                s[s_size++] = current;
-                to_push = 1;
-                is[is_size++] = to_push;
+void *rbti_curr(iterator it) {
+    rbnode *n = it.curr;
+    return n ? rbn_valaddr(n) : NULL;
+}
 
-                current = current->left;
-            } else {
-                current = s[--s_size];
-                value = is[--is_size];
+void *rbti_start(iterator it) {
+    rbtree *t = it.container;
+    return t->root ? rbn_valaddr(rbn_min(t->root)) : NULL;
+}
 
-                if (value == 1) {
-                    s[s_size++] = current;
-                    to_push = 2;
-                    is[is_size++] = to_push;
+void *rbti_finish(iterator it) {
+    /**< end has no element; rbti_curr yields NULL there, as does finish */
+    return NULL;
+}
 
-                    current = current->right;
-                    value = 0;
-                } else {
-                    consumer(&current);
-                }
-            }
-        }
+int rbti_distance(iterator *first, iterator *last) {
+    if (first == NULL && last != NULL) {
+        return (int)(rbti_index(*last));
+    } else if (last == NULL && first != NULL) {
+        return (int)(rbti_index(*first));
+    } else if (first == NULL && last == NULL) {
+        ERROR(__FILE__, "Both iterator first and last are NULL.");
+        return 0;
+    } else {
+        return (int)(rbti_index(*last)) - (int)(rbti_index(*first));
     }
-
-    free(is);
-    is = NULL;
-
-    free(s);
-    s = NULL;
 }
 
-static void rbn_levelorder(rbnode **n, void (*consumer)(void *)) {
-    size_t sz = 0;
-    rbnode **temp_q = NULL;
-    int tq_size = 0;
-    int tq_cap = 0;
-    int tq_front = 0;
-    int tq_rear = 0;
-    rbnode *current = NULL;
-
-    assert((*n));
-    assert(consumer);
+bool rbti_has_next(iterator it) {
+    return it.curr != NULL;
+}
 
-    sz = rbn_size((*n));
+bool rbti_has_prev(iterator it) {
+    rbtree *t = it.container;
+    rbnode *n = it.curr;
 
-    temp_q = calloc(sz, sizeof(struct rbnode *));
-    assert(temp_q);
-    tq_size = 0;
-    tq_cap = sz;
-    tq_front = 0;
-    tq_rear = sz - 1;
+    if (n == NULL) {
+        return t->root != NULL;
+    }
 
-    current = (*n);
+    return rbn_prev(n) != NULL;
+}
 
-    tq_rear = (tq_rear + 1) % tq_cap;
-    temp_q[tq_rear] = current;
-    ++tq_size;
+struct typetable *rbti_get_ttbl(void *arg) {
+    rbtree *t = (rbtree *)(arg);
+    return t->ttbl;
+}
 
-    while (tq_size > 0) {
+static size_t rbti_index(iterator it) {
+    rbtree *t = it.container;
+    return it.curr ? rbn_index(it.curr) : t->size;
+}
 
-        rbnode *front = temp_q[tq_front];
-        tq_front = (tq_front + 1) % tq_cap;
-        --tq_size;
+/**
+ *  A frozen rbtree (rbfrozen) holds a sorted copy of the tree's elements
+ *  in one contiguous array, in Eytzinger order: slot 1 is the root,
+ *  and slots 2k and 2k + 1 are the children of slot k (slot 0 is unused).
+ *  This is a BFS of a complete binary search tree -- a search touches
+ *  slots 1, 2 or 3, 4 through 7, ..., so the top levels share
+ *  a few cache lines, and the 16 candidates four levels below
+ *  the current slot are contiguous, which allows them to be prefetched
+ *  while the comparisons in between are still being made.
+ *
+ *  t is left unchanged; the snapshot does not track later changes to t.
+ *
+ *  @param[in]  t   pointer to rbtree
+ *
+ *  @return     pointer to rbfrozen, with copies of the elements of t
+ */
+rbfrozen *rbt_freeze(rbtree *t) {
+    rbfrozen *f = NULL;
+    rbnode *n = NULL;
+    size_t k = 0;
+    size_t width = 0;
 
-        current = front;
+    assert(t);
 
-        consumer(&current);
+    f = malloc(sizeof *f);
+    massert_malloc(f);
 
-        if (current->left) {
+    width = t->ttbl->width;
 
-            tq_rear = (tq_rear + 1) % tq_cap;
-            temp_q[tq_rear] = current->left;
-            ++tq_size;
-        }
+    f->ttbl = t->ttbl;
+    f->size = t->size;
+    f->base = malloc((t->size + 1) * width);
+    massert_malloc(f->base);
 
-        if (current->right) {
+    /**< the inorder walks of t and of the implicit tree line up */
+    n = t->root ? rbn_min(t->root) : NULL;
 
-            tq_rear = (tq_rear + 1) % tq_cap;
-            temp_q[tq_rear] = current->right;
-            ++tq_size;
+    for (k = rbf_first(f); n; k = rbf_next(f, k), n = rbn_next(n)) {
+        if (f->ttbl->copy) {
+            f->ttbl->copy(ADDR_AT(f->base, k, width), rbn_valaddr(n));
+        } else {
+            memcpy(ADDR_AT(f->base, k, width), rbn_valaddr(n), width);
         }
     }
 
-    free(temp_q);
-    temp_q = NULL;
+    return f;
 }
 
-static rbnode **rbn_inorder_buffer(rbnode **n) {
-    size_t sz = 0;
-    rbnode **s = NULL;
-    int s_size = 0;
-    rbnode **q = NULL;
-    int q_size = 0;
-    rbnode *current = NULL;
-
-    assert((*n));
-
-    sz = rbn_size((*n));
-
-    s = calloc(sz, sizeof((*s)));
-    assert(s);
+/**
+ *  Moves the elements of a frozen rbtree into a new rbtree,
+ *  built bottom-up in O(n), and releases the frozen rbtree.
+ *
+ *  @param[out] f   address of pointer to rbfrozen
+ *
+ *  @return     pointer to rbtree
+ */
+rbtree *rbt_thaw(rbfrozen **f) {
+    rbtree *t = NULL;
+    char *sorted = NULL;
+    size_t width = 0;
+    size_t k = 0;
+    size_t i = 0;
 
-    q = calloc(sz, sizeof((*q)));
-    assert(q);
+    assert((*f));
 
-    current = (*n);
+    t = rbt_new((*f)->ttbl);
+    width = t->ttbl->width;
 
-    while (current || (s_size > 0)) {
-        if (current) {
-            s[s_size++] = current;
-            current = current->left;
-        } else {
-            rbnode *top = s[--s_size];
-            current = top;
+    if ((*f)->size > 0) {
+        sorted = malloc((*f)->size * width);
+        massert_malloc(sorted);
 
-            q[q_size++] = current;
-            current = current->right;
+        for (k = rbf_first((*f)); k; k = rbf_next((*f), k)) {
+            memcpy(sorted + (i++ * width), ADDR_AT((*f)->base, k, width), width);
         }
-    }
-
-    free(s);
-    s = NULL;
 
-    return q;
-}
+        rbp_reserve(&t->pool, (*f)->size);
 
-static rbnode **rbn_preorder_buffer(rbnode **n) {
-    size_t sz = 0;
-    rbnode **s = NULL;
-    int s_size = 0;
-    rbnode **q = NULL;
-    int q_size = 0;
-    rbnode *current = NULL;
+        t->root = rbn_build(t, sorted, (*f)->size,
+                            rbn_build_height((*f)->size), true);
+        rbn_set_parent(t->root, NULL);
+        t->size = (*f)->size;
 
-    assert((*n));
+        free(sorted);
+        sorted = NULL;
+    }
 
-    sz = rbn_size((*n));
+    /**< the elements now belong to t -- release f without its dtor */
+    free((*f)->base);
+    (*f)->base = NULL;
 
-    s = calloc(sz, sizeof((*s)));
-    assert(s);
+    free((*f));
+    (*f) = NULL;
 
-    q = calloc(sz, sizeof((*q)));
-    assert(q);
+    return t;
+}
 
-    current = (*n);
+void rbf_delete(rbfrozen **f) {
+    size_t k = 0;
 
-    while (current || (s_size > 0)) {
-        if (current) {
-            s[s_size++] = current;
-            q[q_size++] = current;
-            current = current->left;
-        } else {
-            rbnode *top = s[--s_size];
-            current = top;
+    assert((*f));
 
-            current = current->right;
+    if ((*f)->ttbl->dtor) {
+        for (k = 1; k <= (*f)->size; k++) {
+            (*f)->ttbl->dtor(ADDR_AT((*f)->base, k, (*f)->ttbl->width));
         }
     }
 
-    free(s);
-    s = NULL;
+    free((*f)->base);
+    (*f)->base = NULL;
 
-    return q;
+    free((*f));
+    (*f) = NULL;
 }
 
-static rbnode **rbn_postorder_buffer(rbnode **n) {
-    size_t sz = 0;
-    rbnode **s = NULL;
-    int *is = NULL;
-    int s_size = 0;
-    int is_size = 0;
-    rbnode **q = NULL;
-    int q_size = 0;
-    int value = -1;
-    int to_push = 0;
-    rbnode *current = NULL;
-
-    assert((*n));
+iterator rbf_begin(rbfrozen *f) {
+    return rbfi_begin(f);
+}
 
-    sz = rbn_size((*n));
+iterator rbf_end(rbfrozen *f) {
+    return rbfi_end(f);
+}
 
-    s = calloc(sz, sizeof((*s)));
-    assert(s);
+size_t rbf_size(rbfrozen *f) {
+    assert(f);
+    return f->size;
+}
 
-    is = calloc(sz, sizeof((*is)));
-    assert(is);
+/**
+ *  Searches a frozen rbtree for an element matching valaddr.
+ *
+ *  @param[in]  f       pointer to rbfrozen
+ *  @param[in]  valaddr address of the key to find
+ *
+ *  @return     address of the first matching element, or NULL if not found
+ */
+void *rbf_find(rbfrozen *f, const void *valaddr) {
+    void *found = NULL;
+    size_t k = 0;
 
-    q = calloc(sz, sizeof((*q)));
-    assert(q);
+    assert(f);
+    assert(valaddr);
 
-    value = -1;
+    k = rbf_lower_index(f, valaddr);
 
-    current = (*n);
-    value = 0;
+    if (k) {
+        found = ADDR_AT(f->base, k, f->ttbl->width);
+        found = f->ttbl->compare(found, valaddr) == 0 ? found : NULL;
+    }
 
-    if (current == NULL) {
+    return found;
+}
 
-    } else {
-        s[s_size++] = current;
+/**
+ *  Positions an iterator at the first element of a frozen rbtree
+ *  that does not compare less than valaddr, for ordered iteration
+ *  from there on with it_incr/it_curr.
+ *
+ *  @param[in]  f       pointer to rbfrozen
+ *  @param[in]  valaddr address of the key to search for
+ *
+ *  @return     iterator at the lower bound, or rbf_end(f) if there is none
+ */
+iterator rbf_lower_bound(rbfrozen *f, const void *valaddr) {
+    iterator it;
+    size_t k = 0;
 
-        to_push = 1;
-        is[is_size++] = to_push;
+    assert(f);
+    assert(valaddr);
 
-        current = current->left;
+    k = rbf_lower_index(f, valaddr);
 
-        while (s_size > 0) {
-            if (current && value == 0) {
-                s[s_size++] = current;
-                to_push = 1;
-                is[is_size++] = to_push;
+    it = rbfi_end(f);
+    it.curr = k ? ADDR_AT(f->base, k, f->ttbl->width) : NULL;
 
-                current = current->left;
-            } else {
-                current = s[--s_size];
-                value = is[--is_size];
+    return it;
+}
 
-                if (value == 1) {
-                    s[s_size++] = current;
-                    to_push = 2;
-                    is[is_size++] = to_push;
+static size_t rbf_lower_index(rbfrozen *f, const void *valaddr) {
+    int (*compare)(const void *, const void *) = f->ttbl->compare;
+    size_t width = f->ttbl->width;
+    size_t k = 1;
 
-                    current = current->right;
-                    value = 0;
-                } else {
-                    q[q_size++] = current;
-                }
-            }
+    /**
+     *  Branch-free descent: go left (2k) on not-less, right (2k + 1)
+     *  on less. The slots of the great-great-grandchildren of k
+     *  are 16k through 16k + 15 -- prefetch them four levels ahead.
+     */
+    while (k <= f->size) {
+        if (16 * k <= f->size) {
+            PREFETCH(ADDR_AT(f->base, 16 * k, width));
         }
-    }
 
-    free(is);
-    is = NULL;
+        k = 2 * k + (compare(ADDR_AT(f->base, k, width), valaddr) < 0);
+    }
 
-    free(s);
-    s = NULL;
+    /**< the answer is where the last left turn was taken */
+    while (k & 1) {
+        k >>= 1;
+    }
 
-    return q;
+    return k >> 1;
 }
 
-static rbnode **rbn_levelorder_buffer(rbnode **n)  {
-    size_t sz = 0;
-    rbnode **q = NULL;
-    int q_size = 0;
-    int q_cap = 0;
-    int q_front = 0;
-    int q_rear = 0;
-    rbnode **temp_q = NULL;
-    int tq_size = 0;
-    int tq_cap = 0;
-    int tq_front = 0;
-    int tq_rear = 0;
-    rbnode *current = NULL;
+static size_t rbf_first(rbfrozen *f) {
+    size_t k = 0;
 
-    assert((*n));
+    if (f->size > 0) {
+        for (k = 1; 2 * k <= f->size; k *= 2) {
+            ;
+        }
+    }
 
-    sz = rbn_size((*n));
+    return k;
+}
 
-    q = calloc(sz, sizeof(struct rbnode *));
-    assert(q);
-    q_cap = sz;
-    q_rear = sz - 1;
+static size_t rbf_last(rbfrozen *f) {
+    size_t k = 0;
 
-    temp_q = calloc(sz, sizeof(struct rbnode *));
-    assert(temp_q);
-    tq_cap = sz;
-    tq_rear = sz - 1;
+    if (f->size > 0) {
+        for (k = 1; 2 * k + 1 <= f->size; k = 2 * k + 1) {
+            ;
+        }
+    }
 
-    current = (*n);
+    return k;
+}
 
-    tq_rear = (tq_rear + 1) % tq_cap;
-    temp_q[tq_rear] = current;
-    ++tq_size;
+static size_t rbf_next(rbfrozen *f, size_t k) {
+    if (2 * k + 1 <= f->size) {
+        /**< leftmost slot of the right subtree */
+        for (k = 2 * k + 1; 2 * k <= f->size; k *= 2) {
+            ;
+        }
 
-    while (tq_size > 0) {
-        rbnode *front = temp_q[tq_front];
-        tq_front = (tq_front + 1) % tq_cap;
-        --tq_size;
+        return k;
+    }
 
-        current = front;
+    /**< climb past right children; the parent of a left child is next */
+    while (k & 1) {
+        k >>= 1;
+    }
 
-        q_rear = (q_rear + 1) % q_cap;
-        q[q_rear] = current;
-        ++q_size;
+    return k >> 1;
+}
 
-        if (current->left) {
-            tq_rear = (tq_rear + 1) % tq_cap;
-            temp_q[tq_rear] = current->left;
-            ++tq_size;
+static size_t rbf_prev(rbfrozen *f, size_t k) {
+    if (2 * k <= f->size) {
+        /**< rightmost slot of the left subtree */
+        for (k = 2 * k; 2 * k + 1 <= f->size; k = 2 * k + 1) {
+            ;
         }
 
-        if (current->right) {
-            tq_rear = (tq_rear + 1) % tq_cap;
-            temp_q[tq_rear] = current->right;
-            ++tq_size;
-        }
+        return k;
     }
 
-    free(temp_q);
-    temp_q = NULL;
+    /**< climb past left children; the parent of a right child is prev */
+    while (k > 1 && (k & 1) == 0) {
+        k >>= 1;
+    }
 
-    return q;
+    return k >> 1;
 }
 
-static void rbn_fputs(rbnode *n, FILE *dest, char *b, bool last,
-                      void (*print)(const void *, FILE *dest)) {
-    /**
-     *  Custom recursive preorder traversal
-     */
+static size_t rbf_subtree_size(rbfrozen *f, size_t k) {
+    size_t lo = k;
+    size_t hi = k;
+    size_t size = 0;
 
-    char newbuf[BUFFER_SIZE_4K];
-    bool is_red = false;
+    /**< a subtree spans [lo, hi] on each level, clipped to f->size */
+    while (lo <= f->size) {
+        size += (hi < f->size ? hi : f->size) - lo + 1;
+        lo = 2 * lo;
+        hi = 2 * hi + 1;
+    }
 
-    strcpy(newbuf, b);
+    return size;
+}
 
-    fprintf(dest, "%s", b);
+static size_t rbf_rank(rbfrozen *f, size_t k) {
+    size_t rank = 0;
 
-    if (last) {
-        fprintf(dest, "%sR%s----", KGRY, KNRM);
-        strcat(newbuf, "      ");
-    } else {
-        fprintf(dest, "%sL%s----", KGRY, KNRM);
-        strcat(newbuf, "|     ");
+    if (k == 0) {
+        return f->size;
     }
 
-    is_red = rbn_red(n);
-
-    if (n != NULL) {
-        const char *label_color = is_red ? KRED_b : KNRM_b;
-        fprintf(dest, "%s[", label_color);
-        print(n->valaddr, dest);
+    rank = rbf_subtree_size(f, 2 * k);
 
-        fprintf(dest, "]%s ", KNRM);
+    for (; k > 1; k >>= 1) {
+        if (k & 1) {
+            rank += rbf_subtree_size(f, k - 1) + 1;
+        }
+    }
 
-        fprintf(dest, "(%s%p%s)", KCYN, (void *)(n), KNRM);
+    return rank;
+}
 
-        fprintf(dest, "\n");
-        rbn_fputs(n->left, dest, newbuf, false, print);
-        rbn_fputs(n->right, dest, newbuf, true, print);
-    } else {
-        fprintf(dest, "%s[%s]", KGRY, DIAMOND_SYMBOL);
+static size_t rbf_select(rbfrozen *f, size_t r) {
+    size_t k = 1;
 
-        fprintf(dest, "%s(%p)", KGRY, NULL);
+    while (r < f->size) {
+        size_t left = rbf_subtree_size(f, 2 * k);
 
-        fprintf(dest, "%s\n", KNRM);
+        if (r < left) {
+            k = 2 * k;
+        } else if (r > left) {
+            r -= left + 1;
+            k = 2 * k + 1;
+        } else {
+            return k;
+        }
     }
-}
-
 
-static rbtree *rbt_allocate() {
-    rbtree *t = NULL;
-    t = malloc(sizeof((*t)));
-    assert(t);
-    return t;
+    return 0;
 }
 
-static void rbt_init(rbtree *t, struct typetable *ttbl) {
-    assert(t);
-    t->root = NULL;
-    t->ttbl = ttbl ? ttbl : _void_ptr_;
-}
+/**
+ *  rbfrozen iterators store the address of the current element
+ *  in it.curr; NULL denotes the position one past the maximum (end).
+ *  The snapshot is immutable, so iterators are never invalidated
+ *  until the rbfrozen is deleted or thawed.
+ */
+iterator rbfi_begin(void *arg) {
+    rbfrozen *f = (rbfrozen *)(arg);
+    iterator it;
+    size_t k = 0;
 
-static void rbt_deinit(rbtree *t) {
-    assert(t);
-    rbt_clear(t);
+    assert(f);
 
-    t->root = NULL;
-}
+    k = rbf_first(f);
 
-iterator rbti_begin(void *arg) {
-    iterator it;
+    it.itbl = _rbfrozen_iterator_;
+    it.container = f;
+    it.curr = k ? ADDR_AT(f->base, k, f->ttbl->width) : NULL;
 
     return it;
 }
 
-iterator rbti_end(void *arg) {
+iterator rbfi_end(void *arg) {
+    rbfrozen *f = (rbfrozen *)(arg);
     iterator it;
 
+    assert(f);
+
+    it.itbl = _rbfrozen_iterator_;
+    it.container = f;
+    it.curr = NULL;
+
     return it;
 }
 
-iterator rbti_next(iterator it) {
-    return it;
+iterator rbfi_next(iterator it) {
+    iterator iter = it;
+    rbfi_incr(&iter);
+    return iter;
 }
 
-iterator rbti_next_n(iterator it, int n) {
-    return it;
+iterator rbfi_next_n(iterator it, int n) {
+    iterator iter = it;
+    rbfi_advance(&iter, n);
+    return iter;
 }
 
-iterator rbti_prev(iterator it) {
-    return it;
+iterator rbfi_prev(iterator it) {
+    iterator iter = it;
+    rbfi_decr(&iter);
+    return iter;
 }
 
-iterator rbti_prev_n(iterator it, int n) {
-    return it;
+iterator rbfi_prev_n(iterator it, int n) {
+    iterator iter = it;
+    rbfi_advance(&iter, -n);
+    return iter;
 }
 
-iterator *rbti_advance(iterator *it, int n) {
+iterator *rbfi_advance(iterator *it, int n) {
+    rbfrozen *f = NULL;
+    size_t k = 0;
+    int pos = 0;
+
+    massert_iterator(it);
+
+    f = it->container;
+    pos = (int)(rbf_rank(f, rbfi_slot(*it)));
+
+    if (pos + n < 0 || (size_t)(pos + n) > f->size) {
+        char str[256];
+        sprintf(str, "Cannot advance %d times from position %d.", n, pos);
+        ERROR(__FILE__, str);
+    } else if (n != 0) {
+        k = rbf_select(f, (size_t)(pos + n));
+        it->curr = k ? ADDR_AT(f->base, k, f->ttbl->width) : NULL;
+    }
+
     return it;
 }
 
-iterator *rbti_incr(iterator *it) {
+iterator *rbfi_incr(iterator *it) {
+    rbfrozen *f = NULL;
+    size_t k = 0;
+
+    massert_iterator(it);
+
+    f = it->container;
+
+    if (it->curr == NULL) {
+        ERROR(__FILE__, "Cannot increment - already at end.");
+    } else {
+        k = rbf_next(f, rbfi_slot(*it));
+        it->curr = k ? ADDR_AT(f->base, k, f->ttbl->width) : NULL;
+    }
+
     return it;
 }
 
-iterator *rbti_decr(iterator *it) {
+iterator *rbfi_decr(iterator *it) {
+    rbfrozen *f = NULL;
+    size_t k = 0;
+
+    massert_iterator(it);
+
+    f = it->container;
+    k = it->curr ? rbf_prev(f, rbfi_slot(*it)) : rbf_last(f);
+
+    if (k == 0) {
+        ERROR(__FILE__, "Cannot decrement this iterator, already at begin.");
+    } else {
+        it->curr = ADDR_AT(f->base, k, f->ttbl->width);
+    }
+
     return it;
 }
 
-void *rbti_curr(iterator it) {
-    return NULL;
+void *rbfi_curr(iterator it) {
+    return it.curr;
 }
 
-void *rbti_start(iterator it) {
-    return NULL;
+void *rbfi_start(iterator it) {
+    return rbfi_begin(it.container).curr;
 }
 
-void *rbti_finish(iterator it) {
+void *rbfi_finish(iterator it) {
+    /**< end has no element; rbfi_curr yields NULL there, as does finish */
+    (void)it;
     return NULL;
 }
 
-int rbti_distance(iterator *first, iterator *last) {
-    return 0;
+int rbfi_distance(iterator *first, iterator *last) {
+    if (first == NULL && last != NULL) {
+        return (int)(rbf_rank(last->container, rbfi_slot(*last)));
+    } else if (last == NULL && first != NULL) {
+        return (int)(rbf_rank(first->container, rbfi_slot(*first)));
+    } else if (first == NULL && last == NULL) {
+        ERROR(__FILE__, "Both iterator first and last are NULL.");
+        return 0;
+    } else {
+        return (int)(rbf_rank(last->container, rbfi_slot(*last))) -
+               (int)(rbf_rank(first->container, rbfi_slot(*first)));
+    }
 }
 
-bool rbti_has_next(iterator it) {
-    return false;
+bool rbfi_has_next(iterator it) {
+    return it.curr != NULL;
 }
 
-bool rbti_has_prev(iterator it) {
-    return false;
+bool rbfi_has_prev(iterator it) {
+    rbfrozen *f = it.container;
+
+    if (it.curr == NULL) {
+        return f->size > 0;
+    }
+
+    return rbf_prev(f, rbfi_slot(it)) != 0;
 }
 
-struct typetable *rbti_get_ttbl(void *arg) {
-    return NULL;
+struct typetable *rbfi_get_ttbl(void *arg) {
+    rbfrozen *f = (rbfrozen *)(arg);
+    return f->ttbl;
+}
+
+static size_t rbfi_slot(iterator it) {
+    rbfrozen *f = it.container;
+    char *curr = it.curr;
+
+    return curr ? (size_t)(curr - f->base) / f->ttbl->width : 0;
 }
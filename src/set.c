@@ -0,0 +1,288 @@
+/**
+ *  @file       set.c
+ *  @brief      Source file for an ordered container of unique elements
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "set.h"
+#include "rbtree.h"
+
+/**
+ *  @struct     set
+ *  @brief      An rbtree that only ever holds unique elements
+ */
+struct set {
+    rbtree *t;
+    struct typetable *ttbl;
+};
+
+/**
+ *  @brief  Allocates and initializes a new set
+ *
+ *  @param[in]  ttbl    typetable of the elements (must have compare)
+ *
+ *  @return     pointer to set
+ */
+set *s_new(struct typetable *ttbl) {
+    set *s = malloc(sizeof *s);
+    massert_malloc(s);
+
+    s->ttbl = ttbl ? ttbl : _void_ptr_;
+    s->t = rbt_new(s->ttbl);
+    return s;
+}
+
+/**
+ *  @brief  Allocates a new set and deep copies the elements of s into it
+ *
+ *  @param[in]  s   pointer to set
+ *
+ *  @return     pointer to set
+ */
+set *s_newcopy(set *s) {
+    set *copy = NULL;
+
+    assert(s);
+
+    copy = malloc(sizeof *copy);
+    massert_malloc(copy);
+
+    copy->ttbl = s->ttbl;
+    copy->t = rbt_newcopy(s->t);
+    return copy;
+}
+
+/**
+ *  @brief  Releases every element of (*s), then (*s) itself
+ *
+ *  @param[out] s   address of pointer to set
+ */
+void s_delete(set **s) {
+    assert(s);
+    assert(*s);
+
+    rbt_delete(&(*s)->t);
+
+    free(*s);
+    *s = NULL;
+}
+
+/**
+ *  @brief  Returns an iterator to the least element of s
+ *
+ *  @param[in]  s   pointer to set
+ *
+ *  @return     iterator at the first element
+ */
+iterator s_begin(set *s) {
+    assert(s);
+    return rbt_begin(s->t);
+}
+
+/**
+ *  @brief  Returns an iterator to one past the greatest element of s
+ *
+ *  @param[in]  s   pointer to set
+ *
+ *  @return     iterator at end
+ */
+iterator s_end(set *s) {
+    assert(s);
+    return rbt_end(s->t);
+}
+
+/**
+ *  @brief  Returns the number of elements in s
+ *
+ *  @param[in]  s   pointer to set
+ *
+ *  @return     number of elements
+ */
+size_t s_size(set *s) {
+    assert(s);
+    return rbt_size(s->t);
+}
+
+/**
+ *  @brief  Determines if s has no elements
+ *
+ *  @param[in]  s   pointer to set
+ *
+ *  @return     true if s is empty, false otherwise
+ */
+bool s_empty(set *s) {
+    assert(s);
+    return rbt_empty(s->t);
+}
+
+/**
+ *  @brief  Inserts valaddr into s, unless an equal element is present
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     true if valaddr was inserted, false if it was found
+ */
+bool s_insert(set *s, const void *valaddr) {
+    /**< no hint: rbt_insert_hint searches from the root */
+    iterator hint = { NULL, NULL, NULL };
+    return s_inserthint(s, &hint, valaddr);
+}
+
+/**
+ *  @brief  Inserts valaddr into s, unless an equal element is present,
+ *          using hint as a guess for where valaddr belongs
+ *
+ *  See rbt_insert_hint; *hint is updated to refer to the inserted
+ *  element, or to the equal element that was found.
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[out] hint    iterator into s
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     true if valaddr was inserted, false if it was found
+ */
+bool s_inserthint(set *s, iterator *hint, const void *valaddr) {
+    assert(s);
+    return rbt_insert_hint(s->t, hint, valaddr);
+}
+
+/**
+ *  @brief  Removes the element equal to valaddr from s, if there is one
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ */
+void s_erase(set *s, const void *valaddr) {
+    assert(s);
+    rbt_erase(s->t, valaddr);
+}
+
+/**
+ *  @brief  Removes every element from s
+ *
+ *  @param[in]  s   pointer to set
+ */
+void s_clear(set *s) {
+    assert(s);
+    rbt_clear(s->t);
+}
+
+/**
+ *  @brief  Returns an iterator to the element equal to valaddr
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     iterator at the element, or s_end(s) if it is not in s
+ */
+iterator s_find(set *s, const void *valaddr) {
+    iterator it = s_lowerbound(s, valaddr);
+    void *curr = it_curr(it);
+
+    if (curr && s->ttbl->compare(curr, valaddr) != 0) {
+        return s_end(s);
+    }
+
+    return it;
+}
+
+/**
+ *  @brief  Returns the number of elements equal to valaddr (0 or 1)
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     1 if valaddr is in s, 0 otherwise
+ */
+size_t s_count(set *s, const void *valaddr) {
+    assert(s);
+    return rbt_find(s->t, valaddr) ? 1 : 0;
+}
+
+/**
+ *  @brief  Returns an iterator to the first element that
+ *          does not compare less than valaddr, in O(log n)
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     iterator at the lower bound, or s_end(s)
+ */
+iterator s_lowerbound(set *s, const void *valaddr) {
+    assert(s);
+    return rbt_lower_bound(s->t, valaddr);
+}
+
+/**
+ *  @brief  Returns an iterator to the first element that
+ *          compares greater than valaddr, in O(log n)
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ *
+ *  @return     iterator at the upper bound, or s_end(s)
+ */
+iterator s_upperbound(set *s, const void *valaddr) {
+    assert(s);
+    return rbt_upper_bound(s->t, valaddr);
+}
+
+/**
+ *  @brief  Retrieves the range [*first, *last) of elements equal to valaddr
+ *
+ *  Elements are unique, so the range is empty or holds a single element.
+ *
+ *  @param[in]  s       pointer to set
+ *  @param[in]  valaddr address of the element
+ *  @param[out] first   receives s_lowerbound(s, valaddr)
+ *  @param[out] last    receives s_upperbound(s, valaddr)
+ */
+void s_equalrange(set *s, const void *valaddr, iterator *first, iterator *last) {
+    assert(first);
+    assert(last);
+
+    *first = s_lowerbound(s, valaddr);
+    *last = s_upperbound(s, valaddr);
+}
+
+/**
+ *  @brief  Returns the typetable of s's elements
+ *
+ *  @param[in]  s   pointer to set
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *s_get_ttbl(set *s) {
+    assert(s);
+    return s->ttbl;
+}
@@ -96,7 +96,8 @@ struct iterator_table itbl_slist = {
     sli_distance,
     sli_has_next,
     NULL,
-    sli_get_ttbl
+    sli_get_ttbl,
+    ITERATOR_FORWARD
 };
 
 struct iterator_table *_slist_iterator_ = &itbl_slist;
@@ -0,0 +1,161 @@
+/**
+ *  @file       stack.c
+ *  @brief      Source file for a stack adapter over deque
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "stack.h"
+#include "deque.h"
+#include "utils.h"
+
+#include <stdlib.h>
+
+/**
+ *  @struct     stack
+ *  @brief      Represents a LIFO stack, implemented with a deque
+ *
+ *  Note that struct stack is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct stack be created on the stack.
+ *  This is done to enforce encapsulation.
+ */
+struct stack {
+    deque *impl;
+};
+
+/**
+ *  @brief  Allocates, constructs, and returns a pointer to stack
+ *
+ *  @param[in]  ttbl    pointer to struct typetable for
+ *                      width/copy/dtor/swap/compare/print
+ *
+ *  @return     pointer to stack
+ */
+stack *stk_new(struct typetable *ttbl) {
+    stack *s = NULL;
+
+    s = malloc(sizeof *s);
+    massert_malloc(s);
+
+    s->impl = dq_new(ttbl);
+    return s;
+}
+
+/**
+ *  @brief  Destroys all elements of (*s), then frees memory at (*s)
+ *
+ *  @param[out] s   address of a pointer to stack
+ */
+void stk_delete(stack **s) {
+    massert_container((*s));
+
+    dq_delete(&(*s)->impl);
+
+    free((*s));
+    (*s) = NULL;
+}
+
+/**
+ *  @brief  Returns the number of elements in s
+ *
+ *  @param[in]  s   pointer to stack
+ *
+ *  @return     number of elements in s
+ */
+size_t stk_size(stack *s) {
+    massert_container(s);
+    return dq_size(s->impl);
+}
+
+/**
+ *  @brief  Determines if s has no elements
+ *
+ *  @param[in]  s   pointer to stack
+ *
+ *  @return     true if s is empty, false otherwise
+ */
+bool stk_empty(stack *s) {
+    massert_container(s);
+    return dq_empty(s->impl);
+}
+
+/**
+ *  @brief  Retrieves the address of the top element of s
+ *
+ *  @param[in]  s   pointer to stack
+ *
+ *  @return     address of top element, NULL if s is empty
+ */
+void *stk_top(stack *s) {
+    massert_container(s);
+    return dq_back(s->impl);
+}
+
+/**
+ *  @brief  Pushes a copy of the element at valaddr onto s
+ *
+ *  @param[in]  s       pointer to stack
+ *  @param[in]  valaddr address of element to copy
+ */
+void stk_push(stack *s, const void *valaddr) {
+    massert_container(s);
+    dq_pushb(s->impl, valaddr);
+}
+
+/**
+ *  @brief  Removes the top element of s
+ *
+ *  @param[in]  s   pointer to stack
+ *
+ *  stk_pop is a no-op if s is empty.
+ */
+void stk_pop(stack *s) {
+    massert_container(s);
+    dq_popb(s->impl);
+}
+
+/**
+ *  @brief  Destroys all elements of s
+ *
+ *  @param[in]  s   pointer to stack
+ */
+void stk_clear(stack *s) {
+    massert_container(s);
+    dq_clear(s->impl);
+}
+
+/**
+ *  @brief  Retrieves s's ttbl
+ *
+ *  @param[in]  s   pointer to stack
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *stk_get_ttbl(stack *s) {
+    massert_container(s);
+    return dq_get_ttbl(s->impl);
+}
@@ -0,0 +1,173 @@
+/**
+ *  @file       uqueue.c
+ *  @brief      Source file for an unbounded queue adapter over deque
+ *
+ *  @author     Gemuele Aludino
+ *  @date       07 Sep 2019
+ *  @copyright  Copyright © 2019 Gemuele Aludino
+ */
+/**
+ *  Copyright © 2019 Gemuele Aludino
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ *  THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "uqueue.h"
+#include "deque.h"
+#include "utils.h"
+
+#include <stdlib.h>
+
+/**
+ *  @struct     uqueue
+ *  @brief      Represents an unbounded FIFO queue, implemented with a deque
+ *
+ *  Note that struct uqueue is opaque --
+ *  its fields cannot be accessed directly,
+ *  nor can instances of struct uqueue be created on the stack.
+ *  This is done to enforce encapsulation.
+ */
+struct uqueue {
+    deque *impl;
+};
+
+/**
+ *  @brief  Allocates, constructs, and returns a pointer to uqueue
+ *
+ *  @param[in]  ttbl    pointer to struct typetable for
+ *                      width/copy/dtor/swap/compare/print
+ *
+ *  @return     pointer to uqueue
+ */
+uqueue *uq_new(struct typetable *ttbl) {
+    uqueue *q = NULL;
+
+    q = malloc(sizeof *q);
+    massert_malloc(q);
+
+    q->impl = dq_new(ttbl);
+    return q;
+}
+
+/**
+ *  @brief  Destroys all elements of (*q), then frees memory at (*q)
+ *
+ *  @param[out] q   address of a pointer to uqueue
+ */
+void uq_delete(uqueue **q) {
+    massert_container((*q));
+
+    dq_delete(&(*q)->impl);
+
+    free((*q));
+    (*q) = NULL;
+}
+
+/**
+ *  @brief  Returns the number of elements in q
+ *
+ *  @param[in]  q   pointer to uqueue
+ *
+ *  @return     number of elements in q
+ */
+size_t uq_size(uqueue *q) {
+    massert_container(q);
+    return dq_size(q->impl);
+}
+
+/**
+ *  @brief  Determines if q has no elements
+ *
+ *  @param[in]  q   pointer to uqueue
+ *
+ *  @return     true if q is empty, false otherwise
+ */
+bool uq_empty(uqueue *q) {
+    massert_container(q);
+    return dq_empty(q->impl);
+}
+
+/**
+ *  @brief  Retrieves the address of the front (oldest) element of q
+ *
+ *  @param[in]  q   pointer to uqueue
+ *
+ *  @return     address of front element, NULL if q is empty
+ */
+void *uq_front(uqueue *q) {
+    massert_container(q);
+    return dq_front(q->impl);
+}
+
+/**
+ *  @brief  Retrieves the address of the back (newest) element of q
+ *
+ *  @param[in]  q   pointer to uqueue
+ *
+ *  @return     address of back element, NULL if q is empty
+ */
+void *uq_back(uqueue *q) {
+    massert_container(q);
+    return dq_back(q->impl);
+}
+
+/**
+ *  @brief  Appends a copy of the element at valaddr to q
+ *
+ *  @param[in]  q       pointer to uqueue
+ *  @param[in]  valaddr address of element to copy
+ */
+void uq_push(uqueue *q, const void *valaddr) {
+    massert_container(q);
+    dq_pushb(q->impl, valaddr);
+}
+
+/**
+ *  @brief  Removes the front element of q
+ *
+ *  @param[in]  q   pointer to uqueue
+ *
+ *  uq_pop is a no-op if q is empty.
+ */
+void uq_pop(uqueue *q) {
+    massert_container(q);
+    dq_popf(q->impl);
+}
+
+/**
+ *  @brief  Destroys all elements of q
+ *
+ *  @param[in]  q   pointer to uqueue
+ */
+void uq_clear(uqueue *q) {
+    massert_container(q);
+    dq_clear(q->impl);
+}
+
+/**
+ *  @brief  Retrieves q's ttbl
+ *
+ *  @param[in]  q   pointer to uqueue
+ *
+ *  @return     pointer to typetable
+ */
+struct typetable *uq_get_ttbl(uqueue *q) {
+    massert_container(q);
+    return dq_get_ttbl(q->impl);
+}
@@ -83,17 +83,13 @@ struct typetable ttbl_int8;
 struct typetable ttbl_int16;
 struct typetable ttbl_int32;
 
-#if __STD_VERSION__ >= 199901L
 struct typetable ttbl_int64;
-#endif /* __STDC_VERSION__ >= 199901L */
 
 struct typetable ttbl_uint8;
 struct typetable ttbl_uint16;
 struct typetable ttbl_uint32;
 
-#if __STD_VERSION__ >= 199901L
 struct typetable ttbl_uint64;
-#endif /* __STDC_VERSION__ >= 199901L */
 
 void *str_copy(void *arg, const void *other) {
     char **target = (char **)(arg);
@@ -329,35 +325,15 @@ int str_compare(const void *c1, const void *c2) {
 }
 
 int str_compare_ignore_case(const void *c1, const void *c2) {
-    char **first = (char **)(c1);
-    char **second = (char **)(c2);
-
-    int i = 0;
-    int len_f = strlen((*first));
-    int len_s = strlen((*second));
-    int result = -1;
-    int t = 0;
-
-    char *f = strcpy(malloc(len_f + 1), (*first));
-    char *s = strcpy(malloc(len_s + 1), (*second));
+    const unsigned char *first = *(unsigned char **)(c1);
+    const unsigned char *second = *(unsigned char **)(c2);
 
-    for (i = 0; i < len_f; i++) {
-        t = toupper(f[i]);
+    while (*first && tolower(*first) == tolower(*second)) {
+        ++first;
+        ++second;
     }
 
-    for (i = 0; i < len_s; i++) {
-        t = toupper(s[i]);
-    }
-
-    result = strcmp(f, s);
-
-    free(f);
-    f = NULL;
-
-    free(s);
-    s = NULL;
-
-    return result;
+    return tolower(*first) - tolower(*second);
 }
 
 int cstr_compare(const void *c1, const void *c2) {
@@ -392,11 +368,12 @@ int int32_compare(const void *c1, const void *c2) {
     return int_compare(c1, c2);
 }
 
-#if __STD_VERSION__ >= 199901L
 int int64_compare(const void *c1, const void *c2) {
-    return long_long_int_compare(c1, c2);
+    int64_t a = *(int64_t *)(c1);
+    int64_t b = *(int64_t *)(c2);
+
+    return a < b ? -1 : (a > b ? 1 : 0);
 }
-#endif /* __STDC_VERSION__ >= 199901L */
 
 int uint8_compare(const void *c1, const void *c2) {
     return unsigned_char_compare(c1, c2);
@@ -410,12 +387,464 @@ int uint32_compare(const void *c1, const void *c2) {
     return unsigned_int_compare(c1, c2);
 }
 
-#if __STD_VERSION__ >= 199901L
 int uint64_compare(const void *c1, const void *c2) {
-    return unsigned_long_long_int_compare(c1, c2);
+    uint64_t a = *(uint64_t *)(c1);
+    uint64_t b = *(uint64_t *)(c2);
+
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/**
+ *  @def        HASH_U64
+ *  @brief      Builds a 64-bit constant from two 32-bit halves
+ *              (C89 has no 64-bit integer literals)
+ */
+#define HASH_U64(HI, LO) (((uint64_t)(HI##UL) << 32) | (uint64_t)(LO##UL))
+
+#define HASH_SECRET0 HASH_U64(0x2d358dcc, 0xaa6c78a5)
+#define HASH_SECRET1 HASH_U64(0x8bb84b93, 0x962eacc9)
+#define HASH_SECRET2 HASH_U64(0x4b33a62e, 0xd433d4a3)
+#define HASH_SECRET3 HASH_U64(0x4d5a2da5, 0x1de1aa47)
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 hash_uint128;
+#endif /* defined(__SIZEOF_INT128__) */
+
+/**
+ *  @brief  Replaces *a and *b with the low and high halves of *a * *b
+ */
+static void hash_mum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    hash_uint128 r = (hash_uint128)(*a) * (*b);
+
+    *a = (uint64_t)(r);
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, la = (uint32_t)(*a);
+    uint64_t hb = *b >> 32, lb = (uint32_t)(*b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif /* defined(__SIZEOF_INT128__) */
+}
+
+/**
+ *  @brief  Multiplies a by b, folding the high half of the product
+ *          into the low half
+ */
+static uint64_t hash_mix(uint64_t a, uint64_t b) {
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+/**
+ *  @brief  Lowercases the ASCII letters among the 8 bytes of x at once
+ *
+ *  Per byte (y being its low 7 bits): y + 0x3f carries into bit 7
+ *  iff y >= 'A', and y + 0x25 does iff y > 'Z' -- neither can carry
+ *  into the next byte. Bytes with bit 7 set are not ASCII, and are kept.
+ */
+static uint64_t hash_fold(uint64_t x) {
+    uint64_t lo7 = HASH_U64(0x7f7f7f7f, 0x7f7f7f7f);
+    uint64_t hi1 = HASH_U64(0x80808080, 0x80808080);
+    uint64_t y = x & lo7;
+    uint64_t upper = (y + HASH_U64(0x3f3f3f3f, 0x3f3f3f3f)) &
+                     ~(y + HASH_U64(0x25252525, 0x25252525)) & ~x & hi1;
+
+    return x | (upper >> 2);
+}
+
+static uint64_t hash_read8(const unsigned char *p, bool fold) {
+    uint64_t v = 0;
+    memcpy(&v, p, 8);
+    return fold ? hash_fold(v) : v;
+}
+
+static uint64_t hash_read4(const unsigned char *p, bool fold) {
+    uint32_t v = 0;
+    memcpy(&v, p, 4);
+    return fold ? hash_fold(v) : v;
+}
+
+static uint64_t hash_read3(const unsigned char *p, size_t len, bool fold) {
+    uint64_t v = ((uint64_t)(p[0]) << 16) | ((uint64_t)(p[len >> 1]) << 8) |
+                 p[len - 1];
+    return fold ? hash_fold(v) : v;
+}
+
+/**
+ *  @brief  Hashes len bytes at p (wyhash)
+ *
+ *  Inputs longer than 48 bytes are consumed 48 bytes per step, in three
+ *  independent lanes; what remains, 16 bytes per step; and the last
+ *  (up to) 16 bytes with two overlapping reads -- so no input is ever
+ *  processed a byte at a time. If fold is set, ASCII letters are
+ *  lowercased as they are read, so that case is ignored.
+ *
+ *  @param[in]  p       address of the first byte
+ *  @param[in]  len     number of bytes
+ *  @param[in]  fold    true to ignore (ASCII) case
+ *
+ *  @return     64-bit hash
+ */
+static uint64_t hash_wy(const unsigned char *p, size_t len, bool fold) {
+    uint64_t seed = hash_mix(HASH_SECRET0, HASH_SECRET1);
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t mid = (len >> 3) << 2;
+
+            a = (hash_read4(p, fold) << 32) | hash_read4(p + mid, fold);
+            b = (hash_read4(p + len - 4, fold) << 32) |
+                hash_read4(p + len - 4 - mid, fold);
+        } else if (len > 0) {
+            a = hash_read3(p, len, fold);
+        }
+    } else {
+        size_t i = len;
+
+        if (i > 48) {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+
+            do {
+                seed = hash_mix(hash_read8(p, fold) ^ HASH_SECRET1,
+                                hash_read8(p + 8, fold) ^ seed);
+                see1 = hash_mix(hash_read8(p + 16, fold) ^ HASH_SECRET2,
+                                hash_read8(p + 24, fold) ^ see1);
+                see2 = hash_mix(hash_read8(p + 32, fold) ^ HASH_SECRET3,
+                                hash_read8(p + 40, fold) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = hash_mix(hash_read8(p, fold) ^ HASH_SECRET1,
+                            hash_read8(p + 8, fold) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+
+        a = hash_read8(p + i - 16, fold);
+        b = hash_read8(p + i - 8, fold);
+    }
+
+    a ^= HASH_SECRET1;
+    b ^= seed;
+    hash_mum(&a, &b);
+
+    return hash_mix(a ^ HASH_SECRET0 ^ len, b ^ HASH_SECRET1);
+}
+
+/**
+ *  @brief  Hashes a single integer (all of whose bits are significant)
+ */
+static size_t hash_word(uint64_t x) {
+    uint64_t a = x ^ HASH_SECRET0;
+    uint64_t b = HASH_SECRET1;
+
+    hash_mum(&a, &b);
+    return (size_t)(hash_mix(a ^ HASH_SECRET0, b ^ HASH_SECRET1));
+}
+
+size_t hash_bytes(const void *data, size_t len) {
+    return (size_t)(hash_wy(data, len, false));
+}
+
+size_t hash_bytes_ignore_case(const void *data, size_t len) {
+    return (size_t)(hash_wy(data, len, true));
+}
+
+size_t char_hash(const void *arg) {
+    return hash_word((unsigned char)*(char *)(arg));
+}
+
+size_t signed_char_hash(const void *arg) {
+    return hash_word((unsigned char)*(signed char *)(arg));
+}
+
+size_t unsigned_char_hash(const void *arg) {
+    return hash_word(*(unsigned char *)(arg));
+}
+
+size_t short_int_hash(const void *arg) {
+    return hash_word((unsigned short int)*(short int *)(arg));
+}
+
+size_t signed_short_int_hash(const void *arg) {
+    return short_int_hash(arg);
+}
+
+size_t unsigned_short_int_hash(const void *arg) {
+    return hash_word(*(unsigned short int *)(arg));
+}
+
+size_t int_hash(const void *arg) {
+    return hash_word((unsigned int)*(int *)(arg));
+}
+
+size_t signed_int_hash(const void *arg) {
+    return int_hash(arg);
+}
+
+size_t unsigned_int_hash(const void *arg) {
+    return hash_word(*(unsigned int *)(arg));
+}
+
+size_t long_int_hash(const void *arg) {
+    return hash_word((unsigned long int)*(long int *)(arg));
+}
+
+size_t signed_long_int_hash(const void *arg) {
+    return long_int_hash(arg);
+}
+
+size_t unsigned_long_int_hash(const void *arg) {
+    return hash_word(*(unsigned long int *)(arg));
+}
+
+#if __STDC_VERSION__ >= 199901L
+size_t long_long_int_hash(const void *arg) {
+    return hash_word((unsigned long long int)*(long long int *)(arg));
+}
+
+size_t signed_long_long_int_hash(const void *arg) {
+    return long_long_int_hash(arg);
+}
+
+size_t unsigned_long_long_int_hash(const void *arg) {
+    return hash_word(*(unsigned long long int *)(arg));
 }
 #endif /* __STDC_VERSION__ >= 199901L */
 
+size_t int64_hash(const void *arg) {
+    return hash_word((uint64_t)(*(int64_t *)(arg)));
+}
+
+size_t uint64_hash(const void *arg) {
+    return hash_word(*(uint64_t *)(arg));
+}
+
+/**
+ *  -0.0 hashes as 0.0 (they are equal), and every NaN hashes alike
+ *  (float_equals treats NaNs as equal to each other).
+ */
+size_t float_hash(const void *arg) {
+    float f = *(float *)(arg);
+    uint32_t bits = 0;
+
+    if (f != f) {
+        return hash_word(HASH_U64(0x7fc00000, 0x7fc00000));
+    }
+
+    f = f == 0.0f ? 0.0f : f;
+    memcpy(&bits, &f, sizeof bits);
+
+    return hash_word(bits);
+}
+
+size_t double_hash(const void *arg) {
+    double d = *(double *)(arg);
+    uint64_t bits = 0;
+
+    if (d != d) {
+        return hash_word(HASH_U64(0x7ff80000, 0x7ff80000));
+    }
+
+    d = d == 0.0 ? 0.0 : d;
+    memcpy(&bits, &d, sizeof bits);
+
+    return hash_word(bits);
+}
+
+size_t bool_hash(const void *arg) {
+    return hash_word(*(bool *)(arg));
+}
+
+size_t str_hash(const void *arg) {
+    const char *s = *(char **)(arg);
+    return hash_bytes(s, strlen(s));
+}
+
+size_t str_hash_ignore_case(const void *arg) {
+    const char *s = *(char **)(arg);
+    return hash_bytes_ignore_case(s, strlen(s));
+}
+
+size_t cstr_hash(const void *arg) {
+    return str_hash(arg);
+}
+
+size_t cstr_hash_ignore_case(const void *arg) {
+    return str_hash_ignore_case(arg);
+}
+
+size_t void_ptr_hash(const void *arg) {
+    return hash_word((uint64_t)(size_t)(*(void **)(arg)));
+}
+
+bool char_equals(const void *c1, const void *c2) {
+    return *(char *)(c1) == *(char *)(c2) ? true : false;
+}
+
+bool signed_char_equals(const void *c1, const void *c2) {
+    return *(signed char *)(c1) == *(signed char *)(c2) ? true : false;
+}
+
+bool unsigned_char_equals(const void *c1, const void *c2) {
+    return *(unsigned char *)(c1) == *(unsigned char *)(c2) ? true : false;
+}
+
+bool short_int_equals(const void *c1, const void *c2) {
+    return *(short int *)(c1) == *(short int *)(c2) ? true : false;
+}
+
+bool signed_short_int_equals(const void *c1, const void *c2) {
+    return short_int_equals(c1, c2);
+}
+
+bool unsigned_short_int_equals(const void *c1, const void *c2) {
+    return *(unsigned short int *)(c1) == *(unsigned short int *)(c2) ? true
+                                                                      : false;
+}
+
+bool int_equals(const void *c1, const void *c2) {
+    return *(int *)(c1) == *(int *)(c2) ? true : false;
+}
+
+bool signed_int_equals(const void *c1, const void *c2) {
+    return int_equals(c1, c2);
+}
+
+bool unsigned_int_equals(const void *c1, const void *c2) {
+    return *(unsigned int *)(c1) == *(unsigned int *)(c2) ? true : false;
+}
+
+bool long_int_equals(const void *c1, const void *c2) {
+    return *(long int *)(c1) == *(long int *)(c2) ? true : false;
+}
+
+bool signed_long_int_equals(const void *c1, const void *c2) {
+    return long_int_equals(c1, c2);
+}
+
+bool unsigned_long_int_equals(const void *c1, const void *c2) {
+    return *(unsigned long int *)(c1) == *(unsigned long int *)(c2) ? true
+                                                                    : false;
+}
+
+#if __STDC_VERSION__ >= 199901L
+bool long_long_int_equals(const void *c1, const void *c2) {
+    return *(long long int *)(c1) == *(long long int *)(c2) ? true : false;
+}
+
+bool signed_long_long_int_equals(const void *c1, const void *c2) {
+    return long_long_int_equals(c1, c2);
+}
+
+bool unsigned_long_long_int_equals(const void *c1, const void *c2) {
+    return *(unsigned long long int *)(c1) == *(unsigned long long int *)(c2)
+               ? true
+               : false;
+}
+#endif /* __STDC_VERSION__ >= 199901L */
+
+bool int64_equals(const void *c1, const void *c2) {
+    return *(int64_t *)(c1) == *(int64_t *)(c2) ? true : false;
+}
+
+bool uint64_equals(const void *c1, const void *c2) {
+    return *(uint64_t *)(c1) == *(uint64_t *)(c2) ? true : false;
+}
+
+bool float_equals(const void *c1, const void *c2) {
+    float f1 = *(float *)(c1);
+    float f2 = *(float *)(c2);
+
+    return (f1 == f2 || (f1 != f1 && f2 != f2)) ? true : false;
+}
+
+bool double_equals(const void *c1, const void *c2) {
+    double d1 = *(double *)(c1);
+    double d2 = *(double *)(c2);
+
+    return (d1 == d2 || (d1 != d1 && d2 != d2)) ? true : false;
+}
+
+bool bool_equals(const void *c1, const void *c2) {
+    return *(bool *)(c1) == *(bool *)(c2) ? true : false;
+}
+
+bool str_equals(const void *c1, const void *c2) {
+    return strcmp(*(char **)(c1), *(char **)(c2)) == 0 ? true : false;
+}
+
+bool str_equals_ignore_case(const void *c1, const void *c2) {
+    return str_compare_ignore_case(c1, c2) == 0 ? true : false;
+}
+
+bool cstr_equals(const void *c1, const void *c2) {
+    return str_equals(c1, c2);
+}
+
+bool cstr_equals_ignore_case(const void *c1, const void *c2) {
+    return str_equals_ignore_case(c1, c2);
+}
+
+bool void_ptr_equals(const void *c1, const void *c2) {
+    return *(void **)(c1) == *(void **)(c2) ? true : false;
+}
+
+/**
+ *  @def        INT64_DIGITS_MAX
+ *  @brief      Buffer size for a 64-bit integer in decimal:
+ *              20 digits, a sign, and the null terminator
+ */
+#define INT64_DIGITS_MAX 22
+
+/**
+ *  @brief  Writes value in decimal, right-aligned in a buffer of
+ *          INT64_DIGITS_MAX chars, and returns its first character
+ *
+ *  C89's printf has no conversion for 64-bit integers,
+ *  so int64/uint64 print and parse format through these.
+ */
+static char *uint64_format(char *buffer, uint64_t value) {
+    char *digit = buffer + INT64_DIGITS_MAX - 1;
+    *digit = '\0';
+
+    do {
+        *--digit = (char)('0' + (int)(value % 10));
+        value /= 10;
+    } while (value > 0);
+
+    return digit;
+}
+
+static char *int64_format(char *buffer, int64_t value) {
+    char *digit = NULL;
+
+    /**< negate in unsigned arithmetic, which is defined for INT64_MIN */
+    if (value < 0) {
+        digit = uint64_format(buffer, (uint64_t)(0) - (uint64_t)(value));
+        *--digit = '-';
+    } else {
+        digit = uint64_format(buffer, (uint64_t)(value));
+    }
+
+    return digit;
+}
+
 void char_print(const void *arg, FILE *dest) {
     fprintf(dest, "%c", *(char *)arg);
 }
@@ -528,11 +957,10 @@ void int32_print(const void *arg, FILE *dest) {
     int_print(arg, dest);
 }
 
-#if __STD_VERSION__ >= 199901L
 void int64_print(const void *arg, FILE *dest) {
-    long_long_int_print(arg, dest);
+    char buffer[INT64_DIGITS_MAX];
+    fputs(int64_format(buffer, *(int64_t *)(arg)), dest);
 }
-#endif /* __STDC_VERSION__ >= 199901L */
 
 void uint8_print(const void *arg, FILE *dest) {
     unsigned_char_print(arg, dest);
@@ -546,11 +974,10 @@ void uint32_print(const void *arg, FILE *dest) {
     unsigned_int_print(arg, dest);
 }
 
-#if __STD_VERSION__ >= 199901L
 void uint64_print(const void *arg, FILE *dest) {
-    unsigned_long_long_int_print(arg, dest);
+    char buffer[INT64_DIGITS_MAX];
+    fputs(uint64_format(buffer, *(uint64_t *)(arg)), dest);
 }
-#endif /* __STDC_VERSION__ >= 199901L */
 
 char *char_parse(const void *arg) {
     const char value = *(char *)arg;
@@ -861,11 +1288,16 @@ char *int32_parse(const void *arg) {
     return int_parse(arg);
 }
 
-#if __STD_VERSION__ >= 199901L
 char *int64_parse(const void *arg) {
-    return long_long_int_parse(arg);
+    char buffer[INT64_DIGITS_MAX];
+    const char *formatted = int64_format(buffer, *(int64_t *)(arg));
+    char *parsed = malloc(strlen(formatted) + 1);
+
+    massert_malloc(parsed);
+    strcpy(parsed, formatted);
+
+    return parsed;
 }
-#endif /* __STDC_VERSION__ >= 199901L */
 
 char *uint8_parse(const void *arg) {
     return unsigned_char_parse(arg);
@@ -879,11 +1311,16 @@ char *uint32_parse(const void *arg) {
     return unsigned_int_parse(arg);
 }
 
-#if __STD_VERSION__ >= 199901L
 char *uint64_parse(const void *arg) {
-    return unsigned_long_long_int_parse(arg);
+    char buffer[INT64_DIGITS_MAX];
+    const char *formatted = uint64_format(buffer, *(uint64_t *)(arg));
+    char *parsed = malloc(strlen(formatted) + 1);
+
+    massert_malloc(parsed);
+    strcpy(parsed, formatted);
+
+    return parsed;
 }
-#endif /* __STDC_VERSION__ >= 199901L */
 
 char *str_trim_left(char *to_trim, const char *charset) {
     size_t trim_length = 0;
@@ -947,147 +1384,184 @@ void void_ptr_swap(void **n1, void **n2) {
     *n2 = temp;
 }
 
-struct typetable ttbl_char = {sizeof(char), NULL,         NULL,
-                              NULL,         char_compare, char_print};
+struct typetable ttbl_char = {
+    sizeof(char), NULL, NULL, NULL,
+    char_compare, char_print,
+    char_hash, char_equals};
 
 struct typetable ttbl_signed_char = {
-    sizeof(signed char), NULL, NULL, NULL, signed_char_compare,
-    signed_char_print};
+    sizeof(signed char), NULL, NULL, NULL,
+    signed_char_compare, signed_char_print,
+    signed_char_hash, signed_char_equals};
 
 struct typetable ttbl_unsigned_char = {
-    sizeof(unsigned char), NULL, NULL, NULL, unsigned_char_compare,
-    unsigned_char_print};
+    sizeof(unsigned char), NULL, NULL, NULL,
+    unsigned_char_compare, unsigned_char_print,
+    unsigned_char_hash, unsigned_char_equals};
 
 struct typetable ttbl_short_int = {
-    sizeof(short int), NULL, NULL, NULL, short_int_compare, short_int_print};
+    sizeof(short int), NULL, NULL, NULL,
+    short_int_compare, short_int_print,
+    short_int_hash, short_int_equals};
 
 struct typetable ttbl_signed_short_int = {
-    sizeof(signed short int), NULL, NULL, NULL, signed_int_compare,
-    signed_int_print};
+    sizeof(signed short int), NULL, NULL, NULL,
+    signed_short_int_compare, signed_short_int_print,
+    signed_short_int_hash, signed_short_int_equals};
 
 struct typetable ttbl_unsigned_short_int = {
-    sizeof(unsigned short int), NULL, NULL, NULL, unsigned_int_compare,
-    unsigned_int_print};
+    sizeof(unsigned short int), NULL, NULL, NULL,
+    unsigned_short_int_compare, unsigned_short_int_print,
+    unsigned_short_int_hash, unsigned_short_int_equals};
 
-struct typetable ttbl_int = {sizeof(int), NULL,        NULL,
-                             NULL,        int_compare, int_print};
+struct typetable ttbl_int = {
+    sizeof(int), NULL, NULL, NULL,
+    int_compare, int_print,
+    int_hash, int_equals};
 
 struct typetable ttbl_signed_int = {
-    sizeof(signed int), NULL, NULL, NULL, signed_int_compare, signed_int_print};
+    sizeof(signed int), NULL, NULL, NULL,
+    signed_int_compare, signed_int_print,
+    signed_int_hash, signed_int_equals};
 
 struct typetable ttbl_unsigned_int = {
-    sizeof(unsigned int), NULL, NULL, NULL, unsigned_int_compare,
-    unsigned_int_print};
+    sizeof(unsigned int), NULL, NULL, NULL,
+    unsigned_int_compare, unsigned_int_print,
+    unsigned_int_hash, unsigned_int_equals};
 
-struct typetable ttbl_long_int = {sizeof(long int), NULL,          NULL, NULL,
-                                  long_int_compare, long_int_print};
+struct typetable ttbl_long_int = {
+    sizeof(long int), NULL, NULL, NULL,
+    long_int_compare, long_int_print,
+    long_int_hash, long_int_equals};
 
 struct typetable ttbl_signed_long_int = {
-    sizeof(signed long int), NULL, NULL, NULL, signed_long_int_compare,
-    signed_long_int_print};
+    sizeof(signed long int), NULL, NULL, NULL,
+    signed_long_int_compare, signed_long_int_print,
+    signed_long_int_hash, signed_long_int_equals};
 
 struct typetable ttbl_unsigned_long_int = {
-    sizeof(unsigned long int), NULL, NULL, NULL, unsigned_long_int_compare,
-    unsigned_long_int_print};
+    sizeof(unsigned long int), NULL, NULL, NULL,
+    unsigned_long_int_compare, unsigned_long_int_print,
+    unsigned_long_int_hash, unsigned_long_int_equals};
 
 #if __STD_VERSION__ >= 199901L
 struct typetable ttbl_long_long_int = {
-    sizeof(long long int), NULL, NULL, NULL, long_long_int_compare,
-    long_long_int_print};
-
-struct typetable ttbl_signed_long_long_int = {sizeof(signed long long int),
-                                              NULL,
-                                              NULL,
-                                              NULL,
-                                              signed_long_long_int_compare,
-                                              signed_long_long_int_print};
-
-struct typetable ttbl_unsigned_long_long_int = {sizeof(unsigned long long int),
-                                                NULL,
-                                                NULL,
-                                                NULL,
-                                                unsigned_long_long_int_compare,
-                                                unsigned_long_long_int_print};
+    sizeof(long long int), NULL, NULL, NULL,
+    long_long_int_compare, long_long_int_print,
+    long_long_int_hash, long_long_int_equals};
+
+struct typetable ttbl_signed_long_long_int = {
+    sizeof(signed long long int), NULL, NULL, NULL,
+    signed_long_long_int_compare, signed_long_long_int_print,
+    signed_long_long_int_hash, signed_long_long_int_equals};
+
+struct typetable ttbl_unsigned_long_long_int = {
+    sizeof(unsigned long long int), NULL, NULL, NULL,
+    unsigned_long_long_int_compare, unsigned_long_long_int_print,
+    unsigned_long_long_int_hash, unsigned_long_long_int_equals};
 #endif /* __STDC_VERSION__ >= 199901L */
 
-struct typetable ttbl_float = {sizeof(float), NULL,          NULL,
-                               NULL,          float_compare, float_print};
+struct typetable ttbl_float = {
+    sizeof(float), NULL, NULL, NULL,
+    float_compare, float_print,
+    float_hash, float_equals};
 
-struct typetable ttbl_double = {sizeof(double), NULL,           NULL,
-                                NULL,           double_compare, double_print};
+struct typetable ttbl_double = {
+    sizeof(double), NULL, NULL, NULL,
+    double_compare, double_print,
+    double_hash, double_equals};
 
 #if __STDC_VERSION__ >= 199901L
 struct typetable ttbl_long_double = {
-    sizeof(long double), NULL, NULL, NULL, long_double_compare,
-    long_double_print};
+    sizeof(long double), NULL, NULL, NULL,
+    long_double_compare, long_double_print,
+    NULL, NULL};
 #endif
 
-struct typetable ttbl_bool = {sizeof(bool), NULL,         NULL,
-                              NULL,         bool_compare, bool_print};
+struct typetable ttbl_bool = {
+    sizeof(bool), NULL, NULL, NULL,
+    bool_compare, bool_print,
+    bool_hash, bool_equals};
 
-struct typetable ttbl_char_ptr = {sizeof(char *),   NULL,          NULL, NULL,
-                                  char_ptr_compare, char_ptr_print};
+struct typetable ttbl_char_ptr = {
+    sizeof(char *), NULL, NULL, NULL,
+    char_ptr_compare, char_ptr_print,
+    str_hash, str_equals};
 
-struct typetable ttbl_str = {sizeof(char *), str_copy,    str_dtor,
-                             str_swap,       str_compare, str_print};
+struct typetable ttbl_str = {
+    sizeof(char *), str_copy, str_dtor, str_swap,
+    str_compare, str_print,
+    str_hash, str_equals};
 
 struct typetable ttbl_str_ignore_case = {
-    sizeof(char *),          str_copy, str_dtor, str_swap,
-    str_compare_ignore_case, str_print};
+    sizeof(char *), str_copy, str_dtor, str_swap,
+    str_compare_ignore_case, str_print,
+    str_hash_ignore_case, str_equals_ignore_case};
 
-struct typetable ttbl_cstr = {sizeof(char *), NULL,         NULL,
-                              cstr_swap,      cstr_compare, cstr_print};
+struct typetable ttbl_cstr = {
+    sizeof(char *), NULL, NULL, cstr_swap,
+    cstr_compare, cstr_print,
+    cstr_hash, cstr_equals};
 
 struct typetable ttbl_cstr_ignore_case = {
-    sizeof(char *),           NULL,      NULL, cstr_swap,
-    cstr_compare_ignore_case, cstr_print};
+    sizeof(char *), NULL, NULL, cstr_swap,
+    cstr_compare_ignore_case, cstr_print,
+    cstr_hash_ignore_case, cstr_equals_ignore_case};
 
-struct typetable ttbl_cstr_strdup = {sizeof(char *), cstr_copy,    cstr_dtor,
-                                     cstr_swap,      cstr_compare, cstr_print};
+struct typetable ttbl_cstr_strdup = {
+    sizeof(char *), cstr_copy, cstr_dtor, cstr_swap,
+    cstr_compare, cstr_print,
+    cstr_hash, cstr_equals};
 
 struct typetable ttbl_cstr_ignore_case_strdup = {
-    sizeof(char *),           cstr_copy, cstr_dtor, cstr_swap,
-    cstr_compare_ignore_case, cstr_print};
+    sizeof(char *), cstr_copy, cstr_dtor, cstr_swap,
+    cstr_compare_ignore_case, cstr_print,
+    cstr_hash_ignore_case, cstr_equals_ignore_case};
+
+struct typetable ttbl_void_ptr = {
+    sizeof(void *), NULL, void_ptr_dtor, NULL,
+    void_ptr_compare, void_ptr_print,
+    void_ptr_hash, void_ptr_equals};
+
+struct typetable ttbl_int8 = {
+    sizeof(char), NULL, NULL, NULL,
+    char_compare, char_print,
+    char_hash, char_equals};
+
+struct typetable ttbl_int16 = {
+    sizeof(short int), NULL, NULL, NULL,
+    short_int_compare, short_int_print,
+    short_int_hash, short_int_equals};
+
+struct typetable ttbl_int32 = {
+    sizeof(int), NULL, NULL, NULL,
+    int_compare, int_print,
+    int_hash, int_equals};
 
-struct typetable ttbl_void_ptr = {sizeof(void *),   NULL,
-                                  void_ptr_dtor,    NULL,
-                                  void_ptr_compare, void_ptr_print};
-
-struct typetable ttbl_int8 = {sizeof(char), NULL,         NULL,
-                              NULL,         char_compare, char_print};
-
-struct typetable ttbl_int16 = {sizeof(short int), NULL,           NULL, NULL,
-                               short_int_compare, short_int_print};
-
-struct typetable ttbl_int32 = {sizeof(int), NULL,        NULL,
-                               NULL,        int_compare, int_print};
-
-#if __STD_VERSION__ >= 199901L
 struct typetable ttbl_int64 = {
-    sizeof(long long int), NULL, NULL, NULL, long_long_int_compare,
-    long_long_int_print};
-#endif /* __STDC_VERSION__ >= 199901L */
+    sizeof(int64_t), NULL, NULL, NULL,
+    int64_compare, int64_print,
+    int64_hash, int64_equals};
 
 struct typetable ttbl_uint8 = {
-    sizeof(unsigned char), NULL, NULL, NULL, unsigned_char_compare,
-    unsigned_char_print};
+    sizeof(unsigned char), NULL, NULL, NULL,
+    unsigned_char_compare, unsigned_char_print,
+    unsigned_char_hash, unsigned_char_equals};
 
 struct typetable ttbl_uint16 = {
-    sizeof(unsigned short int), NULL, NULL, NULL, unsigned_int_compare,
-    unsigned_int_print};
+    sizeof(unsigned short int), NULL, NULL, NULL,
+    unsigned_short_int_compare, unsigned_short_int_print,
+    unsigned_short_int_hash, unsigned_short_int_equals};
 
 struct typetable ttbl_uint32 = {
-    sizeof(unsigned int), NULL, NULL, NULL, unsigned_int_compare,
-    unsigned_int_print};
+    sizeof(unsigned int), NULL, NULL, NULL,
+    unsigned_int_compare, unsigned_int_print,
+    unsigned_int_hash, unsigned_int_equals};
 
-#if __STD_VERSION__ >= 199901L
-struct typetable ttbl_uint64 = {sizeof(unsigned long long int),
-                                NULL,
-                                NULL,
-                                NULL,
-                                unsigned_long_long_int_compare,
-                                unsigned_long_long_int_print};
-#endif /* __STDC_VERSION__ >= 199901L */
+struct typetable ttbl_uint64 = {
+    sizeof(uint64_t), NULL, NULL, NULL,
+    uint64_compare, uint64_print,
+    uint64_hash, uint64_equals};
 
 struct typetable *_char_ = &ttbl_char;
 struct typetable *_signed_char_ = &ttbl_signed_char;
@@ -1142,13 +1616,8 @@ struct typetable *_int16_t_ = &ttbl_int16;
 struct typetable *_int32_ = &ttbl_int32;
 struct typetable *_int32_t_ = &ttbl_int32;
 
-#if __STD_VERSION__ >= 199901L
 struct typetable *_int64_ = &ttbl_int64;
 struct typetable *_int64_t_ = &ttbl_int64;
-#else
-struct typetable *_int64_ = NULL;
-struct typetable *_int64_t = NULL;
-#endif /* __STDC_VERSION__ >= 199901L */
 
 struct typetable *_uint8_ = &ttbl_uint8;
 struct typetable *_uint8_t_ = &ttbl_uint8;
@@ -1157,13 +1626,8 @@ struct typetable *_uint16_t_ = &ttbl_uint16;
 struct typetable *_uint32_ = &ttbl_uint32;
 struct typetable *_uint32_t_ = &ttbl_uint32;
 
-#if __STD_VERSION__ >= 199901L
 struct typetable *_uint64_ = &ttbl_uint64;
 struct typetable *_uint64_t_ = &ttbl_uint64;
-#else
-struct typetable *_uint64_ = NULL;
-struct typetable *_uint64_t_ = NULL;
-#endif /* __STDC_VERSION__ >= 199901L */
 
 struct typetable *_pthread_t_ = NULL;
 
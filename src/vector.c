@@ -29,6 +29,7 @@
  */
 
 #include "vector.h"
+#include "hashset.h"
 #include "mergesort.h"
 #include "iterator.h"
 #include "utils.h"
@@ -39,6 +40,7 @@
 
 #define VECTOR_MAXIMUM_STACK_BUFFER_SIZE 16384
 #define VECTOR_DEFAULT_CAPACITY          16
+#define VECTOR_FIND_GROUP                16
 
 /**< optional macros for accessing the innards of vector_base */
 #define AT(VEC, INDEX)      ((char *)(VEC->impl.start) + ((INDEX) * (VEC->ttbl->width)))
@@ -73,6 +75,7 @@ static vector *v_allocate(void);
 static void v_init(vector *v, struct typetable *ttbl, size_t capacity);
 static void v_deinit(vector *v);
 static void v_swap_addr(vector *v, void *first, void *second);
+static void v_copyrnge(vector *v, iterator first, iterator last);
 
 struct typetable ttbl_vector = {
     sizeof(vector),
@@ -125,7 +128,8 @@ struct iterator_table itbl_vector = {
     vi_distance,
     vi_has_next,
     vi_has_prev,
-    vi_get_ttbl
+    vi_get_ttbl,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *_vector_iterator_ = &itbl_vector;
@@ -230,7 +234,12 @@ vector *v_newfill(struct typetable *ttbl, size_t n, void *valaddr) {
  *  If iterator first refers to a container with a ttbl that has a copy
  *  function defined, [first, last) will be copied into the return vector
  *  using the copy function -- this function meant for deep copying.
- *  Otherwise, [first, last) will be shallow-copied using memcpy.
+ *  Otherwise, [first, last) will be shallow-copied using memcpy
+ *  (a single memcpy, if first is contiguous).
+ *
+ *  If first is random access, the returned vector is allocated once,
+ *  to the size of [first, last). Otherwise, [first, last) is walked once
+ *  and the vector grows as it would for v_pushb.
  */
 vector *v_newrnge(iterator first, iterator last) {
     int delta = 0;
@@ -255,29 +264,29 @@ vector *v_newrnge(iterator first, iterator last) {
         return NULL;
     }
 
-    delta = it_distance(&first, &last);
     ttbl_first = it_get_ttbl(first);
 
-    v = v_newr(ttbl_first, delta);
-
-    sentinel = it_curr(last);         /* iteration range is [first, last) */
-
-    if (ttbl_first->copy) {
-        while ((curr = it_curr(first)) != sentinel)  {
-            ttbl_first->copy(v->impl.finish, curr);
+    if (it_random_access(first) == false) {
+        /**
+         *  Finding the length of [first, last) would mean walking it twice --
+         *  walk it once instead, and let v grow as it would for v_pushb.
+         */
+        v = v_new(ttbl_first);
+        sentinel = it_curr(last);
 
-            v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
+        while ((curr = it_curr(first)) != sentinel) {
+            v_pushb(v, curr);
             it_incr(&first);
         }
-    } else {
-        while ((curr = it_curr(first)) != sentinel)  {
-            memcpy(v->impl.finish, curr, v->ttbl->width);
 
-            v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-            it_incr(&first);
-        };
+        return v;
     }
 
+    delta = it_distance(&first, &last);
+
+    v = v_newr(ttbl_first, delta);
+    v_copyrnge(v, first, last);
+
     return v;
 }
 
@@ -905,6 +914,29 @@ const void *v_data_const(vector *v) {
     return &(v->impl.start);
 }
 
+/**
+ *  @brief  Retrieves v's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector
+ *
+ *  @return     span over [v_front(v), v_back(v)]
+ *
+ *  Unlike v_data, the base is the buffer itself, so
+ *      span s = v_span(v);
+ *      TYPE *array = s.base;
+ *  and array[i] is valid for 0 <= i < s.count.
+ *  The span is invalidated by anything that reallocates v.
+ */
+span v_span(vector *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = v_size(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector, starting at its beginning
  *
@@ -916,13 +948,14 @@ const void *v_data_const(vector *v) {
  *  contents from [first, last).
  *
  *  If the range of [first, last) exceeds that of v_capacity(v),
- *  the capacity will be increased to that of size it_distance(&first, &last).
+ *  the capacity will be increased to that of size it_distance(&first, &last)
+ *  -- if first is random access. Otherwise, [first, last) is walked once
+ *  and the vector grows as it would for v_pushb.
  */
 void v_assignrnge(vector *v, iterator first, iterator last) {
-    int delta = it_distance(&first, &last);
-    struct typetable *ttbl_first = it_get_ttbl(first);
+    int delta = 0;
 
-    void *sentinel = it_curr(last);
+    void *sentinel = NULL;
     void *curr = NULL;
 
     if (first.itbl != last.itbl) {
@@ -944,28 +977,28 @@ void v_assignrnge(vector *v, iterator first, iterator last) {
      */
     v_clear(v);
 
+    if (it_random_access(first) == false) {
+        /* one pass over [first, last); v grows as it would for v_pushb */
+        sentinel = it_curr(last);
+
+        while ((curr = it_curr(first)) != sentinel) {
+            v_pushb(v, curr);
+            it_incr(&first);
+        }
+
+        return;
+    }
+
     /**
      *  Resize vector if necessary.
      */
+    delta = it_distance(&first, &last);
+
     if (delta > v_capacity(v)) {
         v_resize(v, delta);
     }
 
-    if (ttbl_first->copy) {
-        while ((curr = it_curr(first)) != sentinel)  {
-            ttbl_first->copy(v->impl.finish, curr);
-
-            v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-            it_incr(&first);
-        }
-    } else {
-        while ((curr = it_curr(first)) != sentinel)  {
-            memcpy(v->impl.finish, curr, v->ttbl->width);
-
-            v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-            it_incr(&first);
-        };
-    }
+    v_copyrnge(v, first, last);
 }
 
 /**
@@ -1324,16 +1357,14 @@ iterator v_insertrnge(vector *v, iterator pos, iterator first, iterator last) {
     size_t old_capacity = 0;
     size_t delta = 0;
 
-    void *sentinel = NULL;
-    void *right_adj = NULL;
-    void *finish = NULL;
+    char *gap = NULL;
 
     massert_container(v);
 
     ipos = it_distance(NULL, &pos);      /**< pos's index position */
     old_size = v_size(v);                /**< v's former size */
     old_capacity = v_capacity(v);        /**< v's former capacity */
-    delta = it_distance(&first, &last);  /**< index(last) - index(first) */
+    delta = it_distance(&first, &last);  /**< O(1) if first is random access */
 
     if ((old_size + delta) >= old_capacity) {
         /**
@@ -1354,90 +1385,21 @@ iterator v_insertrnge(vector *v, iterator pos, iterator first, iterator last) {
         return it_next_n(v_begin(v), ipos);
     }
 
-    if (ipos >= old_size - 1) {
-        /* inlined instructions resembling pushb */
-        sentinel = (char *)(v->impl.finish) + (delta * v->ttbl->width);
-
-        if (v->ttbl->copy) {
-            while (v->impl.finish != sentinel) {
-                v->ttbl->copy(v->impl.finish, it_curr(first));
-                v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-                it_incr(&first);
-            }
-        } else {
-            while (v->impl.finish != sentinel) {
-                memcpy(v->impl.finish, it_curr(first), v->ttbl->width);
-                v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-                it_incr(&first);
-            }
-        }
-
-        /* since n == back index, return early */
-        return it_next_n(v_begin(v), delta);
-    } else {
-        /* decrement finish pointer so it refers to the rear element */
-        v->impl.finish = (char *)(v->impl.finish) - (v->ttbl->width);
-
-        /**
-         *  Each element in the range [n, v_size(v))
-         *  will be moved delta blocks over
-         *  -- starting with the rear element.
-         *
-         *  sentinel will be set one position behind pos.curr
-         *  to account for the new element(s) being inserted
-         */
-        sentinel = (char *)(pos.curr) - (v->ttbl->width);
-
-        /* new destination address for finish pointer */
-        right_adj = (char *)(v->impl.finish) + (delta * v->ttbl->width);
-
-        /* need to save this address for later when restoring impl.finish */
-        finish = (char *)(v->impl.finish) + ((delta + 1) * v->ttbl->width);
-
-        /**
-         *  Elements [n, v_size(v)) are moved over delta blocks to the right,
-         *  starting with v->impl.finish.
-         *  Loop stops when finish pointer reaches sentinel
-         */
-        while (v->impl.finish != sentinel) {
-            v_swap_addr(v, v->impl.finish, right_adj);
-
-            v->impl.finish = (char *)(v->impl.finish) - (v->ttbl->width);
-            right_adj = (char *)(right_adj) - (v->ttbl->width);
-        }
-
-        /**
-         *  sentinel is changed to point to the (ipos + delta)th block
-         *  (one element past the last fill insertion element)
-         */
-        sentinel = (char *)(v->impl.start) + ((ipos + delta)) * v->ttbl->width;
-
-        /**
-         *  v->impl.finish must be advanced one block forward
-         *  (finish was decremented until it was at the address of the former
-         *  sentinel value, which one position behind pos.curr)
-         */
-        v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
+    /**
+     *  Elements [ipos, v_size(v)) are moved delta blocks to the right
+     *  in one step, which leaves a gap of delta blocks at ipos.
+     */
+    gap = (char *)(v->impl.start) + (ipos * v->ttbl->width);
+    memmove(gap + (delta * v->ttbl->width), gap,
+            (old_size - ipos) * v->ttbl->width);
 
-        if (v->ttbl->copy) {
-            /* deep copy */
-            while (v->impl.finish != sentinel) {
-                v->ttbl->copy(v->impl.finish, it_curr(first));
-                v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-                it_incr(&first);
-            }
-        } else {
-            /* shallow copy */
-            while (v->impl.finish != sentinel) {
-                memcpy(v->impl.finish, it_curr(first), v->ttbl->width);
-                v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
-                it_incr(&first);
-            }
-        }
+    /* [first, last) is copied into the gap */
+    v->impl.finish = gap;
+    v_copyrnge(v, first, last);
 
-        /* now restoring v->impl.finish to where it should be */
-        v->impl.finish = finish;
-    }
+    /* now restoring v->impl.finish to where it should be */
+    v->impl.finish
+    = (char *)(v->impl.start) + ((old_size + delta) * v->ttbl->width);
 
     return it_next_n(v_begin(v), ipos);
 }
@@ -2088,6 +2050,111 @@ void v_remove_if(vector *v, bool (*unary_predicate)(const void *)) {
     }
 }
 
+/**
+ *  @brief  Removes every element of v that equals an earlier element,
+ *          in O(n) expected time -- v need not be sorted
+ *
+ *  @param[in]  v   pointer to vector
+ *
+ *  Every element is looked up in a hashset of the elements kept so far
+ *  (with v's ttbl->hash and ttbl->equals, see hashset); the first
+ *  occurrence of each element is kept and moved down into place,
+ *  so the kept elements keep their relative order. The elements
+ *  dropped are destroyed with ttbl->dtor, if there is one.
+ *
+ *  The hashset holds shallow copies of the kept elements,
+ *  which stay valid for as long as the elements themselves do.
+ */
+void v_unique_unordered(vector *v) {
+    struct typetable shallow;
+    hashset *seen = NULL;
+    size_t width = 0;
+
+    char *read = NULL;
+    char *write = NULL;
+
+    massert_container(v);
+
+    if (v->impl.start == v->impl.finish) {
+        return;
+    }
+
+    shallow = *(v->ttbl);
+    shallow.copy = NULL;
+    shallow.dtor = NULL;
+
+    seen = hs_new(&shallow);
+
+    width = v->ttbl->width;
+    write = v->impl.start;
+
+    for (read = v->impl.start; read != (char *)(v->impl.finish); read += width) {
+        if (hs_insert(seen, read)) {
+            if (write != read) {
+                memcpy(write, read, width);
+            }
+
+            write += width;
+        } else if (v->ttbl->dtor) {
+            v->ttbl->dtor(read);
+        }
+    }
+
+    v->impl.finish = write;
+    hs_delete(&seen);
+}
+
+/**
+ *  @brief  Hands v's elements to visitor as runs of adjacent elements
+ *
+ *  @param[in]  v       pointer to vector
+ *  @param[in]  chunk   most elements per run, or 0 for the whole buffer
+ *  @param[in]  visitor function to apply to each run
+ *  @param[in]  ctx     caller state, passed through to visitor
+ *
+ *  @return     number of elements passed to visitor
+ *
+ *  visitor receives ctx, the address of the first element of a run,
+ *  and the number of elements in it -- so a visitor that knows the
+ *  element type can loop over the run with a plain pointer,
+ *  and the compiler is free to unroll or vectorize that loop.
+ *  With chunk == 0, the entire buffer is one run;
+ *  a nonzero chunk bounds how much work is done between chances to stop.
+ *
+ *  The walk ends early once visitor returns false.
+ *  visitor must not insert or erase elements of v.
+ */
+size_t v_for_each_chunk(vector *v, size_t chunk,
+                        bool (*visitor)(void *, void *, size_t), void *ctx) {
+    char *curr = NULL;
+    size_t remaining = 0;
+    size_t visited = 0;
+
+    massert_container(v);
+    massert_pfunc(visitor);
+
+    curr = v->impl.start;
+    remaining = v_size(v);
+
+    if (chunk == 0) {
+        chunk = remaining;
+    }
+
+    while (remaining > 0) {
+        size_t count = remaining < chunk ? remaining : chunk;
+        visited += count;
+
+        if (visitor(ctx, curr, count) == false) {
+            break;
+        }
+
+        curr += count * v->ttbl->width;
+        remaining -= count;
+    }
+
+    return visited;
+}
+
 /**
  *  @brief  Append the contents of other to the rear of v
  *
@@ -2339,6 +2406,89 @@ int v_search(vector *v, const void *valaddr) {
     return found ? result : -1;
 }
 
+/**
+ *  @brief  Binary searches a sorted v for each of n keys at once
+ *
+ *  out[i] receives the address of the first element of v equal to
+ *  the i-th key, or NULL if there is none. v must be sorted by
+ *  ttbl->compare (e.g. by v_sort).
+ *
+ *  Searches proceed in groups of VECTOR_FIND_GROUP, one halving step
+ *  per round: every search in the group shares the same sequence of
+ *  interval lengths, so each can prefetch its next probe and the misses
+ *  of the group overlap, rather than stall one search at a time.
+ *
+ *  @param[in]  v       pointer to vector
+ *  @param[in]  keys    address of n contiguous keys, ttbl->width bytes each
+ *  @param[in]  n       number of keys
+ *  @param[out] out     array of n pointers to fill
+ *
+ *  @return     number of keys found
+ */
+size_t v_find_many(vector *v, const void *keys, size_t n, void **out) {
+    int (*comparator)(const void *, const void *) = NULL;
+    char *lane[VECTOR_FIND_GROUP];
+
+    size_t width = 0;
+    size_t size = 0;
+    size_t found = 0;
+    size_t base = 0;
+
+    massert_container(v);
+    massert_ptr(keys);
+    massert_ptr(out);
+
+    comparator = v->ttbl->compare ? v->ttbl->compare : void_ptr_compare;
+    width = v->ttbl->width;
+    size = v_size(v);
+
+    for (base = 0; base < n; base += VECTOR_FIND_GROUP) {
+        size_t group = n - base < VECTOR_FIND_GROUP ? n - base : VECTOR_FIND_GROUP;
+        size_t len = size;
+        size_t j = 0;
+
+        for (j = 0; j < group; j++) {
+            lane[j] = v->impl.start;
+        }
+
+        /* branch-free lower bound, one step for every lane per round */
+        while (len > 1) {
+            size_t half = len / 2;
+
+            for (j = 0; j < group; j++) {
+                if (comparator(lane[j] + half * width, ADDR_AT(keys, base + j, width)) < 0) {
+                    lane[j] += half * width;
+                }
+
+                PREFETCH(lane[j] + ((len - half) / 2) * width);
+            }
+
+            len -= half;
+        }
+
+        for (j = 0; j < group; j++) {
+            void *key = ADDR_AT(keys, base + j, width);
+            int cmp = size > 0 ? comparator(lane[j], key) : 1;
+
+            /* lane[j] is the last element less than key, if any -- */
+            /* then the lower bound is the element after it */
+            if (cmp < 0 && lane[j] + width != (char *)(v->impl.finish)) {
+                lane[j] += width;
+                cmp = comparator(lane[j], key);
+            }
+
+            if (cmp == 0) {
+                out[base + j] = lane[j];
+                ++found;
+            } else {
+                out[base + j] = NULL;
+            }
+        }
+    }
+
+    return found;
+}
+
 /**
  *  @brief  Sorts the contents of v using ttbl->compare
  *
@@ -2815,6 +2965,52 @@ static void v_swap_addr(vector *v, void *first, void *second) {
     temp = NULL;
 }
 
+/**
+ *  @brief  Copies [first, last) to v->impl.finish, and advances it
+ *
+ *  @param[in]  v       pointer to vector, with room for [first, last)
+ *  @param[in]  first   represents the beginning of the range (inc)
+ *  @param[in]  last    represents the end of the range (exc)
+ *
+ *  If v's ttbl has a copy function defined, elements are deep copied
+ *  one at a time. Otherwise, a contiguous range is copied with a single
+ *  memcpy, and any other range one element at a time.
+ */
+static void v_copyrnge(vector *v, iterator first, iterator last) {
+    void *sentinel = NULL;
+    void *curr = NULL;
+
+    if (v->ttbl->copy) {
+        /* deep copy */
+        sentinel = it_curr(last);
+
+        while ((curr = it_curr(first)) != sentinel) {
+            v->ttbl->copy(v->impl.finish, curr);
+
+            v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
+            it_incr(&first);
+        }
+    } else if (it_contiguous(first)) {
+        /* shallow copy, all at once */
+        span s = it_span(first, last);
+
+        if (s.count > 0) {
+            memcpy(v->impl.finish, s.base, s.count * s.width);
+            v->impl.finish = (char *)(v->impl.finish) + (s.count * s.width);
+        }
+    } else {
+        /* shallow copy */
+        sentinel = it_curr(last);
+
+        while ((curr = it_curr(first)) != sentinel) {
+            memcpy(v->impl.finish, curr, v->ttbl->width);
+
+            v->impl.finish = (char *)(v->impl.finish) + (v->ttbl->width);
+            it_incr(&first);
+        }
+    }
+}
+
 /**
  *  @brief  Initializes and returns an iterator that refers to arg
  *
@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, char_ptr) = {
     vidistance_char_ptr,
     vihasnext_char_ptr,
     vihasprev_char_ptr,
-    vigetttbl_char_ptr
+    vigetttbl_char_ptr,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_char_ptr = &table_id(itbl_vector, char_ptr);
@@ -935,6 +936,26 @@ const char_ptr **vdataconst_char_ptr(vector_char_ptr *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_char_ptr's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_char_ptr
+ *
+ *  @return     span over [vfront_char_ptr(v), vback_char_ptr(v)]
+ *
+ *  s.base may be cast to (char_ptr *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_char_ptr(vector_char_ptr *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_char_ptr(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_char_ptr, starting at its beginning
  *
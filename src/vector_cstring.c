@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, cstr) = {
     vidistance_cstr,
     vihasnext_cstr,
     vihasprev_cstr,
-    vigetttbl_cstr
+    vigetttbl_cstr,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_cstr = &table_id(itbl_vector, cstr);
@@ -935,6 +936,26 @@ const cstr **vdataconst_cstr(vector_cstr *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_cstr's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_cstr
+ *
+ *  @return     span over [vfront_cstr(v), vback_cstr(v)]
+ *
+ *  s.base may be cast to (cstr *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_cstr(vector_cstr *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_cstr(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_cstr, starting at its beginning
  *
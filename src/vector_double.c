@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, double) = {
     vidistance_double,
     vihasnext_double,
     vihasprev_double,
-    vigetttbl_double
+    vigetttbl_double,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_double = &table_id(itbl_vector, double);
@@ -935,6 +936,26 @@ const double **vdataconst_double(vector_double *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_double's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_double
+ *
+ *  @return     span over [vfront_double(v), vback_double(v)]
+ *
+ *  s.base may be cast to (double *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_double(vector_double *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_double(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_double, starting at its beginning
  *
@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, float) = {
     vidistance_float,
     vihasnext_float,
     vihasprev_float,
-    vigetttbl_float
+    vigetttbl_float,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_float = &table_id(itbl_vector, float);
@@ -935,6 +936,26 @@ const float **vdataconst_float(vector_float *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_float's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_float
+ *
+ *  @return     span over [vfront_float(v), vback_float(v)]
+ *
+ *  s.base may be cast to (float *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_float(vector_float *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_float(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_float, starting at its beginning
  *
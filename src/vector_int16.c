@@ -142,7 +142,8 @@ struct iterator_table table_id(itbl_vector, short) = {
     vidistance_short,
     vihasnext_short,
     vihasprev_short,
-    vigetttbl_short
+    vigetttbl_short,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_short = &table_id(itbl_vector, short);
@@ -936,6 +937,26 @@ const short **vdataconst_short(vector_short *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_short's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_short
+ *
+ *  @return     span over [vfront_short(v), vback_short(v)]
+ *
+ *  s.base may be cast to (short *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_short(vector_short *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_short(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_short, starting at its beginning
  *
@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, int) = {
     vidistance_int,
     vihasnext_int,
     vihasprev_int,
-    vigetttbl_int
+    vigetttbl_int,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_int = &table_id(itbl_vector, int);
@@ -935,6 +936,26 @@ const int **vdataconst_int(vector_int *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_int's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_int
+ *
+ *  @return     span over [vfront_int(v), vback_int(v)]
+ *
+ *  s.base may be cast to (int *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_int(vector_int *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_int(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_int, starting at its beginning
  *
@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, int64_t) = {
     vidistance_int64_t,
     vihasnext_int64_t,
     vihasprev_int64_t,
-    vigetttbl_int64_t
+    vigetttbl_int64_t,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_int64_t = &table_id(itbl_vector, int64_t);
@@ -935,6 +936,26 @@ const int64_t **vdataconst_int64_t(vector_int64_t *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_int64_t's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_int64_t
+ *
+ *  @return     span over [vfront_int64_t(v), vback_int64_t(v)]
+ *
+ *  s.base may be cast to (int64_t *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_int64_t(vector_int64_t *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_int64_t(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_int64_t, starting at its beginning
  *
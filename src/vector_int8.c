@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, char) = {
     vidistance_char,
     vihasnext_char,
     vihasprev_char,
-    vigetttbl_char
+    vigetttbl_char,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_char = &table_id(itbl_vector, char);
@@ -935,6 +936,26 @@ const char **vdataconst_char(vector_char *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_char's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_char
+ *
+ *  @return     span over [vfront_char(v), vback_char(v)]
+ *
+ *  s.base may be cast to (char *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_char(vector_char *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_char(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_char, starting at its beginning
  *
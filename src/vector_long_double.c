@@ -142,7 +142,8 @@ struct iterator_table table_id(itbl_vector, long_double) = {
     vidistance_long_double,
     vihasnext_long_double,
     vihasprev_long_double,
-    vigetttbl_long_double
+    vigetttbl_long_double,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_long_double = &table_id(itbl_vector, long_double);
@@ -936,6 +937,26 @@ const long_double **vdataconst_long_double(vector_long_double *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_long_double's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_long_double
+ *
+ *  @return     span over [vfront_long_double(v), vback_long_double(v)]
+ *
+ *  s.base may be cast to (long_double *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_long_double(vector_long_double *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_long_double(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_long_double, starting at its beginning
  *
@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, str) = {
     vidistance_str,
     vihasnext_str,
     vihasprev_str,
-    vigetttbl_str
+    vigetttbl_str,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_str = &table_id(itbl_vector, str);
@@ -935,6 +936,26 @@ const str **vdataconst_str(vector_str *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_str's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_str
+ *
+ *  @return     span over [vfront_str(v), vback_str(v)]
+ *
+ *  s.base may be cast to (str *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_str(vector_str *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_str(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_str, starting at its beginning
  *
@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, uint16_t) = {
     vidistance_uint16_t,
     vihasnext_uint16_t,
     vihasprev_uint16_t,
-    vigetttbl_uint16_t
+    vigetttbl_uint16_t,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_uint16_t = &table_id(itbl_vector, uint16_t);
@@ -935,6 +936,26 @@ const uint16_t **vdataconst_uint16_t(vector_uint16_t *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_uint16_t's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_uint16_t
+ *
+ *  @return     span over [vfront_uint16_t(v), vback_uint16_t(v)]
+ *
+ *  s.base may be cast to (uint16_t *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_uint16_t(vector_uint16_t *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_uint16_t(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_uint16_t, starting at its beginning
  *
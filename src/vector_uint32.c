@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, uint32_t) = {
     vidistance_uint32_t,
     vihasnext_uint32_t,
     vihasprev_uint32_t,
-    vigetttbl_uint32_t
+    vigetttbl_uint32_t,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_uint32_t = &table_id(itbl_vector, uint32_t);
@@ -935,6 +936,26 @@ const uint32_t **vdataconst_uint32_t(vector_uint32_t *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_uint32_t's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_uint32_t
+ *
+ *  @return     span over [vfront_uint32_t(v), vback_uint32_t(v)]
+ *
+ *  s.base may be cast to (uint32_t *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_uint32_t(vector_uint32_t *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_uint32_t(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_uint32_t, starting at its beginning
  *
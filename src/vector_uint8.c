@@ -141,7 +141,8 @@ struct iterator_table table_id(itbl_vector, uint8_t) = {
     vidistance_uint8_t,
     vihasnext_uint8_t,
     vihasprev_uint8_t,
-    vigetttbl_uint8_t
+    vigetttbl_uint8_t,
+    ITERATOR_CONTIGUOUS
 };
 
 struct iterator_table *vector_iterator_table_ptr_id_uint8_t = &table_id(itbl_vector, uint8_t);
@@ -935,6 +936,26 @@ const uint8_t **vdataconst_uint8_t(vector_uint8_t *v) {
     return result;
 }
 
+/**
+ *  @brief  Retrieves vector_uint8_t's elements as a base address, count, and width
+ *
+ *  @param[in]  v   pointer to vector_uint8_t
+ *
+ *  @return     span over [vfront_uint8_t(v), vback_uint8_t(v)]
+ *
+ *  s.base may be cast to (uint8_t *) and indexed over [0, s.count).
+ *  The span is invalidated by anything that reallocates v.
+ */
+span vspan_uint8_t(vector_uint8_t *v) {
+    span s;
+    massert_container(v);
+
+    s.base = v->impl.start;
+    s.width = v->ttbl->width;
+    s.count = vsize_uint8_t(v);
+    return s;
+}
+
 /**
  *  @brief  Assigns a range of elements to vector_uint8_t, starting at its beginning
  *
@@ -40,6 +40,581 @@
 #include "vector_string.h"
 #include "vec2D.h"
 
+/**
+ *  Number of CHECKs that have failed so far
+ */
+static int failures = 0;
+
+/**
+ *  @def        CHECK
+ *  @brief      Reports COND, with its file and line, if it does not hold
+ */
+#define CHECK(COND)                                                            \
+do {                                                                           \
+    if (!(COND)) {                                                             \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND);\
+        ++failures;                                                            \
+    }                                                                          \
+} while (0)
+
+/**
+ *  Number of distinct keys the randomized tests draw from
+ */
+#define TEST_KEYS 256
+
+/**
+ *  Number of random operations each randomized test performs
+ */
+#define TEST_OPS 20000
+
+static void test_hashmap(void);
+static void test_hashset(void);
+static void test_int64(void);
+static void test_intern(void);
+static void test_bloomfilter(void);
+static void test_cuckoofilter(void);
+
+/**
+ *  @brief  Writes i to buf, as the type ttbl describes
+ *
+ *  @param[in]  ttbl    one of _double_, _int_, or _short_int_
+ *  @param[in]  i       number to convert
+ *  @param[out] buf     receives the converted number
+ */
+static void test_make(struct typetable *ttbl, int i, void *buf) {
+    if (ttbl == _double_) {
+        double d = i + 0.5;
+        memcpy(buf, &d, sizeof d);
+    } else if (ttbl == _int_) {
+        int n = i;
+        memcpy(buf, &n, sizeof n);
+    } else {
+        short sh = (short)(i);
+        memcpy(buf, &sh, sizeof sh);
+    }
+}
+
+/**
+ *  @brief  Randomly inserts, assigns, and erases keys of a hashmap
+ *          with ttbl_key/ttbl_val, checking every step against arrays
+ *
+ *  Also checks that every key and value in the table
+ *  is aligned as its type requires.
+ */
+static void test_hashmap_types(struct typetable *ttbl_key,
+                               struct typetable *ttbl_val) {
+    hashmap *h = hm_new(ttbl_key, ttbl_val);
+    hashmap *copy = NULL;
+
+    bool present[TEST_KEYS];
+    int vals[TEST_KEYS];
+
+    char key[sizeof(double)];
+    char val[sizeof(double)];
+    char expected[sizeof(double)];
+
+    size_t size = 0;
+    size_t n = 0;
+    int i = 0;
+    iterator it;
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        present[i] = false;
+    }
+
+    for (n = 0; n < TEST_OPS; n++) {
+        int k = rand() % TEST_KEYS;
+        int v = rand() % 1000;
+        int op = rand() % 3;
+
+        test_make(ttbl_key, k, key);
+        test_make(ttbl_val, v, val);
+
+        if (op == 0) {
+            CHECK((hm_insert(h, key, val) != false) == (present[k] == false));
+
+            if (present[k] == false) {
+                present[k] = true;
+                vals[k] = v;
+                ++size;
+            }
+        } else if (op == 1) {
+            CHECK((hm_assign(h, key, val) != false) == (present[k] == false));
+
+            size += present[k] ? 0 : 1;
+            present[k] = true;
+            vals[k] = v;
+        } else {
+            hm_erase(h, key);
+
+            size -= present[k] ? 1 : 0;
+            present[k] = false;
+        }
+
+        CHECK(hm_size(h) == size);
+    }
+
+    copy = hm_newcopy(h);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        void *found = NULL;
+
+        test_make(ttbl_key, i, key);
+        found = hm_find(h, key);
+
+        CHECK((found != NULL) == (present[i] != false));
+        CHECK((hm_find(copy, key) != NULL) == (present[i] != false));
+
+        if (found && present[i]) {
+            test_make(ttbl_val, vals[i], expected);
+            CHECK(memcmp(found, expected, ttbl_val->width) == 0);
+        }
+    }
+
+    n = 0;
+
+    for (it = hm_begin(h); it.curr != hm_end(h).curr; it_incr(&it)) {
+        CHECK((size_t)(hm_key(h, it)) % ttbl_key->width == 0);
+        CHECK((size_t)(hm_val(h, it)) % ttbl_val->width == 0);
+        ++n;
+    }
+
+    CHECK(n == size);
+
+    hm_delete(&copy);
+    hm_delete(&h);
+}
+
+/**
+ *  @brief  Tests hashmap against arrays, with keys and values
+ *          of mixed widths -- so that entries need padding
+ */
+static void test_hashmap(void) {
+    test_hashmap_types(_double_, _int_);
+    test_hashmap_types(_int_, _double_);
+    test_hashmap_types(_short_int_, _double_);
+    test_hashmap_types(_double_, _short_int_);
+    test_hashmap_types(_int_, _int_);
+}
+
+/**
+ *  @brief  Randomly inserts and erases elements of a hashset,
+ *          checking every step against an array
+ */
+static void test_hashset(void) {
+    hashset *s = hs_new(_int_);
+    bool present[TEST_KEYS];
+
+    size_t size = 0;
+    size_t n = 0;
+    int i = 0;
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        present[i] = false;
+    }
+
+    for (n = 0; n < TEST_OPS; n++) {
+        int k = rand() % TEST_KEYS;
+
+        if (rand() % 2) {
+            CHECK((hs_insert(s, &k) != false) == (present[k] == false));
+            size += present[k] ? 0 : 1;
+            present[k] = true;
+        } else {
+            hs_erase(s, &k);
+            size -= present[k] ? 1 : 0;
+            present[k] = false;
+        }
+
+        CHECK(hs_size(s) == size);
+        CHECK(hs_count(s, &k) == (present[k] ? 1 : 0));
+    }
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        CHECK((hs_find(s, &i) != NULL) == (present[i] != false));
+    }
+
+    hs_delete(&s);
+}
+
+/**
+ *  @brief  Tests the int64/uint64 typetables -- compare, equals, hash,
+ *          and parse at the extremes -- and a hashmap keyed by each
+ */
+static void test_int64(void) {
+    int64_t smax = (int64_t)((((uint64_t)(1)) << 63) - 1);
+    int64_t smin = -smax - 1;
+    int64_t big = (int64_t)(1) << 40;
+    int64_t bigger = big + 1;
+    int64_t neg = -1;
+    uint64_t umax = (uint64_t)(0) - 1;
+    uint64_t ubig = (uint64_t)(1) << 63;
+    uint64_t one = 1;
+
+    hashmap *h = NULL;
+    vector *v = NULL;
+    iterator first;
+    iterator last;
+    iterator it;
+    char *parsed = NULL;
+    int64_t key = 0;
+    uint64_t ukey = 0;
+    int i = 0;
+
+    CHECK(_int64_ != NULL && _int64_t_ == _int64_);
+    CHECK(_uint64_ != NULL && _uint64_t_ == _uint64_);
+
+    if (_int64_ == NULL || _uint64_ == NULL) {
+        return;
+    }
+
+    CHECK(_int64_->width == sizeof(int64_t));
+    CHECK(_uint64_->width == sizeof(uint64_t));
+
+    /**< values that differ only above bit 31, or in sign */
+    CHECK(_int64_->compare(&big, &bigger) < 0);
+    CHECK(_int64_->compare(&bigger, &big) > 0);
+    CHECK(_int64_->compare(&smin, &smax) < 0);
+    CHECK(_int64_->compare(&neg, &big) < 0);
+    CHECK(_int64_->compare(&big, &big) == 0);
+    CHECK(_uint64_->compare(&one, &ubig) < 0);
+    CHECK(_uint64_->compare(&umax, &ubig) > 0);
+
+    CHECK(_int64_->equals(&big, &big) != false);
+    CHECK(_int64_->equals(&big, &bigger) == false);
+    CHECK(_uint64_->equals(&umax, &ubig) == false);
+
+    key = big;
+    CHECK(_int64_->hash(&key) == _int64_->hash(&big));
+    CHECK(_int64_->hash(&big) != _int64_->hash(&bigger));
+
+    parsed = int64_parse(&smin);
+    CHECK(strcmp(parsed, "-9223372036854775808") == 0);
+    free(parsed);
+
+    parsed = int64_parse(&smax);
+    CHECK(strcmp(parsed, "9223372036854775807") == 0);
+    free(parsed);
+
+    parsed = uint64_parse(&umax);
+    CHECK(strcmp(parsed, "18446744073709551615") == 0);
+    free(parsed);
+
+    /**< keys spaced 2^32 apart -- only their upper halves differ */
+    h = hm_new(_int64_, _int_);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        key = ((int64_t)(i) << 32) * (i % 2 ? -1 : 1);
+        CHECK(hm_insert(h, &key, &i) != false);
+    }
+
+    CHECK(hm_size(h) == TEST_KEYS);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        int *val = NULL;
+
+        key = ((int64_t)(i) << 32) * (i % 2 ? -1 : 1);
+        val = hm_find(h, &key);
+
+        CHECK(val != NULL && *val == i);
+    }
+
+    hm_delete(&h);
+
+    h = hm_new(_uint64_, _int_);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        ukey = umax - ((uint64_t)(i) << 32);
+        CHECK(hm_insert(h, &ukey, &i) != false);
+    }
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        int *val = NULL;
+
+        ukey = umax - ((uint64_t)(i) << 32);
+        val = hm_find(h, &ukey);
+
+        CHECK(val != NULL && *val == i);
+    }
+
+    hm_delete(&h);
+
+    /**< find and count compare 64-bit elements bytewise, in full */
+    v = v_new(_int64_);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        key = (int64_t)(i % 4) << 32;
+        v_pushb(v, &key);
+    }
+
+    key = (int64_t)(1) << 32;
+    first = v_begin(v);
+    last = v_end(v);
+    CHECK(count(&first, &last, &key) == TEST_KEYS / 4);
+
+    it = find(&first, &last, &key);
+    CHECK(it.curr != last.curr && *(int64_t *)(it_curr(it)) == key);
+
+    key = 1;
+    CHECK(count(&first, &last, &key) == 0);
+
+    v_delete(&v);
+}
+
+/**
+ *  @brief  Returns a malloc'd "key<i>", sized to fit -- never interned
+ */
+static char *test_plain_str(int i) {
+    char buf[32];
+    char *str = NULL;
+
+    sprintf(buf, "key%d", i);
+    str = malloc(strlen(buf) + 1);
+    massert_malloc(str);
+    strcpy(str, buf);
+
+    return str;
+}
+
+/**
+ *  @brief  _str_interned_ containers, keyed by interned and
+ *          non-interned strings alike
+ */
+static void test_intern(void) {
+    char *plain[TEST_KEYS];
+    const char *canonical[TEST_KEYS];
+    hashset *s = NULL;
+    hashmap *h = NULL;
+    rbtree *t = NULL;
+    char *key = NULL;
+    char *other = NULL;
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        plain[i] = test_plain_str(i);
+    }
+
+    /**< a non-interned string is hashed and compared by content */
+    CHECK(_str_interned_->hash(&plain[0]) == str_hash(&plain[0]));
+    CHECK(_str_interned_->equals(&plain[0], &plain[0]) != false);
+    CHECK(_str_interned_->equals(&plain[0], &plain[1]) == false);
+    CHECK(_str_interned_->compare(&plain[0], &plain[1]) < 0);
+
+    s = hs_new(_str_interned_);
+    h = hm_new(_str_interned_, _int_);
+    t = rbt_new(_str_interned_);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        CHECK(hs_insert(s, &plain[i]) != false);
+        CHECK(hm_insert(h, &plain[i], &i) != false);
+        rbt_insert(t, &plain[i]);
+    }
+
+    CHECK(str_intern_count() == TEST_KEYS);
+    CHECK(hs_size(s) == TEST_KEYS);
+    CHECK(rbt_size(t) == TEST_KEYS);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        char **found = NULL;
+        int *val = NULL;
+
+        canonical[i] = str_intern_find(plain[i]);
+        CHECK(canonical[i] != NULL && canonical[i] != plain[i]);
+        CHECK(canonical[i] != NULL && strcmp(canonical[i], plain[i]) == 0);
+
+        /**< equal content, distinct address: interned or not */
+        key = plain[i];
+        found = hs_find(s, &key);
+        CHECK(found != NULL && *found == canonical[i]);
+        CHECK(hs_insert(s, &key) == false);
+
+        val = hm_find(h, &key);
+        CHECK(val != NULL && *val == i);
+
+        found = rbt_find(t, &key);
+        CHECK(found != NULL && *found == canonical[i]);
+
+        key = (char *)(canonical[i]);
+        CHECK(_str_interned_->hash(&key) == str_hash(&plain[i]));
+        CHECK(_str_interned_->equals(&key, &plain[i]) != false);
+        CHECK(_str_interned_->equals(&plain[i], &key) != false);
+        CHECK(_str_interned_->compare(&key, &plain[i]) == 0);
+        CHECK(hs_find(s, &key) != NULL);
+
+        /**< a suffix of an interned string is not an interned string */
+        other = key + 1;
+        CHECK(_str_interned_->hash(&other) == str_hash(&other));
+        CHECK(_str_interned_->equals(&other, &key) == false);
+    }
+
+    /**< compare agrees with strcmp, ranked or not */
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i + 1 < TEST_KEYS; i++) {
+            int expected = strcmp(plain[i], plain[i + 1]);
+            int actual = 0;
+
+            key = (char *)(canonical[i]);
+            other = (char *)(canonical[i + 1]);
+            actual = _str_interned_->compare(&key, &other);
+            CHECK((actual < 0) == (expected < 0) && (actual > 0) == (expected > 0));
+
+            actual = _str_interned_->compare(&key, &plain[i + 1]);
+            CHECK((actual < 0) == (expected < 0) && (actual > 0) == (expected > 0));
+        }
+
+        str_intern_rank();
+    }
+
+    for (i = 0; i < TEST_KEYS; i += 2) {
+        hs_erase(s, &plain[i]);
+        rbt_erase(t, &plain[i]);
+    }
+
+    CHECK(hs_size(s) == TEST_KEYS / 2);
+    CHECK(rbt_size(t) == TEST_KEYS / 2);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        CHECK((hs_find(s, &plain[i]) != NULL) == (i % 2 == 1));
+        CHECK((rbt_find(t, &plain[i]) != NULL) == (i % 2 == 1));
+    }
+
+    hs_delete(&s);
+    hm_delete(&h);
+    rbt_delete(&t);
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        free(plain[i]);
+    }
+
+    str_intern_clear();
+    CHECK(str_intern_count() == 0);
+}
+
+/**
+ *  @brief  bloomfilter: no false negatives, few false positives,
+ *          and a serialized filter answers as the original does
+ */
+static void test_bloomfilter(void) {
+    int keys[2 * TEST_KEYS];
+    bool out[2 * TEST_KEYS];
+    bloomfilter *bf = NULL;
+    bloomfilter *copy = NULL;
+    unsigned char *buf = NULL;
+    size_t size = 0;
+    size_t positives = 0;
+    int i = 0;
+
+    bf = bf_new(_int_, TEST_KEYS, 0.01);
+
+    for (i = 0; i < 2 * TEST_KEYS; i++) {
+        keys[i] = i * 7919;
+    }
+
+    /**< even-indexed keys are added, odd-indexed ones are not */
+    for (i = 0; i < 2 * TEST_KEYS; i += 2) {
+        bf_add(bf, &keys[i]);
+    }
+
+    positives = bf_maybe_contains_many(bf, keys, 2 * TEST_KEYS, out);
+
+    for (i = 0; i < 2 * TEST_KEYS; i++) {
+        CHECK(out[i] == bf_maybe_contains(bf, &keys[i]));
+
+        if (i % 2 == 0) {
+            CHECK(out[i] != false);
+        }
+    }
+
+    CHECK(positives >= TEST_KEYS && positives - TEST_KEYS < TEST_KEYS / 10);
+
+    size = bf_serialize(bf, NULL, 0);
+    buf = malloc(size);
+    massert_malloc(buf);
+
+    CHECK(bf_serialize(bf, buf, size) == size);
+    copy = bf_deserialize(_int_, buf, size);
+    CHECK(copy != NULL);
+
+    for (i = 0; copy && i < 2 * TEST_KEYS; i++) {
+        CHECK(bf_maybe_contains(copy, &keys[i]) == out[i]);
+    }
+
+    if (copy) {
+        bf_delete(&copy);
+    }
+
+    free(buf);
+    bf_delete(&bf);
+}
+
+/**
+ *  @brief  cuckoofilter: no false negatives -- in particular, while
+ *          a victim (a fingerprint that found no slot) is set
+ */
+static void test_cuckoofilter(void) {
+    int keys[TEST_KEYS];
+    cuckoofilter *cf = NULL;
+    cuckoofilter *copy = NULL;
+    unsigned char *buf = NULL;
+    size_t size = 0;
+    int lo = 0;
+    int hi = 0;
+    int round = 0;
+    int i = 0;
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        keys[i] = i;
+    }
+
+    cf = cf_new(_int_, 64);
+
+    /**
+     *  fill cf until cf_add fails (a victim is set), remove the oldest
+     *  key, and repeat: every key still in cf must be found
+     */
+    for (round = 0; round < TEST_KEYS / 2 && hi < TEST_KEYS; round++) {
+        while (hi < TEST_KEYS && cf_add(cf, &keys[hi])) {
+            ++hi;
+        }
+
+        CHECK(cf_remove(cf, &keys[lo]) != false);
+        ++lo;
+
+        CHECK(cf_count(cf) == (size_t)(hi - lo));
+
+        for (i = lo; i < hi; i++) {
+            CHECK(cf_maybe_contains(cf, &keys[i]) != false);
+        }
+    }
+
+    size = cf_serialize(cf, NULL, 0);
+    buf = malloc(size);
+    massert_malloc(buf);
+
+    CHECK(cf_serialize(cf, buf, size) == size);
+    copy = cf_deserialize(_int_, buf, size);
+    CHECK(copy != NULL);
+
+    for (i = lo; copy && i < hi; i++) {
+        CHECK(cf_maybe_contains(copy, &keys[i]) != false);
+    }
+
+    if (copy) {
+        cf_delete(&copy);
+    }
+
+    free(buf);
+
+    /**< removing everything leaves an empty filter */
+    for (i = lo; i < hi; i++) {
+        CHECK(cf_remove(cf, &keys[i]) != false);
+    }
+
+    CHECK(cf_count(cf) == 0);
+    cf_delete(&cf);
+}
+
 /**
  *  @brief  Program execution begins here
  *
@@ -109,5 +684,19 @@ int main(int argc, const char * argv[]) {
     vdelete_str(&v);
     */
 
+    srand(1);
+
+    test_hashmap();
+    test_hashset();
+    test_int64();
+    test_intern();
+    test_bloomfilter();
+    test_cuckoofilter();
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }